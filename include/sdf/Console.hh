@@ -21,6 +21,7 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <sdf/sdf_config.h>
@@ -153,6 +154,13 @@ namespace sdf
     /// \return Mutable reference to current log stream object.
     public: ConsoleStream &GetLogStream();
 
+    /// \brief Get the mutex that serializes writes to the log file, which
+    /// may come from several threads that are parsing at the same time. The
+    /// log file is only opened by the constructor, so checking whether it is
+    /// open needs no lock.
+    /// \return The mutex.
+    private: static std::mutex &LogFileMutex();
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<ConsolePrivate> dataPtr;
@@ -184,10 +192,12 @@ namespace sdf
       *this->stream << _rhs;
     }
 
-    if (Console::Instance()->dataPtr->logFileStream.is_open())
+    ConsolePtr console = Console::Instance();
+    if (console->dataPtr->logFileStream.is_open())
     {
-      Console::Instance()->dataPtr->logFileStream << _rhs;
-      Console::Instance()->dataPtr->logFileStream.flush();
+      std::lock_guard<std::mutex> lock(Console::LogFileMutex());
+      console->dataPtr->logFileStream << _rhs;
+      console->dataPtr->logFileStream.flush();
     }
 
     return *this;
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_CONVERSION_CACHE_HH_
+#define SDF_CONVERSION_CACHE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Error.hh"
+#include "sdf/FileStamp.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief A directory of files that were converted to the latest SDFormat
+/// version when they were read.
+///
+/// Files of older SDFormat versions, and URDF files, are converted every
+/// time they are read. When a ParserConfig has a conversion cache, readFile
+/// stores the result of reading such a file in the cache directory, in the
+/// binary form written by sdf::precompileFile, and later reads of the same
+/// file load it from there instead, in the same or in another process.
+///
+/// Entries are keyed by the resolved file name, the SHA-256 digest of the
+/// contents of the file and the ParserConfig settings that change how the
+/// file is read, and by SDF_PATH and the current directory, which change
+/// how its includes are resolved. Each entry stores the file name and the
+/// size and digest of the contents, which are checked before it is used,
+/// and it is only used by the same version of the library, and while the
+/// modification time and size of every file that the file includes are
+/// unchanged. The results of a find file callback cannot be checked, so the
+/// cache is not used with a ParserConfig that has one.
+///
+/// The total size of the entries is kept below a limit by removing the
+/// entries that were used least recently. The modification time of an
+/// entry is its last use. An insert lists the directory again whenever
+/// another process changed it since the last listing, so the limit also
+/// holds across processes that share the directory, except for entries
+/// that several processes write at the same moment, which are counted by
+/// the next insert that lists the directory.
+///
+/// The cache may be used from several threads at once.
+///
+/// Example:
+/// \code{.cpp}
+///   sdf::ParserConfig config;
+///   config.SetConversionCache(
+///       std::make_shared<sdf::ConversionCache>("/tmp/sdf_cache"));
+///
+///   // A 1.6 model is converted and stored in /tmp/sdf_cache.
+///   sdf::Root first;
+///   first.Load("model_1_6.sdf", config);
+///
+///   // The converted model is loaded from /tmp/sdf_cache.
+///   sdf::Root second;
+///   second.Load("model_1_6.sdf", config);
+/// \endcode
+class SDFORMAT_VISIBLE ConversionCache
+{
+  /// \brief Default limit of the total size of the entries, in bytes.
+  public: static constexpr std::uintmax_t kDefaultMaxSize = 256u << 20;
+
+  /// \brief Constructor.
+  /// \param[in] _directory Directory the entries are stored in. It is
+  /// created if it does not exist, but its parent must exist.
+  /// \param[in] _maxSize Limit of the total size of the entries, in bytes.
+  public: explicit ConversionCache(const std::string &_directory,
+                                   std::uintmax_t _maxSize = kDefaultMaxSize);
+
+  /// \brief Get the directory the entries are stored in.
+  /// \return The directory.
+  public: const std::string &Directory() const;
+
+  /// \brief Get the limit of the total size of the entries.
+  /// \return The limit, in bytes.
+  public: std::uintmax_t MaxSize() const;
+
+  /// \brief Load the stored result of reading a file.
+  /// \param[in] _filename Resolved name of the file.
+  /// \param[in] _contents Contents of the file.
+  /// \param[in] _config Configuration the file is being read with.
+  /// \param[out] _sdf SDF object that is set to the stored result.
+  /// \param[out] _errors The errors that were found when the file was read
+  /// are appended to this.
+  /// \param[out] _files Set to the files that were read along with
+  /// _filename, such as the files it includes, with their stamps from when
+  /// the entry was made.
+  /// \return True if the cache has a usable entry for the file.
+  public: bool Find(const std::string &_filename,
+                    std::string_view _contents,
+                    const ParserConfig &_config,
+                    SDFPtr _sdf,
+                    Errors &_errors,
+                    StampedFiles &_files) const;
+
+  /// \brief Store the result of reading a file, replacing any earlier
+  /// entry for the same file, contents and configuration. Entries that were
+  /// used least recently are then removed while the total size is above
+  /// the limit.
+  /// \param[in] _filename Resolved name of the file.
+  /// \param[in] _contents Contents of the file.
+  /// \param[in] _config Configuration the file was read with.
+  /// \param[in] _sdf The result of reading the file.
+  /// \param[in] _errors The errors found when reading the file.
+  /// \param[in] _files The files that were read along with _filename, each
+  /// stamped before it was read. A change to any of them, including one
+  /// made while it was read, invalidates the entry.
+  /// \return True if the entry was written.
+  public: bool Insert(const std::string &_filename,
+                      std::string_view _contents,
+                      const ParserConfig &_config,
+                      const SDFPtr _sdf,
+                      const Errors &_errors,
+                      const StampedFiles &_files);
+
+  /// \brief Remove all the entries from the cache directory.
+  public: void Clear();
+
+  /// \brief Get the total size of the entries in the cache directory.
+  /// \return The size, in bytes.
+  public: std::uintmax_t Size() const;
+
+  /// \brief Get the number of calls to Find that loaded an entry.
+  /// \return Number of cache hits.
+  public: std::size_t HitCount() const;
+
+  /// \brief Get the number of calls to Find that found no usable entry.
+  /// \return Number of cache misses.
+  public: std::size_t MissCount() const;
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
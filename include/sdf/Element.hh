@@ -20,6 +20,7 @@
 #include <any>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -47,6 +48,7 @@ namespace sdf
   //
 
   class ElementPrivate;
+  class PrecompiledSdf;
   class SDFORMAT_VISIBLE Element;
 
   /// \def ElementPtr
@@ -267,16 +269,31 @@ namespace sdf
     /// \return The number of element descriptions.
     public: size_t GetElementDescriptionCount() const;
 
-    /// \brief Get an element description using an index
+    /// \brief Get an element description using an index.
+    /// Element descriptions are shared between all elements created from
+    /// the same description, so the returned element should be cloned
+    /// before it is modified.
     /// \param[in] _index the index of the element description to get.
     /// \return An Element pointer to the found element.
     public: ElementPtr GetElementDescription(unsigned int _index) const;
 
-    /// \brief Get an element description using a key
+    /// \brief Get an element description using a key.
+    /// Element descriptions are shared between all elements created from
+    /// the same description, so the returned element should be cloned
+    /// before it is modified.
     /// \param[in] _key the key to use to find the element.
     /// \return An Element pointer to the found element.
     public: ElementPtr GetElementDescription(const std::string &_key) const;
 
+    /// \brief Get the index of an element description using a key. The
+    /// lookup uses a table built when the descriptions are added, so it does
+    /// not search the list of descriptions.
+    /// \param[in] _key the name of the element description to find.
+    /// \return The index of the first element description with the given
+    /// name, or std::nullopt if there is no such description.
+    public: std::optional<std::size_t> GetElementDescriptionIndex(
+                const std::string &_key) const;
+
     /// \brief Return true if an element description exists.
     /// \param[in] _name the name of the element to find.
     /// \return True if the element description exists, false otherwise.
@@ -538,10 +555,29 @@ namespace sdf
     /// /sdf/world[@name="default"]/model[@name="robot1"]/link[@name="link"])
     public: void SetXmlPath(const std::string &_path);
 
-    /// \brief Get the XML path of this element.
+    /// \brief Set the XML path of this element relative to the XML path of
+    /// its parent, which is only joined with it when the full path is asked
+    /// for. For the link of the example of SetXmlPath, the relative XML path
+    /// would be: link[@name="link"]
+    ///
+    /// The full path does not change when the element moves to another
+    /// parent or is cloned. It is only known while the parent element
+    /// exists, or if it was asked for before.
+    /// \param[in] _path XML path relative to the parent element.
+    public: void SetRelativeXmlPath(const std::string &_path);
+
+    /// \brief Get the XML path of this element. A relative XML path is
+    /// joined with the XML path of the parent element the first time, and
+    /// the result is kept with the element.
     /// \return Full XML path to the SDF element.
     public: const std::string &XmlPath() const;
 
+    /// \brief Build the XML path of this element. Unlike XmlPath, a relative
+    /// XML path is joined with the XML path of the parent element on each
+    /// call, and the result is not kept with the element.
+    /// \return Full XML path to the SDF element.
+    public: std::string BuildXmlPath() const;
+
     /// \brief Set the spec version that this was originally parsed from.
     /// \param[in] _version Spec version string.
     public: void SetOriginalVersion(const std::string &_version);
@@ -611,12 +647,45 @@ namespace sdf
                                   const std::string &_description = "");
 
 
+    /// \brief Create a copy of this Element and its descendants that keeps
+    /// the relative XML path of this Element.
+    /// \return A copy of this Element.
+    private: ElementPtr CloneTree() const;
+
+    /// \brief Set the XML path of this Element, keeping the full XML paths
+    /// of the child elements whose XML paths are relative to it.
+    /// \param[in] _path The XML path.
+    /// \param[in] _relative True if the path is relative to the parent.
+    private: void UpdateXmlPath(const std::string &_path, bool _relative);
+
     /// \brief Private data pointer
     private: std::unique_ptr<ElementPrivate> dataPtr;
+
+    /// \brief Reads and writes the private data of precompiled files.
+    friend class PrecompiledSdf;
+
+    /// \brief Tells the parent of an element when its name attribute changes.
+    friend class ParamPrivate;
   };
 
+  /// \internal
+  /// \brief Names of the child elements of an element.
+  struct ElementChildNames;
+
+  /// \internal
+  /// \brief List of the element descriptions of an element.
+  class ElementDescriptionList;
+
+  /// \internal
+  /// \brief Private data of an Element that is not part of ElementPrivate.
+  class ElementState;
+
   /// \internal
   /// \brief Private data for Element
+  ///
+  /// The inline templates of Element read the members of this class, so
+  /// binaries built against 12.4 depend on its layout. Data that was added
+  /// after 12.4 is kept in ElementState, see state.
   class ElementPrivate
   {
     /// \brief Element name
@@ -625,7 +694,8 @@ namespace sdf
     /// \brief True if element is required
     public: std::string required;
 
-    /// \brief Element description
+    /// \brief Element description. It is not set, since ElementState holds
+    /// the description.
     public: std::string description;
 
     /// \brief True if element's children should be copied.
@@ -686,6 +756,64 @@ namespace sdf
     /// \brief XML path of this element.
     public: std::string xmlPath;
 
+    /// \brief Private data that is not part of the 12.4 layout above.
+    public: std::unique_ptr<ElementState> state;
+
+    /// \brief Mark the full XML path joined by XmlPath as out of date, after
+    /// xmlPath or the parent changed.
+    public: void ResetFullXmlPath();
+
+    /// \brief Destructor.
+    public: ~ElementPrivate();
+
+    /// \brief Get the names of the child elements, counting them if they
+    /// changed since they were last counted.
+    /// \return The names of the child elements.
+    public: const ElementChildNames &ChildNames() const;
+
+    /// \brief Forget the names of the child elements after the child
+    /// elements, or their names, changed.
+    public: void ChildNamesChanged();
+
+    /// \brief Get the list of element descriptions for modification. If the
+    /// list is shared with other elements, it is copied first so that the
+    /// other elements are not affected.
+    /// \return The element descriptions owned by this element.
+    public: ElementDescriptionList &MutableElementDescriptions();
+
+    /// \brief Update the name index after a child element has been appended
+    /// to the list of child elements.
+    /// \param[in] _elem The appended child element.
+    public: void AddToElementIndex(const ElementPtr &_elem);
+
+    /// \brief Update the name index after a child element has been removed
+    /// from the list of child elements.
+    /// \param[in] _elem The removed child element.
+    public: void RemoveFromElementIndex(const ElementPtr &_elem);
+
+    /// \brief Rebuild the name index from the list of child elements.
+    public: void RebuildElementIndex();
+
+    /// \brief Find the first child element with the given name.
+    /// \param[in] _name Name of the child element.
+    /// \return The child element, or nullptr if not found.
+    public: ElementPtr FindElementByName(const std::string &_name) const;
+
+    /// \brief Update the key index after an attribute has been appended to
+    /// the list of attributes.
+    /// \param[in] _param The appended attribute.
+    public: void AddToAttributeIndex(const ParamPtr &_param);
+
+    /// \brief Update the key index after an attribute has been removed from
+    /// the list of attributes.
+    /// \param[in] _param The removed attribute.
+    public: void RemoveFromAttributeIndex(const ParamPtr &_param);
+
+    /// \brief Find the first attribute with the given key.
+    /// \param[in] _key Key of the attribute.
+    /// \return The attribute, or nullptr if not found.
+    public: ParamPtr FindAttributeByKey(const std::string &_key) const;
+
     /// \brief Generate the string (XML) for the attributes.
     /// \param[in] _includeDefaultAttributes flag to include default attributes.
     /// \param[in] _config Configuration for printing attributes.
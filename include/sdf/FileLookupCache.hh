@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef SDF_FILE_LOOKUP_CACHE_HH_
+#define SDF_FILE_LOOKUP_CACHE_HH_
+
+#include <cstddef>
+#include <string>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief A cache of the file system lookups done to resolve URIs.
+///
+/// sdf::findFile tries several search paths for each URI, and the model
+/// directory of each <include> is searched for a model.config file that is
+/// then parsed. On slow file systems, such as network mounts of large model
+/// libraries, these lookups can take most of the load time. When a
+/// ParserConfig has a file lookup cache, the results of sdf::findFile,
+/// including files that were not found, the directory checks and the model
+/// file chosen from each model.config are remembered and reused.
+///
+/// Results are keyed by everything that sdf::findFile depends on except
+/// the find file callback: the URI path map, the SDF_PATH environment
+/// variable and, when the local path is searched, the current directory.
+/// The cache is not told about files that are added, removed or changed
+/// later, so Clear() must be called after such changes.
+///
+/// The cache may be used from several threads at once.
+class SDFORMAT_VISIBLE FileLookupCache
+{
+  /// \brief Default constructor
+  public: FileLookupCache();
+
+  /// \brief Same as sdf::findFile, with the result taken from the cache if
+  /// the same lookup was done before.
+  /// \param[in] _filename Name of the file to find.
+  /// \param[in] _searchLocalPath True to search for the file in the current
+  /// working directory.
+  /// \param[in] _useCallback True to find a file based on a registered
+  /// callback if the file is not found via the normal mechanism.
+  /// \param[in] _config Parser configuration to use for the search.
+  /// \return File's full path, or an empty string if the file was not
+  /// found.
+  public: std::string FindFile(const std::string &_filename,
+                               bool _searchLocalPath,
+                               bool _useCallback,
+                               const ParserConfig &_config);
+
+  /// \brief Check whether a path is a directory.
+  /// \param[in] _path The path to check.
+  /// \return True if _path is a directory.
+  public: bool IsDirectory(const std::string &_path);
+
+  /// \brief Same as sdf::getModelFilePath, with the result taken from the
+  /// cache if the model directory was looked up before.
+  /// \param[in] _modelDirPath Directory of the model.
+  /// \return Path of the best supported model file in the directory, or an
+  /// empty string on error.
+  public: std::string ModelFilePath(const std::string &_modelDirPath);
+
+  /// \brief Remove all the results from the cache.
+  public: void Clear();
+
+  /// \brief Get the number of lookups that were answered from the cache.
+  /// \return Number of cache hits.
+  public: std::size_t HitCount() const;
+
+  /// \brief Get the number of lookups that queried the file system.
+  /// \return Number of cache misses.
+  public: std::size_t MissCount() const;
+
+  /// \brief Get the number of file system queries, such as checks for the
+  /// existence of a file and reads of model.config files, that the cache
+  /// hits avoided.
+  /// \return Number of queries avoided.
+  public: std::size_t QueriesAvoided() const;
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
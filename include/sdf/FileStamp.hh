@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef SDF_FILE_STAMP_HH_
+#define SDF_FILE_STAMP_HH_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief Modification time and size of a file, used by the caches of
+/// parsed files to tell whether the file changed since a result read from
+/// it was stored.
+struct SDFORMAT_VISIBLE FileStamp
+{
+  /// \brief Modification time in seconds, or -1 if the file is missing.
+  int64_t mtime = -1;
+
+  /// \brief Sub-second part of the modification time, where available.
+  int64_t mtimeNsec = 0;
+
+  /// \brief Size in bytes.
+  int64_t size = -1;
+
+  /// \brief Equality operator.
+  /// \param[in] _other Stamp to compare with.
+  /// \return True if both stamps are the same.
+  bool operator==(const FileStamp &_other) const
+  {
+    return this->mtime == _other.mtime &&
+           this->mtimeNsec == _other.mtimeNsec &&
+           this->size == _other.size;
+  }
+};
+
+/// \brief Files that were read, each with the stamp it had before it was
+/// read. A file that changes while it is read then no longer matches its
+/// stamp.
+using StampedFiles = std::vector<std::pair<std::string, FileStamp>>;
+}
+}
+#endif
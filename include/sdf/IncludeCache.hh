@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef SDF_INCLUDE_CACHE_HH_
+#define SDF_INCLUDE_CACHE_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ignition/utils/ImplPtr.hh>
+
+#include "sdf/Error.hh"
+#include "sdf/FileStamp.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief A cache of the files read through <include> elements.
+///
+/// When a ParserConfig has an include cache, each file read for an
+/// <include> is stored in the cache after it has been read, parsed and
+/// converted. Later includes of the same file, in the same document or in
+/// any later document loaded with a ParserConfig that shares the cache, copy
+/// the stored elements instead of reading the file again. The overrides of
+/// the <include> element, such as <name>, <pose>, <static>, <plugin> and
+/// <experimental:params>, are applied to the copy.
+///
+/// Entries are keyed by the resolved file name, by the ParserConfig
+/// settings that change how the file is read, and by SDF_PATH and the
+/// current directory, which change how its includes are resolved. An entry
+/// is only used while the modification time and size of the file, and of
+/// every file it includes, are unchanged. The results of a find file
+/// callback cannot be checked, so the cache is not used with a ParserConfig
+/// that has one.
+///
+/// The cache may be used from several threads at once.
+///
+/// Example:
+/// \code{.cpp}
+///   sdf::ParserConfig config;
+///   config.SetIncludeCache(std::make_shared<sdf::IncludeCache>());
+///
+///   sdf::Root first;
+///   first.Load("world.sdf", config);
+///
+///   // Models included by world.sdf are not read from disk again.
+///   sdf::Root second;
+///   second.Load("world.sdf", config);
+/// \endcode
+class SDFORMAT_VISIBLE IncludeCache
+{
+  /// \brief Default constructor
+  public: IncludeCache();
+
+  /// \brief Copy the cached contents of an included file.
+  /// \param[in] _filename Resolved name of the included file.
+  /// \param[in] _config Configuration the file is being read with.
+  /// \param[out] _sdf SDF object whose root is replaced by a copy of the
+  /// cached elements.
+  /// \param[out] _errors The errors that were found when the file was read
+  /// are appended to this.
+  /// \param[out] _files The files that were read along with _filename,
+  /// such as the files it includes, are appended to this, with their
+  /// stamps from when the entry was made.
+  /// \return True if the file was found in the cache and is unchanged.
+  public: bool Find(const std::string &_filename,
+                    const ParserConfig &_config,
+                    SDFPtr _sdf,
+                    Errors &_errors,
+                    StampedFiles &_files) const;
+
+  /// \brief Add an included file to the cache, replacing any earlier entry
+  /// for the same file and configuration.
+  /// \param[in] _filename Resolved name of the included file.
+  /// \param[in] _config Configuration the file was read with.
+  /// \param[in] _sdf The file that was read. Its elements are copied.
+  /// \param[in] _errors The errors found when reading the file.
+  /// \param[in] _files The files that were read, starting with _filename
+  /// itself and followed by the files read along with it, such as the files
+  /// it includes. Each is stamped before it is read, so that a change made
+  /// to any of them while it is read invalidates the entry.
+  public: void Insert(const std::string &_filename,
+                      const ParserConfig &_config,
+                      const SDFPtr _sdf,
+                      const Errors &_errors,
+                      const StampedFiles &_files);
+
+  /// \brief Remove all the entries from the cache.
+  public: void Clear();
+
+  /// \brief Get the number of entries in the cache.
+  /// \return Number of entries.
+  public: std::size_t Size() const;
+
+  /// \brief Get the number of calls to Find that copied an entry.
+  /// \return Number of cache hits.
+  public: std::size_t HitCount() const;
+
+  /// \brief Get the number of calls to Find that found no usable entry.
+  /// \return Number of cache misses.
+  public: std::size_t MissCount() const;
+
+  /// \brief Private data pointer.
+  IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}
+}
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_INTERNED_STRING_HH_
+#define SDF_INTERNED_STRING_HH_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief Handle to a string in a table that is shared by the whole
+/// program.
+///
+/// The descriptions of elements and parameters come from the spec files,
+/// but are held by every element and parameter. An InternedString stores a
+/// pointer to the one copy of its value in the table, so copies of it do
+/// not allocate, and two InternedStrings are equal if and only if they
+/// point to the same copy.
+///
+/// Strings are never removed from the table, which may be used from
+/// several threads at once. Only strings of the spec, whose number is
+/// bounded, should be interned: strings read from documents, such as names
+/// and values, would make the table grow for as long as the program runs.
+class SDFORMAT_VISIBLE InternedString
+{
+  /// \brief Constructor of an empty string.
+  public: InternedString();
+
+  /// \brief Constructor.
+  /// \param[in] _str Value of the string.
+  // cppcheck-suppress noExplicitConstructor
+  public: InternedString(const std::string &_str);
+
+  /// \brief Constructor.
+  /// \param[in] _str Value of the string.
+  // cppcheck-suppress noExplicitConstructor
+  public: InternedString(const char *_str);
+
+  /// \brief Get the value of the string.
+  /// \return The copy of the value in the table.
+  public: const std::string &Str() const
+  {
+    return *this->str;
+  }
+
+  /// \brief Get the value of the string.
+  /// \return The copy of the value in the table.
+  public: operator const std::string &() const
+  {
+    return *this->str;
+  }
+
+  /// \brief Get whether the string is empty.
+  /// \return True if the string is empty.
+  public: bool Empty() const
+  {
+    return this->str->empty();
+  }
+
+  /// \brief Get the number of strings in the table.
+  /// \return The number of strings.
+  public: static std::size_t TableSize();
+
+  /// \brief The copy of the value in the table.
+  private: const std::string *str;
+
+  /// \brief Compare two interned strings by their copies in the table.
+  /// \param[in] _a First string.
+  /// \param[in] _b Second string.
+  /// \return True if the strings are equal.
+  public: friend bool operator==(const InternedString &_a,
+                                 const InternedString &_b)
+  {
+    return _a.str == _b.str;
+  }
+
+  /// \brief Compare two interned strings by their copies in the table.
+  /// \param[in] _a First string.
+  /// \param[in] _b Second string.
+  /// \return True if the strings differ.
+  public: friend bool operator!=(const InternedString &_a,
+                                 const InternedString &_b)
+  {
+    return _a.str != _b.str;
+  }
+};
+
+/// \brief Compare an interned string with a string.
+/// \param[in] _a Interned string.
+/// \param[in] _b String.
+/// \return True if the strings are equal.
+inline bool operator==(const InternedString &_a, const std::string &_b)
+{
+  return _a.Str() == _b;
+}
+
+/// \brief Compare a string with an interned string.
+/// \param[in] _a String.
+/// \param[in] _b Interned string.
+/// \return True if the strings are equal.
+inline bool operator==(const std::string &_a, const InternedString &_b)
+{
+  return _a == _b.Str();
+}
+
+/// \brief Compare an interned string with a string.
+/// \param[in] _a Interned string.
+/// \param[in] _b String.
+/// \return True if the strings are equal.
+inline bool operator==(const InternedString &_a, const char *_b)
+{
+  return _a.Str() == _b;
+}
+
+/// \brief Compare a string with an interned string.
+/// \param[in] _a String.
+/// \param[in] _b Interned string.
+/// \return True if the strings are equal.
+inline bool operator==(const char *_a, const InternedString &_b)
+{
+  return _a == _b.Str();
+}
+
+/// \brief Compare an interned string with a string.
+/// \param[in] _a Interned string.
+/// \param[in] _b String.
+/// \return True if the strings differ.
+inline bool operator!=(const InternedString &_a, const std::string &_b)
+{
+  return _a.Str() != _b;
+}
+
+/// \brief Compare a string with an interned string.
+/// \param[in] _a String.
+/// \param[in] _b Interned string.
+/// \return True if the strings differ.
+inline bool operator!=(const std::string &_a, const InternedString &_b)
+{
+  return _a != _b.Str();
+}
+
+/// \brief Compare an interned string with a string.
+/// \param[in] _a Interned string.
+/// \param[in] _b String.
+/// \return True if the strings differ.
+inline bool operator!=(const InternedString &_a, const char *_b)
+{
+  return _a.Str() != _b;
+}
+
+/// \brief Compare a string with an interned string.
+/// \param[in] _a String.
+/// \param[in] _b Interned string.
+/// \return True if the strings differ.
+inline bool operator!=(const char *_a, const InternedString &_b)
+{
+  return _a != _b.Str();
+}
+
+/// \brief Write an interned string to a stream.
+/// \param[in] _out The stream.
+/// \param[in] _str The string.
+/// \return The stream.
+inline std::ostream &operator<<(std::ostream &_out,
+                                const InternedString &_str)
+{
+  return _out << _str.Str();
+}
+}
+}
+#endif
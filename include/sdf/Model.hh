@@ -17,8 +17,10 @@
 #ifndef SDF_MODEL_HH_
 #define SDF_MODEL_HH_
 
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <ignition/math/Pose3.hh>
@@ -374,6 +376,23 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the poses of every frame of this model, including the
+    /// implicit frames of its links, joints and nested models at every
+    /// nesting level, in one pass over the pose graph. This is faster than
+    /// resolving the SemanticPose of each of them when most are needed.
+    /// The model must have been loaded by sdf::Root, which builds the graph.
+    /// \param[out] _poses Poses of the frames, keyed by their names scoped to
+    /// this model, such as "link", "nested_model::link" or "__model__".
+    /// Frames whose pose cannot be resolved are left out.
+    /// \param[in] _resolveTo Name of the frame relative to which the poses
+    /// are resolved. Empty, the default, resolves them relative to the model
+    /// frame.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors ResolveAllPoses(
+                std::map<std::string, ignition::math::Pose3d> &_poses,
+                const std::string &_resolveTo = "") const;
+
     /// \brief Get the name of the placement frame of the model.
     /// \return Name of the placement frame attribute of the model.
     public: const std::string &PlacementFrameName() const;
@@ -529,9 +548,18 @@ namespace sdf
     private: const std::vector<std::pair<std::optional<sdf::NestedInclude>,
              sdf::InterfaceModelConstPtr>> &MergedInterfaceModels() const;
 
+    /// \brief Get a nested model by its name relative to this model, in
+    /// the same way as ModelByName, but without copying the name. This is
+    /// private and is intended to be called by ModelByName and the other
+    /// lookups of Model and World.
+    /// \param[in] _name Name of the nested model.
+    /// \return Pointer to the model, or nullptr if it was not found.
+    private: const Model *NestedModelByName(std::string_view _name) const;
+
     /// \brief Allow Root::Load, World::SetPoseRelativeToGraph, or
     /// World::SetFrameAttachedToGraph to call SetPoseRelativeToGraph and
-    /// SetFrameAttachedToGraph
+    /// SetFrameAttachedToGraph, and the lookups of World to call
+    /// NestedModelByName
     friend class Root;
     friend class World;
 
@@ -29,13 +29,16 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include <ignition/math.hh>
 
 #include "sdf/Console.hh"
+#include "sdf/InternedString.hh"
 #include "sdf/PrintConfig.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
@@ -70,6 +73,7 @@ namespace sdf
 
   /// \internal
   class ParamPrivate;
+  class PrecompiledSdf;
 
   template<class T>
   struct ParamStreamer
@@ -210,7 +214,9 @@ namespace sdf
     /// parent Element.
     public: ElementPtr GetParentElement() const;
 
-    /// \brief Set the parent Element of this Param.
+    /// \brief Set the parent Element of this Param. The value is only
+    /// reparsed if it depends on the attributes of the parent Element, the
+    /// already parsed value is kept otherwise.
     /// \param[in] _parentElement Pointer to new parent Element. A nullptr can
     /// provided to remove the current parent Element.
     /// \return True if the parent Element was set and the value was reparsed
@@ -277,7 +283,9 @@ namespace sdf
 
     /// \brief Set the parameter's value.
     ///
-    /// The passed in value value must have an input and output stream operator.
+    /// Values of one of the supported parameter types are stored directly,
+    /// converting between numeric types when needed. Any other type must
+    /// have an output stream operator, and is set from its string form.
     /// \param[in] _value The value to set the parameter to.
     /// \return True if the value was successfully set.
     public: template<typename T>
@@ -327,10 +335,19 @@ namespace sdf
 
     /// \brief Private data
     private: std::unique_ptr<ParamPrivate> dataPtr;
+
+    /// \brief Reads and writes the private data of precompiled files.
+    friend class PrecompiledSdf;
   };
 
   /// \internal
   /// \brief Private data for the param class
+  ///
+  /// The inline templates of Param read the members of this class, so
+  /// binaries built against 12.4 depend on its layout. Members that were
+  /// added after 12.4 come after the others, and are trivially destructible,
+  /// since those binaries destroy ParamPrivate in the inline move assignment
+  /// of Param.
   class ParamPrivate
   {
     /// \brief Key value
@@ -345,7 +362,8 @@ namespace sdf
     //// \brief Name of the type.
     public: std::string typeName;
 
-    /// \brief Description of the parameter.
+    /// \brief Description of the parameter. It is not set, see
+    /// internedDescription.
     public: std::string description;
 
     /// \brief Parent element.
@@ -356,8 +374,10 @@ namespace sdf
 
     /// \def ParamVariant
     /// \brief Variant type def.
-    /// Note: When a new variant is added, add variant to functions
-    /// ParamPrivate::TypeToString and ParamPrivate::ValueFromStringImpl
+    /// Note: When a new variant is added, add variant to the ValueType enum
+    /// and to functions ParamPrivate::TypeToString,
+    /// ParamPrivate::TypeToValueType, ParamPrivate::ValueTypeFromName and
+    /// ParamPrivate::ValueFromStringImpl
     public: typedef std::variant<bool, char, std::string, int, std::uint64_t,
                                    unsigned int, double, float, sdf::Time,
                                    ignition::math::Angle,
@@ -368,6 +388,31 @@ namespace sdf
                                    ignition::math::Quaterniond,
                                    ignition::math::Pose3d> ParamVariant;
 
+    /// \brief Value types of a parameter. The enumerators are listed in the
+    /// same order as the alternatives of ParamVariant.
+    public: enum class ValueType
+    {
+      BOOL,
+      CHAR,
+      STRING,
+      INT,
+      UINT64,
+      UNSIGNED_INT,
+      DOUBLE,
+      FLOAT,
+      TIME,
+      ANGLE,
+      COLOR,
+      VECTOR2I,
+      VECTOR2D,
+      VECTOR3D,
+      QUATERNIOND,
+      POSE3D,
+
+      /// \brief The type name is not recognized.
+      UNKNOWN
+    };
+
     /// \brief This parameter's value
     public: ParamVariant value;
 
@@ -391,6 +436,20 @@ namespace sdf
     /// \brief This parameter's maximum allowed value
     public: std::optional<ParamVariant> maxValue;
 
+    /// \brief Description of the parameter. Descriptions come from the spec,
+    /// so the parameters of one description share a single copy.
+    public: InternedString internedDescription;
+
+    /// \brief Get the value type of this parameter. The default value is
+    /// parsed from typeName when the parameter is constructed, and the
+    /// alternatives of ParamVariant are in the order of ValueType, so the
+    /// type is resolved once into the index of the default value.
+    /// \return The value type.
+    public: ValueType GetValueType() const
+    {
+      return static_cast<ValueType>(this->defaultValue.index());
+    }
+
     /// \brief Method used to set the Param from a passed-in string
     /// \param[in] _typeName The data type of the value to set
     /// \param[in] _valueStr The value as a string
@@ -401,6 +460,16 @@ namespace sdf
                                     const std::string &_valueStr,
                                     ParamVariant &_valueToSet) const;
 
+    /// \brief Method used to set the Param from a passed-in string
+    /// \param[in] _valueType The data type of the value to set
+    /// \param[in] _valueStr The value as a string
+    /// \param[out] _valueToSet The value to set
+    /// \return True if the value was successfully set, false otherwise
+    public: bool SDFORMAT_VISIBLE ValueFromStringImpl(
+                                    ValueType _valueType,
+                                    const std::string &_valueStr,
+                                    ParamVariant &_valueToSet) const;
+
     /// \brief Method used to get the string representation from a ParamVariant,
     /// or the string that was used to set it.
     /// \param[in] _config Print configuration for the string output
@@ -430,12 +499,108 @@ namespace sdf
                 const std::optional<std::string> &_originalStr,
                 std::string &_valueStr) const;
 
+    /// \brief Method used to get the string representation from a ParamVariant,
+    /// or the string that was used to set it.
+    /// \param[in] _config Print configuration for the string output
+    /// \param[in] _valueType The data type of the value
+    /// \param[in] _value The value
+    /// \param[in] _orignalStr The original string that was used to set the
+    /// value. A nullopt can be passed in if it is not available.
+    /// \param[out] _valueStr The output string.
+    /// \return True if the string was successfully retrieved, false otherwise.
+    public: bool StringFromValueImpl(
+                const PrintConfig &_config,
+                ValueType _valueType,
+                const ParamVariant &_value,
+                const std::optional<std::string> &_originalStr,
+                std::string &_valueStr) const;
+
+    /// \brief Resolve a type name, including its aliases such as
+    /// "ignition::math::Vector3d" for "vector3", to a value type.
+    /// \param[in] _typeName Name of the type.
+    /// \return The value type, or ValueType::UNKNOWN if the name is not
+    /// recognized.
+    public: static ValueType SDFORMAT_VISIBLE ValueTypeFromName(
+                const std::string &_typeName);
+
+    /// \brief Convert between the numeric types bool, int, unsigned int,
+    /// uint64_t, double and float without going through a string. Floating
+    /// point values are truncated toward zero when converted to integers,
+    /// and only 0 and 1 convert to bool.
+    /// \param[in] _value The value to convert.
+    /// \param[in] _valueType The type to convert to.
+    /// \param[out] _converted Set to the converted value on success.
+    /// \return True if both types are numeric and the value is representable
+    /// by the target type, false otherwise.
+    public: static bool SDFORMAT_VISIBLE ConvertNumeric(
+                const ParamVariant &_value,
+                ValueType _valueType,
+                ParamVariant &_converted);
+
+    /// \brief Check whether the parsed value depends on the attributes of
+    /// the parent element. This is the case for poses that are not ignoring
+    /// parent attributes, since their rotation is parsed according to the
+    /// @degrees and @rotation_format attributes of the parent element.
+    /// \return True if the value needs to be reparsed when the parent element
+    /// changes, false otherwise.
+    public: bool DependsOnParentAttributes() const;
+
+    /// \brief Tell the parent of the parent element that the names of its
+    /// child elements may have changed, if this is a name attribute. Called
+    /// after the value changed.
+    public: void ValueChanged() const;
+
     /// \brief Data type to string mapping
     /// \return The type as a string, empty string if unknown type
     public: template<typename T>
             std::string TypeToString() const;
+
+    /// \brief Data type to value type mapping
+    /// \return The value type, ValueType::UNKNOWN if unknown type
+    public: template<typename T>
+            static constexpr ValueType TypeToValueType();
   };
 
+  ///////////////////////////////////////////////
+  template<typename T>
+  constexpr ParamPrivate::ValueType ParamPrivate::TypeToValueType()
+  {
+    if constexpr (std::is_same_v<T, bool>)
+      return ValueType::BOOL;
+    else if constexpr (std::is_same_v<T, char>)
+      return ValueType::CHAR;
+    else if constexpr (std::is_same_v<T, std::string>)
+      return ValueType::STRING;
+    else if constexpr (std::is_same_v<T, int>)
+      return ValueType::INT;
+    else if constexpr (std::is_same_v<T, std::uint64_t>)
+      return ValueType::UINT64;
+    else if constexpr (std::is_same_v<T, unsigned int>)
+      return ValueType::UNSIGNED_INT;
+    else if constexpr (std::is_same_v<T, double>)
+      return ValueType::DOUBLE;
+    else if constexpr (std::is_same_v<T, float>)
+      return ValueType::FLOAT;
+    else if constexpr (std::is_same_v<T, sdf::Time>)
+      return ValueType::TIME;
+    else if constexpr (std::is_same_v<T, ignition::math::Angle>)
+      return ValueType::ANGLE;
+    else if constexpr (std::is_same_v<T, ignition::math::Color>)
+      return ValueType::COLOR;
+    else if constexpr (std::is_same_v<T, ignition::math::Vector2i>)
+      return ValueType::VECTOR2I;
+    else if constexpr (std::is_same_v<T, ignition::math::Vector2d>)
+      return ValueType::VECTOR2D;
+    else if constexpr (std::is_same_v<T, ignition::math::Vector3d>)
+      return ValueType::VECTOR3D;
+    else if constexpr (std::is_same_v<T, ignition::math::Quaterniond>)
+      return ValueType::QUATERNIOND;
+    else if constexpr (std::is_same_v<T, ignition::math::Pose3d>)
+      return ValueType::POSE3D;
+    else
+      return ValueType::UNKNOWN;
+  }
+
   ///////////////////////////////////////////////
   template<typename T>
   std::string ParamPrivate::TypeToString() const
@@ -488,6 +653,46 @@ namespace sdf
   template<typename T>
   bool Param::Set(const T &_value)
   {
+    constexpr ParamPrivate::ValueType valueType =
+        ParamPrivate::TypeToValueType<T>();
+
+    if constexpr (std::is_convertible_v<const T &, std::string>)
+    {
+      return this->SetFromString(_value, true);
+    }
+    else if constexpr (valueType != ParamPrivate::ValueType::UNKNOWN)
+    {
+      // Store the typed value directly, without a string round trip. The
+      // string form is only produced when it is asked for.
+      ParamPrivate::ParamVariant newValue;
+      bool converted = true;
+      if (valueType == this->dataPtr->GetValueType())
+      {
+        newValue.template emplace<T>(_value);
+      }
+      else
+      {
+        converted = ParamPrivate::ConvertNumeric(
+            ParamPrivate::ParamVariant(std::in_place_type<T>, _value),
+            this->dataPtr->GetValueType(), newValue);
+      }
+
+      if (converted)
+      {
+        this->dataPtr->ignoreParentAttributes = true;
+        std::swap(this->dataPtr->value, newValue);
+        if (!this->ValidateValue())
+        {
+          std::swap(this->dataPtr->value, newValue);
+          return false;
+        }
+        this->dataPtr->strValue = std::nullopt;
+        this->dataPtr->set = true;
+        return true;
+      }
+    }
+
+    // Other types and conversions are set from the value's string form.
     try
     {
       std::stringstream ss;
@@ -515,22 +720,31 @@ namespace sdf
     }
     else
     {
-      std::string typeStr = this->dataPtr->TypeToString<T>();
-      if (typeStr.empty())
+      constexpr ParamPrivate::ValueType valueType =
+          ParamPrivate::TypeToValueType<T>();
+      if (valueType == ParamPrivate::ValueType::UNKNOWN)
       {
         sdferr << "Unknown parameter type[" << typeid(T).name() << "]\n";
         return false;
       }
 
-      std::string valueStr = this->GetAsString();
       ParamPrivate::ParamVariant pv;
-      bool success = this->dataPtr->ValueFromStringImpl(typeStr, valueStr, pv);
+      if (ParamPrivate::ConvertNumeric(this->dataPtr->value, valueType, pv))
+      {
+        _value = std::get<T>(pv);
+        return true;
+      }
+
+      std::string valueStr = this->GetAsString();
+      bool success =
+          this->dataPtr->ValueFromStringImpl(valueType, valueStr, pv);
 
       if (success)
       {
         _value = std::get<T>(pv);
       }
-      else if (typeStr == "bool" && this->dataPtr->typeName == "string")
+      else if (valueType == ParamPrivate::ValueType::BOOL &&
+               this->dataPtr->GetValueType() == ParamPrivate::ValueType::STRING)
       {
         // this section for handling bool types is to keep backward behavior
         // TODO(anyone) remove for Fortress. For more details:
@@ -557,6 +771,25 @@ namespace sdf
   template<typename T>
   bool Param::GetDefault(T &_value) const
   {
+    constexpr ParamPrivate::ValueType valueType =
+        ParamPrivate::TypeToValueType<T>();
+    if constexpr (valueType != ParamPrivate::ValueType::UNKNOWN)
+    {
+      if (const T *value = std::get_if<T>(&this->dataPtr->defaultValue))
+      {
+        _value = *value;
+        return true;
+      }
+
+      ParamPrivate::ParamVariant pv;
+      if (ParamPrivate::ConvertNumeric(
+              this->dataPtr->defaultValue, valueType, pv))
+      {
+        _value = std::get<T>(pv);
+        return true;
+      }
+    }
+
     std::stringstream ss;
 
     try
@@ -20,6 +20,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,24 @@ enum class EnforcementPolicy
 // Forward declare private data class.
 class ParserConfigPrivate;
 
+// Forward declare the include cache, see sdf/IncludeCache.hh.
+class IncludeCache;
+
+/// \brief Shared pointer to an IncludeCache.
+typedef std::shared_ptr<IncludeCache> IncludeCachePtr;
+
+// Forward declare the file lookup cache, see sdf/FileLookupCache.hh.
+class FileLookupCache;
+
+/// \brief Shared pointer to a FileLookupCache.
+typedef std::shared_ptr<FileLookupCache> FileLookupCachePtr;
+
+// Forward declare the conversion cache, see sdf/ConversionCache.hh.
+class ConversionCache;
+
+/// \brief Shared pointer to a ConversionCache.
+typedef std::shared_ptr<ConversionCache> ConversionCachePtr;
+
 /// This class contains configuration options for the libsdformat parser.
 ///
 /// The configuration options include:
@@ -92,7 +111,11 @@ class SDFORMAT_VISIBLE ParserConfig
 
   /// Mutable access to a singleton ParserConfig that serves as the global
   /// ParserConfig object for all parsing operations that do not specify their
-  /// own ParserConfig.
+  /// own ParserConfig. Those operations parse with a copy of this object, and
+  /// sdf::setFindCallback() and sdf::addURIPath() update it under a lock, so
+  /// they may all be called from multiple threads. Modifying the returned
+  /// reference directly is not synchronized and must not happen while other
+  /// threads are parsing.
   /// \return A mutable reference to the singleton ParserConfig object
   public: static ParserConfig &GlobalConfig();
 
@@ -174,6 +197,115 @@ class SDFORMAT_VISIBLE ParserConfig
   /// \brief Get the preserveFixedJoint flag value.
   public: bool URDFPreserveFixedJoint() const;
 
+  /// \brief Set whether the line number and XML path of each element are
+  /// recorded when reading a document, for sdf::Element::LineNumber and
+  /// sdf::Element::XmlPath. Turning it off saves time and memory when
+  /// loading large documents. Errors found while reading still have line
+  /// numbers, but their XML paths are then incomplete. The file path of each
+  /// element is always recorded, since relative URIs are resolved against
+  /// it.
+  /// \param[in] _track True to record source locations, which is the
+  /// default.
+  public: void SetTrackSourceLocations(bool _track);
+
+  /// \brief Get whether the line number and XML path of each element are
+  /// recorded when reading a document.
+  /// \return True if source locations are recorded.
+  /// \sa SetTrackSourceLocations
+  public: bool TrackSourceLocations() const;
+
+  /// \brief Set the number of threads used to read the files referenced by
+  /// sibling <include> elements. With more than one thread, the included
+  /// files are read, parsed and converted concurrently, and then inserted
+  /// in document order, so the resulting elements and errors are the same as
+  /// when reading them one after another. The find file callback and custom
+  /// model parsers may then be called from several threads at once. The
+  /// includes nested in the included files are read by the same threads.
+  /// Sibling includes separated by other elements are read a run at a time,
+  /// and the includes after one whose file cannot be read are skipped once
+  /// that is found, so that reading stops where it would when reading one
+  /// after another.
+  /// \param[in] _threadCount Number of threads. 1, the default, reads
+  /// includes one after another. 0 uses one thread per hardware thread.
+  public: void SetIncludeThreadCount(unsigned int _threadCount);
+
+  /// \brief Get the number of threads used to read included files.
+  /// \return The number of threads, or 0 for one per hardware thread.
+  /// \sa SetIncludeThreadCount
+  public: unsigned int IncludeThreadCount() const;
+
+  /// \brief Set the number of threads used to load the DOM objects of a
+  /// document, such as sdf::World and sdf::Model, from its elements. With
+  /// more than one thread, the worlds of a sdf::Root, the models of a world,
+  /// and the nested models and links of a model are loaded concurrently,
+  /// with idle threads taking over the loads of nested models that are left.
+  /// The resulting objects and errors are the same, and in the same order,
+  /// as when loading them one after another, but the warnings printed to
+  /// the console may be interleaved. Custom model parsers may then be called
+  /// from several threads at once.
+  /// \param[in] _threadCount Number of threads. 1, the default, loads the
+  /// objects one after another. 0 uses one thread per hardware thread.
+  public: void SetLoadThreadCount(unsigned int _threadCount);
+
+  /// \brief Get the number of threads used to load DOM objects.
+  /// \return The number of threads, or 0 for one per hardware thread.
+  /// \sa SetLoadThreadCount
+  public: unsigned int LoadThreadCount() const;
+
+  /// \brief Set the cache of included files. Copies of this ParserConfig
+  /// share the cache, so it is kept across successive loads that use them.
+  /// \param[in] _cache The cache, or nullptr to read every included file
+  /// from disk, which is the default.
+  /// \sa IncludeCache
+  public: void SetIncludeCache(IncludeCachePtr _cache);
+
+  /// \brief Get the cache of included files.
+  /// \return The cache, or nullptr if there is none.
+  public: const IncludeCachePtr &IncludeCache() const;
+
+  /// \brief Set the cache of file lookups, which is used by sdf::findFile
+  /// and when resolving the URI of an <include>. Copies of this ParserConfig
+  /// share the cache.
+  /// \param[in] _cache The cache, or nullptr to query the file system for
+  /// every lookup, which is the default.
+  /// \sa FileLookupCache
+  public: void SetFileLookupCache(FileLookupCachePtr _cache);
+
+  /// \brief Get the cache of file lookups.
+  /// \return The cache, or nullptr if there is none.
+  public: const FileLookupCachePtr &FileLookupCache() const;
+
+  /// \brief Set the cache of converted files. Files that are converted to
+  /// the latest SDFormat version when they are read are stored in it, and
+  /// later reads of the same files load them from it. Copies of this
+  /// ParserConfig share the cache.
+  /// \param[in] _cache The cache, or nullptr to convert files every time
+  /// they are read, which is the default.
+  /// \sa ConversionCache
+  public: void SetConversionCache(ConversionCachePtr _cache);
+
+  /// \brief Get the cache of converted files.
+  /// \return The cache, or nullptr if there is none.
+  public: const ConversionCachePtr &ConversionCache() const;
+
+  /// \brief Set whether readFile loads the precompiled file that
+  /// sdf::precompileFile stored next to a file, or next to a file that it
+  /// includes, instead of reading the file. The precompiled file is only
+  /// loaded while the files it was read from are unchanged.
+  /// \param[in] _use True to load precompiled files. False, the default,
+  /// reads every file and ignores any precompiled file next to it.
+  /// \sa sdf::precompileFile
+  public: void SetUsePrecompiledFiles(bool _use);
+
+  /// \brief Get whether readFile loads precompiled files.
+  /// \return True if precompiled files are loaded.
+  /// \sa SetUsePrecompiledFiles
+  public: bool UsePrecompiledFiles() const;
+
+  /// \brief Compares the revisions of the global config and of its
+  /// snapshot, which are kept in the private data.
+  private: friend std::shared_ptr<const ParserConfig> globalParserConfig();
+
   /// \brief Private data pointer.
   IGN_UTILS_IMPL_PTR(dataPtr)
 };
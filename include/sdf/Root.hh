@@ -17,6 +17,7 @@
 #ifndef SDF_ROOT_HH_
 #define SDF_ROOT_HH_
 
+#include <cstddef>
 #include <string>
 #include <ignition/utils/ImplPtr.hh>
 
@@ -90,6 +91,28 @@ namespace sdf
     public: Errors LoadSdfString(
                 const std::string &_sdf, const ParserConfig &_config);
 
+    /// \brief Parse an SDF string held in a buffer, and generate objects
+    /// based on types specified in the SDF string. The string is read in
+    /// place, without copying it.
+    /// \param[in] _data SDF string to parse. It need not be null
+    /// terminated.
+    /// \param[in] _size Length of the string.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors LoadSdfString(const char *_data, std::size_t _size);
+
+    /// \brief Parse an SDF string held in a buffer, and generate objects
+    /// based on types specified in the SDF string. The string is read in
+    /// place, without copying it.
+    /// \param[in] _data SDF string to parse. It need not be null
+    /// terminated.
+    /// \param[in] _size Length of the string.
+    /// \param[in] _config Custom parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors LoadSdfString(const char *_data, std::size_t _size,
+                const ParserConfig &_config);
+
     /// \brief Parse the given SDF pointer, and generate objects based on types
     /// specified in the SDF file.
     /// \param[in] _sdf SDF pointer to parse.
@@ -17,9 +17,12 @@
 #ifndef SDF_WORLD_HH_
 #define SDF_WORLD_HH_
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <ignition/math/Pose3.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/utils/ImplPtr.hh>
@@ -82,6 +85,23 @@ namespace sdf
     /// an error code and message. An empty vector indicates no error.
     public: Errors ValidateGraphs() const;
 
+    /// \brief Resolve the poses of every frame of this world, including the
+    /// implicit frames of models, links and joints at every nesting level,
+    /// in one pass over the pose graph. This is faster than resolving the
+    /// SemanticPose of each of them when most are needed. The world must
+    /// have been loaded by sdf::Root, which builds the graph.
+    /// \param[out] _poses Poses of the frames, keyed by their names scoped to
+    /// the world, such as "model", "model::link" or "world". Frames whose
+    /// pose cannot be resolved are left out.
+    /// \param[in] _resolveTo Name of the frame relative to which the poses
+    /// are resolved. Empty, the default, resolves them relative to the world
+    /// frame.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors ResolveAllPoses(
+                std::map<std::string, ignition::math::Pose3d> &_poses,
+                const std::string &_resolveTo = "") const;
+
     /// \brief Get the name of the world.
     /// \return Name of the world.
     public: std::string Name() const;
@@ -469,6 +489,12 @@ namespace sdf
     private: void SetFrameAttachedToGraph(
         sdf::ScopedGraph<FrameAttachedToGraph> _graph);
 
+    /// \brief Get a model by its name relative to this world, in the same
+    /// way as ModelByName, but without copying the name.
+    /// \param[in] _name Name of the model.
+    /// \return Pointer to the model, or nullptr if it was not found.
+    private: const Model *NestedModelByName(std::string_view _name) const;
+
     /// \brief Allow Root::Load to call SetPoseRelativeToGraph and
     /// SetFrameAttachedToGraph
     friend class Root;
@@ -17,6 +17,7 @@
 #ifndef SDF_PARSER_HH_
 #define SDF_PARSER_HH_
 
+#include <cstddef>
 #include <string>
 
 #include "sdf/SDFImpl.hh"
@@ -192,6 +193,30 @@ namespace sdf
   bool readFileWithoutConversion(const std::string &_filename,
       const ParserConfig &_config, SDFPtr _sdf, Errors &_errors);
 
+  /// \brief Read a file and store the result in a precompiled file next to
+  /// it. With a ParserConfig that enables
+  /// ParserConfig::SetUsePrecompiledFiles, readFile loads the precompiled
+  /// file instead of reading the file for as long as none of the files that
+  /// were read changed.
+  ///
+  /// The precompiled file holds the elements, with the parsed values of
+  /// their parameters, and the errors that readFile finds. Its name is the
+  /// name of the file with the ".sdf" extension replaced by ".sdfb", or with
+  /// ".sdfb" appended. It is only loaded with a ParserConfig that has the
+  /// same policies and URI paths, with the same SDF_PATH and current
+  /// directory, and by the same version of the library. The results of a
+  /// find file callback cannot be checked, so files are neither precompiled
+  /// nor loaded from precompiled files with a ParserConfig that has one.
+  /// \param[in] _filename Name of the SDF file
+  /// \param[in] _config Custom parser configuration
+  /// \param[out] _errors Errors found when reading the file or writing the
+  /// precompiled file will be appended to this variable.
+  /// \return True if the file was read and the precompiled file was
+  /// written.
+  SDFORMAT_VISIBLE
+  bool precompileFile(const std::string &_filename,
+      const ParserConfig &_config, Errors &_errors);
+
   /// \brief Populate the SDF values from a file
   ///
   /// This populates the given SDF pointer from a file. If the file is a URDF
@@ -229,6 +254,23 @@ namespace sdf
   bool readString(const std::string &_xmlString, const ParserConfig &_config,
       SDFPtr _sdf, Errors &_errors);
 
+  /// \brief Populate the SDF values from a string held in a buffer
+  ///
+  /// This is the same as readString, but reads the string in place, so that
+  /// callers that generate SDFormat in memory need not copy it into a
+  /// std::string. The string may contain a URDF model, and all strings are
+  /// converted to the latest SDF version.
+  /// \param[in] _data XML string to be parsed. It need not be null
+  /// terminated.
+  /// \param[in] _size Length of the string.
+  /// \param[in] _config Custom parser configuration
+  /// \param[out] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readString(const char *_data, std::size_t _size,
+      const ParserConfig &_config, SDFPtr _sdf, Errors &_errors);
+
   /// \brief Populate the SDF values from a string
   ///
   /// This populates the SDF pointer from a string. If the string is a URDF
@@ -315,6 +357,17 @@ namespace sdf
   SDFORMAT_VISIBLE
   std::string getModelFilePath(const std::string &_modelDirPath);
 
+  /// \brief Get the file path to the model file
+  /// \param[in] _modelDirPath directory system path of the model
+  /// \param[in] _config Custom parser configuration. Its FileLookupCache()
+  /// is used, if it has one.
+  /// \return string with the full filesystem path to the best version (greater
+  ///         SDF protocol supported by this sdformat version) of the .sdf
+  ///         model files hosted by _modelDirPath.
+  SDFORMAT_VISIBLE
+  std::string getModelFilePath(const std::string &_modelDirPath,
+                               const ParserConfig &_config);
+
   /// \brief Convert an SDF file to a specific SDF version.
   /// \param[in] _filename Name of the SDF file to convert.
   /// \param[in] _version Version to convert _filename to.
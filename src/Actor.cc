@@ -21,6 +21,7 @@
 #include "sdf/Error.hh"
 #include "sdf/parser.hh"
 #include "sdf/Plugin.hh"
+#include "NameIndex.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -476,6 +477,7 @@ const std::string &Actor::Name() const
 void Actor::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
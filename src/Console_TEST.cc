@@ -15,7 +15,10 @@
  *
  */
 
+#include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -94,6 +97,43 @@ TEST(Console, logdir_doesnt_exist)
   sdferr << "Error.\n";
 }
 
+////////////////////////////////////////////////////
+/// Messages that are logged from several threads at once all reach the log
+/// file.
+TEST(Console, ConcurrentLog)
+{
+  sdf::Console::Clear();
+
+  std::string temp_dir;
+  ASSERT_TRUE(create_new_temp_dir(temp_dir));
+  ASSERT_EQ(setenv("HOME", temp_dir.c_str(), 1), 0);
+
+  const int threadCount = 8;
+  const int messageCount = 2000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([]
+    {
+      for (int j = 0; j < messageCount; ++j)
+        sdfdbg << "Concurrent " << j << " message.\n";
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  sdf::Console::Clear();
+
+  std::ifstream log(temp_dir + "/.sdformat/sdformat.log");
+  std::string line;
+  int count = 0;
+  while (std::getline(log, line))
+  {
+    if (line.find("message.") != std::string::npos)
+      ++count;
+  }
+  EXPECT_EQ(threadCount * messageCount, count);
+}
+
 #endif  // _WIN32
 
 ////////////////////////////////////////////////////
@@ -0,0 +1,326 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _WIN32
+#include <utime.h>
+#else
+#include <sys/utime.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "sdf/ConversionCache.hh"
+#include "sdf/Filesystem.hh"
+
+#include "PrecompiledSdf.hh"
+#include "Utils.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief Extension of the entry files.
+constexpr std::string_view kEntryExtension = ".sdfb";
+
+/////////////////////////////////////////////////
+/// \brief Set the modification time of a file to the current time.
+/// \param[in] _path Path of the file.
+void touchFile(const std::string &_path)
+{
+#ifndef _WIN32
+  ::utime(_path.c_str(), nullptr);
+#else
+  ::_utime(_path.c_str(), nullptr);
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a path is the path of an entry file.
+/// \param[in] _path The path.
+/// \return True if the path has the extension of entry files.
+bool isEntryFile(const std::string &_path)
+{
+  return _path.size() > kEntryExtension.size() &&
+      _path.compare(_path.size() - kEntryExtension.size(),
+                    kEntryExtension.size(), kEntryExtension) == 0;
+}
+}
+
+/// \brief Private data for ConversionCache.
+class sdf::ConversionCache::Implementation
+{
+  /// \brief Get the path of the entry of a file.
+  /// \param[in] _filename Resolved name of the file.
+  /// \param[in] _digest SHA-256 digest of the contents of the file.
+  /// \param[in] _configKey Key of the configuration the file is read with.
+  /// \return Path of the entry file.
+  public: std::string EntryPath(const std::string &_filename,
+                                const std::string &_digest,
+                                const std::string &_configKey) const
+  {
+    // Entries of the same file read with different settings are kept
+    // apart, so that they do not replace each other.
+    const std::string name =
+        sha256(_filename + '\n' + _configKey) + '-' +
+        _digest + std::string(kEntryExtension);
+    return sdf::filesystem::append(this->directory, name);
+  }
+
+  /// \brief Get the source an entry is written with, which Find checks
+  /// before loading the entry, so that a hit never depends on the name of
+  /// the entry alone.
+  /// \param[in] _filename Resolved name of the file.
+  /// \param[in] _contents Contents of the file.
+  /// \param[in] _digest SHA-256 digest of the contents.
+  /// \return The source.
+  public: static std::string Source(const std::string &_filename,
+                                    std::string_view _contents,
+                                    const std::string &_digest)
+  {
+    return _filename + '\n' + std::to_string(_contents.size()) + '\n' +
+        _digest;
+  }
+
+  /// \brief Remove the entries that were used least recently until the
+  /// total size is within the limit.
+  /// \param[in] _added Size of an entry that was just written.
+  /// \param[in] _replaced Size of the entry it replaced, or 0.
+  /// \param[in] _directoryBefore Stamp of the directory before the entry
+  /// was written.
+  public: void Trim(std::uintmax_t _added, std::uintmax_t _replaced,
+                    const FileStamp &_directoryBefore)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // The size is only updated in place while no other process or thread
+    // changed the directory since it was last listed. Writing or removing
+    // an entry changes the modification time of the directory, while using
+    // an entry does not.
+    if (this->size.has_value() && _directoryBefore == this->directoryStamp)
+    {
+      const std::uintmax_t size =
+          *this->size - std::min(*this->size, _replaced) + _added;
+      if (size <= this->maxSize)
+      {
+        this->size = size;
+        this->directoryStamp = fileStamp(this->directory);
+        return;
+      }
+    }
+
+    // The directory is listed when the size is not known yet, goes over
+    // the limit or may have been changed by others.
+    std::vector<std::tuple<FileStamp, std::string>> entries;
+    std::uintmax_t total = 0;
+    for (sdf::filesystem::DirIter it(this->directory);
+         it != sdf::filesystem::DirIter(); ++it)
+    {
+      const std::string path = *it;
+      if (!isEntryFile(path))
+        continue;
+      const FileStamp stamp = fileStamp(path);
+      if (stamp.mtime < 0)
+        continue;
+      total += static_cast<std::uintmax_t>(stamp.size);
+      entries.emplace_back(stamp, path);
+    }
+
+    std::sort(entries.begin(), entries.end(),
+        [](const auto &_a, const auto &_b)
+    {
+      const FileStamp &a = std::get<0>(_a);
+      const FileStamp &b = std::get<0>(_b);
+      return std::tie(a.mtime, a.mtimeNsec) < std::tie(b.mtime, b.mtimeNsec);
+    });
+    for (const auto &[stamp, path] : entries)
+    {
+      if (total <= this->maxSize)
+        break;
+      if (std::remove(path.c_str()) == 0)
+        total -= static_cast<std::uintmax_t>(stamp.size);
+    }
+    this->size = total;
+    this->directoryStamp = fileStamp(this->directory);
+  }
+
+  /// \brief Directory the entries are stored in.
+  public: std::string directory;
+
+  /// \brief Limit of the total size of the entries, in bytes.
+  public: std::uintmax_t maxSize = 0;
+
+  /// \brief Protects size and directoryStamp.
+  public: std::mutex mutex;
+
+  /// \brief Total size of the entries, as far as this process knows, or
+  /// nullopt before the directory is first listed.
+  public: std::optional<std::uintmax_t> size;
+
+  /// \brief Stamp of the directory when size was last updated.
+  public: FileStamp directoryStamp;
+
+  /// \brief Number of cache hits.
+  public: mutable std::atomic<std::size_t> hits{0};
+
+  /// \brief Number of cache misses.
+  public: mutable std::atomic<std::size_t> misses{0};
+};
+
+/////////////////////////////////////////////////
+ConversionCache::ConversionCache(const std::string &_directory,
+    std::uintmax_t _maxSize)
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->directory = _directory;
+  this->dataPtr->maxSize = _maxSize;
+  if (!sdf::filesystem::is_directory(_directory))
+    sdf::filesystem::create_directory(_directory);
+}
+
+/////////////////////////////////////////////////
+const std::string &ConversionCache::Directory() const
+{
+  return this->dataPtr->directory;
+}
+
+/////////////////////////////////////////////////
+std::uintmax_t ConversionCache::MaxSize() const
+{
+  return this->dataPtr->maxSize;
+}
+
+/////////////////////////////////////////////////
+bool ConversionCache::Find(const std::string &_filename,
+    std::string_view _contents, const ParserConfig &_config, SDFPtr _sdf,
+    Errors &_errors, StampedFiles &_files) const
+{
+  const std::optional<std::string> configKey = parserConfigKey(_config);
+  if (!configKey)
+    return false;
+
+  const std::string digest = sha256(_contents);
+  const std::string path =
+      this->dataPtr->EntryPath(_filename, digest, *configKey);
+  if (!PrecompiledSdf::Read(path, true, _config, _sdf, _errors, _files,
+                            Implementation::Source(_filename, _contents,
+                                                   digest)))
+  {
+    ++this->dataPtr->misses;
+    return false;
+  }
+
+  // The modification time of an entry is the time it was last used.
+  touchFile(path);
+  ++this->dataPtr->hits;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ConversionCache::Insert(const std::string &_filename,
+    std::string_view _contents, const ParserConfig &_config,
+    const SDFPtr _sdf, const Errors &_errors,
+    const StampedFiles &_files)
+{
+  const std::optional<std::string> configKey = parserConfigKey(_config);
+  if (!_sdf || !_sdf->Root() || !configKey)
+    return false;
+
+  // The file itself is not stamped, since the entry is keyed by its
+  // contents.
+  const std::string digest = sha256(_contents);
+  const std::string path =
+      this->dataPtr->EntryPath(_filename, digest, *configKey);
+  StampedFiles files;
+  for (const auto &file : _files)
+  {
+    if (file.first != _filename)
+      files.push_back(file);
+  }
+
+  // The size of an entry that is overwritten is no longer part of the
+  // total.
+  auto entrySize = [&path]() -> std::uintmax_t
+  {
+    const FileStamp stamp = fileStamp(path);
+    return stamp.mtime < 0 ? 0 : static_cast<std::uintmax_t>(stamp.size);
+  };
+  const std::uintmax_t replaced = entrySize();
+  const FileStamp directoryBefore = fileStamp(this->dataPtr->directory);
+
+  // Errors writing the entry are not errors of the file that was read.
+  Errors writeErrors;
+  if (!PrecompiledSdf::Write(path, _sdf, _errors, files, true, _config,
+                             writeErrors,
+                             Implementation::Source(_filename, _contents,
+                                                    digest)))
+  {
+    return false;
+  }
+
+  this->dataPtr->Trim(entrySize(), replaced, directoryBefore);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ConversionCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (sdf::filesystem::DirIter it(this->dataPtr->directory);
+       it != sdf::filesystem::DirIter(); ++it)
+  {
+    const std::string path = *it;
+    if (isEntryFile(path))
+      std::remove(path.c_str());
+  }
+  this->dataPtr->size = 0;
+  this->dataPtr->directoryStamp = fileStamp(this->dataPtr->directory);
+}
+
+/////////////////////////////////////////////////
+std::uintmax_t ConversionCache::Size() const
+{
+  std::uintmax_t total = 0;
+  for (sdf::filesystem::DirIter it(this->dataPtr->directory);
+       it != sdf::filesystem::DirIter(); ++it)
+  {
+    const std::string path = *it;
+    const FileStamp stamp = fileStamp(path);
+    if (isEntryFile(path) && stamp.mtime >= 0)
+      total += static_cast<std::uintmax_t>(stamp.size);
+  }
+  return total;
+}
+
+/////////////////////////////////////////////////
+std::size_t ConversionCache::HitCount() const
+{
+  return this->dataPtr->hits;
+}
+
+/////////////////////////////////////////////////
+std::size_t ConversionCache::MissCount() const
+{
+  return this->dataPtr->misses;
+}
@@ -16,7 +16,10 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -32,6 +35,66 @@
 #include "EmbeddedSdf.hh"
 #include "XmlUtils.hh"
 
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+/// \brief The recipes of a conversion, grouped into the traversals of the
+/// document that apply them.
+struct ConvertPlan
+{
+  /// \brief A part of a recipe.
+  struct Stage
+  {
+    /// \brief Kinds of parts.
+    enum class Kind
+    {
+      /// \brief The deprecated values of the recipe.
+      DEPRECATIONS,
+
+      /// \brief A nested rule of the recipe.
+      CHILD,
+
+      /// \brief The operations of the recipe.
+      OPERATIONS
+    };
+
+    /// \brief Kind of part.
+    Kind kind;
+
+    /// \brief The recipe.
+    const ConvertRule *recipe;
+
+    /// \brief Index of the nested rule, for CHILD parts.
+    std::size_t child;
+  };
+
+  /// \brief A traversal of the document.
+  struct Group
+  {
+    /// \brief True to apply the rules of all parts in one traversal, false
+    /// to apply the parts one after the other.
+    bool fused = false;
+
+    /// \brief The parts, when not fused.
+    std::vector<Stage> stages;
+
+    /// \brief The parts of each recipe as a rule applied to the root
+    /// element, with the position of the recipe, when fused.
+    std::vector<std::pair<ConvertRule, std::size_t>> roots;
+  };
+
+  /// \brief The traversals.
+  std::vector<Group> groups;
+
+  /// \brief Version of the document after the conversion.
+  std::string version;
+
+  /// \brief Error in a recipe, which stops the conversion.
+  std::string error;
+};
+}
+}
+
 using namespace sdf;
 
 namespace {
@@ -70,6 +133,694 @@ void UpdatePose(tinyxml2::XMLElement *_elem,
   if (_elem->FirstChildElement("camera"))
     UpdatePose(_elem->FirstChildElement("camera"), _childNameIdx, _modelName);
 }
+
+/////////////////////////////////////////////////
+// returns true if the search for descendants does not look into the element,
+// which is the case for plugins and elements of custom namespaces
+bool IsDescendantSearchStop(const tinyxml2::XMLElement *_elem)
+{
+  return strcmp(_elem->Name(), "plugin") == 0 ||
+      strchr(_elem->Name(), ':') != nullptr;
+}
+
+/////////////////////////////////////////////////
+// returns the string, or nullptr if there is none
+const char *OptionalCStr(const std::optional<std::string> &_str)
+{
+  return _str ? _str->c_str() : nullptr;
+}
+
+/////////////////////////////////////////////////
+// returns an attribute of a recipe element, if it has it
+std::optional<std::string> OptionalAttribute(
+    const tinyxml2::XMLElement *_elem, const char *_name)
+{
+  const char *value = _elem->Attribute(_name);
+  if (!value)
+    return std::nullopt;
+  return std::string(value);
+}
+
+/////////////////////////////////////////////////
+// reads the <from> and <to> of a <map> operation
+void CompileMap(const tinyxml2::XMLElement *_mapElem, ConvertOperation &_op)
+{
+  auto *fromConvertElem = _mapElem->FirstChildElement("from");
+  auto *toConvertElem = _mapElem->FirstChildElement("to");
+
+  if (!fromConvertElem)
+  {
+    _op.error = "<map> element requires a <from> child element.";
+    return;
+  }
+  if (!toConvertElem)
+  {
+    _op.error = "<map> element requires a <to> child element.";
+    return;
+  }
+
+  const char *fromNameStr = fromConvertElem->Attribute("name");
+  const char *toNameStr = toConvertElem->Attribute("name");
+
+  if (!fromNameStr || strlen(fromNameStr) == 0)
+  {
+    _op.error = "Map: <from> element requires a non-empty name attribute.";
+    return;
+  }
+  if (!toNameStr || strlen(toNameStr) == 0)
+  {
+    _op.error = "Map: <to> element requires a non-empty name attribute.";
+    return;
+  }
+
+  // create map of input and output values
+  auto *fromValueElem = fromConvertElem->FirstChildElement("value");
+  auto *toValueElem = toConvertElem->FirstChildElement("value");
+  if (!fromValueElem)
+  {
+    _op.error = "Map: <from> element requires at least one <value> element.";
+    return;
+  }
+  if (!toValueElem)
+  {
+    _op.error = "Map: <to> element requires at least one <value> element.";
+    return;
+  }
+  while (fromValueElem)
+  {
+    if (!fromValueElem->GetText())
+    {
+      _op.error = "Map: from value must not be empty.";
+      return;
+    }
+    if (!toValueElem->GetText())
+    {
+      _op.error = "Map: to value must not be empty.";
+      return;
+    }
+    _op.valueMap[fromValueElem->GetText()] = toValueElem->GetText();
+
+    fromValueElem = fromValueElem->NextSiblingElement("value");
+    if (fromValueElem && toValueElem->NextSiblingElement("value"))
+    {
+      toValueElem = toValueElem->NextSiblingElement("value");
+    }
+  }
+
+  // tokenize 'from' and 'to' name attributes
+  _op.fromTokens = split(fromNameStr, "/");
+  _op.toTokens = split(toNameStr, "/");
+
+  // split() always returns at least one element, even with the
+  // empty string.  Thus we don't check if the fromTokens or toTokens are empty.
+  const std::string &fromLeaf = _op.fromTokens.back();
+  _op.invalidFromLeaf = fromLeaf.empty() || fromLeaf == "@";
+  const std::string &toLeaf = _op.toTokens.back();
+  _op.invalidToLeaf = toLeaf.empty() || toLeaf == "@";
+}
+
+/////////////////////////////////////////////////
+// reads an operation of a recipe
+ConvertOperation CompileOperation(const tinyxml2::XMLElement *_elem)
+{
+  ConvertOperation op;
+  op.name = _elem->Name();
+
+  if (op.name == "rename" || op.name == "copy" || op.name == "move")
+  {
+    if (op.name == "rename")
+      op.type = ConvertOperation::Type::RENAME;
+    else if (op.name == "copy")
+      op.type = ConvertOperation::Type::COPY;
+    else
+      op.type = ConvertOperation::Type::MOVE;
+
+    auto *fromConvertElem = _elem->FirstChildElement("from");
+    auto *toConvertElem = _elem->FirstChildElement("to");
+    if (!fromConvertElem || !toConvertElem)
+    {
+      op.error = "<" + op.name + "> element requires <from> and <to> "
+          "child elements.";
+      return op;
+    }
+
+    op.fromElement = OptionalAttribute(fromConvertElem, "element");
+    op.fromAttribute = OptionalAttribute(fromConvertElem, "attribute");
+    op.toElement = OptionalAttribute(toConvertElem, "element");
+    op.toAttribute = OptionalAttribute(toConvertElem, "attribute");
+
+    if (op.type != ConvertOperation::Type::RENAME)
+    {
+      // tokenize 'from' and 'to' strs
+      op.fromTokens = split(op.fromElement.value_or(
+          op.fromAttribute.value_or("")), "::");
+      op.toTokens = split(op.toElement.value_or(
+          op.toAttribute.value_or("")), "::");
+    }
+  }
+  else if (op.name == "add" || op.name == "remove" ||
+           op.name == "remove_empty")
+  {
+    if (op.name == "add")
+      op.type = ConvertOperation::Type::ADD;
+    else if (op.name == "remove")
+      op.type = ConvertOperation::Type::REMOVE;
+    else
+      op.type = ConvertOperation::Type::REMOVE_EMPTY;
+
+    op.fromAttribute = OptionalAttribute(_elem, "attribute");
+    op.fromElement = OptionalAttribute(_elem, "element");
+    op.value = OptionalAttribute(_elem, "value");
+
+    const std::string opName =
+        op.type == ConvertOperation::Type::ADD ? "add" : "remove";
+    if (op.fromAttribute.has_value() == op.fromElement.has_value())
+    {
+      op.error = "Exactly one 'element' or 'attribute'"
+          " must be specified in <" + opName + ">";
+    }
+    else if (op.type == ConvertOperation::Type::ADD && op.fromAttribute &&
+             !op.value)
+    {
+      op.error = "No 'value' specified in <add>";
+    }
+  }
+  else if (op.name == "map")
+  {
+    op.type = ConvertOperation::Type::MAP;
+    CompileMap(_elem, op);
+  }
+  else if (op.name == "unflatten")
+  {
+    op.type = ConvertOperation::Type::UNFLATTEN;
+  }
+  else
+  {
+    op.error = "Unknown convert element[" + op.name + "]";
+  }
+
+  return op;
+}
+
+/////////////////////////////////////////////////
+// indexes the nested rules of a rule by the elements they apply to
+void IndexChildren(ConvertRule &_rule)
+{
+  _rule.namedChildren.clear();
+  _rule.descendantChildren.clear();
+  for (std::size_t i = 0; i < _rule.children.size(); ++i)
+  {
+    if (_rule.children[i].descendant)
+      _rule.descendantChildren.push_back(i);
+    else
+      _rule.namedChildren[_rule.children[i].name].push_back(i);
+  }
+}
+
+/////////////////////////////////////////////////
+// reads a <convert> element of a recipe, numbering its rules from _order
+void CompileRule(const tinyxml2::XMLElement *_convert, ConvertRule &_rule,
+                 std::size_t &_order)
+{
+  _rule.order = _order++;
+
+  for (auto *deprecatedElem = _convert->FirstChildElement("deprecated");
+       deprecatedElem;
+       deprecatedElem = deprecatedElem->NextSiblingElement("deprecated"))
+  {
+    const char *text = deprecatedElem->GetText();
+    _rule.deprecated.emplace_back(text ? text : "");
+  }
+
+  for (auto *convertElem = _convert->FirstChildElement("convert");
+       convertElem; convertElem = convertElem->NextSiblingElement("convert"))
+  {
+    for (const char *attribute : {"name", "descendant_name"})
+    {
+      if (const char *name = convertElem->Attribute(attribute))
+      {
+        ConvertRule child;
+        child.name = name;
+        child.descendant = strcmp(attribute, "descendant_name") == 0;
+        CompileRule(convertElem, child, _order);
+        _rule.children.push_back(std::move(child));
+      }
+    }
+  }
+  IndexChildren(_rule);
+
+  for (auto *childElem = _convert->FirstChildElement(); childElem;
+       childElem = childElem->NextSiblingElement())
+  {
+    if (strcmp(childElem->Name(), "convert") != 0)
+      _rule.operations.push_back(CompileOperation(childElem));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief A recipe of the embedded files database.
+struct ConvertStep
+{
+  /// \brief Version the recipe converts to.
+  std::string toVersion;
+
+  /// \brief The compiled recipe.
+  ConvertRule rule;
+
+  /// \brief Error found when parsing the recipe.
+  std::string error;
+};
+
+/////////////////////////////////////////////////
+// returns the recipes of the embedded files database by the version they
+// convert from, which are compiled the first time this is called
+const std::map<std::string, ConvertStep> &ConvertSteps()
+{
+  static const std::map<std::string, ConvertStep> steps = []()
+  {
+    // The conversion recipes within the embedded files database are named,
+    // e.g., "1.8/1_7.convert" to upgrade from 1.7 to 1.8.
+    const std::string extension = ".convert";
+    std::map<std::string, ConvertStep> result;
+    for (const auto &[pathname, data] : GetEmbeddedSdf())
+    {
+      const std::size_t slash = pathname.rfind('/');
+      if (!EndsWith(pathname, extension) || slash == std::string::npos)
+        continue;
+
+      std::string fromVersion = pathname.substr(
+          slash + 1, pathname.size() - slash - 1 - extension.size());
+      std::replace(fromVersion.begin(), fromVersion.end(), '_', '.');
+
+      ConvertStep step;
+      step.toVersion = pathname.substr(0, slash);
+      tinyxml2::XMLDocument xmlDoc;
+      xmlDoc.Parse(data.c_str());
+      if (xmlDoc.Error())
+      {
+        step.error = std::string("Error parsing XML from string: ") +
+            xmlDoc.ErrorStr();
+      }
+      else if (auto *convertElem = xmlDoc.FirstChildElement("convert"))
+      {
+        std::size_t order = 0;
+        CompileRule(convertElem, step.rule, order);
+      }
+      result.emplace(fromVersion, std::move(step));
+    }
+    return result;
+  }();
+  return steps;
+}
+
+/////////////////////////////////////////////////
+/// \brief An element name in the path of the elements a rule applies to,
+/// or any number of elements.
+struct PathToken
+{
+  /// \brief Name of the element.
+  std::string name;
+
+  /// \brief True for any number of elements of any name.
+  bool any = false;
+};
+
+/////////////////////////////////////////////////
+/// \brief The elements a rule applies to and the elements its operations
+/// read or change.
+struct RuleSite
+{
+  /// \brief Path of the elements the rule applies to, from the root.
+  std::vector<PathToken> path;
+
+  /// \brief Paths of the child elements read or changed by the operations.
+  std::vector<std::vector<std::string>> touched;
+
+  /// \brief True if the operations may change any child element.
+  bool touchesAll = false;
+
+  /// \brief Position of the rule in the order its part of a recipe
+  /// applies the operations.
+  std::size_t position = 0;
+
+  /// \brief The rules for descendants that the rule is nested in.
+  std::vector<const ConvertRule *> scans;
+};
+
+/////////////////////////////////////////////////
+// adds the paths of the child elements an operation reads or changes
+void AddTouchedPaths(const ConvertOperation &_op, RuleSite &_site)
+{
+  auto addPath = [&_site](std::vector<std::string> _path, bool _leafIsElement)
+  {
+    if (!_leafIsElement && !_path.empty())
+      _path.pop_back();
+    if (!_path.empty())
+      _site.touched.push_back(std::move(_path));
+  };
+
+  switch (_op.type)
+  {
+    case ConvertOperation::Type::ADD:
+    case ConvertOperation::Type::REMOVE:
+    case ConvertOperation::Type::REMOVE_EMPTY:
+      if (_op.fromElement)
+        addPath({*_op.fromElement}, true);
+      break;
+    case ConvertOperation::Type::RENAME:
+      if (_op.fromElement)
+        addPath({*_op.fromElement}, true);
+      if (_op.toElement)
+        addPath({*_op.toElement}, true);
+      break;
+    case ConvertOperation::Type::COPY:
+    case ConvertOperation::Type::MOVE:
+      addPath(_op.fromTokens, _op.fromElement.has_value());
+      addPath(_op.toTokens, _op.toElement.has_value());
+      break;
+    case ConvertOperation::Type::MAP:
+      if (!_op.fromTokens.empty())
+        addPath(_op.fromTokens, _op.fromTokens.back()[0] != '@');
+      if (!_op.toTokens.empty())
+        addPath(_op.toTokens, _op.toTokens.back()[0] != '@');
+      break;
+    case ConvertOperation::Type::UNFLATTEN:
+      _site.touchesAll = true;
+      break;
+    case ConvertOperation::Type::UNKNOWN:
+      break;
+  }
+}
+
+/////////////////////////////////////////////////
+// collects the rules with operations of a part of a recipe, nested rules
+// first, which is the order the operations are applied in
+void CollectSites(const ConvertRule &_rule, std::vector<PathToken> _path,
+                  std::vector<const ConvertRule *> _scans,
+                  std::vector<RuleSite> &_sites, bool &_deprecated)
+{
+  if (_rule.descendant)
+  {
+    _path.push_back({"", true});
+    _scans.push_back(&_rule);
+  }
+  _path.push_back({_rule.name, false});
+  _deprecated = _deprecated || !_rule.deprecated.empty();
+
+  for (const auto &child : _rule.children)
+    CollectSites(child, _path, _scans, _sites, _deprecated);
+
+  if (_rule.operations.empty())
+    return;
+
+  RuleSite site;
+  site.path = std::move(_path);
+  site.scans = std::move(_scans);
+  site.position = _sites.size();
+  for (const auto &op : _rule.operations)
+    AddTouchedPaths(op, site);
+  _sites.push_back(std::move(site));
+}
+
+/////////////////////////////////////////////////
+// finds the tokens of _below at which paths matching _below can continue
+// after a path matching _above, from the tokens _j of _above and _i of _below
+void PathRemainders(const std::vector<PathToken> &_above, std::size_t _j,
+                    const std::vector<PathToken> &_below, std::size_t _i,
+                    std::set<std::size_t> &_remainders,
+                    std::set<std::pair<std::size_t, std::size_t>> &_visited)
+{
+  if (!_visited.insert({_j, _i}).second)
+    return;
+
+  if (_j == _above.size())
+  {
+    _remainders.insert(_i);
+    return;
+  }
+
+  if (_i == _below.size())
+  {
+    if (_above[_j].any)
+      PathRemainders(_above, _j + 1, _below, _i, _remainders, _visited);
+    return;
+  }
+
+  if (_above[_j].any || _below[_i].any)
+  {
+    // Either the elements matched by one of the tokens end, or they include
+    // an element matched by the other token.
+    PathRemainders(_above, _j + 1, _below, _i, _remainders, _visited);
+    PathRemainders(_above, _j, _below, _i + 1, _remainders, _visited);
+  }
+  else if (_above[_j].name == _below[_i].name)
+  {
+    PathRemainders(_above, _j + 1, _below, _i + 1, _remainders, _visited);
+  }
+}
+
+/////////////////////////////////////////////////
+// returns the tokens of _below at which paths matching _below can continue
+// after a path matching _above
+std::set<std::size_t> PathRemainders(const std::vector<PathToken> &_above,
+                                     const std::vector<PathToken> &_below)
+{
+  std::set<std::size_t> remainders;
+  std::set<std::pair<std::size_t, std::size_t>> visited;
+  PathRemainders(_above, 0, _below, 0, remainders, visited);
+  return remainders;
+}
+
+/////////////////////////////////////////////////
+// returns true if the operations of _later, which the recipes apply after
+// those of _earlier, may give another result when applied before them,
+// which is what a single traversal does for _later rules on descendants
+bool Conflicts(const RuleSite &_earlier, const RuleSite &_later)
+{
+  if (_earlier.touched.empty() && !_earlier.touchesAll)
+    return false;
+
+  for (std::size_t i : PathRemainders(_earlier.path, _later.path))
+  {
+    // The rules apply to the same element.
+    if (i == _later.path.size())
+      continue;
+
+    if (_earlier.touchesAll)
+      return true;
+
+    if (!_later.path[i].any)
+    {
+      for (const auto &path : _earlier.touched)
+      {
+        if (path.front() == _later.path[i].name)
+          return true;
+      }
+      continue;
+    }
+
+    // The later rule applies to descendants found anywhere below, and
+    // gives the same result wherever the earlier operations put them, as
+    // long as those operations do not reach into them or create them.
+    for (const auto &path : _earlier.touched)
+    {
+      for (const auto &name : path)
+      {
+        if (name == "plugin" || name.find(':') != std::string::npos)
+          return true;
+        for (std::size_t k = i; k < _later.path.size(); ++k)
+        {
+          if (!_later.path[k].any && _later.path[k].name == name)
+            return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+// returns true if the rules of a part of a recipe cannot be applied in one
+// traversal that applies the nested rules first
+bool PartConflicts(const std::vector<RuleSite> &_sites)
+{
+  for (const auto &earlier : _sites)
+  {
+    for (const auto &later : _sites)
+    {
+      // A rule for descendants applies again to the descendants of the
+      // elements it already converted.
+      bool sharedScan = false;
+      for (const ConvertRule *scan : earlier.scans)
+      {
+        sharedScan = sharedScan || std::find(later.scans.begin(),
+            later.scans.end(), scan) != later.scans.end();
+      }
+
+      if (!sharedScan && later.position <= earlier.position)
+        continue;
+
+      if (Conflicts(earlier, later))
+        return true;
+
+      // The order of rules applied to the same element is only kept for
+      // rules that apply to children.
+      const auto isAny = [](const PathToken &_token) {return _token.any;};
+      if (&earlier != &later &&
+          (std::any_of(earlier.path.begin(), earlier.path.end(), isAny) ||
+           std::any_of(later.path.begin(), later.path.end(), isAny)) &&
+          PathRemainders(earlier.path, later.path).count(later.path.size()))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+// groups the recipes into traversals, in which the rules of consecutive
+// recipes are fused when that gives the same result as applying the
+// recipes one after the other
+void GroupRecipes(const std::vector<const ConvertRule *> &_recipes,
+                  ConvertPlan &_plan)
+{
+  struct Part
+  {
+    ConvertPlan::Stage stage;
+    std::size_t recipe;
+    std::vector<RuleSite> sites;
+    bool alone;
+  };
+
+  std::vector<Part> parts;
+  for (std::size_t k = 0; k < _recipes.size(); ++k)
+  {
+    const ConvertRule *recipe = _recipes[k];
+    if (!recipe->deprecated.empty())
+    {
+      parts.push_back({{ConvertPlan::Stage::Kind::DEPRECATIONS, recipe, 0},
+                       k, {}, true});
+    }
+
+    for (std::size_t i = 0; i < recipe->children.size(); ++i)
+    {
+      Part part{{ConvertPlan::Stage::Kind::CHILD, recipe, i}, k, {}, false};
+      CollectSites(recipe->children[i], {}, {}, part.sites, part.alone);
+      part.alone = part.alone || PartConflicts(part.sites);
+      parts.push_back(std::move(part));
+    }
+
+    if (!recipe->operations.empty())
+    {
+      Part part{{ConvertPlan::Stage::Kind::OPERATIONS, recipe, 0}, k, {},
+                false};
+      RuleSite site;
+      for (const auto &op : recipe->operations)
+        AddTouchedPaths(op, site);
+      part.sites.push_back(std::move(site));
+      parts.push_back(std::move(part));
+    }
+  }
+
+  std::vector<const Part *> fused;
+  auto addGroup = [&]()
+  {
+    if (fused.empty())
+      return;
+
+    ConvertPlan::Group group;
+    if (fused.size() == 1)
+    {
+      group.stages.push_back(fused.front()->stage);
+    }
+    else
+    {
+      group.fused = true;
+      for (const Part *part : fused)
+      {
+        if (group.roots.empty() || group.roots.back().second != part->recipe)
+        {
+          ConvertRule root;
+          root.order = part->stage.recipe->order;
+          group.roots.emplace_back(std::move(root), part->recipe);
+        }
+
+        const ConvertPlan::Stage &stage = part->stage;
+        ConvertRule &root = group.roots.back().first;
+        if (stage.kind == ConvertPlan::Stage::Kind::CHILD)
+          root.children.push_back(stage.recipe->children[stage.child]);
+        else
+          root.operations = stage.recipe->operations;
+      }
+      for (auto &root : group.roots)
+        IndexChildren(root.first);
+    }
+    _plan.groups.push_back(std::move(group));
+    fused.clear();
+  };
+
+  for (const Part &part : parts)
+  {
+    bool conflict = part.alone;
+    for (const Part *previous : fused)
+    {
+      for (const auto &earlier : previous->sites)
+      {
+        for (const auto &later : part.sites)
+          conflict = conflict || Conflicts(earlier, later);
+      }
+    }
+
+    if (conflict)
+      addGroup();
+
+    fused.push_back(&part);
+    if (part.alone)
+      addGroup();
+  }
+  addGroup();
+}
+
+/////////////////////////////////////////////////
+// returns the plan to convert between two versions with the embedded
+// recipes, which is made the first time it is needed
+std::shared_ptr<const ConvertPlan> GetPlan(const std::string &_fromVersion,
+                                           const std::string &_toVersion)
+{
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, std::string>,
+                  std::shared_ptr<const ConvertPlan>> plans;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto &plan = plans[{_fromVersion, _toVersion}];
+  if (plan)
+    return plan;
+
+  // Find the recipes one at a time until we reach the desired _toVersion.
+  auto newPlan = std::make_shared<ConvertPlan>();
+  const std::map<std::string, ConvertStep> &steps = ConvertSteps();
+  std::vector<const ConvertRule *> recipes;
+  newPlan->version = _fromVersion;
+  while (newPlan->version != _toVersion)
+  {
+    auto step = steps.find(newPlan->version);
+    if (step == steps.end())
+      break;
+
+    newPlan->version = step->second.toVersion;
+    if (!step->second.error.empty())
+    {
+      newPlan->error = step->second.error;
+      break;
+    }
+    recipes.push_back(&step->second.rule);
+  }
+
+  GroupRecipes(recipes, *newPlan);
+  plan = newPlan;
+  return plan;
+}
 }
 
 /////////////////////////////////////////////////
@@ -111,47 +862,20 @@ bool Converter::Convert(tinyxml2::XMLDocument *_doc,
 
   elem->SetAttribute("version", _toVersion.c_str());
 
-  // The conversion recipes within the embedded files database are named, e.g.,
-  // "1.8/1_7.convert" to upgrade from 1.7 to 1.8.
-  const std::map<std::string, std::string> &embedded = GetEmbeddedSdf();
+  // The recipes are compiled once, and the rules of consecutive recipes are
+  // applied in as few traversals as possible.
+  const std::shared_ptr<const ConvertPlan> plan =
+      GetPlan(origVersion, _toVersion);
+  ApplyPlan(elem, *plan);
 
-  // Apply the conversions one at a time until we reach the desired _toVersion.
-  std::string curVersion = origVersion;
-  while (curVersion != _toVersion)
+  if (!plan->error.empty())
   {
-    // Find the (at most one) file named, e.g., ".../1_7.convert".
-    std::string snakeVersion = curVersion;
-    std::replace(snakeVersion.begin(), snakeVersion.end(), '.', '_');
-    const std::string suffix = "/" + snakeVersion + ".convert";
-    const char* convertXml = nullptr;
-    for (const auto& [pathname, data] : embedded)
-    {
-      if (EndsWith(pathname, suffix))
-      {
-        curVersion = pathname.substr(0, pathname.size() - suffix.size());
-        convertXml = data.c_str();
-        break;
-      }
-    }
-    if (convertXml == nullptr)
-    {
-      break;
-    }
-
-    // Parse and apply the conversion XML.
-    tinyxml2::XMLDocument xmlDoc;
-    xmlDoc.Parse(convertXml);
-    if (xmlDoc.Error())
-    {
-      sdferr << "Error parsing XML from string: "
-             << xmlDoc.ErrorStr() << '\n';
-      return false;
-    }
-    ConvertImpl(elem, xmlDoc.FirstChildElement("convert"));
+    sdferr << plan->error << '\n';
+    return false;
   }
 
   // Check that we actually converted to the desired final version.
-  if (curVersion != _toVersion)
+  if (plan->version != _toVersion)
   {
     sdferr << "Unable to convert from SDF version " << origVersion
            << " to " << _toVersion << "\n";
@@ -168,24 +892,70 @@ void Converter::Convert(tinyxml2::XMLDocument *_doc,
   SDF_ASSERT(_doc != NULL, "SDF XML doc is NULL");
   SDF_ASSERT(_convertDoc != NULL, "Convert XML doc is NULL");
 
-  ConvertImpl(_doc->FirstChildElement(), _convertDoc->FirstChildElement());
+  auto *convertElem = _convertDoc->FirstChildElement();
+  SDF_ASSERT(convertElem != NULL, "Convert element is NULL");
+
+  ConvertRule recipe;
+  std::size_t order = 0;
+  CompileRule(convertElem, recipe, order);
+
+  ConvertPlan plan;
+  GroupRecipes({&recipe}, plan);
+  ApplyPlan(_doc->FirstChildElement(), plan);
 }
 
 /////////////////////////////////////////////////
-void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
-                                       tinyxml2::XMLElement *_c)
+void Converter::ApplyPlan(tinyxml2::XMLElement *_elem,
+                          const ConvertPlan &_plan)
 {
-  if (!_c->Attribute("descendant_name"))
-  {
-    return;
-  }
+  SDF_ASSERT(_elem != NULL, "SDF element is NULL");
 
-  if (strcmp(_e->Name(), "plugin") == 0)
+  for (const auto &group : _plan.groups)
   {
-    return;
+    if (group.fused)
+    {
+      ConvertRuleRefs rules;
+      for (const auto &[root, recipe] : group.roots)
+        rules.emplace_back(&root, recipe);
+      ConvertFusedImpl(_elem, rules, {});
+      continue;
+    }
+
+    for (const auto &stage : group.stages)
+    {
+      switch (stage.kind)
+      {
+        case ConvertPlan::Stage::Kind::DEPRECATIONS:
+          CheckDeprecation(_elem, *stage.recipe);
+          break;
+        case ConvertPlan::Stage::Kind::CHILD:
+        {
+          const ConvertRule &rule = stage.recipe->children[stage.child];
+          if (rule.descendant)
+          {
+            ConvertDescendantsImpl(_elem, rule);
+            break;
+          }
+          for (auto *elem = _elem->FirstChildElement(rule.name.c_str());
+               elem; elem = elem->NextSiblingElement(rule.name.c_str()))
+          {
+            ConvertImpl(elem, rule);
+          }
+          break;
+        }
+        case ConvertPlan::Stage::Kind::OPERATIONS:
+          ApplyOperations(_elem, *stage.recipe);
+          break;
+      }
+    }
   }
+}
 
-  if (strchr(_e->Name(), ':') != nullptr)
+/////////////////////////////////////////////////
+void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
+                                       const ConvertRule &_rule)
+{
+  if (IsDescendantSearchStop(_e))
   {
     return;
   }
@@ -193,83 +963,146 @@ void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
   tinyxml2::XMLElement *e = _e->FirstChildElement();
   while (e)
   {
-    if (strcmp(e->Name(), _c->Attribute("descendant_name")) == 0)
+    if (_rule.name == e->Name())
     {
-      ConvertImpl(e, _c);
+      ConvertImpl(e, _rule);
     }
-    ConvertDescendantsImpl(e, _c);
+    ConvertDescendantsImpl(e, _rule);
     e = e->NextSiblingElement();
   }
 }
 
 /////////////////////////////////////////////////
 void Converter::ConvertImpl(tinyxml2::XMLElement *_elem,
-                            tinyxml2::XMLElement *_convert)
+                            const ConvertRule &_rule)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_convert != NULL, "Convert element is NULL");
 
-  CheckDeprecation(_elem, _convert);
+  CheckDeprecation(_elem, _rule);
 
-  for (auto *convertElem = _convert->FirstChildElement("convert");
-       convertElem; convertElem = convertElem->NextSiblingElement("convert"))
+  for (const auto &child : _rule.children)
   {
-    if (convertElem->Attribute("name"))
+    if (child.descendant)
     {
-      tinyxml2::XMLElement *elem = _elem->FirstChildElement(
-          convertElem->Attribute("name"));
-      while (elem)
-      {
-        ConvertImpl(elem, convertElem);
-        elem = elem->NextSiblingElement(convertElem->Attribute("name"));
-      }
+      ConvertDescendantsImpl(_elem, child);
+      continue;
     }
-    if (convertElem->Attribute("descendant_name"))
+
+    tinyxml2::XMLElement *elem = _elem->FirstChildElement(child.name.c_str());
+    while (elem)
     {
-      ConvertDescendantsImpl(_elem, convertElem);
+      ConvertImpl(elem, child);
+      elem = elem->NextSiblingElement(child.name.c_str());
     }
   }
 
-  for (tinyxml2::XMLElement *childElem = _convert->FirstChildElement();
-       childElem; childElem = childElem->NextSiblingElement())
-  {
-    const auto name = std::string(childElem->Name());
+  ApplyOperations(_elem, _rule);
+}
 
-    if (name == "rename")
-    {
-      Rename(_elem, childElem);
-    }
-    else if (name == "copy")
-    {
-      Move(_elem, childElem, true);
-    }
-    else if (name == "map")
-    {
-      Map(_elem, childElem);
-    }
-    else if (name == "move")
+/////////////////////////////////////////////////
+void Converter::ConvertFusedImpl(tinyxml2::XMLElement *_elem,
+                                 const ConvertRuleRefs &_rules,
+                                 const ConvertRuleRefs &_scans)
+{
+  // Rules for descendants of this element and of its ancestors, unless the
+  // search for descendants stops here.
+  ConvertRuleRefs newScans;
+  const ConvertRuleRefs *scans = &_scans;
+  if (IsDescendantSearchStop(_elem))
+  {
+    scans = &newScans;
+  }
+  else
+  {
+    for (const auto &[rule, recipe] : _rules)
     {
-      Move(_elem, childElem, false);
+      for (std::size_t index : rule->descendantChildren)
+        newScans.emplace_back(&rule->children[index], recipe);
     }
-    else if (name == "add")
+    if (!newScans.empty())
     {
-      Add(_elem, childElem);
+      newScans.insert(newScans.begin(), _scans.begin(), _scans.end());
+      scans = &newScans;
     }
-    else if (name == "remove")
+  }
+
+  for (tinyxml2::XMLElement *elem = _elem->FirstChildElement(); elem;
+       elem = elem->NextSiblingElement())
+  {
+    ConvertRuleRefs childRules;
+    for (const auto &[rule, recipe] : _rules)
     {
-      Remove(_elem, childElem);
+      auto named = rule->namedChildren.find(elem->Name());
+      if (named == rule->namedChildren.end())
+        continue;
+      for (std::size_t index : named->second)
+        childRules.emplace_back(&rule->children[index], recipe);
     }
-    else if (name == "remove_empty")
+    for (const auto &[rule, recipe] : *scans)
     {
-      Remove(_elem, childElem, true);
+      if (rule->name == elem->Name())
+        childRules.emplace_back(rule, recipe);
     }
-    else if (name == "unflatten")
+
+    if (childRules.empty() && scans->empty())
+      continue;
+
+    // Rules applied to the same element run in the order of the recipes.
+    std::stable_sort(childRules.begin(), childRules.end(),
+        [](const auto &_a, const auto &_b)
+        {
+          return std::make_pair(_a.second, _a.first->order) <
+              std::make_pair(_b.second, _b.first->order);
+        });
+    ConvertFusedImpl(elem, childRules, *scans);
+  }
+
+  for (const auto &[rule, recipe] : _rules)
+  {
+    ApplyOperations(_elem, *rule);
+  }
+}
+
+/////////////////////////////////////////////////
+void Converter::ApplyOperations(tinyxml2::XMLElement *_elem,
+                                const ConvertRule &_rule)
+{
+  for (const auto &op : _rule.operations)
+  {
+    if (!op.error.empty())
     {
-      Unflatten(_elem);
+      sdferr << op.error << "\n";
+      continue;
     }
-    else if (name != "convert")
+
+    switch (op.type)
     {
-      sdferr << "Unknown convert element[" << name << "]\n";
+      case ConvertOperation::Type::RENAME:
+        Rename(_elem, op);
+        break;
+      case ConvertOperation::Type::COPY:
+        Move(_elem, op, true);
+        break;
+      case ConvertOperation::Type::MAP:
+        Map(_elem, op);
+        break;
+      case ConvertOperation::Type::MOVE:
+        Move(_elem, op, false);
+        break;
+      case ConvertOperation::Type::ADD:
+        Add(_elem, op);
+        break;
+      case ConvertOperation::Type::REMOVE:
+        Remove(_elem, op);
+        break;
+      case ConvertOperation::Type::REMOVE_EMPTY:
+        Remove(_elem, op, true);
+        break;
+      case ConvertOperation::Type::UNFLATTEN:
+        Unflatten(_elem);
+        break;
+      case ConvertOperation::Type::UNKNOWN:
+        break;
     }
   }
 }
@@ -547,21 +1380,18 @@ bool Converter::FindNewModelElements(tinyxml2::XMLElement *_elem,
   return unflattenedNewModel;
 }
 
+
 /////////////////////////////////////////////////
 void Converter::Rename(tinyxml2::XMLElement *_elem,
-                       tinyxml2::XMLElement *_renameElem)
+                       const ConvertOperation &_rename)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_renameElem != NULL, "Rename element is NULL");
-
-  auto *fromConvertElem = _renameElem->FirstChildElement("from");
-  auto *toConvertElem = _renameElem->FirstChildElement("to");
 
-  const char *fromElemName = fromConvertElem->Attribute("element");
-  const char *fromAttrName = fromConvertElem->Attribute("attribute");
+  const char *fromElemName = OptionalCStr(_rename.fromElement);
+  const char *fromAttrName = OptionalCStr(_rename.fromAttribute);
 
-  const char *toElemName = toConvertElem->Attribute("element");
-  const char *toAttrName = toConvertElem->Attribute("attribute");
+  const char *toElemName = OptionalCStr(_rename.toElement);
+  const char *toAttrName = OptionalCStr(_rename.toAttribute);
 
   const char *value = GetValue(fromElemName, fromAttrName, _elem);
   if (!value)
@@ -601,33 +1431,19 @@ void Converter::Rename(tinyxml2::XMLElement *_elem,
 }
 
 /////////////////////////////////////////////////
-void Converter::Add(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_addElem)
+void Converter::Add(tinyxml2::XMLElement *_elem, const ConvertOperation &_add)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_addElem != NULL, "Add element is NULL");
 
-  const char *attributeName = _addElem->Attribute("attribute");
-  const char *elementName = _addElem->Attribute("element");
-  const char *value = _addElem->Attribute("value");
-
-  if (!((attributeName == nullptr) ^ (elementName == nullptr)))
-  {
-    sdferr << "Exactly one 'element' or 'attribute'"
-           << " must be specified in <add>\n";
-    return;
-  }
+  // The recipe was checked to have exactly one of 'element' or 'attribute',
+  // and a value for an attribute, when it was read.
+  const char *attributeName = OptionalCStr(_add.fromAttribute);
+  const char *elementName = OptionalCStr(_add.fromElement);
+  const char *value = OptionalCStr(_add.value);
 
   if (attributeName)
   {
-    if (value)
-    {
-      _elem->SetAttribute(attributeName, value);
-    }
-    else
-    {
-      sdferr << "No 'value' specified in <add>\n";
-      return;
-    }
+    _elem->SetAttribute(attributeName, value);
   }
   else
   {
@@ -644,21 +1460,15 @@ void Converter::Add(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_addElem)
 
 /////////////////////////////////////////////////
 void Converter::Remove(tinyxml2::XMLElement *_elem,
-                       tinyxml2::XMLElement *_removeElem,
+                       const ConvertOperation &_remove,
                        bool _removeOnlyEmpty)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_removeElem != NULL, "remove element is NULL");
-
-  const char *attributeName = _removeElem->Attribute("attribute");
-  const char *elementName = _removeElem->Attribute("element");
 
-  if (!((attributeName == nullptr) ^ (elementName == nullptr)))
-  {
-    sdferr << "Exactly one 'element' or 'attribute'"
-           << " must be specified in <remove>\n";
-    return;
-  }
+  // The recipe was checked to have exactly one of 'element' or 'attribute'
+  // when it was read.
+  const char *attributeName = OptionalCStr(_remove.fromAttribute);
+  const char *elementName = OptionalCStr(_remove.fromElement);
 
   if (attributeName)
   {
@@ -686,93 +1496,14 @@ void Converter::Remove(tinyxml2::XMLElement *_elem,
 }
 
 /////////////////////////////////////////////////
-void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
+void Converter::Map(tinyxml2::XMLElement *_elem, const ConvertOperation &_map)
 {
   SDF_ASSERT(_elem != nullptr, "SDF element is nullptr");
-  SDF_ASSERT(_mapElem != nullptr, "Map element is nullptr");
-
-  tinyxml2::XMLElement *fromConvertElem = _mapElem->FirstChildElement("from");
-  tinyxml2::XMLElement *toConvertElem = _mapElem->FirstChildElement("to");
-
-  if (!fromConvertElem)
-  {
-    sdferr << "<map> element requires a <from> child element.\n";
-    return;
-  }
-  if (!toConvertElem)
-  {
-    sdferr << "<map> element requires a <to> child element.\n";
-    return;
-  }
-
-  const char *fromNameStr = fromConvertElem->Attribute("name");
-  const char *toNameStr = toConvertElem->Attribute("name");
-
-  if (!fromNameStr || strlen(fromNameStr) == 0)
-  {
-    sdferr << "Map: <from> element requires a non-empty name attribute.\n";
-    return;
-  }
-  if (!toNameStr || strlen(toNameStr) == 0)
-  {
-    sdferr << "Map: <to> element requires a non-empty name attribute.\n";
-    return;
-  }
 
-  // create map of input and output values
-  std::map<std::string, std::string> valueMap;
-  auto *fromValueElem = fromConvertElem->FirstChildElement("value");
-  auto *toValueElem = toConvertElem->FirstChildElement("value");
-  if (!fromValueElem)
-  {
-    sdferr << "Map: <from> element requires at least one <value> element.\n";
-    return;
-  }
-  if (!toValueElem)
-  {
-    sdferr << "Map: <to> element requires at least one <value> element.\n";
-    return;
-  }
-  if (!fromValueElem->GetText())
-  {
-    sdferr << "Map: from value must not be empty.\n";
-    return;
-  }
-  if (!toValueElem->GetText())
-  {
-    sdferr << "Map: to value must not be empty.\n";
-    return;
-  }
-  valueMap[fromValueElem->GetText()] = toValueElem->GetText();
-  while (fromValueElem->NextSiblingElement("value"))
-  {
-    fromValueElem = fromValueElem->NextSiblingElement("value");
-    if (toValueElem->NextSiblingElement("value"))
-    {
-      toValueElem = toValueElem->NextSiblingElement("value");
-    }
-    if (!fromValueElem->GetText())
-    {
-      sdferr << "Map: from value must not be empty.\n";
-      return;
-    }
-    if (!toValueElem->GetText())
-    {
-      sdferr << "Map: to value must not be empty.\n";
-      return;
-    }
-    valueMap[fromValueElem->GetText()] = toValueElem->GetText();
-  }
-
-  // tokenize 'from' and 'to' name attributes
-  std::string fromStr = fromNameStr;
-  std::string toStr = toNameStr;
-
-  std::vector<std::string> fromTokens = split(fromStr, "/");
-  std::vector<std::string> toTokens = split(toStr, "/");
-
-  // split() always returns at least one element, even with the
-  // empty string.  Thus we don't check if the fromTokens or toTokens are empty.
+  // The <from> and <to> elements and the values were checked when the
+  // recipe was read.
+  const std::vector<std::string> &fromTokens = _map.fromTokens;
+  const std::vector<std::string> &toTokens = _map.toTokens;
 
   // get value of the 'from' element/attribute
   tinyxml2::XMLElement *fromElem = _elem;
@@ -787,13 +1518,12 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
     }
   }
 
-  const char *fromLeaf = fromTokens.back().c_str();
-  if (fromLeaf[0] == '\0' ||
-      (fromLeaf[0] == '@' && fromLeaf[1] == '\0'))
+  if (_map.invalidFromLeaf)
   {
     sdferr << "Map: <from> has invalid name attribute\n";
     return;
   }
+  const char *fromLeaf = fromTokens.back().c_str();
   const char *fromValue = nullptr;
   if (fromLeaf[0] == '@')
   {
@@ -806,12 +1536,17 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
     fromValue = GetValue(fromLeaf, nullptr, fromElem);
   }
 
-  if (!fromValue || valueMap.end() == valueMap.find(std::string(fromValue)))
+  if (!fromValue)
+  {
+    return;
+  }
+  auto mapped = _map.valueMap.find(fromValue);
+  if (mapped == _map.valueMap.end())
   {
     // No match, no message to avoid spam.
     return;
   }
-  const char *toValue = valueMap[std::string(fromValue)].c_str();
+  const char *toValue = mapped->second.c_str();
   // sdfdbg << "Map from [" << fromValue << "] to [" << toValue << "]\n";
 
   // check if destination elements before leaf exist and create if necessary
@@ -830,13 +1565,12 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
   }
 
   // get the destination leaf name
-  const char *toLeaf = toTokens.back().c_str();
-  if (toLeaf[0] == '\0' ||
-      (toLeaf[0] == '@' && toLeaf[1] == '\0'))
+  if (_map.invalidToLeaf)
   {
     sdferr << "Map: <to> has invalid name attribute\n";
     return;
   }
+  const char *toLeaf = toTokens.back().c_str();
   bool toAttribute = toLeaf[0] == '@';
 
   auto *doc = _elem->GetDocument();
@@ -874,46 +1608,20 @@ void Converter::Map(tinyxml2::XMLElement *_elem, tinyxml2::XMLElement *_mapElem)
 
 /////////////////////////////////////////////////
 void Converter::Move(tinyxml2::XMLElement *_elem,
-                     tinyxml2::XMLElement *_moveElem,
+                     const ConvertOperation &_move,
                      const bool _copy)
 {
   SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_moveElem != NULL, "Move element is NULL");
 
-  tinyxml2::XMLElement *fromConvertElem = _moveElem->FirstChildElement("from");
-  tinyxml2::XMLElement *toConvertElem = _moveElem->FirstChildElement("to");
+  const char *fromElemStr = OptionalCStr(_move.fromElement);
+  const char *fromAttrStr = OptionalCStr(_move.fromAttribute);
 
-  const char *fromElemStr = fromConvertElem->Attribute("element");
-  const char *fromAttrStr = fromConvertElem->Attribute("attribute");
+  const char *toElemStr = OptionalCStr(_move.toElement);
+  const char *toAttrStr = OptionalCStr(_move.toAttribute);
 
-  const char *toElemStr = toConvertElem->Attribute("element");
-  const char *toAttrStr = toConvertElem->Attribute("attribute");
-
-  // tokenize 'from' and 'to' strs
-  std::string fromStr = "";
-  if (fromElemStr)
-  {
-    fromStr = fromElemStr;
-  }
-  else if (fromAttrStr)
-  {
-    fromStr = fromAttrStr;
-  }
-  std::string toStr = "";
-  if (toElemStr)
-  {
-    toStr = toElemStr;
-  }
-  else if (toAttrStr)
-  {
-    toStr = toAttrStr;
-  }
-
-  std::vector<std::string> fromTokens = split(fromStr, "::");
-  std::vector<std::string> toTokens = split(toStr, "::");
-
-  // split() always returns at least one element, even with the
-  // empty string.  Thus we don't check if the fromTokens or toTokens are empty.
+  // The 'from' and 'to' strs were tokenized when the recipe was read.
+  const std::vector<std::string> &fromTokens = _move.fromTokens;
+  const std::vector<std::string> &toTokens = _move.toTokens;
 
   // get value of the 'from' element/attribute
   tinyxml2::XMLElement *fromElem = _elem;
@@ -1059,16 +1767,14 @@ const char *Converter::GetValue(const char *_valueElem, const char *_valueAttr,
   return NULL;
 }
 
+
 /////////////////////////////////////////////////
 void Converter::CheckDeprecation(tinyxml2::XMLElement *_elem,
-                                 tinyxml2::XMLElement *_convert)
+                                 const ConvertRule &_rule)
 {
   // Process deprecated elements
-  for (auto *deprecatedElem = _convert->FirstChildElement("deprecated");
-       deprecatedElem;
-       deprecatedElem = deprecatedElem->NextSiblingElement("deprecated"))
+  for (const std::string &value : _rule.deprecated)
   {
-    std::string value = deprecatedElem->GetText();
     std::vector<std::string> valueSplit = split(value, "/");
 
     bool found = false;
@@ -19,8 +19,14 @@
 
 #include <tinyxml2.h>
 
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <sdf/sdf_config.h>
 #include "sdf/system_util.hh"
@@ -31,6 +37,100 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  /// \brief An operation of a conversion recipe, such as <rename> or
+  /// <move>, with its arguments read from the recipe.
+  struct ConvertOperation
+  {
+    /// \brief Types of operations.
+    enum class Type
+    {
+      ADD,
+      COPY,
+      MAP,
+      MOVE,
+      REMOVE,
+      REMOVE_EMPTY,
+      RENAME,
+      UNFLATTEN,
+      UNKNOWN
+    };
+
+    /// \brief Type of the operation.
+    Type type = Type::UNKNOWN;
+
+    /// \brief Name of the recipe element of the operation.
+    std::string name;
+
+    /// \brief Element and attribute of <from> and <to> of <rename>,
+    /// <move> and <copy>, or of <add> and <remove> in fromElement and
+    /// fromAttribute.
+    std::optional<std::string> fromElement;
+    std::optional<std::string> fromAttribute;
+    std::optional<std::string> toElement;
+    std::optional<std::string> toAttribute;
+
+    /// \brief Value of <add>.
+    std::optional<std::string> value;
+
+    /// \brief The 'from' and 'to' paths of <move>, <copy> and <map>, split
+    /// into element names. The last name of a <map> path starts with '@'
+    /// when it is an attribute.
+    std::vector<std::string> fromTokens;
+    std::vector<std::string> toTokens;
+
+    /// \brief Values of <map>.
+    std::map<std::string, std::string, std::less<>> valueMap;
+
+    /// \brief True if the last name of the 'from' or 'to' path of <map> is
+    /// not valid.
+    bool invalidFromLeaf = false;
+    bool invalidToLeaf = false;
+
+    /// \brief Error in the recipe, which is printed instead of applying the
+    /// operation.
+    std::string error;
+  };
+
+  /// \brief A <convert> element of a conversion recipe, compiled so that
+  /// it can be applied without reading the recipe again.
+  struct ConvertRule
+  {
+    /// \brief Name of the elements the rule applies to.
+    std::string name;
+
+    /// \brief True if the rule applies to all descendants with the name,
+    /// false if it applies to children with the name.
+    bool descendant = false;
+
+    /// \brief Position of the rule in its recipe, in the order the recipe
+    /// is applied. Rules applied to the same element run in this order.
+    std::size_t order = 0;
+
+    /// \brief Paths of deprecated elements and attributes.
+    std::vector<std::string> deprecated;
+
+    /// \brief Rules of the nested <convert> elements.
+    std::vector<ConvertRule> children;
+
+    /// \brief Indices of the children that apply to child elements, by
+    /// element name.
+    std::map<std::string, std::vector<std::size_t>, std::less<>>
+        namedChildren;
+
+    /// \brief Indices of the children that apply to descendants.
+    std::vector<std::size_t> descendantChildren;
+
+    /// \brief Operations, which are applied after the nested rules.
+    std::vector<ConvertOperation> operations;
+  };
+
+  /// \brief Rules applied to an element, each with the position of its
+  /// recipe among the recipes being applied.
+  using ConvertRuleRefs = std::vector<std::pair<const ConvertRule *,
+                                                std::size_t>>;
+
+  struct ConvertPlan;
+
   /// \brief Convert from one version of SDF to another
   class Converter
   {
@@ -52,60 +152,78 @@ namespace sdf
                                 tinyxml2::XMLDocument *_convertDoc);
     /// \endcond
 
+    /// \brief Apply the recipes of a conversion.
+    /// \param[in] _elem The root element of the SDF xml doc.
+    /// \param[in] _plan The recipes, grouped into traversals.
+    private: static void ApplyPlan(tinyxml2::XMLElement *_elem,
+                                   const ConvertPlan &_plan);
+
     /// \brief Implementation of Convert functionality.
     /// \param[in] _elem SDF xml element tree to convert.
-    /// \param[in] _convert Convert xml element tree.
+    /// \param[in] _rule Rule to apply.
     private: static void ConvertImpl(tinyxml2::XMLElement *_elem,
-                                     tinyxml2::XMLElement *_convert);
+                                     const ConvertRule &_rule);
 
     /// \brief Recursive helper function for ConvertImpl that converts
     /// elements named by the descendant_name attribute.
     /// \param[in] _e SDF xml element tree to convert.
-    /// \param[in] _c Convert xml element tree.
+    /// \param[in] _rule Rule to apply to the descendants.
     private: static void ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
-                                                tinyxml2::XMLElement *_c);
+                                                const ConvertRule &_rule);
+
+    /// \brief Apply the rules of several recipes in one traversal. The
+    /// nested rules are applied to the descendants of the element first,
+    /// then the operations of each rule in order.
+    /// \param[in] _elem SDF xml element tree to convert.
+    /// \param[in] _rules Rules to apply to the element, in order.
+    /// \param[in] _scans Rules of ancestors that apply to descendants.
+    private: static void ConvertFusedImpl(tinyxml2::XMLElement *_elem,
+                                          const ConvertRuleRefs &_rules,
+                                          const ConvertRuleRefs &_scans);
+
+    /// \brief Apply the operations of a rule.
+    /// \param[in] _elem The element to convert.
+    /// \param[in] _rule The rule.
+    private: static void ApplyOperations(tinyxml2::XMLElement *_elem,
+                                         const ConvertRule &_rule);
 
     /// \brief Rename an element or attribute.
     /// \param[in] _elem The element to be renamed, or the element which
     /// has the attribute to be renamed.
-    /// \param[in] _renameElem A 'convert' element that describes the rename
-    /// operation.
+    /// \param[in] _rename The rename operation of the recipe.
     private: static void Rename(tinyxml2::XMLElement *_elem,
-                                tinyxml2::XMLElement *_renameElem);
+                                const ConvertOperation &_rename);
 
     /// \brief Map values from one element or attribute to another.
     /// \param[in] _elem Ancestor element of the element or attribute to
     /// be mapped.
-    /// \param[in] _mapElem A 'convert' element that describes the map
-    /// operation.
+    /// \param[in] _map The map operation of the recipe.
     private: static void Map(tinyxml2::XMLElement *_elem,
-                             tinyxml2::XMLElement *_mapElem);
+                             const ConvertOperation &_map);
 
     /// \brief Move an element or attribute within a common ancestor element.
     /// \param[in] _elem Ancestor element of the element or attribute to
     /// be moved.
-    /// \param[in] _moveElem A 'convert' element that describes the move
-    /// operation.
+    /// \param[in] _move The move operation of the recipe.
     /// \param[in] _copy True to copy the element
     private: static void Move(tinyxml2::XMLElement *_elem,
-                              tinyxml2::XMLElement *_moveElem,
+                              const ConvertOperation &_move,
                               const bool _copy);
 
     /// \brief Add an element or attribute to an element.
     /// \param[in] _elem The element to receive the value.
-    /// \param[in] _addElem A 'convert' element that describes the add
-    /// operation.
+    /// \param[in] _add The add operation of the recipe.
     private: static void Add(tinyxml2::XMLElement *_elem,
-                             tinyxml2::XMLElement *_addElem);
+                             const ConvertOperation &_add);
 
     /// \brief Remove an attribute or elements.
     /// \param[in] _elem The element from which data may be removed.
-    /// \param[in] _removeElem The metadata about what to remove.
+    /// \param[in] _remove The remove operation of the recipe.
     /// \param[in] _removeOnlyEmpty If true, only remove an attribute
     /// containing an empty string or elements that contain neither value nor
     /// child elements nor attributes.
     private: static void Remove(tinyxml2::XMLElement *_elem,
-                                tinyxml2::XMLElement *_removeElem,
+                                const ConvertOperation &_remove,
                                 bool _removeOnlyEmpty = false);
 
     /// \brief Unflatten an element (conversion from SDFormat <= 1.7 to 1.8)
@@ -127,7 +245,7 @@ namespace sdf
                                          tinyxml2::XMLElement *_elem);
 
     private: static void CheckDeprecation(tinyxml2::XMLElement *_elem,
-                                          tinyxml2::XMLElement *_convert);
+                                          const ConvertRule &_rule);
   };
   }
 }
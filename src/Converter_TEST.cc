@@ -16,8 +16,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <array>
 #include <sstream>
+#include <string>
+#include <vector>
 #include "sdf/Exception.hh"
 #include "sdf/Filesystem.hh"
 
@@ -25,6 +28,7 @@
 #include "XmlUtils.hh"
 
 #include "test_config.h"
+#include "test_utils.hh"
 
 ////////////////////////////////////////////////////
 /// Set up an xml string for testing
@@ -2727,6 +2731,105 @@ TEST(Converter, World_17_to_18)
   EXPECT_STREQ(convertedElem->NextSiblingElement()->Name(), "geometry");
 }
 
+/////////////////////////////////////////////////
+/// Operations of a recipe that depend on an earlier part of the same recipe
+/// see the result of that part.
+TEST(Converter, RecipeOrder)
+{
+  std::string xmlString = R"(
+    <sdf version="1.0">
+      <world>
+        <physics><gravity>0 0 -9.8</gravity></physics>
+      </world>
+    </sdf>)";
+  tinyxml2::XMLDocument xmlDoc;
+  xmlDoc.Parse(xmlString.c_str());
+
+  std::string convertString = R"(
+    <convert name="sdf">
+      <convert name="world">
+        <move>
+          <from element="physics::gravity"/>
+          <to element="gravity"/>
+        </move>
+      </convert>
+      <convert name="world">
+        <convert name="gravity">
+          <add attribute="moved" value="true"/>
+        </convert>
+      </convert>
+      <convert descendant_name="gravity">
+        <add element="checked"/>
+      </convert>
+    </convert>)";
+  tinyxml2::XMLDocument convertXmlDoc;
+  convertXmlDoc.Parse(convertString.c_str());
+
+  sdf::Converter::Convert(&xmlDoc, &convertXmlDoc);
+
+  tinyxml2::XMLElement *worldElem =
+      xmlDoc.FirstChildElement("sdf")->FirstChildElement("world");
+  ASSERT_NE(nullptr, worldElem);
+  ASSERT_NE(nullptr, worldElem->FirstChildElement("physics"));
+  EXPECT_EQ(nullptr,
+      worldElem->FirstChildElement("physics")->FirstChildElement());
+
+  tinyxml2::XMLElement *gravityElem = worldElem->FirstChildElement("gravity");
+  ASSERT_NE(nullptr, gravityElem);
+  EXPECT_STREQ("0 0 -9.8", gravityElem->GetText());
+  EXPECT_STREQ("true", gravityElem->Attribute("moved"));
+  EXPECT_NE(nullptr, gravityElem->FirstChildElement("checked"));
+  EXPECT_EQ(nullptr, gravityElem->NextSiblingElement());
+}
+
+/////////////////////////////////////////////////
+/// Converting a file to the latest version at once gives the same document
+/// as converting it one version at a time.
+TEST(Converter, ConvertAtOnce)
+{
+  const std::vector<std::string> versions =
+      {"1.0", "1.2", "1.3", "1.4", "1.5", "1.6", "1.7", "1.8", "1.9"};
+
+  std::vector<std::string> files;
+  sdf::testing::FindSdfFiles(sdf::testing::TestFile("integration"), files);
+  ASSERT_FALSE(files.empty());
+
+  auto print = [](const tinyxml2::XMLDocument &_doc)
+  {
+    tinyxml2::XMLPrinter printer;
+    _doc.Print(&printer);
+    return std::string(printer.CStr());
+  };
+
+  std::size_t converted = 0;
+  for (const auto &file : files)
+  {
+    tinyxml2::XMLDocument atOnce;
+    tinyxml2::XMLDocument stepwise;
+    if (atOnce.LoadFile(file.c_str()) != tinyxml2::XML_SUCCESS ||
+        stepwise.LoadFile(file.c_str()) != tinyxml2::XML_SUCCESS)
+    {
+      continue;
+    }
+
+    tinyxml2::XMLElement *sdfElem = atOnce.FirstChildElement("sdf");
+    if (!sdfElem || !sdfElem->Attribute("version"))
+      continue;
+    auto version = std::find(versions.begin(), versions.end(),
+                             sdfElem->Attribute("version"));
+    if (version == versions.end() || version + 1 == versions.end())
+      continue;
+
+    EXPECT_TRUE(sdf::Converter::Convert(&atOnce, versions.back())) << file;
+    for (++version; version != versions.end(); ++version)
+      EXPECT_TRUE(sdf::Converter::Convert(&stepwise, *version)) << file;
+
+    EXPECT_EQ(print(stepwise), print(atOnce)) << file;
+    ++converted;
+  }
+  EXPECT_GT(converted, 10u);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -16,21 +16,40 @@
  */
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "sdf/Assert.hh"
 #include "sdf/Element.hh"
 #include "sdf/Filesystem.hh"
+#include "ElementState.hh"
 
 using namespace sdf;
 
+/////////////////////////////////////////////////
+/// \brief Get the shared empty list of element descriptions assigned to
+/// newly constructed elements.
+/// \return Pointer to an empty list of element descriptions.
+static const std::shared_ptr<ElementDescriptionList> &
+emptyElementDescriptions()
+{
+  static const std::shared_ptr<ElementDescriptionList> empty =
+      std::make_shared<ElementDescriptionList>();
+  return empty;
+}
+
 /////////////////////////////////////////////////
 Element::Element()
   : dataPtr(new ElementPrivate)
 {
+  this->dataPtr->state = std::make_unique<ElementState>();
+  this->dataPtr->state->elementDescriptions = emptyElementDescriptions();
   this->dataPtr->copyChildren = false;
-  this->dataPtr->referenceSDF = "";
   this->dataPtr->explicitlySetInFile = true;
 }
 
@@ -48,13 +67,29 @@ ElementPtr Element::GetParent() const
 /////////////////////////////////////////////////
 void Element::SetParent(const ElementPtr _parent)
 {
+  // A relative XML path refers to the parent it was read under, so it is
+  // resolved before the element moves to another parent.
+  if (this->dataPtr->state->xmlPathRelative)
+  {
+    auto oldParent = this->dataPtr->parent.lock();
+    if (oldParent != _parent)
+    {
+      if (nullptr != oldParent)
+      {
+        this->dataPtr->xmlPath = this->BuildXmlPath();
+        this->dataPtr->state->xmlPathRelative = false;
+      }
+      this->dataPtr->ResetFullXmlPath();
+    }
+  }
+
   this->dataPtr->parent = _parent;
 
   // If this element doesn't have a path, get it from the parent
-  if (nullptr != _parent && (this->FilePath().empty() ||
-      this->FilePath() == std::string(kSdfStringSource)))
+  if (nullptr != _parent && (!this->dataPtr->state->path ||
+      *this->dataPtr->state->path == kSdfStringSource))
   {
-    this->SetFilePath(_parent->FilePath());
+    this->dataPtr->state->path = _parent->dataPtr->state->path;
   }
 
   // If this element doesn't have an original version, get it from the parent
@@ -67,7 +102,20 @@ void Element::SetParent(const ElementPtr _parent)
 /////////////////////////////////////////////////
 void Element::SetName(const std::string &_name)
 {
+  if (this->dataPtr->name == _name)
+  {
+    return;
+  }
   this->dataPtr->name = _name;
+
+  // The name index of the parent is keyed by the names of its children.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent)
+  {
+    parent->dataPtr->ChildNamesChanged();
+    if (!parent->dataPtr->state->elementIndex.empty())
+      parent->dataPtr->RebuildElementIndex();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -179,20 +227,44 @@ void Element::AddAttribute(const std::string &_key,
 {
   this->dataPtr->attributes.push_back(
       this->CreateParam(_key, _type, _defaultValue, _required, _description));
+  this->dataPtr->AddToAttributeIndex(this->dataPtr->attributes.back());
+
+  // The parent keeps the names of its children.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent && _key == "name")
+  {
+    parent->dataPtr->ChildNamesChanged();
+  }
 }
 
 /////////////////////////////////////////////////
 ElementPtr Element::Clone() const
+{
+  ElementPtr clone = this->CloneTree();
+
+  // The clone has no parent, so it gets the full XML path.
+  if (this->dataPtr->state->xmlPathRelative)
+  {
+    clone->dataPtr->xmlPath = this->BuildXmlPath();
+    clone->dataPtr->state->xmlPathRelative = false;
+  }
+  return clone;
+}
+
+/////////////////////////////////////////////////
+ElementPtr Element::CloneTree() const
 {
   ElementPtr clone(new Element);
-  clone->dataPtr->description = this->dataPtr->description;
+  clone->dataPtr->state->description = this->dataPtr->state->description;
   clone->dataPtr->name = this->dataPtr->name;
   clone->dataPtr->required = this->dataPtr->required;
   clone->dataPtr->copyChildren = this->dataPtr->copyChildren;
   clone->dataPtr->referenceSDF = this->dataPtr->referenceSDF;
-  clone->dataPtr->path = this->dataPtr->path;
+  clone->dataPtr->state->path = this->dataPtr->state->path;
   clone->dataPtr->lineNumber = this->dataPtr->lineNumber;
   clone->dataPtr->xmlPath = this->dataPtr->xmlPath;
+  clone->dataPtr->state->xmlPathRelative =
+      this->dataPtr->state->xmlPathRelative;
   clone->dataPtr->originalVersion = this->dataPtr->originalVersion;
   clone->dataPtr->explicitlySetInFile = this->dataPtr->explicitlySetInFile;
 
@@ -205,20 +277,22 @@ ElementPtr Element::Clone() const
         "Cannot set parent Element of cloned attribute Param to cloned "
         "Element.");
     clone->dataPtr->attributes.push_back(clonedAttribute);
+    clone->dataPtr->AddToAttributeIndex(clonedAttribute);
   }
 
-  ElementPtr_V::const_iterator eiter;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
-  {
-    clone->dataPtr->elementDescriptions.push_back((*eiter)->Clone());
-  }
+  // Element descriptions are immutable, so they are shared with the clone.
+  clone->dataPtr->state->elementDescriptions =
+      this->dataPtr->state->elementDescriptions;
 
+  ElementPtr_V::const_iterator eiter;
   for (eiter = this->dataPtr->elements.begin();
        eiter != this->dataPtr->elements.end(); ++eiter)
   {
-    clone->dataPtr->elements.push_back((*eiter)->Clone());
-    clone->dataPtr->elements.back()->SetParent(clone);
+    ElementPtr elem = (*eiter)->CloneTree();
+    elem->SetParent(clone);
+    elem->dataPtr->state->indexInParent = clone->dataPtr->elements.size();
+    clone->dataPtr->elements.push_back(elem);
+    clone->dataPtr->AddToElementIndex(elem);
   }
 
   if (this->dataPtr->value)
@@ -239,15 +313,22 @@ ElementPtr Element::Clone() const
 /////////////////////////////////////////////////
 void Element::Copy(const ElementPtr _elem)
 {
-  this->dataPtr->name = _elem->GetName();
-  this->dataPtr->description = _elem->GetDescription();
-  this->dataPtr->required = _elem->GetRequired();
+  // The parent keeps the names of its children.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent)
+  {
+    parent->dataPtr->ChildNamesChanged();
+  }
+
+  this->dataPtr->name = _elem->dataPtr->name;
+  this->dataPtr->state->description = _elem->dataPtr->state->description;
+  this->dataPtr->required = _elem->dataPtr->required;
   this->dataPtr->copyChildren = _elem->GetCopyChildren();
-  this->dataPtr->referenceSDF = _elem->ReferenceSDF();
-  this->dataPtr->originalVersion = _elem->OriginalVersion();
-  this->dataPtr->path = _elem->FilePath();
+  this->dataPtr->referenceSDF = _elem->dataPtr->referenceSDF;
+  this->dataPtr->originalVersion = _elem->dataPtr->originalVersion;
+  this->dataPtr->state->path = _elem->dataPtr->state->path;
   this->dataPtr->lineNumber = _elem->LineNumber();
-  this->dataPtr->xmlPath = _elem->XmlPath();
+  this->UpdateXmlPath(_elem->BuildXmlPath(), false);
   this->dataPtr->explicitlySetInFile = _elem->GetExplicitlySetInFile();
 
   for (Param_V::iterator iter = _elem->dataPtr->attributes.begin();
@@ -256,6 +337,7 @@ void Element::Copy(const ElementPtr _elem)
     if (!this->HasAttribute((*iter)->GetKey()))
     {
       this->dataPtr->attributes.push_back((*iter)->Clone());
+      this->dataPtr->AddToAttributeIndex(this->dataPtr->attributes.back());
     }
     ParamPtr param = this->GetAttribute((*iter)->GetKey());
     (*param) = (**iter);
@@ -277,22 +359,21 @@ void Element::Copy(const ElementPtr _elem)
         "Cannot set parent Element of copied value Param to itself.");
   }
 
-  this->dataPtr->elementDescriptions.clear();
-  for (ElementPtr_V::const_iterator iter =
-       _elem->dataPtr->elementDescriptions.begin();
-       iter != _elem->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    this->dataPtr->elementDescriptions.push_back((*iter)->Clone());
-  }
+  this->dataPtr->state->elementDescriptions =
+      _elem->dataPtr->state->elementDescriptions;
 
   this->dataPtr->elements.clear();
+  this->dataPtr->state->elementIndex.clear();
+  this->dataPtr->ChildNamesChanged();
   for (ElementPtr_V::iterator iter = _elem->dataPtr->elements.begin();
        iter != _elem->dataPtr->elements.end(); ++iter)
   {
     ElementPtr elem = (*iter)->Clone();
     elem->Copy(*iter);
     elem->SetParent(shared_from_this());
+    elem->dataPtr->state->indexInParent = this->dataPtr->elements.size();
     this->dataPtr->elements.push_back(elem);
+    this->dataPtr->AddToElementIndex(elem);
   }
 
   if (_elem->dataPtr->includeElement)
@@ -336,7 +417,7 @@ void Element::PrintDescription(const std::string &_prefix) const
   std::cout << ">\n";
 
   std::cout << _prefix << "  <description><![CDATA["
-            << this->dataPtr->description
+            << this->dataPtr->state->description
             << "]]></description>\n";
 
   Param_V::iterator aiter;
@@ -366,9 +447,10 @@ void Element::PrintDescription(const std::string &_prefix) const
               << "' required ='*'/>\n";
   }
 
-  ElementPtr_V::iterator eiter;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
+  const ElementPtr_V &descriptions =
+      this->dataPtr->state->elementDescriptions->descriptions;
+  ElementPtr_V::const_iterator eiter;
+  for (eiter = descriptions.begin(); eiter != descriptions.end(); ++eiter)
   {
     (*eiter)->PrintDescription(_prefix + "  ");
   }
@@ -381,13 +463,14 @@ void Element::PrintDocRightPane(std::string &_html, int _spacing,
                                 int &_index) const
 {
   std::ostringstream stream;
-  ElementPtr_V::iterator eiter;
+  ElementPtr_V::const_iterator eiter;
 
   int start = _index++;
 
   std::string childHTML;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
+  const ElementPtr_V &descriptions =
+      this->dataPtr->state->elementDescriptions->descriptions;
+  for (eiter = descriptions.begin(); eiter != descriptions.end(); ++eiter)
   {
     (*eiter)->PrintDocRightPane(childHTML, _spacing + 4, _index);
   }
@@ -400,9 +483,9 @@ void Element::PrintDocRightPane(std::string &_html, int _spacing,
   stream << "<div style='background-color: #ffffff'>\n";
 
   stream << "<font style='font-weight:bold'>Description: </font>";
-  if (!this->dataPtr->description.empty())
+  if (!this->dataPtr->state->description.Empty())
   {
-    stream << this->dataPtr->description << "<br>\n";
+    stream << this->dataPtr->state->description << "<br>\n";
   }
   else
   {
@@ -477,13 +560,14 @@ void Element::PrintDocLeftPane(std::string &_html, int _spacing,
                                int &_index) const
 {
   std::ostringstream stream;
-  ElementPtr_V::iterator eiter;
+  ElementPtr_V::const_iterator eiter;
 
   int start = _index++;
 
   std::string childHTML;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
+  const ElementPtr_V &descriptions =
+      this->dataPtr->state->elementDescriptions->descriptions;
+  for (eiter = descriptions.begin(); eiter != descriptions.end(); ++eiter)
   {
     (*eiter)->PrintDocLeftPane(childHTML, _spacing + 4, _index);
   }
@@ -546,6 +630,224 @@ void Element::PrintValuesImpl(const std::string &_prefix,
   }
 }
 
+/////////////////////////////////////////////////
+ElementDescriptionList &ElementPrivate::MutableElementDescriptions()
+{
+  auto &descriptions = this->state->elementDescriptions;
+  if (descriptions.use_count() > 1)
+  {
+    descriptions = std::make_shared<ElementDescriptionList>(*descriptions);
+  }
+  return *descriptions;
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::AddToElementIndex(const ElementPtr &_elem)
+{
+  this->ChildNamesChanged();
+  if (this->elements.size() == ElementState::kNameIndexThreshold)
+  {
+    this->RebuildElementIndex();
+  }
+  else if (this->elements.size() > ElementState::kNameIndexThreshold)
+  {
+    // Only the first element with a given name is indexed.
+    this->state->elementIndex.emplace(_elem->GetName(), _elem);
+  }
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::RemoveFromElementIndex(const ElementPtr &_elem)
+{
+  this->ChildNamesChanged();
+  if (this->elements.size() < ElementState::kNameIndexThreshold)
+  {
+    this->state->elementIndex.clear();
+    return;
+  }
+
+  auto it = this->state->elementIndex.find(_elem->GetName());
+  if (it == this->state->elementIndex.end() || it->second != _elem)
+  {
+    return;
+  }
+
+  // The removed element was the first one with its name, so index the next
+  // one, if any.
+  this->state->elementIndex.erase(it);
+  for (const auto &elem : this->elements)
+  {
+    if (elem->GetName() == _elem->GetName())
+    {
+      this->state->elementIndex.emplace(elem->GetName(), elem);
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::RebuildElementIndex()
+{
+  this->state->elementIndex.clear();
+  if (this->elements.size() < ElementState::kNameIndexThreshold)
+  {
+    return;
+  }
+
+  for (const auto &elem : this->elements)
+  {
+    this->state->elementIndex.emplace(elem->GetName(), elem);
+  }
+}
+
+/////////////////////////////////////////////////
+ElementPtr ElementPrivate::FindElementByName(const std::string &_name) const
+{
+  if (this->elements.size() >= ElementState::kNameIndexThreshold)
+  {
+    auto it = this->state->elementIndex.find(_name);
+    return it == this->state->elementIndex.end() ? ElementPtr() : it->second;
+  }
+
+  for (const auto &elem : this->elements)
+  {
+    if (elem->GetName() == _name)
+    {
+      return elem;
+    }
+  }
+
+  return ElementPtr();
+}
+
+/////////////////////////////////////////////////
+ElementPrivate::~ElementPrivate()
+{
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::ResetFullXmlPath()
+{
+  // References to the full path may have been handed out, so the string is
+  // kept and only joined again by the next call to XmlPath.
+  this->state->fullXmlPathJoined = false;
+}
+
+/////////////////////////////////////////////////
+const ElementChildNames &ElementPrivate::ChildNames() const
+{
+  if (const ElementChildNames *names = this->state->childNames.load())
+  {
+    return *names;
+  }
+
+  auto names = std::make_unique<ElementChildNames>();
+  std::unordered_map<std::string, std::size_t> firstChildWithName;
+  for (const auto &elem : this->elements)
+  {
+    // Get("name") returns attribute value if it exists before checking
+    // for the value of a child element <name>, so it's safe to use
+    // here since we've checked HasAttribute("name").
+    if (!elem->HasAttribute("name"))
+    {
+      continue;
+    }
+    std::string name = elem->Get<std::string>("name");
+    const std::string &type = elem->GetName();
+
+    auto [it, inserted] =
+        firstChildWithName.emplace(name, names->children.size());
+    if (!inserted)
+    {
+      auto &types = names->duplicates[name];
+      if (types.empty())
+      {
+        types.push_back(names->children[it->second].first);
+      }
+      types.push_back(type);
+    }
+    names->children.emplace_back(type, std::move(name));
+  }
+
+  // Elements may be read from several threads at once, so another thread
+  // may have counted the names first.
+  const ElementChildNames *expected = nullptr;
+  if (this->state->childNames.compare_exchange_strong(expected, names.get()))
+  {
+    return *names.release();
+  }
+  return *expected;
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::ChildNamesChanged()
+{
+  delete this->state->childNames.exchange(nullptr);
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::AddToAttributeIndex(const ParamPtr &_param)
+{
+  if (this->attributes.size() == ElementState::kNameIndexThreshold)
+  {
+    this->state->attributeIndex.clear();
+    for (const auto &param : this->attributes)
+    {
+      this->state->attributeIndex.emplace(param->GetKey(), param);
+    }
+  }
+  else if (this->attributes.size() > ElementState::kNameIndexThreshold)
+  {
+    this->state->attributeIndex.emplace(_param->GetKey(), _param);
+  }
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::RemoveFromAttributeIndex(const ParamPtr &_param)
+{
+  if (this->attributes.size() < ElementState::kNameIndexThreshold)
+  {
+    this->state->attributeIndex.clear();
+    return;
+  }
+
+  auto it = this->state->attributeIndex.find(_param->GetKey());
+  if (it == this->state->attributeIndex.end() || it->second != _param)
+  {
+    return;
+  }
+
+  this->state->attributeIndex.erase(it);
+  for (const auto &param : this->attributes)
+  {
+    if (param->GetKey() == _param->GetKey())
+    {
+      this->state->attributeIndex.emplace(param->GetKey(), param);
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+ParamPtr ElementPrivate::FindAttributeByKey(const std::string &_key) const
+{
+  if (this->attributes.size() >= ElementState::kNameIndexThreshold)
+  {
+    auto it = this->state->attributeIndex.find(_key);
+    return it == this->state->attributeIndex.end() ? ParamPtr() : it->second;
+  }
+
+  for (const auto &param : this->attributes)
+  {
+    if (param->GetKey() == _key)
+    {
+      return param;
+    }
+  }
+
+  return ParamPtr();
+}
+
 /////////////////////////////////////////////////
 void ElementPrivate::PrintAttributes(bool _includeDefaultAttributes,
                                      const PrintConfig &_config,
@@ -679,31 +981,39 @@ void Element::RemoveAttribute(const std::string &_key)
   {
     if ((*iter)->GetKey() == _key)
     {
+      ParamPtr param = *iter;
       this->dataPtr->attributes.erase(iter);
+      this->dataPtr->RemoveFromAttributeIndex(param);
       break;
     }
   }
+
+  // The parent keeps the names of its children.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent && _key == "name")
+  {
+    parent->dataPtr->ChildNamesChanged();
+  }
 }
 
 /////////////////////////////////////////////////
 void Element::RemoveAllAttributes()
 {
   this->dataPtr->attributes.clear();
+  this->dataPtr->state->attributeIndex.clear();
+
+  // The parent keeps the names of its children.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent)
+  {
+    parent->dataPtr->ChildNamesChanged();
+  }
 }
 
 /////////////////////////////////////////////////
 ParamPtr Element::GetAttribute(const std::string &_key) const
 {
-  Param_V::const_iterator iter;
-  for (iter = this->dataPtr->attributes.begin();
-      iter != this->dataPtr->attributes.end(); ++iter)
-  {
-    if ((*iter)->GetKey() == _key)
-    {
-      return (*iter);
-    }
-  }
-  return ParamPtr();
+  return this->dataPtr->FindAttributeByKey(_key);
 }
 
 /////////////////////////////////////////////////
@@ -733,16 +1043,18 @@ ParamPtr Element::GetAttribute(unsigned int _index) const
 /////////////////////////////////////////////////
 size_t Element::GetElementDescriptionCount() const
 {
-  return this->dataPtr->elementDescriptions.size();
+  return this->dataPtr->state->elementDescriptions->descriptions.size();
 }
 
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementDescription(unsigned int _index) const
 {
+  const ElementPtr_V &descriptions =
+      this->dataPtr->state->elementDescriptions->descriptions;
   ElementPtr result;
-  if (_index < this->dataPtr->elementDescriptions.size())
+  if (_index < descriptions.size())
   {
-    result = this->dataPtr->elementDescriptions[_index];
+    result = descriptions[_index];
   }
   return result;
 }
@@ -750,17 +1062,28 @@ ElementPtr Element::GetElementDescription(unsigned int _index) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementDescription(const std::string &_key) const
 {
-  ElementPtr_V::const_iterator iter;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-       iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  auto index = this->GetElementDescriptionIndex(_key);
+  if (!index.has_value())
   {
-    if ((*iter)->GetName() == _key)
-    {
-      return (*iter);
-    }
+    return ElementPtr();
   }
 
-  return ElementPtr();
+  return this->dataPtr->state->elementDescriptions->descriptions[*index];
+}
+
+/////////////////////////////////////////////////
+std::optional<std::size_t> Element::GetElementDescriptionIndex(
+    const std::string &_key) const
+{
+  const auto &indexByName =
+      this->dataPtr->state->elementDescriptions->indexByName;
+  auto it = indexByName.find(_key);
+  if (it == indexByName.end())
+  {
+    return std::nullopt;
+  }
+
+  return it->second;
 }
 
 /////////////////////////////////////////////////
@@ -778,17 +1101,7 @@ bool Element::HasElement(const std::string &_name) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementImpl(const std::string &_name) const
 {
-  ElementPtr_V::const_iterator iter;
-  for (iter = this->dataPtr->elements.begin();
-       iter != this->dataPtr->elements.end(); ++iter)
-  {
-    if ((*iter)->GetName() == _name)
-    {
-      return (*iter);
-    }
-  }
-
-  return ElementPtr();
+  return this->dataPtr->FindElementByName(_name);
 }
 
 /////////////////////////////////////////////////
@@ -810,32 +1123,34 @@ ElementPtr Element::GetNextElement(const std::string &_name) const
   auto parent = this->dataPtr->parent.lock();
   if (parent)
   {
-    ElementPtr_V::const_iterator iter;
-    iter = std::find(parent->dataPtr->elements.begin(),
-        parent->dataPtr->elements.end(), shared_from_this());
+    const ElementPtr_V &siblings = parent->dataPtr->elements;
 
-    if (iter == parent->dataPtr->elements.end())
+    // Use the stored index to locate this element among its siblings, and
+    // only search for it if the index is stale.
+    std::size_t index = this->dataPtr->state->indexInParent;
+    if (index >= siblings.size() || siblings[index].get() != this)
     {
-      return ElementPtr();
+      ElementPtr_V::const_iterator iter = std::find_if(
+          siblings.begin(), siblings.end(),
+          [this](const ElementPtr &_sibling)
+          {
+            return _sibling.get() == this;
+          });
+
+      if (iter == siblings.end())
+      {
+        return ElementPtr();
+      }
+      index = static_cast<std::size_t>(iter - siblings.begin());
+      this->dataPtr->state->indexInParent = index;
     }
 
-    ++iter;
-    if (iter == parent->dataPtr->elements.end())
-    {
-      return ElementPtr();
-    }
-    else if (_name.empty())
-    {
-      return *(iter);
-    }
-    else
+    for (++index; index < siblings.size(); ++index)
     {
-      for (; iter != parent->dataPtr->elements.end(); ++iter)
+      if (_name.empty() || siblings[index]->GetName() == _name)
       {
-        if ((*iter)->GetName() == _name)
-        {
-          return (*iter);
-        }
+        siblings[index]->dataPtr->state->indexInParent = index;
+        return siblings[index];
       }
     }
   }
@@ -868,10 +1183,21 @@ bool Element::HasUniqueChildNames(
     const std::string &_type,
     const std::vector<std::string> &_ignoreElements) const
 {
-  auto namedElementsCount = this->CountNamedElements(_type, _ignoreElements);
-  for (auto &iter : namedElementsCount)
+  // Only the names that more than one child element has need to be checked.
+  const ElementChildNames &childNames = this->dataPtr->ChildNames();
+  for (const auto &[name, types] : childNames.duplicates)
   {
-    if (iter.second > 1)
+    std::size_t count = 0;
+    for (const std::string &type : types)
+    {
+      if ((_type.empty() || type == _type) &&
+          std::find(_ignoreElements.begin(), _ignoreElements.end(),
+                    type) == _ignoreElements.end())
+      {
+        ++count;
+      }
+    }
+    if (count > 1)
     {
       return false;
     }
@@ -893,37 +1219,15 @@ std::map<std::string, std::size_t> Element::CountNamedElements(
 {
   std::map<std::string, std::size_t> result;
 
-  sdf::ElementPtr elem;
-  if (_type.empty())
-  {
-    elem = this->GetFirstElement();
-  }
-  else
-  {
-    elem = this->GetElementImpl(_type);
-  }
-
-  while (elem)
+  const ElementChildNames &childNames = this->dataPtr->ChildNames();
+  for (const auto &[type, name] : childNames.children)
   {
-    auto ignoreIt = std::find(_ignoreElements.begin(), _ignoreElements.end(),
-                              elem->GetName());
-    if (elem->HasAttribute("name") && ignoreIt == _ignoreElements.end())
+    if ((_type.empty() || type == _type) &&
+        std::find(_ignoreElements.begin(), _ignoreElements.end(),
+                  type) == _ignoreElements.end())
     {
-      // Get("name") returns attribute value if it exists before checking
-      // for the value of a child element <name>, so it's safe to use
-      // here since we've checked HasAttribute("name").
-      std::string childNameAttributeValue = elem->Get<std::string>("name");
-      if (result.find(childNameAttributeValue) == result.end())
-      {
-        result[childNameAttributeValue] = 1;
-      }
-      else
-      {
-        ++result[childNameAttributeValue];
-      }
+      ++result[name];
     }
-
-    elem = elem->GetNextElement(_type);
   }
 
   return result;
@@ -956,7 +1260,9 @@ ElementConstPtr Element::FindElement(const std::string &_name) const
 /////////////////////////////////////////////////
 void Element::InsertElement(ElementPtr _elem)
 {
+  _elem->dataPtr->state->indexInParent = this->dataPtr->elements.size();
   this->dataPtr->elements.push_back(_elem);
+  this->dataPtr->AddToElementIndex(_elem);
 }
 
 /////////////////////////////////////////////////
@@ -964,7 +1270,9 @@ void Element::InsertElement(ElementPtr _elem,  bool _setParentToSelf)
 {
   if (_setParentToSelf)
     _elem->SetParent(shared_from_this());
+  _elem->dataPtr->state->indexInParent = this->dataPtr->elements.size();
   this->dataPtr->elements.push_back(_elem);
+  this->dataPtr->AddToElementIndex(_elem);
 }
 
 /////////////////////////////////////////////////
@@ -980,39 +1288,34 @@ ElementPtr Element::AddElement(const std::string &_name)
   // descriptions then get them from its parent
   auto parent = this->dataPtr->parent.lock();
   if (!this->dataPtr->referenceSDF.empty() &&
-      this->dataPtr->elementDescriptions.empty() && parent &&
-      parent->GetName() == this->dataPtr->name)
+      this->dataPtr->state->elementDescriptions->descriptions.empty() &&
+      parent && parent->GetName() == this->dataPtr->name)
   {
-    for (unsigned int i = 0; i < parent->GetElementDescriptionCount(); ++i)
-    {
-      this->dataPtr->elementDescriptions.push_back(
-          parent->GetElementDescription(i)->Clone());
-    }
+    this->dataPtr->state->elementDescriptions =
+        parent->dataPtr->state->elementDescriptions;
   }
 
-  ElementPtr_V::const_iterator iter, iter2;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  ElementPtr elemDesc = this->GetElementDescription(_name);
+  if (elemDesc)
   {
-    if ((*iter)->dataPtr->name == _name)
-    {
-      ElementPtr elem = (*iter)->Clone();
-      elem->SetParent(shared_from_this());
-      this->dataPtr->elements.push_back(elem);
+    ElementPtr elem = elemDesc->Clone();
+    elem->SetParent(shared_from_this());
+    elem->dataPtr->state->indexInParent = this->dataPtr->elements.size();
+    this->dataPtr->elements.push_back(elem);
+    this->dataPtr->AddToElementIndex(elem);
 
-      // Add all child elements.
-      for (iter2 = elem->dataPtr->elementDescriptions.begin();
-           iter2 != elem->dataPtr->elementDescriptions.end(); ++iter2)
+    // Add all child elements.
+    const auto childDescriptions = elem->dataPtr->state->elementDescriptions;
+    for (const auto &childDesc : childDescriptions->descriptions)
+    {
+      // Add only required child element
+      if (childDesc->GetRequired() == "1")
       {
-        // Add only required child element
-        if ((*iter2)->GetRequired() == "1")
-        {
-          elem->AddElement((*iter2)->dataPtr->name);
-        }
+        elem->AddElement(childDesc->dataPtr->name);
       }
-
-      return this->dataPtr->elements.back();
     }
+
+    return elem;
   }
 
   sdferr << "Missing element description for [" << _name << "]\n";
@@ -1024,9 +1327,11 @@ void Element::Clear()
 {
   this->ClearElements();
   this->dataPtr->originalVersion.clear();
-  this->dataPtr->path.clear();
+  this->dataPtr->state->path = nullptr;
   this->dataPtr->lineNumber = std::nullopt;
   this->dataPtr->xmlPath.clear();
+  this->dataPtr->state->xmlPathRelative = false;
+  this->dataPtr->ResetFullXmlPath();
 }
 
 /////////////////////////////////////////////////
@@ -1039,6 +1344,8 @@ void Element::ClearElements()
   }
 
   this->dataPtr->elements.clear();
+  this->dataPtr->state->elementIndex.clear();
+  this->dataPtr->ChildNamesChanged();
 }
 
 /////////////////////////////////////////////////
@@ -1075,17 +1382,12 @@ void Element::Reset()
     (*iter).reset();
   }
 
-  for (ElementPtr_V::iterator iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    if (*iter)
-    {
-      (*iter)->Reset();
-    }
-    (*iter).reset();
-  }
+  // Element descriptions may be shared with other elements, so only drop
+  // the reference to them instead of resetting them.
   this->dataPtr->elements.clear();
-  this->dataPtr->elementDescriptions.clear();
+  this->dataPtr->state->elementIndex.clear();
+  this->dataPtr->ChildNamesChanged();
+  this->dataPtr->state->elementDescriptions = emptyElementDescriptions();
 
   this->dataPtr->value.reset();
 
@@ -1095,7 +1397,12 @@ void Element::Reset()
 /////////////////////////////////////////////////
 void Element::AddElementDescription(ElementPtr _elem)
 {
-  this->dataPtr->elementDescriptions.push_back(_elem);
+  ElementDescriptionList &list = this->dataPtr->MutableElementDescriptions();
+
+  // Only the first description with a given name is indexed, which matches
+  // the order of a linear search.
+  list.indexByName.emplace(_elem->GetName(), list.descriptions.size());
+  list.descriptions.push_back(_elem);
 }
 
 /////////////////////////////////////////////////
@@ -1113,13 +1420,20 @@ sdf::ElementPtr Element::GetIncludeElement() const
 /////////////////////////////////////////////////
 void Element::SetFilePath(const std::string &_path)
 {
-  this->dataPtr->path = _path;
+  // Child elements share the path of their parent, see SetParent.
+  std::shared_ptr<const std::string> &path = this->dataPtr->state->path;
+  if (_path.empty())
+    path = nullptr;
+  else if (!path || *path != _path)
+    path = std::make_shared<const std::string>(_path);
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::FilePath() const
 {
-  return this->dataPtr->path;
+  static const std::string empty;
+  const std::shared_ptr<const std::string> &path = this->dataPtr->state->path;
+  return path ? *path : empty;
 }
 
 /////////////////////////////////////////////////
@@ -1137,13 +1451,98 @@ std::optional<int> Element::LineNumber() const
 /////////////////////////////////////////////////
 void Element::SetXmlPath(const std::string &_path)
 {
+  this->UpdateXmlPath(_path, false);
+}
+
+/////////////////////////////////////////////////
+void Element::SetRelativeXmlPath(const std::string &_path)
+{
+  this->UpdateXmlPath(_path, true);
+}
+
+/////////////////////////////////////////////////
+void Element::UpdateXmlPath(const std::string &_path, bool _relative)
+{
+  // The child elements with relative XML paths get their full paths first,
+  // so that they do not change with this one.
+  for (const ElementPtr &child : this->dataPtr->elements)
+  {
+    if (child->dataPtr->state->xmlPathRelative)
+    {
+      child->dataPtr->xmlPath = child->BuildXmlPath();
+      child->dataPtr->state->xmlPathRelative = false;
+      child->dataPtr->ResetFullXmlPath();
+    }
+  }
+
   this->dataPtr->xmlPath = _path;
+  this->dataPtr->state->xmlPathRelative = _relative;
+  this->dataPtr->ResetFullXmlPath();
 }
 
 /////////////////////////////////////////////////
 const std::string &Element::XmlPath() const
 {
-  return this->dataPtr->xmlPath;
+  if (!this->dataPtr->state->xmlPathRelative)
+    return this->dataPtr->xmlPath;
+  if (this->dataPtr->state->fullXmlPathJoined)
+    return this->dataPtr->state->fullXmlPath;
+
+  // Without a parent, only the relative path is known.
+  if (!this->dataPtr->parent.lock())
+    return this->dataPtr->xmlPath;
+
+  // Elements may be read from several threads at once, so the path is only
+  // stored by the first thread that joins it. It is not written again until
+  // xmlPath or the parent change.
+  std::string fullXmlPath = this->BuildXmlPath();
+  static std::mutex fullXmlPathMutex;
+  std::lock_guard<std::mutex> lock(fullXmlPathMutex);
+  if (!this->dataPtr->state->fullXmlPathJoined)
+  {
+    this->dataPtr->state->fullXmlPath = std::move(fullXmlPath);
+    this->dataPtr->state->fullXmlPathJoined = true;
+  }
+  return this->dataPtr->state->fullXmlPath;
+}
+
+/////////////////////////////////////////////////
+std::string Element::BuildXmlPath() const
+{
+  const ElementPrivate *data = this->dataPtr.get();
+  if (!data->state->xmlPathRelative)
+    return data->xmlPath;
+
+  // Collect the relative paths up to the first element with a full path.
+  std::vector<ElementPtr> ancestors;
+  std::vector<const std::string *> paths{&data->xmlPath};
+  std::size_t size = data->xmlPath.size();
+  while (data->state->xmlPathRelative)
+  {
+    if (data->state->fullXmlPathJoined)
+    {
+      paths.back() = &data->state->fullXmlPath;
+      size += data->state->fullXmlPath.size();
+      break;
+    }
+    ElementPtr parent = data->parent.lock();
+    if (!parent)
+      break;
+    ancestors.push_back(parent);
+    data = parent->dataPtr.get();
+    paths.push_back(&data->xmlPath);
+    size += data->xmlPath.size() + 1;
+  }
+
+  std::string xmlPath;
+  xmlPath.reserve(size);
+  for (auto it = paths.rbegin(); it != paths.rend(); ++it)
+  {
+    if (it != paths.rbegin())
+      xmlPath += '/';
+    xmlPath += **it;
+  }
+  return xmlPath;
 }
 
 /////////////////////////////////////////////////
@@ -1161,13 +1560,13 @@ const std::string &Element::OriginalVersion() const
 /////////////////////////////////////////////////
 std::string Element::GetDescription() const
 {
-  return this->dataPtr->description;
+  return this->dataPtr->state->description;
 }
 
 /////////////////////////////////////////////////
 void Element::SetDescription(const std::string &_desc)
 {
-  this->dataPtr->description = _desc;
+  this->dataPtr->state->description = _desc;
 }
 
 /////////////////////////////////////////////////
@@ -1182,7 +1581,13 @@ void Element::RemoveFromParent()
 
     if (iter != parent->dataPtr->elements.end())
     {
-      parent->dataPtr->elements.erase(iter);
+      iter = parent->dataPtr->elements.erase(iter);
+      for (; iter != parent->dataPtr->elements.end(); ++iter)
+      {
+        (*iter)->dataPtr->state->indexInParent =
+            static_cast<std::size_t>(iter - parent->dataPtr->elements.begin());
+      }
+      parent->dataPtr->RemoveFromElementIndex(shared_from_this());
       parent.reset();
     }
   }
@@ -1200,7 +1605,13 @@ void Element::RemoveChild(ElementPtr _child)
   if (iter != this->dataPtr->elements.end())
   {
     _child->SetParent(ElementPtr());
-    this->dataPtr->elements.erase(iter);
+    iter = this->dataPtr->elements.erase(iter);
+    for (; iter != this->dataPtr->elements.end(); ++iter)
+    {
+      (*iter)->dataPtr->state->indexInParent =
+          static_cast<std::size_t>(iter - this->dataPtr->elements.begin());
+    }
+    this->dataPtr->RemoveFromElementIndex(_child);
   }
 }
 
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_ELEMENTSTATE_HH
+#define SDFORMAT_ELEMENTSTATE_HH
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sdf/Element.hh"
+#include "sdf/InternedString.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief List of the element descriptions of an element, with an index to
+  /// look them up by name.
+  class ElementDescriptionList
+  {
+    /// \brief The element descriptions, in the order they were added.
+    public: ElementPtr_V descriptions;
+
+    /// \brief Index of the first element description with a given name.
+    public: std::unordered_map<std::string, std::size_t> indexByName;
+  };
+
+  /// \brief Names of the child elements of an element that have a name
+  /// attribute.
+  struct ElementChildNames
+  {
+    /// \brief Type and name of each child element that has a name attribute,
+    /// in order.
+    std::vector<std::pair<std::string, std::string>> children;
+
+    /// \brief Types of the child elements with each name that more than one
+    /// child element has.
+    std::unordered_map<std::string, std::vector<std::string>> duplicates;
+  };
+
+  /// \brief Private data of an Element that is not part of ElementPrivate.
+  /// The inline templates of Element read ElementPrivate, so its members are
+  /// those of 12.4, and the data added since lives here instead.
+  class ElementState
+  {
+    /// \brief The possible child elements. The list is shared between all
+    /// elements cloned or copied from the same description and must not be
+    /// modified in place. Use ElementPrivate::MutableElementDescriptions to
+    /// obtain a list owned by the element.
+    public: std::shared_ptr<ElementDescriptionList> elementDescriptions;
+
+    /// \brief Index of the element in the list of child elements of its
+    /// parent. This is only a hint used by GetNextElement to avoid searching
+    /// the siblings, and it is verified before use.
+    public: std::atomic<std::size_t> indexInParent{0};
+
+    /// \brief Index from name to the first child element with that name.
+    /// It is only populated while the number of child elements is at least
+    /// kNameIndexThreshold, below which a linear search is used instead.
+    public: std::unordered_map<std::string, ElementPtr> elementIndex;
+
+    /// \brief Index from key to attribute. It is only populated while the
+    /// number of attributes is at least kNameIndexThreshold, below which a
+    /// linear search is used instead.
+    public: std::unordered_map<std::string, ParamPtr> attributeIndex;
+
+    /// \brief Minimum number of child elements or attributes for which
+    /// lookups by name use a hash index.
+    public: static constexpr std::size_t kNameIndexThreshold = 16;
+
+    /// \brief Names of the child elements, which are counted once by
+    /// ElementPrivate::ChildNames and kept until the child elements or their
+    /// names change. Null if they were not counted since the last change.
+    public: mutable std::atomic<const ElementChildNames *> childNames{nullptr};
+
+    /// \brief Element description. Descriptions come from the spec, so the
+    /// elements of one description share a single copy.
+    /// ElementPrivate::description is not used.
+    public: InternedString description;
+
+    /// \brief Path to file where the element came from. It is shared with
+    /// the parent and the other elements of the same file, and is null if
+    /// the path is empty. ElementPrivate::path is not used.
+    public: std::shared_ptr<const std::string> path;
+
+    /// \brief True if ElementPrivate::xmlPath is relative to the XML path of
+    /// the parent.
+    public: bool xmlPathRelative{false};
+
+    /// \brief Full XML path that Element::XmlPath joined from a relative
+    /// XML path. XmlPath returns a reference to it, so it is kept for as
+    /// long as the element exists, and is only joined again after the XML
+    /// path or the parent changed.
+    public: mutable std::string fullXmlPath;
+
+    /// \brief True if fullXmlPath was joined since the XML path or the
+    /// parent last changed.
+    public: mutable std::atomic<bool> fullXmlPathJoined{false};
+
+    /// \brief Destructor.
+    public: ~ElementState()
+    {
+      delete this->childNames.load();
+    }
+  };
+  }
+}
+#endif
@@ -15,6 +15,9 @@
  *
  */
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "sdf/Element.hh"
@@ -444,6 +447,153 @@ TEST(Element, Clone)
   EXPECT_EQ(newelem, clonedAttribs[0]->GetParentElement());
 }
 
+/////////////////////////////////////////////////
+TEST(Element, RelativeXmlPath)
+{
+  sdf::ElementPtr world = std::make_shared<sdf::Element>();
+  sdf::ElementPtr model = std::make_shared<sdf::Element>();
+  sdf::ElementPtr link = std::make_shared<sdf::Element>();
+  world->SetXmlPath("/sdf/world[@name=\"default\"]");
+  model->SetParent(world);
+  model->SetRelativeXmlPath("model[@name=\"robot\"]");
+  world->InsertElement(model);
+  link->SetParent(model);
+  link->SetRelativeXmlPath("link[@name=\"link\"]");
+  model->InsertElement(link);
+
+  const std::string modelXmlPath =
+      "/sdf/world[@name=\"default\"]/model[@name=\"robot\"]";
+  const std::string linkXmlPath = modelXmlPath + "/link[@name=\"link\"]";
+  EXPECT_EQ(linkXmlPath, link->BuildXmlPath());
+  EXPECT_EQ(modelXmlPath, model->XmlPath());
+  EXPECT_EQ(linkXmlPath, link->XmlPath());
+
+  // The joined path is kept, so its reference stays valid
+  EXPECT_EQ(&link->XmlPath(), &link->XmlPath());
+
+  // The reference also stays valid when the path changes
+  const std::string &linkXmlPathRef = link->XmlPath();
+  link->SetRelativeXmlPath("link[@name=\"other\"]");
+  EXPECT_EQ(modelXmlPath + "/link[@name=\"other\"]", link->XmlPath());
+  EXPECT_EQ(&linkXmlPathRef, &link->XmlPath());
+  EXPECT_EQ(modelXmlPath + "/link[@name=\"other\"]", linkXmlPathRef);
+  link->SetRelativeXmlPath("link[@name=\"link\"]");
+
+  // Relative paths keep their full path when the parent's path changes
+  world->SetXmlPath("/sdf/world[@name=\"other\"]");
+  EXPECT_EQ(modelXmlPath, model->XmlPath());
+  EXPECT_EQ(linkXmlPath, link->XmlPath());
+  world->SetXmlPath("/sdf/world[@name=\"default\"]");
+
+  // A clone has the full path, and its children keep theirs
+  sdf::ElementPtr modelClone = model->Clone();
+  EXPECT_EQ(nullptr, modelClone->GetParent());
+  EXPECT_EQ(modelXmlPath, modelClone->XmlPath());
+  ASSERT_NE(nullptr, modelClone->GetFirstElement());
+  EXPECT_EQ(linkXmlPath, modelClone->GetFirstElement()->XmlPath());
+
+  // The full path is kept when the element moves to another parent
+  sdf::ElementPtr otherModel = std::make_shared<sdf::Element>();
+  otherModel->SetXmlPath("/sdf/model[@name=\"other\"]");
+  link->SetParent(otherModel);
+  EXPECT_EQ(linkXmlPath, link->XmlPath());
+
+  // A relative path without a parent is returned as is
+  sdf::ElementPtr orphan = std::make_shared<sdf::Element>();
+  orphan->SetRelativeXmlPath("pose");
+  EXPECT_EQ("pose", orphan->XmlPath());
+
+  // SetXmlPath stores the path as is, even if it does not start with '/'
+  sdf::ElementPtr pose = std::make_shared<sdf::Element>();
+  pose->SetParent(world);
+  pose->SetXmlPath("pose");
+  EXPECT_EQ("pose", pose->XmlPath());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, FilePathIsShared)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  sdf::ElementPtr child = std::make_shared<sdf::Element>();
+  sdf::ElementPtr other = std::make_shared<sdf::Element>();
+  parent->SetFilePath("/path/to/file.sdf");
+  child->SetParent(parent);
+  other->SetFilePath(std::string("/path/to/") + "file.sdf");
+
+  EXPECT_EQ("/path/to/file.sdf", child->FilePath());
+  EXPECT_EQ(&parent->FilePath(), &child->FilePath());
+  EXPECT_EQ(parent->FilePath(), other->FilePath());
+
+  // The path outlives the element that set it.
+  parent.reset();
+  EXPECT_EQ("/path/to/file.sdf", child->FilePath());
+
+  other->SetFilePath("");
+  EXPECT_TRUE(other->FilePath().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, CloneSharesElementDescriptions)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  sdf::ElementPtr desc = std::make_shared<sdf::Element>();
+  desc->SetName("desc");
+  parent->AddElementDescription(desc);
+
+  sdf::ElementPtr newelem = parent->Clone();
+  ASSERT_EQ(1UL, newelem->GetElementDescriptionCount());
+  EXPECT_EQ(desc, newelem->GetElementDescription(0));
+
+  // Adding a description to the clone must not modify the original.
+  sdf::ElementPtr otherDesc = std::make_shared<sdf::Element>();
+  otherDesc->SetName("other_desc");
+  newelem->AddElementDescription(otherDesc);
+  EXPECT_EQ(2UL, newelem->GetElementDescriptionCount());
+  EXPECT_EQ(1UL, parent->GetElementDescriptionCount());
+  EXPECT_FALSE(parent->HasElementDescription("other_desc"));
+
+  // Resetting the clone must not reset the shared description.
+  newelem->Reset();
+  EXPECT_EQ(0UL, newelem->GetElementDescriptionCount());
+  ASSERT_EQ(1UL, parent->GetElementDescriptionCount());
+  EXPECT_EQ("desc", parent->GetElementDescription(0)->GetName());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, GetElementDescriptionIndex)
+{
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  for (const std::string name : {"a", "b", "c", "b"})
+  {
+    sdf::ElementPtr desc = std::make_shared<sdf::Element>();
+    desc->SetName(name);
+    elem->AddElementDescription(desc);
+  }
+  ASSERT_EQ(4UL, elem->GetElementDescriptionCount());
+
+  ASSERT_TRUE(elem->GetElementDescriptionIndex("a").has_value());
+  EXPECT_EQ(0UL, *elem->GetElementDescriptionIndex("a"));
+  ASSERT_TRUE(elem->GetElementDescriptionIndex("c").has_value());
+  EXPECT_EQ(2UL, *elem->GetElementDescriptionIndex("c"));
+
+  // The first description with a given name is found.
+  ASSERT_TRUE(elem->GetElementDescriptionIndex("b").has_value());
+  EXPECT_EQ(1UL, *elem->GetElementDescriptionIndex("b"));
+  EXPECT_EQ(elem->GetElementDescription(1), elem->GetElementDescription("b"));
+
+  EXPECT_FALSE(elem->GetElementDescriptionIndex("d").has_value());
+  EXPECT_EQ(nullptr, elem->GetElementDescription("d"));
+
+  // The index is shared with clones until a description is added.
+  sdf::ElementPtr clone = elem->Clone();
+  sdf::ElementPtr desc = std::make_shared<sdf::Element>();
+  desc->SetName("d");
+  clone->AddElementDescription(desc);
+  ASSERT_TRUE(clone->GetElementDescriptionIndex("d").has_value());
+  EXPECT_EQ(4UL, *clone->GetElementDescriptionIndex("d"));
+  EXPECT_FALSE(elem->GetElementDescriptionIndex("d").has_value());
+}
+
 /////////////////////////////////////////////////
 TEST(Element, ClearElements)
 {
@@ -875,6 +1025,103 @@ TEST(Element, GetNextElementMultiple)
   ASSERT_EQ(child2->GetNextElement(""), nullptr);
 }
 
+/////////////////////////////////////////////////
+TEST(Element, GetNextElementAfterRemove)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  std::vector<sdf::ElementPtr> children;
+  for (const std::string name : {"a", "b", "a", "b", "a"})
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName(name);
+    parent->InsertElement(child, true);
+    children.push_back(child);
+  }
+
+  EXPECT_EQ(children[2], children[0]->GetNextElement("a"));
+  EXPECT_EQ(children[4], children[2]->GetNextElement("a"));
+  EXPECT_EQ(nullptr, children[4]->GetNextElement("a"));
+  EXPECT_EQ(children[3], children[2]->GetNextElement());
+
+  parent->RemoveChild(children[1]);
+  EXPECT_EQ(children[2], children[0]->GetNextElement());
+  EXPECT_EQ(children[3], children[0]->GetNextElement("b"));
+  EXPECT_EQ(children[4], children[3]->GetNextElement());
+
+  children[2]->RemoveFromParent();
+  EXPECT_EQ(children[4], children[0]->GetNextElement("a"));
+  EXPECT_EQ(children[3], children[0]->GetNextElement());
+  EXPECT_EQ(nullptr, children[4]->GetNextElement());
+
+  // The removed element is no longer one of the children of the parent.
+  EXPECT_EQ(nullptr, children[1]->GetNextElement());
+}
+
+/////////////////////////////////////////////////
+TEST(Element, FindElementWithManyChildren)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  std::vector<sdf::ElementPtr> children;
+  for (int i = 0; i < 40; ++i)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName("child" + std::to_string(i % 20));
+    parent->InsertElement(child, true);
+    children.push_back(child);
+  }
+
+  for (int i = 0; i < 20; ++i)
+  {
+    EXPECT_EQ(children[i], parent->FindElement("child" + std::to_string(i)));
+  }
+  EXPECT_EQ(nullptr, parent->FindElement("child20"));
+  EXPECT_FALSE(parent->HasElement("child20"));
+
+  // Removing the first element with a name finds the next one.
+  parent->RemoveChild(children[3]);
+  EXPECT_EQ(children[23], parent->FindElement("child3"));
+  children[5]->RemoveFromParent();
+  EXPECT_EQ(children[25], parent->FindElement("child5"));
+
+  // Renaming a child updates the lookup.
+  children[7]->SetName("renamed");
+  EXPECT_EQ(children[7], parent->FindElement("renamed"));
+  EXPECT_EQ(children[27], parent->FindElement("child7"));
+
+  parent->ClearElements();
+  EXPECT_EQ(nullptr, parent->FindElement("child0"));
+}
+
+/////////////////////////////////////////////////
+TEST(Element, GetAttributeWithManyAttributes)
+{
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  for (int i = 0; i < 40; ++i)
+  {
+    elem->AddAttribute("attr" + std::to_string(i), "int", std::to_string(i),
+                       false);
+  }
+
+  sdf::ElementPtr clone = elem->Clone();
+  for (int i = 0; i < 40; ++i)
+  {
+    const std::string key = "attr" + std::to_string(i);
+    ASSERT_NE(nullptr, elem->GetAttribute(key));
+    EXPECT_EQ(std::to_string(i), elem->GetAttribute(key)->GetAsString());
+    ASSERT_NE(nullptr, clone->GetAttribute(key));
+    EXPECT_EQ(std::to_string(i), clone->GetAttribute(key)->GetAsString());
+  }
+  EXPECT_FALSE(elem->HasAttribute("attr40"));
+
+  elem->RemoveAttribute("attr10");
+  EXPECT_FALSE(elem->HasAttribute("attr10"));
+  EXPECT_TRUE(elem->HasAttribute("attr11"));
+  EXPECT_TRUE(clone->HasAttribute("attr10"));
+
+  elem->RemoveAllAttributes();
+  EXPECT_FALSE(elem->HasAttribute("attr0"));
+}
+
 /////////////////////////////////////////////////
 /// Helper function to add child elements without having to create descriptions
 sdf::ElementPtr addChildElement(sdf::ElementPtr _parent,
@@ -967,6 +1214,64 @@ TEST(Element, CountNamedElements)
   EXPECT_EQ(allMap.at("child3"), 1u);
 }
 
+/////////////////////////////////////////////////
+TEST(Element, CountNamedElementsAfterChanges)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  sdf::ElementPtr child1 = addChildElement(parent, "child", true, "name1");
+  sdf::ElementPtr child2 = addChildElement(parent, "child", true, "name2");
+  EXPECT_TRUE(parent->HasUniqueChildNames());
+
+  // Change the name attribute of a child.
+  ASSERT_TRUE(child2->GetAttribute("name")->Set("name1"));
+  EXPECT_FALSE(parent->HasUniqueChildNames());
+  EXPECT_FALSE(parent->HasUniqueChildNames("child"));
+  EXPECT_EQ(2u, parent->CountNamedElements().at("name1"));
+
+  // Change the type of a child.
+  child2->SetName("other");
+  EXPECT_FALSE(parent->HasUniqueChildNames());
+  EXPECT_TRUE(parent->HasUniqueChildNames("child"));
+  EXPECT_TRUE(parent->HasUniqueChildNames("", {"other"}));
+  EXPECT_EQ(1u, parent->CountNamedElements("other").at("name1"));
+
+  // Reset the name attribute of a child to its default value.
+  child2->GetAttribute("name")->Reset();
+  EXPECT_TRUE(parent->HasUniqueChildNames());
+  EXPECT_EQ(1u, parent->CountNamedElements("other").at("name2"));
+  ASSERT_TRUE(child2->GetAttribute("name")->SetFromString("name1"));
+  EXPECT_FALSE(parent->HasUniqueChildNames());
+  ASSERT_TRUE(child2->GetAttribute("name")->SetFromString("name3"));
+  EXPECT_TRUE(parent->HasUniqueChildNames());
+
+  // Remove the name attribute of a child, and add it back.
+  child2->RemoveAttribute("name");
+  EXPECT_EQ(1u, parent->CountNamedElements().size());
+  child2->AddAttribute("name", "string", "name1", false, "description");
+  EXPECT_FALSE(parent->HasUniqueChildNames());
+  child2->RemoveAllAttributes();
+  EXPECT_TRUE(parent->HasUniqueChildNames());
+
+  // Add and remove children.
+  sdf::ElementPtr child3 = addChildElement(parent, "child", true, "name1");
+  EXPECT_FALSE(parent->HasUniqueChildNames("child"));
+  parent->RemoveChild(child3);
+  EXPECT_TRUE(parent->HasUniqueChildNames("child"));
+  child3 = addChildElement(parent, "child", true, "name1");
+  child3->RemoveFromParent();
+  EXPECT_TRUE(parent->HasUniqueChildNames("child"));
+
+  // Copy an element over a child.
+  sdf::ElementPtr copied = std::make_shared<sdf::Element>();
+  copied->SetName("child");
+  copied->AddAttribute("name", "string", "name1", false, "description");
+  child2->Copy(copied);
+  EXPECT_FALSE(parent->HasUniqueChildNames("child"));
+
+  parent->ClearElements();
+  EXPECT_TRUE(parent->CountNamedElements().empty());
+}
+
 TEST(Element, FindElement)
 {
   // <root>
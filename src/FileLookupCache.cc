@@ -0,0 +1,185 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "sdf/FileLookupCache.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/SDFImpl.hh"
+
+#include "Utils.hh"
+
+using namespace sdf;
+
+/// \brief Private data for FileLookupCache.
+class sdf::FileLookupCache::Implementation
+{
+  /// \brief Return the cached value of a lookup, or compute and cache it.
+  /// \param[in] _key Key of the lookup.
+  /// \param[in] _compute Function that does the lookup. It is given a
+  /// counter to increment for each file system query.
+  /// \return The value of the lookup.
+  public: template<typename Compute>
+          std::string Lookup(const std::string &_key, Compute _compute)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      auto it = this->entries.find(_key);
+      if (it != this->entries.end())
+      {
+        ++this->hits;
+        this->queriesAvoided += it->second.second;
+        return it->second.first;
+      }
+    }
+
+    // The lookup is done without holding the lock, so that slow file
+    // systems do not serialize threads that look up different files.
+    std::size_t queries = 0;
+    std::string value = _compute(queries);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->misses;
+    this->entries.emplace(_key, std::make_pair(value, queries));
+    return value;
+  }
+
+  /// \brief Protects all the members below.
+  public: mutable std::mutex mutex;
+
+  /// \brief Value of each lookup, and the number of file system queries it
+  /// took, by key.
+  public: std::unordered_map<std::string,
+              std::pair<std::string, std::size_t>> entries;
+
+  /// \brief Number of cache hits.
+  public: std::size_t hits = 0;
+
+  /// \brief Number of cache misses.
+  public: std::size_t misses = 0;
+
+  /// \brief Number of file system queries avoided by cache hits.
+  public: std::size_t queriesAvoided = 0;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the value of the SDF_PATH environment variable.
+/// \return The value, or an empty string if it is not set.
+static std::string sdfPathEnv()
+{
+  std::string value;
+#ifndef _WIN32
+  const char *pathCStr = std::getenv("SDF_PATH");
+  if (pathCStr)
+    value = pathCStr;
+#else
+  char *pathCStr = nullptr;
+  size_t sz = 0;
+  if (_dupenv_s(&pathCStr, &sz, "SDF_PATH") == 0 && pathCStr)
+  {
+    value = pathCStr;
+    free(pathCStr);
+  }
+#endif
+  return value;
+}
+
+/////////////////////////////////////////////////
+FileLookupCache::FileLookupCache()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+std::string FileLookupCache::FindFile(const std::string &_filename,
+    bool _searchLocalPath, bool _useCallback, const ParserConfig &_config)
+{
+  // The key holds everything the search depends on, other than the
+  // callback itself.
+  std::string key = "file\n" + _filename;
+  key += '\n' + std::to_string(_searchLocalPath) +
+         std::to_string(_useCallback);
+  key += '\n' + SDF::Version();
+  key += '\n' + sdfPathEnv();
+  if (_searchLocalPath)
+    key += '\n' + sdf::filesystem::current_path();
+  for (const auto &[scheme, paths] : _config.URIPathMap())
+  {
+    key += '\n' + scheme;
+    for (const auto &path : paths)
+      key += ':' + path;
+  }
+
+  return this->dataPtr->Lookup(key, [&](std::size_t &_queries)
+  {
+    return findFileUncached(
+        _filename, _searchLocalPath, _useCallback, _config, _queries);
+  });
+}
+
+/////////////////////////////////////////////////
+bool FileLookupCache::IsDirectory(const std::string &_path)
+{
+  return !this->dataPtr->Lookup("directory\n" + _path,
+      [&](std::size_t &_queries) -> std::string
+  {
+    ++_queries;
+    return sdf::filesystem::is_directory(_path) ? "1" : "";
+  }).empty();
+}
+
+/////////////////////////////////////////////////
+std::string FileLookupCache::ModelFilePath(const std::string &_modelDirPath)
+{
+  return this->dataPtr->Lookup("model\n" + _modelDirPath,
+      [&](std::size_t &_queries)
+  {
+    return getModelFilePathUncached(_modelDirPath, _queries);
+  });
+}
+
+/////////////////////////////////////////////////
+void FileLookupCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries.clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t FileLookupCache::HitCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->hits;
+}
+
+/////////////////////////////////////////////////
+std::size_t FileLookupCache::MissCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->misses;
+}
+
+/////////////////////////////////////////////////
+std::size_t FileLookupCache::QueriesAvoided() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->queriesAvoided;
+}
@@ -20,6 +20,7 @@
 #include "sdf/Error.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -117,6 +118,7 @@ const std::string &Frame::Name() const
 void Frame::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
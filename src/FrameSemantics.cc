@@ -15,8 +15,11 @@
  *
 */
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <string>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -1616,6 +1619,133 @@ Errors validatePoseRelativeToGraph(
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Find the sink vertex of a vertex in the frozen copy of a
+/// FrameAttachedToGraph by following the only outgoing edge of each vertex.
+/// \param[in] _frozen Frozen copy of the graph.
+/// \param[in] _index Index of the vertex to start from.
+/// \return Index of the sink vertex, or kNone if a vertex on the way has
+/// more than one outgoing edge, or if the walk is longer than the number of
+/// vertices, which means that there is a cycle.
+static FrameAttachedToGraph::FrozenType::Index frozenSinkVertex(
+    const FrameAttachedToGraph::FrozenType &_frozen,
+    FrameAttachedToGraph::FrozenType::Index _index)
+{
+  for (std::size_t steps = 0;
+       _index != FrameAttachedToGraph::FrozenType::kNone &&
+       steps <= _frozen.VertexCount(); ++steps)
+  {
+    if (_frozen.OutDegree(_index) == 0)
+      return _index;
+    _index = _frozen.Successor(_index);
+  }
+  return FrameAttachedToGraph::FrozenType::kNone;
+}
+
+/////////////////////////////////////////////////
+/// \brief Same as FindSinkVertex, over the frozen copy of a
+/// FrameAttachedToGraph, which reports the same errors.
+/// \param[in] _frozen Frozen copy of the graph.
+/// \param[in] _id VertexId of the starting vertex.
+/// \param[out] _errors Errors found.
+/// \return Index of the sink vertex, or kNone if a cycle or a vertex with
+/// multiple outgoing edges is detected.
+static FrameAttachedToGraph::FrozenType::Index FindFrozenSinkVertex(
+    const FrameAttachedToGraph::FrozenType &_frozen,
+    const ignition::math::graph::VertexId _id,
+    Errors &_errors)
+{
+  using FrozenType = FrameAttachedToGraph::FrozenType;
+  FrozenType::Index index = _frozen.IndexOf(_id);
+  if (index == FrozenType::kNone)
+  {
+    _errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
+        "Invalid vertex[" + std::to_string(_id) + "] "
+        "in FrameAttachedToGraph."});
+    return FrozenType::kNone;
+  }
+
+  std::set<FrozenType::Index> visited;
+  visited.insert(index);
+  while (_frozen.OutDegree(index) != 0)
+  {
+    if (_frozen.OutDegree(index) != 1)
+    {
+      _errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+          "FrameAttachedToGraph error: multiple outgoing edges from "
+          "current vertex [" + _frozen.Name(index) + "]."});
+      return FrozenType::kNone;
+    }
+    index = _frozen.Successor(index);
+    if (!visited.insert(index).second)
+    {
+      _errors.push_back({ErrorCode::FRAME_ATTACHED_TO_CYCLE,
+          "FrameAttachedToGraph cycle detected, already visited vertex [" +
+          _frozen.Name(index) + "]."});
+      return FrozenType::kNone;
+    }
+  }
+
+  return index;
+}
+
+/////////////////////////////////////////////////
+/// \brief Same as FindSourceVertex, over the frozen copy of a
+/// PoseRelativeToGraph, which reports the same errors and also composes the
+/// poses of the edges leading to the source vertex.
+/// \param[in] _graph Scope of the graph.
+/// \param[in] _frozen Frozen copy of the graph.
+/// \param[in] _id VertexId of the starting vertex.
+/// \param[out] _pose Pose of the starting vertex relative to the source
+/// vertex.
+/// \param[out] _errors Errors found.
+/// \return Index of the source vertex, which is the scope vertex, or kNone
+/// if a cycle, a vertex with multiple incoming edges or another source
+/// vertex is found.
+static PoseRelativeToGraph::FrozenType::Index FindFrozenSourceVertex(
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const PoseRelativeToGraph::FrozenType &_frozen,
+    const ignition::math::graph::VertexId _id,
+    ignition::math::Pose3d &_pose,
+    Errors &_errors)
+{
+  using FrozenType = PoseRelativeToGraph::FrozenType;
+  FrozenType::Index index = _frozen.IndexOf(_id);
+  if (index == FrozenType::kNone)
+  {
+    _errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "Unable to resolve pose, invalid vertex[" + std::to_string(_id) + "] "
+        "in PoseRelativeToGraph."});
+    return FrozenType::kNone;
+  }
+
+  const FrozenType::Index scope = _frozen.IndexOf(_graph.ScopeVertexId());
+  _pose = ignition::math::Pose3d::Zero;
+  std::set<FrozenType::Index> visited;
+  while (index != scope && _frozen.InDegree(index) != 0)
+  {
+    if (_frozen.InDegree(index) != 1)
+    {
+      _errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+          "PoseRelativeToGraph error: multiple incoming edges to "
+          "current vertex [" + _frozen.Name(index) + "]."});
+      return FrozenType::kNone;
+    }
+    visited.insert(index);
+    _pose = _frozen.PredecessorPose(index) * _pose;
+    index = _frozen.Predecessor(index);
+    if (visited.count(index))
+    {
+      _errors.push_back({ErrorCode::POSE_RELATIVE_TO_CYCLE,
+          "PoseRelativeToGraph cycle detected, already visited vertex [" +
+          _frozen.Name(index) + "]."});
+      return FrozenType::kNone;
+    }
+  }
+
+  return index == scope ? index : FrozenType::kNone;
+}
+
 /////////////////////////////////////////////////
 Errors resolveFrameAttachedToBody(
     std::string &_attachedToBody,
@@ -1633,38 +1763,68 @@ Errors resolveFrameAttachedToBody(
     return errors;
   }
 
-  if (_in.Count(_vertexName) != 1)
+  // The map holds each name once, so a name is unique if it is found.
+  const auto vertexId = _in.VertexIdByName(_vertexName);
+  if (vertexId == ignition::math::graph::kNullId)
   {
     errors.push_back({ErrorCode::FRAME_ATTACHED_TO_INVALID,
         "FrameAttachedToGraph unable to find unique frame with name [" +
         _vertexName + "] in graph."});
     return errors;
   }
-  auto vertexId = _in.VertexIdByName(_vertexName);
 
-  auto sinkVertexEdges = FindSinkVertex(_in, vertexId, errors);
-  auto sinkVertex = sinkVertexEdges.first;
-
-  if (!errors.empty())
+  FrameType sinkType;
+  std::string sinkName;
+  if (const auto *frozen = _in.Frozen())
   {
-    return errors;
-  }
+    // Graph errors, including cycles, are left to the walk that reports
+    // them, which is slower.
+    auto sinkIndex = frozenSinkVertex(*frozen, frozen->IndexOf(vertexId));
+    if (sinkIndex == FrameAttachedToGraph::FrozenType::kNone)
+      sinkIndex = FindFrozenSinkVertex(*frozen, vertexId, errors);
 
-  if (!sinkVertex.Valid())
+    if (!errors.empty())
+    {
+      return errors;
+    }
+
+    if (sinkIndex == FrameAttachedToGraph::FrozenType::kNone)
+    {
+      errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+          "FrameAttachedToGraph unable to find sink vertex when starting "
+          "from vertex with name [" + _vertexName + "]."});
+      return errors;
+    }
+    sinkType = frozen->Data(sinkIndex);
+    sinkName = frozen->Name(sinkIndex);
+  }
+  else
   {
-    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
-        "FrameAttachedToGraph unable to find sink vertex when starting "
-        "from vertex with name [" + _vertexName + "]."});
-    return errors;
+    const auto &sinkVertex = FindSinkVertex(_in, vertexId, errors).first;
+
+    if (!errors.empty())
+    {
+      return errors;
+    }
+
+    if (!sinkVertex.Valid())
+    {
+      errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+          "FrameAttachedToGraph unable to find sink vertex when starting "
+          "from vertex with name [" + _vertexName + "]."});
+      return errors;
+    }
+    sinkType = sinkVertex.Data();
+    sinkName = sinkVertex.Name();
   }
 
   if (_in.ScopeContextName() == "world" &&
-      !(sinkVertex.Data() == FrameType::WORLD ||
-          sinkVertex.Data() == FrameType::STATIC_MODEL ||
-          sinkVertex.Data() == FrameType::LINK))
+      !(sinkType == FrameType::WORLD ||
+          sinkType == FrameType::STATIC_MODEL ||
+          sinkType == FrameType::LINK))
   {
     errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
-        "Graph has world scope but sink vertex named [" + sinkVertex.Name() +
+        "Graph has world scope but sink vertex named [" + sinkName +
             "] does not have FrameType WORLD, LINK or STATIC_MODEL "
             "when starting from vertex with name [" +
             _vertexName + "]."});
@@ -1673,8 +1833,7 @@ Errors resolveFrameAttachedToBody(
 
   if (_in.ScopeContextName() == "__model__")
   {
-    if (sinkVertex.Data() == FrameType::MODEL &&
-        sinkVertex.Name() == "__model__")
+    if (sinkType == FrameType::MODEL && sinkName == "__model__")
     {
       errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
           "Graph with __model__ scope has sink vertex named [__model__] "
@@ -1682,18 +1841,18 @@ Errors resolveFrameAttachedToBody(
           "which is not permitted."});
       return errors;
     }
-    else if (sinkVertex.Data() != FrameType::LINK &&
-             sinkVertex.Data() != FrameType::STATIC_MODEL)
+    else if (sinkType != FrameType::LINK &&
+             sinkType != FrameType::STATIC_MODEL)
     {
       errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
           "Graph has __model__ scope but sink vertex named [" +
-          sinkVertex.Name() + "] does not have FrameType LINK or STATIC_MODEL "
+          sinkName + "] does not have FrameType LINK or STATIC_MODEL "
           "when starting from vertex with name [" + _vertexName + "]."});
       return errors;
     }
   }
 
-  _attachedToBody = _in.VertexLocalName(sinkVertex);
+  _attachedToBody = _in.FindAndRemovePrefix(sinkName).first;
 
   return errors;
 }
@@ -1706,7 +1865,9 @@ Errors resolvePoseRelativeToRoot(
 {
   Errors errors;
 
-  if (_graph.Count(_vertexName) != 1)
+  // The map holds each name once, so a name is unique if it is found.
+  const auto vertexId = _graph.VertexIdByName(_vertexName);
+  if (vertexId == ignition::math::graph::kNullId)
   {
     errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
         "PoseRelativeToGraph unable to find unique frame with name [" +
@@ -1714,17 +1875,42 @@ Errors resolvePoseRelativeToRoot(
     return errors;
   }
 
-  return resolvePoseRelativeToRoot(
-      _pose, _graph, _graph.VertexIdByName(_vertexName));
+  return resolvePoseRelativeToRoot(_pose, _graph, vertexId);
 }
+
 /////////////////////////////////////////////////
-Errors resolvePoseRelativeToRoot(
+/// \brief Resolve pose of a vertex relative to the scope vertex by walking
+/// all the way to it, without using the memoized poses.
+/// \param[out] _pose Pose object to write.
+/// \param[in] _graph PoseRelativeToGraph to read from.
+/// \param[in] _vertexId Id of vertex whose pose is to be computed.
+/// \return Errors.
+static Errors resolvePoseRelativeToRootUncached(
       ignition::math::Pose3d &_pose,
       const ScopedGraph<PoseRelativeToGraph> &_graph,
       const ignition::math::graph::VertexId &_vertexId)
 {
   Errors errors;
 
+  if (const auto *frozen = _graph.Frozen())
+  {
+    ignition::math::Pose3d pose;
+    const auto source =
+        FindFrozenSourceVertex(_graph, *frozen, _vertexId, pose, errors);
+    if (errors.empty() && source == PoseRelativeToGraph::FrozenType::kNone)
+    {
+      errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+          "PoseRelativeToGraph unable to find path to source vertex "
+          "when starting from vertex with id [" +
+              std::to_string(_vertexId) + "]."});
+    }
+    if (errors.empty())
+    {
+      _pose = pose;
+    }
+    return errors;
+  }
+
   auto incomingVertexEdges = FindSourceVertex(_graph, _vertexId, errors);
 
   if (!errors.empty())
@@ -1763,6 +1949,98 @@ Errors resolvePoseRelativeToRoot(
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the poses memoized in a scope, discarding them first if the
+/// graph changed since they were resolved.
+/// \param[in] _graph Scope of a PoseRelativeToGraph.
+/// \param[in] _lock Lock of the mutex of the poses, which must be held.
+/// \return The memoized poses.
+static std::unordered_map<ignition::math::graph::VertexId,
+                          ignition::math::Pose3d> &
+memoizedPoses(const ScopedGraph<PoseRelativeToGraph> &_graph,
+              const std::lock_guard<std::mutex> &/*_lock*/)
+{
+  ScopedPoseCache &cache = _graph.PoseCache();
+  if (cache.graphVersion != _graph.GraphVersion())
+  {
+    cache.poses.clear();
+    cache.graphVersion = _graph.GraphVersion();
+  }
+  return cache.poses;
+}
+
+/////////////////////////////////////////////////
+Errors resolvePoseRelativeToRoot(
+      ignition::math::Pose3d &_pose,
+      const ScopedGraph<PoseRelativeToGraph> &_graph,
+      const ignition::math::graph::VertexId &_vertexId)
+{
+  using VertexId = ignition::math::graph::VertexId;
+  using FrozenType = PoseRelativeToGraph::FrozenType;
+  const FrozenType *frozen = _graph.Frozen();
+  if (frozen ? frozen->IndexOf(_vertexId) == FrozenType::kNone :
+      !_graph.Graph().VertexFromId(_vertexId).Valid())
+  {
+    return resolvePoseRelativeToRootUncached(_pose, _graph, _vertexId);
+  }
+
+  std::lock_guard<std::mutex> lock(_graph.PoseCache().mutex);
+  auto &poses = memoizedPoses(_graph, lock);
+
+  // Walk up from the vertex to the scope vertex, or to the first vertex
+  // whose pose is memoized, collecting the poses of the edges on the way.
+  // The frozen copy of the graph is walked if it is up to date. Graph
+  // errors, including cycles, which would make the walk longer than the
+  // number of vertices, are left to the uncached walk to report.
+  ignition::math::Pose3d pose;
+  std::vector<std::pair<VertexId, ignition::math::Pose3d>> path;
+  const std::size_t vertexCount =
+      frozen ? frozen->VertexCount() : _graph.Map().size();
+  for (VertexId id = _vertexId; id != _graph.ScopeVertexId();)
+  {
+    auto memoized = poses.find(id);
+    if (memoized != poses.end())
+    {
+      pose = memoized->second;
+      break;
+    }
+
+    if (path.size() > vertexCount)
+      return resolvePoseRelativeToRootUncached(_pose, _graph, _vertexId);
+
+    if (frozen)
+    {
+      const auto index = frozen->IndexOf(id);
+      const auto parent = frozen->Predecessor(index);
+      if (parent == FrozenType::kNone)
+        return resolvePoseRelativeToRootUncached(_pose, _graph, _vertexId);
+
+      path.emplace_back(id, frozen->PredecessorPose(index));
+      id = frozen->Id(parent);
+    }
+    else
+    {
+      const auto incidentsTo = _graph.Graph().IncidentsTo(id);
+      if (incidentsTo.size() != 1)
+        return resolvePoseRelativeToRootUncached(_pose, _graph, _vertexId);
+
+      const auto &edge = incidentsTo.begin()->second.get();
+      path.emplace_back(id, edge.Data());
+      id = edge.Tail();
+    }
+  }
+
+  // Compose the poses down from the scope vertex, memoizing each of them.
+  for (auto it = path.rbegin(); it != path.rend(); ++it)
+  {
+    pose = pose * it->second;
+    poses[it->first] = pose;
+  }
+
+  _pose = pose;
+  return Errors();
+}
+
 /////////////////////////////////////////////////
 Errors resolvePose(ignition::math::Pose3d &_pose,
     const ScopedGraph<PoseRelativeToGraph> &_graph,
@@ -1796,14 +2074,16 @@ Errors resolvePose(
     const std::string &_resolveTo)
 {
   Errors errors;
-  if (_graph.Count(_frameName) != 1)
+  const auto frameVertexId = _graph.VertexIdByName(_frameName);
+  if (frameVertexId == ignition::math::graph::kNullId)
   {
     errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
         "PoseRelativeToGraph unable to find unique frame with name [" +
         _frameName + "] in graph."});
     return errors;
   }
-  if (_graph.Count(_resolveTo) != 1)
+  const auto resolveToVertexId = _graph.VertexIdByName(_resolveTo);
+  if (resolveToVertexId == ignition::math::graph::kNullId)
   {
     errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
         "PoseRelativeToGraph unable to find unique frame with name [" +
@@ -1811,8 +2091,69 @@ Errors resolvePose(
     return errors;
   }
 
-  return resolvePose(_pose, _graph, _graph.VertexIdByName(_frameName),
-      _graph.VertexIdByName(_resolveTo));
+  return resolvePose(_pose, _graph, frameVertexId, resolveToVertexId);
+}
+
+/////////////////////////////////////////////////
+Errors resolveAllPoses(
+    std::map<std::string, ignition::math::Pose3d> &_poses,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const std::string &_resolveTo)
+{
+  using VertexId = ignition::math::graph::VertexId;
+  Errors errors;
+
+  const VertexId resolveToVertexId = _graph.VertexIdByName(_resolveTo);
+  if (resolveToVertexId == ignition::math::graph::kNullId)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "PoseRelativeToGraph unable to find unique frame with name [" +
+        _resolveTo + "] in graph."});
+    return errors;
+  }
+
+  ignition::math::Pose3d resolveToPose;
+  errors = resolvePoseRelativeToRoot(resolveToPose, _graph, resolveToVertexId);
+  if (!errors.empty())
+    return errors;
+  const ignition::math::Pose3d resolveToInverse = resolveToPose.Inverse();
+
+  // The vertices of the scope are those whose names start with its prefix,
+  // which sort together in the map and in the frozen copy. Their local names
+  // keep that order, so each pose is added at the end of _poses when it
+  // starts empty. Each vertex is resolved from the memoized pose of its
+  // parent, which makes the whole pass linear in the number of vertices.
+  const std::string prefix = _graph.AddPrefix("");
+  auto resolveVertex = [&](const std::string &_absoluteName, VertexId _id)
+  {
+    const std::string name = _graph.FindAndRemovePrefix(_absoluteName).first;
+    if (name == "__root__")
+      return;
+
+    ignition::math::Pose3d pose;
+    Errors poseErrors = resolvePoseRelativeToRoot(pose, _graph, _id);
+    if (poseErrors.empty())
+      _poses.insert_or_assign(_poses.end(), name, resolveToInverse * pose);
+    else
+      errors.insert(errors.end(), poseErrors.begin(), poseErrors.end());
+  };
+
+  if (const auto *frozen = _graph.Frozen())
+  {
+    for (const auto index : frozen->FindPrefixed(prefix))
+      resolveVertex(frozen->Name(index), frozen->Id(index));
+    return errors;
+  }
+
+  const auto &map = _graph.Map();
+  for (auto it = map.lower_bound(prefix);
+       it != map.end() && 0 == it->first.compare(0, prefix.size(), prefix);
+       ++it)
+  {
+    resolveVertex(it->first, it->second);
+  }
+
+  return errors;
 }
 }
 }
@@ -17,8 +17,11 @@
 #ifndef SDF_FRAMESEMANTICS_HH_
 #define SDF_FRAMESEMANTICS_HH_
 
+#include <atomic>
+#include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <ignition/math/Pose3.hh>
@@ -27,6 +30,7 @@
 #include "sdf/Error.hh"
 #include "sdf/InterfaceModel.hh"
 #include "sdf/Types.hh"
+#include "FrozenGraph.hh"
 
 /// \ingroup sdf_frame_semantics
 /// \brief namespace for Simulation Description Format Frame Semantics Utilities
@@ -88,6 +92,24 @@ namespace sdf
 
     /// \brief Name of scope vertex, either __model__ or world.
     std::string scopeName;
+
+    /// \brief Incremented by ScopedGraph each time a vertex or edge is added
+    /// or updated, so that data derived from the graph can tell that it is
+    /// out of date.
+    std::size_t version = 0;
+
+    /// \brief Compact copy of the graph made by ScopedGraph::Freeze, which
+    /// is used while its version matches that of the graph, and released
+    /// when the graph changes.
+    using FrozenType = FrozenGraph<FrameType, bool>;
+    std::shared_ptr<const FrozenType> frozen;
+
+    /// \brief True while graph and map are released by ScopedGraph::Freeze,
+    /// in which case they are rebuilt from frozen when they are read again.
+    std::atomic<bool> released{false};
+
+    /// \brief Guards the rebuilding of graph and map.
+    std::mutex releaseMutex;
   };
 
   /// \brief Data structure for pose relative_to graphs for Model or World.
@@ -108,6 +130,24 @@ namespace sdf
 
     /// \brief Name of source vertex, either __model__ or world.
     std::string sourceName;
+
+    /// \brief Incremented by ScopedGraph each time a vertex or edge is added
+    /// or updated, so that poses memoized by resolvePoseRelativeToRoot can
+    /// be discarded.
+    std::size_t version = 0;
+
+    /// \brief Compact copy of the graph made by ScopedGraph::Freeze, which
+    /// is used while its version matches that of the graph, and released
+    /// when the graph changes.
+    using FrozenType = FrozenGraph<FrameType, Pose3d>;
+    std::shared_ptr<const FrozenType> frozen;
+
+    /// \brief True while graph and map are released by ScopedGraph::Freeze,
+    /// in which case they are rebuilt from frozen when they are read again.
+    std::atomic<bool> released{false};
+
+    /// \brief Guards the rebuilding of graph and map.
+    std::mutex releaseMutex;
   };
 
   /// \brief Build a FrameAttachedToGraph for a model.
@@ -186,7 +226,11 @@ namespace sdf
       const std::string &_vertexName);
 
   /// \brief Resolve pose of a vertex relative to its outgoing ancestor
-  /// (analog of the root of a tree).
+  /// (analog of the root of a tree). The poses of the vertex and of the
+  /// vertices between it and the scope vertex are memoized in the scope, so
+  /// that resolving them again, or resolving vertices below them, only
+  /// composes the poses of the edges that were not visited yet. Changing
+  /// the graph through any of its scopes discards the memoized poses.
   /// \param[out] _pose Pose object to write.
   /// \param[in] _graph PoseRelativeToGraph to read from.
   /// \param[in] _vertexName Name of vertex whose pose is to be computed.
@@ -233,6 +277,22 @@ namespace sdf
       const ScopedGraph<PoseRelativeToGraph> &_graph,
       const ignition::math::graph::VertexId &_frameVertexId,
       const ignition::math::graph::VertexId &_resolveToVertexId);
+
+  /// \brief Resolve the pose of every vertex in the scope of a
+  /// PoseRelativeToGraph relative to a named frame. The poses are computed
+  /// in one pass over the vertices, each from the memoized pose of its
+  /// parent, and stay memoized for resolvePoseRelativeToRoot.
+  /// \param[out] _poses Poses of the vertices, keyed by their local names.
+  /// Vertices whose pose cannot be resolved are left out.
+  /// \param[in] _graph PoseRelativeToGraph to read from.
+  /// \param[in] _resolveTo Name of frame relative to which the poses are
+  /// resolved.
+  /// \return Errors, which are the same as those resolvePose returns for
+  /// each of the vertices.
+  Errors resolveAllPoses(
+      std::map<std::string, ignition::math::Pose3d> &_poses,
+      const ScopedGraph<PoseRelativeToGraph> &_graph,
+      const std::string &_resolveTo);
   }
 }
 #endif
@@ -15,8 +15,11 @@
  *
  */
 
+#include <iomanip>
+#include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <ignition/math/Helpers.hh>
@@ -297,6 +300,270 @@ TEST(FrameSemantics, buildPoseRelativeToGraph)
         "invalid] in graph."));
 }
 
+/////////////////////////////////////////////////
+TEST(FrameSemantics, resolveAllPoses)
+{
+  const std::string testFile =
+    sdf::testing::TestFile("sdf", "model_frame_relative_to_joint.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::Model *model = root.Model();
+
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(graph, model).empty());
+  graph = graph.ChildModelScope(model->Name());
+
+  // Every frame is resolved, with the same pose as resolvePose gives.
+  for (const std::string resolveTo : {"__model__", "C", "F3"})
+  {
+    std::map<std::string, ignition::math::Pose3d> poses;
+    EXPECT_TRUE(sdf::resolveAllPoses(poses, graph, resolveTo).empty());
+    EXPECT_EQ(graph.VertexNames().size(), poses.size());
+    for (const auto &name : graph.VertexNames())
+    {
+      ignition::math::Pose3d pose;
+      EXPECT_TRUE(sdf::resolvePose(pose, graph, name, resolveTo).empty());
+      ASSERT_EQ(1u, poses.count(name)) << name;
+      EXPECT_EQ(pose, poses[name]) << name << " in " << resolveTo;
+    }
+  }
+  std::map<std::string, ignition::math::Pose3d> poses;
+  auto errors = sdf::resolveAllPoses(poses, graph, "invalid");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  EXPECT_TRUE(poses.empty());
+
+  // Updating an edge discards the memoized poses of every scope.
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "F4").empty());
+  EXPECT_EQ(ignition::math::Pose3d(6, 3, 3, 0, 0, 0), pose);
+  auto edge = graph.Graph().IncidentsTo(graph.VertexIdByName("F3"))
+      .begin()->second.get();
+  graph.RootScope().UpdateEdge(edge, ignition::math::Pose3d(0, 0, 4, 0, 0, 0));
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "F3").empty());
+  EXPECT_EQ(ignition::math::Pose3d(2, 3, 4, 0, 0, 0), pose);
+  const auto f4Edge = graph.Graph().IncidentsTo(graph.VertexIdByName("F4"))
+      .begin()->second.get().Data();
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "F4").empty());
+  EXPECT_EQ(ignition::math::Pose3d(2, 3, 4, 0, 0, 0) * f4Edge, pose);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, resolveAllPosesErrors)
+{
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  graph = graph.AddScopeVertex(
+      "", "__model__", "__model__", sdf::FrameType::MODEL);
+  const auto modelId = graph.ScopeVertexId();
+  const auto aId = graph.AddVertex("A", sdf::FrameType::FRAME).Id();
+  const auto bId = graph.AddVertex("B", sdf::FrameType::FRAME).Id();
+  const auto cId = graph.AddVertex("C", sdf::FrameType::FRAME).Id();
+  graph.AddEdge({modelId, aId}, ignition::math::Pose3d(1, 0, 0, 0, 0, 0));
+  graph.AddEdge({aId, cId}, ignition::math::Pose3d(0, 1, 0, 0, 0, 0));
+
+  // B has two incoming edges, and C is then memoized before the graph
+  // changes again.
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "C").empty());
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0), pose);
+  graph.AddEdge({modelId, bId}, ignition::math::Pose3d(0, 0, 1, 0, 0, 0));
+  graph.AddEdge({aId, bId}, ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+
+  sdf::Errors expected;
+  EXPECT_FALSE(sdf::resolvePoseRelativeToRoot(pose, graph, "B").empty());
+  expected = sdf::resolvePose(pose, graph, "B", "__model__");
+  ASSERT_EQ(1u, expected.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, expected[0].Code());
+
+  std::map<std::string, ignition::math::Pose3d> poses;
+  auto errors = sdf::resolveAllPoses(poses, graph, "__model__");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(expected[0].Code(), errors[0].Code());
+  EXPECT_EQ(expected[0].Message(), errors[0].Message());
+  ASSERT_EQ(3u, poses.size());
+  EXPECT_EQ(ignition::math::Pose3d::Zero, poses["__model__"]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 0, 0, 0, 0), poses["A"]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0), poses["C"]);
+
+  // A cycle that does not reach the scope vertex.
+  const auto dId = graph.AddVertex("D", sdf::FrameType::FRAME).Id();
+  const auto eId = graph.AddVertex("E", sdf::FrameType::FRAME).Id();
+  graph.AddEdge({dId, eId}, ignition::math::Pose3d::Zero);
+  graph.AddEdge({eId, dId}, ignition::math::Pose3d::Zero);
+  errors = sdf::resolvePoseRelativeToRoot(pose, graph, "E");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  poses.clear();
+  EXPECT_EQ(3u, sdf::resolveAllPoses(poses, graph, "A").size());
+  EXPECT_EQ(3u, poses.size());
+  EXPECT_EQ(ignition::math::Pose3d(0, 1, 0, 0, 0, 0), poses["C"]);
+}
+
+/////////////////////////////////////////////////
+TEST(FrameSemantics, Freeze)
+{
+  const std::string testFile =
+    sdf::testing::TestFile("sdf", "model_nested_frame_attached_to.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::Model *model = root.Model();
+
+  auto frameGraph = sdf::ScopedGraph<sdf::FrameAttachedToGraph>(
+      std::make_shared<sdf::FrameAttachedToGraph>());
+  EXPECT_TRUE(sdf::buildFrameAttachedToGraph(frameGraph, model).empty());
+  auto poseGraph = sdf::ScopedGraph<sdf::PoseRelativeToGraph>(
+      std::make_shared<sdf::PoseRelativeToGraph>());
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(poseGraph, model).empty());
+  EXPECT_EQ(nullptr, frameGraph.Frozen());
+  EXPECT_EQ(nullptr, poseGraph.Frozen());
+
+  // Record the results of the lookups before the graphs are frozen.
+  const std::vector<std::string> names =
+      frameGraph.ChildModelScope(model->Name()).VertexNames();
+  const std::vector<std::string> scopes =
+      {model->Name(), model->Name() + "::M1"};
+  auto lookUp = [&]()
+  {
+    std::vector<std::string> out;
+    for (const auto &scope : scopes)
+    {
+      const auto frameScope = frameGraph.ChildModelScope(scope);
+      const auto poseScope = poseGraph.ChildModelScope(scope);
+      for (const auto &name : names)
+      {
+        for (const auto &queried : {name, name + "x", "M1::" + name})
+        {
+          out.push_back(queried + ": " +
+              std::to_string(frameScope.VertexIdByName(queried)) + " " +
+              std::to_string(frameScope.Count(queried)) + " " +
+              std::to_string(poseScope.VertexIdByName(queried)));
+
+          std::string body;
+          const auto errors =
+              sdf::resolveFrameAttachedToBody(body, frameScope, queried);
+          out.push_back(body);
+          for (const auto &error : errors)
+            out.push_back(error.Message());
+
+          ignition::math::Pose3d pose;
+          for (const auto &error :
+               sdf::resolvePose(pose, poseScope, queried, "__model__"))
+          {
+            out.push_back(error.Message());
+          }
+          std::ostringstream poseStream;
+          poseStream << std::fixed << std::setprecision(9) << pose;
+          out.push_back(poseStream.str());
+        }
+      }
+    }
+    return out;
+  };
+  const std::vector<std::string> expected = lookUp();
+  std::map<std::string, ignition::math::Pose3d> expectedPoses;
+  EXPECT_TRUE(sdf::resolveAllPoses(expectedPoses,
+      poseGraph.ChildModelScope(model->Name()), "__model__").empty());
+  EXPECT_FALSE(expectedPoses.empty());
+  const auto expectedMap = frameGraph.Map();
+  const auto expectedVertexCount = poseGraph.Graph().Vertices().size();
+
+  frameGraph.Freeze();
+  poseGraph.Freeze();
+  ASSERT_NE(nullptr, frameGraph.Frozen());
+  ASSERT_NE(nullptr, poseGraph.ChildModelScope(model->Name()).Frozen());
+  EXPECT_EQ(expected, lookUp());
+  std::map<std::string, ignition::math::Pose3d> poses;
+  EXPECT_TRUE(sdf::resolveAllPoses(poses,
+      poseGraph.ChildModelScope(model->Name()), "__model__").empty());
+  EXPECT_EQ(expectedPoses, poses);
+
+  // The graphs and maps that freezing released are rebuilt when they are
+  // read again, and the frozen copies are kept.
+  EXPECT_EQ(expectedMap, frameGraph.Map());
+  EXPECT_EQ(expectedVertexCount, poseGraph.Graph().Vertices().size());
+  EXPECT_TRUE(sdf::validateFrameAttachedToGraph(frameGraph).empty());
+  EXPECT_TRUE(sdf::validatePoseRelativeToGraph(poseGraph).empty());
+  ASSERT_NE(nullptr, frameGraph.Frozen());
+  ASSERT_NE(nullptr, poseGraph.Frozen());
+  frameGraph.Freeze();
+  EXPECT_EQ(expected, lookUp());
+
+  // Changing the graph through any scope discards the frozen copy.
+  auto modelScope = frameGraph.ChildModelScope(model->Name());
+  const auto id = modelScope.AddVertex("F5", sdf::FrameType::FRAME).Id();
+  EXPECT_EQ(nullptr, frameGraph.Frozen());
+  EXPECT_EQ(id, modelScope.VertexIdByName("F5"));
+  EXPECT_EQ(1u, modelScope.Count("F5"));
+  frameGraph.Freeze();
+  ASSERT_NE(nullptr, frameGraph.Frozen());
+  EXPECT_EQ(id, modelScope.VertexIdByName("F5"));
+
+  // Graph errors found over a frozen graph are the same.
+  const auto f6 = modelScope.AddVertex("F6", sdf::FrameType::FRAME).Id();
+  const auto f7 = modelScope.AddVertex("F7", sdf::FrameType::FRAME).Id();
+  modelScope.AddEdge({id, f6}, true);
+  modelScope.AddEdge({f6, f7}, true);
+  modelScope.AddEdge({f7, f6}, true);
+  const auto f8 = modelScope.AddVertex("F8", sdf::FrameType::FRAME).Id();
+  modelScope.AddEdge({f8, modelScope.VertexIdByName("L")}, true);
+  modelScope.AddEdge({f8, modelScope.VertexIdByName("M1::L")}, true);
+  auto errorMessages = [&]()
+  {
+    std::vector<std::string> out;
+    for (const std::string name : {"F5", "F7", "F8"})
+    {
+      std::string body;
+      for (const auto &error :
+           sdf::resolveFrameAttachedToBody(body, modelScope, name))
+      {
+        out.push_back(error.Message());
+      }
+    }
+    return out;
+  };
+  EXPECT_EQ(nullptr, frameGraph.Frozen());
+  const std::vector<std::string> expectedErrors = errorMessages();
+  EXPECT_EQ(3u, expectedErrors.size());
+  frameGraph.Freeze();
+  ASSERT_NE(nullptr, frameGraph.Frozen());
+  EXPECT_EQ(expectedErrors, errorMessages());
+
+  auto poseScope = poseGraph.ChildModelScope(model->Name());
+  const auto p1 = poseScope.AddVertex("P1", sdf::FrameType::FRAME).Id();
+  const auto p2 = poseScope.AddVertex("P2", sdf::FrameType::FRAME).Id();
+  const auto p3 = poseScope.AddVertex("P3", sdf::FrameType::FRAME).Id();
+  poseScope.AddVertex("P4", sdf::FrameType::FRAME);
+  const ignition::math::Pose3d offset(0, 0, 1, 0, 0, 0);
+  poseScope.AddEdge({p1, p2}, offset);
+  poseScope.AddEdge({p2, p1}, offset);
+  poseScope.AddEdge({p1, p3}, offset);
+  poseScope.AddEdge({p2, p3}, offset);
+  auto poseErrorMessages = [&]()
+  {
+    std::vector<std::string> out;
+    for (const std::string name : {"P1", "P3", "P4"})
+    {
+      ignition::math::Pose3d pose;
+      for (const auto &error :
+           sdf::resolvePoseRelativeToRoot(pose, poseScope, name))
+      {
+        out.push_back(error.Message());
+      }
+    }
+    return out;
+  };
+  EXPECT_EQ(nullptr, poseGraph.Frozen());
+  const std::vector<std::string> expectedPoseErrors = poseErrorMessages();
+  EXPECT_EQ(3u, expectedPoseErrors.size());
+  poseGraph.Freeze();
+  ASSERT_NE(nullptr, poseGraph.Frozen());
+  EXPECT_EQ(expectedPoseErrors, poseErrorMessages());
+}
+
 /////////////////////////////////////////////////
 TEST(NestedFrameSemantics, buildFrameAttachedToGraph_Model)
 {
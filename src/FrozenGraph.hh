@@ -0,0 +1,580 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDFORMAT_FROZENGRAPH_HH
+#define SDFORMAT_FROZENGRAPH_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/graph/Graph.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief A read-only copy of a FrameAttachedToGraph or PoseRelativeToGraph
+/// in compressed sparse row form, for the lookups and walks that follow
+/// loading.
+///
+/// Vertices are numbered by index from 0 in the order of their IDs, and
+/// their data, names and edges are kept in contiguous arrays. The incoming
+/// and outgoing edges of a vertex are stored as ranges of indices, and the
+/// poses of the incoming edges of a PoseRelativeToGraph are stored as one
+/// array per component. Names are found through an open addressing hash
+/// table that hashes the prefix of a scope and a local name one after the
+/// other, so that no absolute name has to be built for a lookup.
+///
+/// The copy records the version of the graph it was made from, and is only
+/// used while the graph keeps that version. It holds everything needed to
+/// rebuild the graph and the map, so that they can be released once the copy
+/// is made, see Thaw.
+/// \tparam V Vertex data type.
+/// \tparam E Edge data type.
+template <typename V, typename E>
+class FrozenGraph
+{
+  /// \brief Type of the graph that is copied.
+  public: using GraphType = ignition::math::graph::DirectedGraph<V, E>;
+
+  /// \brief Type of the map from absolute names to vertex IDs.
+  public: using MapType =
+              std::map<std::string, ignition::math::graph::VertexId>;
+
+  /// \brief Vertex ID type.
+  public: using VertexId = ignition::math::graph::VertexId;
+
+  /// \brief Vertex index type.
+  public: using Index = std::uint32_t;
+
+  /// \brief Index that stands for no vertex.
+  public: static constexpr Index kNone = std::numeric_limits<Index>::max();
+
+  /// \brief Copy a graph.
+  /// \param[in] _graph Graph to copy.
+  /// \param[in] _map Map from absolute names to the IDs of its vertices.
+  /// \param[in] _version Version of the graph.
+  public: FrozenGraph(const GraphType &_graph, const MapType &_map,
+                      std::size_t _version);
+
+  /// \brief Get the version of the graph that was copied.
+  /// \return The version.
+  public: std::size_t Version() const;
+
+  /// \brief Get the number of vertices.
+  /// \return The number of vertices.
+  public: std::size_t VertexCount() const;
+
+  /// \brief Get the index of a vertex.
+  /// \param[in] _id ID of the vertex.
+  /// \return The index, or kNone if the graph has no vertex with the ID.
+  public: Index IndexOf(VertexId _id) const;
+
+  /// \brief Get the ID of a vertex.
+  /// \param[in] _index Index of the vertex.
+  /// \return The ID.
+  public: VertexId Id(Index _index) const;
+
+  /// \brief Get the data of a vertex.
+  /// \param[in] _index Index of the vertex.
+  /// \return The data.
+  public: const V &Data(Index _index) const;
+
+  /// \brief Get the name of a vertex.
+  /// \param[in] _index Index of the vertex.
+  /// \return The absolute name.
+  public: std::string Name(Index _index) const;
+
+  /// \brief Get the number of edges that point to a vertex.
+  /// \param[in] _index Index of the vertex.
+  /// \return The number of incoming edges.
+  public: std::size_t InDegree(Index _index) const;
+
+  /// \brief Get the number of edges that start at a vertex.
+  /// \param[in] _index Index of the vertex.
+  /// \return The number of outgoing edges.
+  public: std::size_t OutDegree(Index _index) const;
+
+  /// \brief Get the vertex at the tail of the only edge that points to a
+  /// vertex, which is its parent in a PoseRelativeToGraph.
+  /// \param[in] _index Index of the vertex.
+  /// \return The index of the tail vertex, or kNone if the vertex does not
+  /// have exactly one incoming edge.
+  public: Index Predecessor(Index _index) const;
+
+  /// \brief Get the vertex at the head of the only edge that starts at a
+  /// vertex, which is the frame it is attached to in a FrameAttachedToGraph.
+  /// \param[in] _index Index of the vertex.
+  /// \return The index of the head vertex, or kNone if the vertex does not
+  /// have exactly one outgoing edge.
+  public: Index Successor(Index _index) const;
+
+  /// \brief Get the pose of the only edge that points to a vertex of a
+  /// PoseRelativeToGraph.
+  /// \param[in] _index Index of the vertex, which must have a predecessor.
+  /// \return The pose of the vertex relative to its predecessor.
+  public: ignition::math::Pose3d PredecessorPose(Index _index) const;
+
+  /// \brief Find a vertex by name.
+  /// \param[in] _prefix Prefix of the scope, which may be empty.
+  /// \param[in] _name Local name of the vertex in the scope.
+  /// \return The index of the vertex whose absolute name is _name, or
+  /// _prefix::_name if _prefix is not empty, or kNone if there is none.
+  public: Index Find(const std::string &_prefix,
+                     const std::string &_name) const;
+
+  /// \brief Get the vertices that the map referred to whose absolute names
+  /// start with a prefix.
+  /// \param[in] _prefix Prefix, which may be empty.
+  /// \return The indices of the vertices, in the order of their names.
+  public: std::vector<Index> FindPrefixed(const std::string &_prefix) const;
+
+  /// \brief Rebuild the graph and the map that were copied. The vertices
+  /// keep their IDs, while the edges are added in the order of their head
+  /// vertices and therefore get new IDs.
+  /// \param[out] _graph Empty graph to add the vertices and edges to.
+  /// \param[out] _map Empty map to add the names to.
+  public: void Thaw(GraphType &_graph, MapType &_map) const;
+
+  /// \brief Get the number of bytes allocated for the copy.
+  /// \return The number of bytes.
+  public: std::size_t MemoryUsage() const;
+
+  /// \brief Hash of a name, which is updated one part of the name at a time
+  /// with 64-bit FNV-1a.
+  /// \param[in] _hash Hash of the preceding parts, or kHashBasis.
+  /// \param[in] _part Next part of the name.
+  /// \return The hash including _part.
+  private: static std::uint64_t Hash(std::uint64_t _hash,
+                                     const std::string &_part);
+
+  /// \brief Check whether the name of a vertex is _prefix::_name, or _name
+  /// if _prefix is empty.
+  /// \param[in] _index Index of the vertex.
+  /// \param[in] _prefix Prefix of the scope.
+  /// \param[in] _name Local name.
+  /// \return True if the names match.
+  private: bool NameEquals(Index _index, const std::string &_prefix,
+                           const std::string &_name) const;
+
+  /// \brief Get the pose of an edge of a PoseRelativeToGraph.
+  /// \param[in] _edge Position of the edge in tails.
+  /// \return The pose.
+  private: ignition::math::Pose3d EdgePose(Index _edge) const;
+
+  /// \brief Hash of an empty name.
+  private: static constexpr std::uint64_t kHashBasis =
+               14695981039346656037ull;
+
+  /// \brief Version of the graph that was copied.
+  private: std::size_t version;
+
+  /// \brief ID of each vertex.
+  private: std::vector<VertexId> ids;
+
+  /// \brief Index of each vertex ID, for the IDs from 0 to the largest.
+  private: std::vector<Index> indices;
+
+  /// \brief Data of each vertex.
+  private: std::vector<V> data;
+
+  /// \brief Absolute names of the vertices, one after the other.
+  private: std::string names;
+
+  /// \brief Offset of the name of each vertex in names, followed by the
+  /// size of names.
+  private: std::vector<Index> nameOffsets;
+
+  /// \brief Hash table slots, which hold vertex indices or kNone.
+  private: std::vector<Index> slots;
+
+  /// \brief Indices of the vertices that the map referred to, in the order
+  /// of their names.
+  private: std::vector<Index> byName;
+
+  /// \brief Offset of the incoming edges of each vertex in tails, followed
+  /// by the number of edges.
+  private: std::vector<Index> inOffsets;
+
+  /// \brief Tail vertex of each edge, grouped by head vertex.
+  private: std::vector<Index> tails;
+
+  /// \brief Offset of the outgoing edges of each vertex in heads, followed
+  /// by the number of edges.
+  private: std::vector<Index> outOffsets;
+
+  /// \brief Head vertex of each edge, grouped by tail vertex.
+  private: std::vector<Index> heads;
+
+  /// \brief Position and rotation components of the pose of each edge,
+  /// in the order of tails. Empty unless the edges hold poses.
+  private: std::vector<double> posX, posY, posZ, rotW, rotX, rotY, rotZ;
+
+  /// \brief Data of each edge, in the order of tails. Empty if the edges
+  /// hold poses, which are kept by component instead.
+  private: std::vector<E> edgeData;
+
+  /// \brief Position in tails and weight of each edge whose weight is not
+  /// 1, such as the alias edges of a FrameAttachedToGraph.
+  private: std::vector<std::pair<Index, double>> weights;
+};
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+FrozenGraph<V, E>::FrozenGraph(const GraphType &_graph, const MapType &_map,
+    std::size_t _version)
+    : version(_version)
+{
+  // The vertex maps of the graph are sorted by ID.
+  const auto vertices = _graph.Vertices();
+  this->ids.reserve(vertices.size());
+  this->data.reserve(vertices.size());
+  this->nameOffsets.reserve(vertices.size() + 1);
+  for (const auto &[id, vertex] : vertices)
+  {
+    if (id >= this->indices.size())
+      this->indices.resize(id + 1, kNone);
+    this->indices[id] = static_cast<Index>(this->ids.size());
+    this->ids.push_back(id);
+    this->data.push_back(vertex.get().Data());
+    this->nameOffsets.push_back(static_cast<Index>(this->names.size()));
+    this->names += vertex.get().Name();
+  }
+  this->nameOffsets.push_back(static_cast<Index>(this->names.size()));
+  const std::size_t vertexCount = this->ids.size();
+
+  // Only the names in the map are hashed, since the map holds the vertex
+  // that a name refers to when several vertices have the same name.
+  std::size_t slotCount = 1;
+  while (slotCount < 2 * _map.size())
+    slotCount *= 2;
+  this->slots.assign(slotCount, kNone);
+  this->byName.reserve(_map.size());
+  for (const auto &[name, id] : _map)
+  {
+    const Index index = this->IndexOf(id);
+    if (index == kNone)
+      continue;
+    this->byName.push_back(index);
+    std::size_t slot = Hash(kHashBasis, name) & (slotCount - 1);
+    while (this->slots[slot] != kNone)
+      slot = (slot + 1) & (slotCount - 1);
+    this->slots[slot] = index;
+  }
+  // Edges, grouped by head and by tail vertex.
+  const auto edges = _graph.Edges();
+  this->inOffsets.assign(vertexCount + 1, 0);
+  this->outOffsets.assign(vertexCount + 1, 0);
+  for (const auto &[edgeId, edge] : edges)
+  {
+    ++this->inOffsets[this->IndexOf(edge.get().Head()) + 1];
+    ++this->outOffsets[this->IndexOf(edge.get().Tail()) + 1];
+  }
+  for (std::size_t i = 0; i < vertexCount; ++i)
+  {
+    this->inOffsets[i + 1] += this->inOffsets[i];
+    this->outOffsets[i + 1] += this->outOffsets[i];
+  }
+  this->tails.resize(edges.size());
+  this->heads.resize(edges.size());
+  constexpr bool kPoses = std::is_same_v<E, ignition::math::Pose3d>;
+  if constexpr (kPoses)
+  {
+    for (auto *component : {&this->posX, &this->posY, &this->posZ,
+                            &this->rotW, &this->rotX, &this->rotY,
+                            &this->rotZ})
+    {
+      component->resize(edges.size());
+    }
+  }
+  else
+  {
+    this->edgeData.resize(edges.size());
+  }
+  std::vector<Index> inNext(this->inOffsets.begin(),
+                            this->inOffsets.end() - 1);
+  std::vector<Index> outNext(this->outOffsets.begin(),
+                             this->outOffsets.end() - 1);
+  for (const auto &[edgeId, edge] : edges)
+  {
+    const Index head = this->IndexOf(edge.get().Head());
+    const Index tail = this->IndexOf(edge.get().Tail());
+    const Index in = inNext[head]++;
+    this->tails[in] = tail;
+    this->heads[outNext[tail]++] = head;
+    if constexpr (kPoses)
+    {
+      const auto &pose = edge.get().Data();
+      this->posX[in] = pose.Pos().X();
+      this->posY[in] = pose.Pos().Y();
+      this->posZ[in] = pose.Pos().Z();
+      this->rotW[in] = pose.Rot().W();
+      this->rotX[in] = pose.Rot().X();
+      this->rotY[in] = pose.Rot().Y();
+      this->rotZ[in] = pose.Rot().Z();
+    }
+    else
+    {
+      this->edgeData[in] = edge.get().Data();
+    }
+    if (edge.get().Weight() != 1.0)
+      this->weights.emplace_back(in, edge.get().Weight());
+  }
+  std::sort(this->weights.begin(), this->weights.end());
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::size_t FrozenGraph<V, E>::Version() const
+{
+  return this->version;
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::size_t FrozenGraph<V, E>::VertexCount() const
+{
+  return this->ids.size();
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+auto FrozenGraph<V, E>::IndexOf(VertexId _id) const -> Index
+{
+  return _id < this->indices.size() ? this->indices[_id] : kNone;
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+auto FrozenGraph<V, E>::Id(Index _index) const -> VertexId
+{
+  return this->ids[_index];
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+const V &FrozenGraph<V, E>::Data(Index _index) const
+{
+  return this->data[_index];
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::string FrozenGraph<V, E>::Name(Index _index) const
+{
+  return this->names.substr(this->nameOffsets[_index],
+      this->nameOffsets[_index + 1] - this->nameOffsets[_index]);
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::size_t FrozenGraph<V, E>::InDegree(Index _index) const
+{
+  return this->inOffsets[_index + 1] - this->inOffsets[_index];
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::size_t FrozenGraph<V, E>::OutDegree(Index _index) const
+{
+  return this->outOffsets[_index + 1] - this->outOffsets[_index];
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+auto FrozenGraph<V, E>::Predecessor(Index _index) const -> Index
+{
+  if (this->InDegree(_index) != 1)
+    return kNone;
+  return this->tails[this->inOffsets[_index]];
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+auto FrozenGraph<V, E>::Successor(Index _index) const -> Index
+{
+  if (this->OutDegree(_index) != 1)
+    return kNone;
+  return this->heads[this->outOffsets[_index]];
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+ignition::math::Pose3d FrozenGraph<V, E>::PredecessorPose(Index _index) const
+{
+  return this->EdgePose(this->inOffsets[_index]);
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+ignition::math::Pose3d FrozenGraph<V, E>::EdgePose(Index _edge) const
+{
+  return ignition::math::Pose3d(
+      ignition::math::Vector3d(
+          this->posX[_edge], this->posY[_edge], this->posZ[_edge]),
+      ignition::math::Quaterniond(
+          this->rotW[_edge], this->rotX[_edge], this->rotY[_edge],
+          this->rotZ[_edge]));
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+auto FrozenGraph<V, E>::Find(const std::string &_prefix,
+    const std::string &_name) const -> Index
+{
+  std::uint64_t hash = kHashBasis;
+  if (!_prefix.empty())
+    hash = Hash(Hash(hash, _prefix), "::");
+  hash = Hash(hash, _name);
+
+  const std::size_t mask = this->slots.size() - 1;
+  for (std::size_t slot = hash & mask; this->slots[slot] != kNone;
+       slot = (slot + 1) & mask)
+  {
+    if (this->NameEquals(this->slots[slot], _prefix, _name))
+      return this->slots[slot];
+  }
+  return kNone;
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+auto FrozenGraph<V, E>::FindPrefixed(const std::string &_prefix) const
+    -> std::vector<Index>
+{
+  // Names with the prefix sort together, from the prefix itself on.
+  auto first = std::lower_bound(this->byName.begin(), this->byName.end(),
+      _prefix, [this](Index _index, const std::string &_value)
+      {
+        const std::size_t offset = this->nameOffsets[_index];
+        return this->names.compare(offset,
+            this->nameOffsets[_index + 1] - offset, _value) < 0;
+      });
+  auto last = std::find_if(first, this->byName.end(),
+      [this, &_prefix](Index _index)
+      {
+        const std::size_t offset = this->nameOffsets[_index];
+        return this->nameOffsets[_index + 1] - offset < _prefix.size() ||
+               0 != this->names.compare(offset, _prefix.size(), _prefix);
+      });
+  return std::vector<Index>(first, last);
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+void FrozenGraph<V, E>::Thaw(GraphType &_graph, MapType &_map) const
+{
+  for (std::size_t i = 0; i < this->ids.size(); ++i)
+  {
+    _graph.AddVertex(this->Name(static_cast<Index>(i)), this->data[i],
+                     this->ids[i]);
+  }
+  for (const Index index : this->byName)
+    _map.emplace_hint(_map.end(), this->Name(index), this->ids[index]);
+
+  auto weight = this->weights.begin();
+  for (std::size_t head = 0; head < this->ids.size(); ++head)
+  {
+    for (Index in = this->inOffsets[head]; in < this->inOffsets[head + 1];
+         ++in)
+    {
+      E value;
+      if constexpr (std::is_same_v<E, ignition::math::Pose3d>)
+        value = this->EdgePose(in);
+      else
+        value = this->edgeData[in];
+
+      double edgeWeight = 1.0;
+      if (weight != this->weights.end() && weight->first == in)
+        edgeWeight = (weight++)->second;
+      _graph.AddEdge({this->ids[this->tails[in]], this->ids[head]},
+                     value, edgeWeight);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::size_t FrozenGraph<V, E>::MemoryUsage() const
+{
+  std::size_t bytes = sizeof(*this) + this->names.capacity();
+  bytes += this->ids.capacity() * sizeof(VertexId);
+  bytes += this->data.capacity() * sizeof(V);
+  for (const auto *indexVector : {&this->indices, &this->nameOffsets,
+                                  &this->slots, &this->byName,
+                                  &this->inOffsets,
+                                  &this->tails, &this->outOffsets,
+                                  &this->heads})
+  {
+    bytes += indexVector->capacity() * sizeof(Index);
+  }
+  for (const auto *component : {&this->posX, &this->posY, &this->posZ,
+                                &this->rotW, &this->rotX, &this->rotY,
+                                &this->rotZ})
+  {
+    bytes += component->capacity() * sizeof(double);
+  }
+  if constexpr (std::is_same_v<E, bool>)
+    bytes += (this->edgeData.capacity() + 7) / 8;
+  else
+    bytes += this->edgeData.capacity() * sizeof(E);
+  bytes += this->weights.capacity() * sizeof(std::pair<Index, double>);
+  return bytes;
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+std::uint64_t FrozenGraph<V, E>::Hash(std::uint64_t _hash,
+    const std::string &_part)
+{
+  for (unsigned char c : _part)
+  {
+    _hash ^= c;
+    _hash *= 1099511628211ull;
+  }
+  return _hash;
+}
+
+/////////////////////////////////////////////////
+template <typename V, typename E>
+bool FrozenGraph<V, E>::NameEquals(Index _index, const std::string &_prefix,
+    const std::string &_name) const
+{
+  const std::size_t offset = this->nameOffsets[_index];
+  const std::size_t size = this->nameOffsets[_index + 1] - offset;
+  if (_prefix.empty())
+    return 0 == this->names.compare(offset, size, _name);
+
+  return size == _prefix.size() + 2 + _name.size() &&
+         0 == this->names.compare(offset, _prefix.size(), _prefix) &&
+         0 == this->names.compare(offset + _prefix.size(), 2, "::") &&
+         0 == this->names.compare(offset + _prefix.size() + 2, _name.size(),
+                                  _name);
+}
+}
+}
+#endif
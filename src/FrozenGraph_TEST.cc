@@ -0,0 +1,203 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/graph/Graph.hh>
+
+#include "FrozenGraph.hh"
+
+using Graph = ignition::math::graph::DirectedGraph<int, ignition::math::Pose3d>;
+using Frozen = sdf::FrozenGraph<int, ignition::math::Pose3d>;
+
+/////////////////////////////////////////////////
+TEST(FrozenGraph, Vertices)
+{
+  Graph graph;
+  Frozen::MapType map;
+  for (const std::string name : {"__model__", "M::__model__", "M::L", "L"})
+  {
+    const auto id = graph.AddVertex(name, static_cast<int>(map.size())).Id();
+    map[name] = id;
+  }
+  // A second vertex named L, which the map refers to instead of the first.
+  const auto shadowedId = map["L"];
+  map["L"] = graph.AddVertex("L", 4).Id();
+
+  const Frozen frozen(graph, map, 7u);
+  EXPECT_EQ(7u, frozen.Version());
+  EXPECT_EQ(5u, frozen.VertexCount());
+
+  for (const auto &[name, id] : map)
+  {
+    const auto index = frozen.IndexOf(id);
+    ASSERT_NE(Frozen::kNone, index);
+    EXPECT_EQ(id, frozen.Id(index));
+    EXPECT_EQ(name, frozen.Name(index));
+    EXPECT_EQ(graph.VertexFromId(id).Data(), frozen.Data(index));
+    EXPECT_EQ(index, frozen.Find("", name)) << name;
+  }
+  EXPECT_EQ("L", frozen.Name(frozen.IndexOf(shadowedId)));
+  EXPECT_EQ(Frozen::kNone, frozen.IndexOf(1000u));
+  EXPECT_EQ(Frozen::kNone, frozen.IndexOf(ignition::math::graph::kNullId));
+
+  // Names in the scope of a prefix.
+  EXPECT_EQ(frozen.IndexOf(map["M::L"]), frozen.Find("M", "L"));
+  EXPECT_EQ(frozen.IndexOf(map["M::__model__"]),
+            frozen.Find("M", "__model__"));
+  EXPECT_EQ(Frozen::kNone, frozen.Find("M", "M::L"));
+  EXPECT_EQ(Frozen::kNone, frozen.Find("M", ""));
+  EXPECT_EQ(Frozen::kNone, frozen.Find("", "M"));
+  EXPECT_EQ(Frozen::kNone, frozen.Find("", "M::"));
+  EXPECT_EQ(Frozen::kNone, frozen.Find("N", "L"));
+  EXPECT_GT(frozen.MemoryUsage(), sizeof(frozen));
+}
+
+/////////////////////////////////////////////////
+TEST(FrozenGraph, Edges)
+{
+  Graph graph;
+  Frozen::MapType map;
+  for (const std::string name : {"A", "B", "C", "D"})
+    map[name] = graph.AddVertex(name, 0).Id();
+
+  const ignition::math::Pose3d poseAB(1, 2, 3, 0.1, 0.2, 0.3);
+  const ignition::math::Pose3d poseBC(-1, 0, 0.5, 0, 0, -1.2);
+  graph.AddEdge({map["A"], map["B"]}, poseAB);
+  graph.AddEdge({map["B"], map["C"]}, poseBC);
+  graph.AddEdge({map["A"], map["D"]}, ignition::math::Pose3d::Zero);
+  graph.AddEdge({map["C"], map["D"]}, ignition::math::Pose3d::Zero);
+
+  const Frozen frozen(graph, map, 0u);
+  const auto a = frozen.Find("", "A");
+  const auto b = frozen.Find("", "B");
+  const auto c = frozen.Find("", "C");
+  const auto d = frozen.Find("", "D");
+
+  EXPECT_EQ(0u, frozen.InDegree(a));
+  EXPECT_EQ(2u, frozen.OutDegree(a));
+  EXPECT_EQ(1u, frozen.InDegree(b));
+  EXPECT_EQ(1u, frozen.OutDegree(b));
+  EXPECT_EQ(2u, frozen.InDegree(d));
+  EXPECT_EQ(0u, frozen.OutDegree(d));
+
+  EXPECT_EQ(Frozen::kNone, frozen.Predecessor(a));
+  EXPECT_EQ(a, frozen.Predecessor(b));
+  EXPECT_EQ(b, frozen.Predecessor(c));
+  EXPECT_EQ(Frozen::kNone, frozen.Predecessor(d));
+  EXPECT_EQ(Frozen::kNone, frozen.Successor(a));
+  EXPECT_EQ(c, frozen.Successor(b));
+  EXPECT_EQ(d, frozen.Successor(c));
+  EXPECT_EQ(Frozen::kNone, frozen.Successor(d));
+
+  EXPECT_EQ(poseAB, frozen.PredecessorPose(b));
+  EXPECT_EQ(poseBC, frozen.PredecessorPose(c));
+}
+
+/////////////////////////////////////////////////
+TEST(FrozenGraph, FindPrefixed)
+{
+  Graph graph;
+  Frozen::MapType map;
+  for (const std::string name : {"M::B", "L", "M::A", "MM::A", "M", "N::A"})
+    map[name] = graph.AddVertex(name, 0).Id();
+
+  const Frozen frozen(graph, map, 0u);
+  auto names = [&frozen](const std::string &_prefix)
+  {
+    std::vector<std::string> out;
+    for (const auto index : frozen.FindPrefixed(_prefix))
+      out.push_back(frozen.Name(index));
+    return out;
+  };
+  EXPECT_EQ(std::vector<std::string>({"M::A", "M::B"}), names("M::"));
+  EXPECT_EQ(std::vector<std::string>({"N::A"}), names("N::"));
+  EXPECT_TRUE(names("O::").empty());
+  EXPECT_EQ(std::vector<std::string>(
+      {"L", "M", "M::A", "M::B", "MM::A", "N::A"}), names(""));
+}
+
+/////////////////////////////////////////////////
+TEST(FrozenGraph, Thaw)
+{
+  using FlagGraph = ignition::math::graph::DirectedGraph<int, bool>;
+  using FrozenFlags = sdf::FrozenGraph<int, bool>;
+
+  FlagGraph graph;
+  FrozenFlags::MapType map;
+  for (const std::string name : {"A", "B", "C"})
+    map[name] = graph.AddVertex(name, static_cast<int>(map.size())).Id();
+  // A vertex that the map does not refer to, and an ID that is not used.
+  graph.AddVertex("A", 3);
+  map["D"] = graph.AddVertex("D", 4, 10u).Id();
+  graph.AddEdge({map["A"], map["B"]}, true);
+  graph.AddEdge({map["C"], map["B"]}, false).SetWeight(0);
+  graph.AddEdge({map["B"], map["D"]}, true, 2.5);
+
+  const FrozenFlags frozen(graph, map, 0u);
+  FlagGraph thawed;
+  FrozenFlags::MapType thawedMap;
+  frozen.Thaw(thawed, thawedMap);
+  EXPECT_EQ(map, thawedMap);
+
+  ASSERT_EQ(graph.Vertices().size(), thawed.Vertices().size());
+  for (const auto &[id, vertex] : graph.Vertices())
+  {
+    const auto &thawedVertex = thawed.VertexFromId(id);
+    ASSERT_TRUE(thawedVertex.Valid());
+    EXPECT_EQ(vertex.get().Name(), thawedVertex.Name());
+    EXPECT_EQ(vertex.get().Data(), thawedVertex.Data());
+  }
+
+  // Edges get new IDs, so they are compared by their vertices.
+  using EdgeTuple = std::tuple<std::size_t, std::size_t, bool, double>;
+  auto edgeTuples = [](const FlagGraph &_graph)
+  {
+    std::vector<EdgeTuple> out;
+    for (const auto &[id, edge] : _graph.Edges())
+    {
+      out.emplace_back(edge.get().Tail(), edge.get().Head(),
+                       edge.get().Data(), edge.get().Weight());
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+  };
+  EXPECT_EQ(3u, edgeTuples(graph).size());
+  EXPECT_EQ(edgeTuples(graph), edgeTuples(thawed));
+
+  // Poses are rebuilt from their components.
+  Graph poseGraph;
+  Frozen::MapType poseMap;
+  for (const std::string name : {"A", "B"})
+    poseMap[name] = poseGraph.AddVertex(name, 0).Id();
+  const ignition::math::Pose3d pose(1, 2, 3, 0.1, 0.2, 0.3);
+  poseGraph.AddEdge({poseMap["A"], poseMap["B"]}, pose);
+
+  Graph thawedPoseGraph;
+  Frozen::MapType thawedPoseMap;
+  Frozen(poseGraph, poseMap, 0u).Thaw(thawedPoseGraph, thawedPoseMap);
+  const auto incidents = thawedPoseGraph.IncidentsTo(poseMap["B"]);
+  ASSERT_EQ(1u, incidents.size());
+  EXPECT_EQ(poseMap["A"], incidents.begin()->second.get().Tail());
+  EXPECT_EQ(pose, incidents.begin()->second.get().Data());
+}
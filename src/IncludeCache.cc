@@ -0,0 +1,188 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sdf/Element.hh"
+#include "sdf/IncludeCache.hh"
+#include "Utils.hh"
+
+using namespace sdf;
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Build the cache key of a file. Besides the file name, it holds
+/// every setting that can change the elements read from the file.
+/// \param[in] _filename Resolved name of the included file.
+/// \param[in] _config Configuration the file is read with.
+/// \return The key, or nullopt if files read with the configuration are
+/// not cached, see parserConfigKey.
+std::optional<std::string> cacheKey(const std::string &_filename,
+                                    const ParserConfig &_config)
+{
+  const std::optional<std::string> configKey = parserConfigKey(_config);
+  if (!configKey)
+    return std::nullopt;
+  return _filename + '\n' + *configKey;
+}
+
+/// \brief A file that was read for an <include>.
+struct IncludeCacheEntry
+{
+  /// \brief Copy of the root element of the file.
+  ElementPtr root;
+
+  /// \brief Value of SDF::FilePath after reading the file.
+  std::string filePath;
+
+  /// \brief Value of SDF::OriginalVersion after reading the file.
+  std::string originalVersion;
+
+  /// \brief Errors found when reading the file.
+  Errors errors;
+
+  /// \brief The file itself, followed by the files read along with it, and
+  /// their stamps from before they were read.
+  StampedFiles files;
+};
+}
+
+/// \brief Private data for IncludeCache.
+class sdf::IncludeCache::Implementation
+{
+  /// \brief Protects entries.
+  public: mutable std::mutex mutex;
+
+  /// \brief Entries by cache key.
+  public: std::unordered_map<std::string,
+              std::shared_ptr<const IncludeCacheEntry>> entries;
+
+  /// \brief Number of cache hits.
+  public: mutable std::atomic<std::size_t> hits{0};
+
+  /// \brief Number of cache misses.
+  public: mutable std::atomic<std::size_t> misses{0};
+};
+
+/////////////////////////////////////////////////
+IncludeCache::IncludeCache()
+  : dataPtr(ignition::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+bool IncludeCache::Find(const std::string &_filename,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors,
+    StampedFiles &_files) const
+{
+  const std::optional<std::string> key = cacheKey(_filename, _config);
+  if (!key)
+    return false;
+
+  std::shared_ptr<const IncludeCacheEntry> entry;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto it = this->dataPtr->entries.find(*key);
+    if (it != this->dataPtr->entries.end())
+      entry = it->second;
+  }
+
+  // The stamps are checked outside the lock, since that touches the disk.
+  if (entry)
+  {
+    for (const auto &[file, stamp] : entry->files)
+    {
+      if (!(fileStamp(file) == stamp))
+      {
+        entry.reset();
+        break;
+      }
+    }
+  }
+
+  if (!entry)
+  {
+    ++this->dataPtr->misses;
+    return false;
+  }
+
+  ++this->dataPtr->hits;
+  _sdf->Root(entry->root->Clone());
+  _sdf->SetFilePath(entry->filePath);
+  _sdf->SetOriginalVersion(entry->originalVersion);
+  _errors.insert(_errors.end(), entry->errors.begin(), entry->errors.end());
+  _files.insert(_files.end(), entry->files.begin() + 1, entry->files.end());
+  return true;
+}
+
+/////////////////////////////////////////////////
+void IncludeCache::Insert(const std::string &_filename,
+    const ParserConfig &_config, const SDFPtr _sdf, const Errors &_errors,
+    const StampedFiles &_files)
+{
+  const std::optional<std::string> key = cacheKey(_filename, _config);
+  if (!_sdf || !_sdf->Root() || !key || _files.empty() ||
+      _files.front().first != _filename)
+  {
+    return;
+  }
+
+  auto entry = std::make_shared<IncludeCacheEntry>();
+  entry->root = _sdf->Root()->Clone();
+  entry->filePath = _sdf->FilePath();
+  entry->originalVersion = _sdf->OriginalVersion();
+  entry->errors = _errors;
+  entry->files = _files;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries[*key] = std::move(entry);
+}
+
+/////////////////////////////////////////////////
+void IncludeCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries.clear();
+}
+
+/////////////////////////////////////////////////
+std::size_t IncludeCache::Size() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->entries.size();
+}
+
+/////////////////////////////////////////////////
+std::size_t IncludeCache::HitCount() const
+{
+  return this->dataPtr->hits;
+}
+
+/////////////////////////////////////////////////
+std::size_t IncludeCache::MissCount() const
+{
+  return this->dataPtr->misses;
+}
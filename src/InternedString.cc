@@ -0,0 +1,100 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+
+#include "sdf/InternedString.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief The strings that InternedStrings point to.
+class StringTable
+{
+  /// \brief Get the copy of a string in the table, adding it if needed.
+  /// \param[in] _str The string.
+  /// \return The copy in the table.
+  public: const std::string *Intern(const std::string &_str)
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock(this->mutex);
+      auto it = this->strings.find(_str);
+      if (it != this->strings.end())
+        return &*it;
+    }
+    std::unique_lock<std::shared_mutex> lock(this->mutex);
+    return &*this->strings.insert(_str).first;
+  }
+
+  /// \brief Get the number of strings in the table.
+  /// \return The number of strings.
+  public: std::size_t Size()
+  {
+    std::shared_lock<std::shared_mutex> lock(this->mutex);
+    return this->strings.size();
+  }
+
+  /// \brief Mutex for strings.
+  private: std::shared_mutex mutex;
+
+  /// \brief The strings. Their nodes never move, so pointers to them stay
+  /// valid.
+  private: std::unordered_set<std::string> strings;
+
+  /// \brief The empty string, which is used by default constructed
+  /// InternedStrings without a lookup.
+  public: const std::string *const empty = &*this->strings.insert("").first;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the table shared by all InternedStrings. It is never
+/// destroyed, so strings held by static objects stay valid.
+/// \return The table.
+StringTable &stringTable()
+{
+  static StringTable *table = new StringTable;
+  return *table;
+}
+}
+
+/////////////////////////////////////////////////
+InternedString::InternedString()
+  : str(stringTable().empty)
+{
+}
+
+/////////////////////////////////////////////////
+InternedString::InternedString(const std::string &_str)
+  : str(_str.empty() ? stringTable().empty : stringTable().Intern(_str))
+{
+}
+
+/////////////////////////////////////////////////
+InternedString::InternedString(const char *_str)
+  : InternedString(std::string(_str))
+{
+}
+
+/////////////////////////////////////////////////
+std::size_t InternedString::TableSize()
+{
+  return stringTable().Size();
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sdf/Element.hh"
+#include "sdf/InternedString.hh"
+#include "sdf/Param.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+
+/////////////////////////////////////////////////
+TEST(InternedString, Construction)
+{
+  sdf::InternedString empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ("", empty.Str());
+  EXPECT_EQ(sdf::InternedString(""), empty);
+  EXPECT_EQ(sdf::InternedString(std::string()), empty);
+
+  sdf::InternedString link("link");
+  EXPECT_FALSE(link.Empty());
+  EXPECT_EQ("link", link.Str());
+  const std::string &str = link;
+  EXPECT_EQ(&link.Str(), &str);
+}
+
+/////////////////////////////////////////////////
+TEST(InternedString, Comparison)
+{
+  const std::string name = std::string("vis") + "ual";
+  sdf::InternedString a(name);
+  sdf::InternedString b("visual");
+  sdf::InternedString c("collision");
+
+  // Equal strings share one copy
+  EXPECT_EQ(&a.Str(), &b.Str());
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a != b);
+  EXPECT_TRUE(a != c);
+
+  EXPECT_TRUE(a == name);
+  EXPECT_TRUE(name == a);
+  EXPECT_TRUE(a == "visual");
+  EXPECT_TRUE("visual" == a);
+  EXPECT_TRUE(c != name);
+  EXPECT_TRUE(name != c);
+  EXPECT_TRUE(c != "visual");
+  EXPECT_TRUE("visual" != c);
+
+  std::ostringstream stream;
+  stream << a;
+  EXPECT_EQ("visual", stream.str());
+}
+
+/////////////////////////////////////////////////
+TEST(InternedString, TableSize)
+{
+  const std::string value = "interned_string_table_size_test";
+  sdf::InternedString first(value);
+  const std::size_t size = sdf::InternedString::TableSize();
+  sdf::InternedString second(value);
+  EXPECT_EQ(size, sdf::InternedString::TableSize());
+  sdf::InternedString third(value + "_other");
+  EXPECT_EQ(size + 1, sdf::InternedString::TableSize());
+}
+
+/////////////////////////////////////////////////
+TEST(InternedString, Threads)
+{
+  std::vector<const std::string *> copies(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < copies.size(); ++i)
+  {
+    threads.emplace_back([&copies, i]()
+    {
+      for (int j = 0; j < 1000; ++j)
+        sdf::InternedString("thread_" + std::to_string(j));
+      copies[i] = &sdf::InternedString("thread_shared").Str();
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (const std::string *copy : copies)
+    EXPECT_EQ(copies.front(), copy);
+}
+
+/////////////////////////////////////////////////
+TEST(InternedString, SharedByClones)
+{
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  elem->SetName("link");
+  elem->SetDescription("A link");
+  elem->AddAttribute("name", "string", "__default__", true, "Link name");
+  const std::size_t tableSize = sdf::InternedString::TableSize();
+
+  sdf::ElementPtr clone = elem->Clone();
+  EXPECT_EQ("A link", clone->GetDescription());
+  EXPECT_EQ("Link name", clone->GetAttribute("name")->GetDescription());
+  EXPECT_EQ(tableSize, sdf::InternedString::TableSize());
+}
+
+/////////////////////////////////////////////////
+/// Only strings of the spec are interned, so reading documents does not
+/// grow the table.
+TEST(InternedString, DocumentStringsAreNotInterned)
+{
+  auto read = [](const std::string &_suffix)
+  {
+    const std::string xml =
+        "<sdf version='1.9'><model name='model_" + _suffix + "'>"
+        "  <link name='link_" + _suffix + "'/>"
+        "  <plugin name='plugin_" + _suffix + "' filename='lib_" + _suffix +
+        "'>"
+        "    <custom_" + _suffix + " key_" + _suffix + "='value_" + _suffix +
+        "'>text_" + _suffix + "</custom_" + _suffix + ">"
+        "  </plugin>"
+        "</model></sdf>";
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readString(xml, sdf, errors));
+    EXPECT_TRUE(errors.empty());
+  };
+
+  read("first");
+  const std::size_t tableSize = sdf::InternedString::TableSize();
+  read("second");
+  EXPECT_EQ(tableSize, sdf::InternedString::TableSize());
+
+  sdf::ElementPtr elem = std::make_shared<sdf::Element>();
+  elem->SetName("custom_name");
+  elem->AddAttribute("custom_key", "string", "custom_default", true);
+  elem->AddValue("string", "custom_text", true);
+  elem->SetFilePath("/path/to/custom.sdf");
+  EXPECT_EQ(tableSize, sdf::InternedString::TableSize());
+}
@@ -27,6 +27,7 @@
 #include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -236,6 +237,7 @@ const std::string &Joint::Name() const
 void Joint::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
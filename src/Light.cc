@@ -20,6 +20,7 @@
 #include "sdf/Light.hh"
 #include "sdf/parser.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -250,6 +251,7 @@ std::string Light::Name() const
 void Light::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
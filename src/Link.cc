@@ -32,6 +32,7 @@
 #include "sdf/Visual.hh"
 
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -202,6 +203,7 @@ std::string Link::Name() const
 void Link::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
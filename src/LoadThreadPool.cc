@@ -0,0 +1,240 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LoadThreadPool.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief The tasks of one call to forEachLoadTask. Every member is guarded
+/// by the mutex of the pool that runs the tasks.
+struct TaskGroup
+{
+  /// \brief Function that runs a task.
+  const std::function<void(std::size_t)> *task = nullptr;
+
+  /// \brief Number of tasks.
+  std::size_t count = 0;
+
+  /// \brief Index of the next task to start.
+  std::size_t next = 0;
+
+  /// \brief Number of tasks that finished.
+  std::size_t finished = 0;
+
+  /// \brief Exception thrown by each task, if any.
+  std::vector<std::exception_ptr> exceptions;
+};
+
+/// \brief Threads that run the tasks of groups, taking them from the most
+/// recently added group that has tasks left.
+class Pool
+{
+  /// \brief Start the threads.
+  /// \param[in] _threadCount Number of threads to start, in addition to the
+  /// thread that runs the first group.
+  public: explicit Pool(std::size_t _threadCount)
+  {
+    try
+    {
+      for (std::size_t i = 0; i < _threadCount; ++i)
+        this->threads.emplace_back(&Pool::Work, this);
+    }
+    catch(...)
+    {
+      this->Stop();
+      throw;
+    }
+  }
+
+  /// \brief Destructor. Stops the threads.
+  public: ~Pool()
+  {
+    this->Stop();
+  }
+
+  /// \brief Add a group, and run tasks until every task of the group has
+  /// finished.
+  /// \param[in,out] _group The group.
+  public: void Run(TaskGroup &_group)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->open.push_back(&_group);
+    this->changed.notify_all();
+    while (_group.finished < _group.count)
+    {
+      if (!this->RunOne(lock))
+        this->changed.wait(lock);
+    }
+  }
+
+  /// \brief Run a task of the most recently added group that has tasks
+  /// left.
+  /// \param[in,out] _lock Lock of the mutex, which is released while the
+  /// task runs.
+  /// \return False if no group has tasks left.
+  private: bool RunOne(std::unique_lock<std::mutex> &_lock)
+  {
+    if (this->open.empty())
+      return false;
+
+    TaskGroup *group = this->open.back();
+    const std::size_t index = group->next++;
+    if (group->next == group->count)
+      this->open.pop_back();
+
+    _lock.unlock();
+    std::exception_ptr exception;
+    try
+    {
+      (*group->task)(index);
+    }
+    catch(...)
+    {
+      exception = std::current_exception();
+    }
+    _lock.lock();
+
+    // The group stays alive until this task is counted as finished.
+    group->exceptions[index] = exception;
+    if (++group->finished == group->count)
+      this->changed.notify_all();
+    return true;
+  }
+
+  /// \brief Body of the threads of the pool.
+  private: void Work();
+
+  /// \brief Stop and join the threads.
+  private: void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stopping = true;
+    }
+    this->changed.notify_all();
+    for (auto &thread : this->threads)
+      thread.join();
+    this->threads.clear();
+  }
+
+  /// \brief Guards the groups.
+  private: std::mutex mutex;
+
+  /// \brief Notified when a group is added or finishes, or the pool stops.
+  private: std::condition_variable changed;
+
+  /// \brief Groups that have tasks left to start, oldest first.
+  private: std::vector<TaskGroup *> open;
+
+  /// \brief True once the threads should stop.
+  private: bool stopping = false;
+
+  /// \brief The threads.
+  private: std::vector<std::thread> threads;
+};
+
+/// \brief The pool whose task the current thread runs, if any.
+thread_local Pool *tPool = nullptr;
+
+/////////////////////////////////////////////////
+void Pool::Work()
+{
+  tPool = this;
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stopping)
+  {
+    if (!this->RunOne(lock))
+      this->changed.wait(lock);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the number of threads a thread count asks for.
+/// \param[in] _threadCount Thread count, where 0 means one per hardware
+/// thread.
+/// \return The number of threads.
+unsigned int resolveThreadCount(unsigned int _threadCount)
+{
+  if (_threadCount == 0)
+    return std::max(1u, std::thread::hardware_concurrency());
+  return _threadCount;
+}
+}
+
+namespace sdf
+{
+inline namespace SDF_VERSION_NAMESPACE {
+/////////////////////////////////////////////////
+bool loadTasksRunInParallel(unsigned int _threadCount)
+{
+  return nullptr != tPool || resolveThreadCount(_threadCount) > 1;
+}
+
+/////////////////////////////////////////////////
+void forEachLoadTask(unsigned int _threadCount, std::size_t _count,
+                     const std::function<void(std::size_t)> &_task)
+{
+  TaskGroup group;
+  group.task = &_task;
+  group.count = _count;
+  group.exceptions.resize(_count);
+
+  const std::size_t threadCount = std::min<std::size_t>(
+      resolveThreadCount(_threadCount), _count);
+  if (_count < 2 || (nullptr == tPool && threadCount < 2))
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      try
+      {
+        _task(i);
+      }
+      catch(...)
+      {
+        group.exceptions[i] = std::current_exception();
+      }
+    }
+  }
+  else if (nullptr != tPool)
+  {
+    tPool->Run(group);
+  }
+  else
+  {
+    Pool pool(threadCount - 1);
+    tPool = &pool;
+    pool.Run(group);
+    tPool = nullptr;
+  }
+
+  for (const auto &exception : group.exceptions)
+  {
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+}
+}
+}
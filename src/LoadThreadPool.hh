@@ -0,0 +1,58 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_LOADTHREADPOOL_HH
+#define SDFORMAT_LOADTHREADPOOL_HH
+
+#include <cstddef>
+#include <functional>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Check whether forEachLoadTask runs tasks on several threads.
+  /// \param[in] _threadCount Number of threads, as given to forEachLoadTask.
+  /// \return True if the calling thread runs a task of a pool, or if
+  /// _threadCount asks for more than one thread.
+  bool loadTasksRunInParallel(unsigned int _threadCount);
+
+  /// \brief Run tasks that load independent parts of a document, such as the
+  /// models of a world, on a pool of threads.
+  ///
+  /// A task that is run by a pool may call forEachLoadTask again, and the
+  /// tasks it adds run on the same pool. Threads with nothing left to run,
+  /// including a thread waiting for its own tasks to finish, take tasks from
+  /// the most recently added group that still has some, so the threads stay
+  /// busy however the work is nested.
+  /// \param[in] _threadCount Number of threads of the pool that is started
+  /// for the call if the calling thread does not run a task of a pool
+  /// already. 0 uses one thread per hardware thread. 1 runs the tasks one
+  /// after another on the calling thread.
+  /// \param[in] _count Number of tasks.
+  /// \param[in] _task Function that runs the task with the given index, from
+  /// 0 to _count - 1. It may be called from several threads at once.
+  /// \throws The exception thrown by the task with the lowest index that
+  /// threw, once every task has finished.
+  void forEachLoadTask(unsigned int _threadCount, std::size_t _count,
+                       const std::function<void(std::size_t)> &_task);
+  }
+}
+#endif
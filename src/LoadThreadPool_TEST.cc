@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LoadThreadPool.hh"
+
+/////////////////////////////////////////////////
+TEST(LoadThreadPool, RunsEachTaskOnce)
+{
+  EXPECT_FALSE(sdf::loadTasksRunInParallel(1u));
+  EXPECT_TRUE(sdf::loadTasksRunInParallel(4u));
+
+  for (unsigned int threadCount : {0u, 1u, 4u})
+  {
+    std::vector<std::atomic<int>> runs(1000);
+    sdf::forEachLoadTask(threadCount, runs.size(), [&](std::size_t _index)
+    {
+      ++runs[_index];
+    });
+    for (std::size_t i = 0; i < runs.size(); ++i)
+    {
+      EXPECT_EQ(1, runs[i].load())
+          << "task " << i << ", threads " << threadCount;
+    }
+  }
+
+  // No tasks.
+  sdf::forEachLoadTask(4u, 0u, [](std::size_t)
+  {
+    FAIL() << "No task should run";
+  });
+}
+
+/////////////////////////////////////////////////
+/// Tasks may add tasks of their own, which run on the threads of the same
+/// pool.
+TEST(LoadThreadPool, NestedTasks)
+{
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::vector<std::atomic<int>> runs(8 * 50);
+  std::atomic<bool> nestedInParallel{true};
+
+  sdf::forEachLoadTask(4u, 8u, [&](std::size_t _outer)
+  {
+    // A single thread is asked for, but the tasks still use the pool.
+    nestedInParallel = nestedInParallel && sdf::loadTasksRunInParallel(1u);
+    sdf::forEachLoadTask(1u, 50u, [&](std::size_t _inner)
+    {
+      ++runs[_outer * 50 + _inner];
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.insert(std::this_thread::get_id());
+    });
+  });
+
+  EXPECT_TRUE(nestedInParallel);
+  for (const auto &run : runs)
+    EXPECT_EQ(1, run.load());
+  EXPECT_LE(threads.size(), 4u);
+
+  // The calling thread is not left in the pool once it is done.
+  EXPECT_FALSE(sdf::loadTasksRunInParallel(1u));
+}
+
+/////////////////////////////////////////////////
+/// The exception of the task with the lowest index is rethrown once every
+/// task has run.
+TEST(LoadThreadPool, Exceptions)
+{
+  for (unsigned int threadCount : {1u, 4u})
+  {
+    std::atomic<int> runs{0};
+    try
+    {
+      sdf::forEachLoadTask(threadCount, 100u, [&](std::size_t _index)
+      {
+        ++runs;
+        if (_index % 10 == 3)
+          throw std::runtime_error(std::to_string(_index));
+      });
+      FAIL() << "Expected an exception";
+    }
+    catch(const std::runtime_error &_e)
+    {
+      EXPECT_EQ(std::string("3"), _e.what());
+    }
+    EXPECT_EQ(100, runs.load());
+  }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include "MappedFile.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+/// \brief Map a regular file read-only into memory.
+/// \param[in] _filename Name of the file.
+/// \param[out] _size Size of the mapping.
+/// \return Start of the mapping, or nullptr if the file could not be
+/// mapped. Empty files are never mapped.
+static void *mapFile(const std::string &_filename, std::size_t &_size)
+{
+  void *mapping = nullptr;
+#ifndef _WIN32
+  int fd = ::open(_filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat info;
+  if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+  {
+    _size = static_cast<std::size_t>(info.st_size);
+    mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+      mapping = nullptr;
+  }
+  // The mapping keeps the file open.
+  ::close(fd);
+#else
+  HANDLE file = CreateFileA(_filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+      nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER size;
+  if (GetFileType(file) == FILE_TYPE_DISK && GetFileSizeEx(file, &size) &&
+      size.QuadPart > 0)
+  {
+    HANDLE fileMapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (fileMapping)
+    {
+      _size = static_cast<std::size_t>(size.QuadPart);
+      mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+      // The view keeps the mapping and the file open.
+      CloseHandle(fileMapping);
+    }
+  }
+  CloseHandle(file);
+#endif
+  return mapping;
+}
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string &_filename)
+{
+  this->mapping = mapFile(_filename, this->mappingSize);
+  if (this->mapping)
+  {
+    this->open = true;
+    return;
+  }
+  this->mappingSize = 0;
+
+  std::ifstream file(_filename, std::ios::binary);
+  if (!file)
+    return;
+  this->buffer.assign(std::istreambuf_iterator<char>(file),
+                      std::istreambuf_iterator<char>());
+  this->open = !file.bad();
+}
+
+/////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+  if (!this->mapping)
+    return;
+#ifndef _WIN32
+  ::munmap(this->mapping, this->mappingSize);
+#else
+  UnmapViewOfFile(this->mapping);
+#endif
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::IsOpen() const
+{
+  return this->open;
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::IsMapped() const
+{
+  return this->mapping != nullptr;
+}
+
+/////////////////////////////////////////////////
+std::string_view MappedFile::Data() const
+{
+  if (this->mapping)
+  {
+    return std::string_view(
+        static_cast<const char *>(this->mapping), this->mappingSize);
+  }
+  return this->buffer;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_MAPPEDFILE_HH
+#define SDFORMAT_MAPPEDFILE_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief The contents of a file, mapped read-only into memory.
+  ///
+  /// Files that cannot be mapped, such as pipes, are read into a buffer
+  /// instead. Either way, the contents stay valid until the MappedFile is
+  /// destroyed.
+  class MappedFile
+  {
+    /// \brief Map a file.
+    /// \param[in] _filename Name of the file.
+    public: explicit MappedFile(const std::string &_filename);
+
+    /// \brief Destructor. Unmaps the file.
+    public: ~MappedFile();
+
+    /// \brief No copy constructor.
+    public: MappedFile(const MappedFile &) = delete;
+
+    /// \brief No copy assignment.
+    public: MappedFile &operator=(const MappedFile &) = delete;
+
+    /// \brief Check whether the file could be opened and read.
+    /// \return True if it could.
+    public: bool IsOpen() const;
+
+    /// \brief Check whether the contents are mapped, rather than read into a
+    /// buffer.
+    /// \return True if the contents are mapped.
+    public: bool IsMapped() const;
+
+    /// \brief Get the contents of the file.
+    /// \return The contents, which are not null-terminated. Empty if the
+    /// file could not be read.
+    public: std::string_view Data() const;
+
+    /// \brief Start of the mapping, or nullptr if the file is not mapped.
+    private: void *mapping = nullptr;
+
+    /// \brief Size of the mapping.
+    private: std::size_t mappingSize = 0;
+
+    /// \brief Contents of a file that could not be mapped.
+    private: std::string buffer;
+
+    /// \brief True if the file could be opened and read.
+    private: bool open = false;
+  };
+  }
+}
+#endif
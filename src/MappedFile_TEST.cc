@@ -0,0 +1,60 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "sdf/Filesystem.hh"
+#include "MappedFile.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Contents)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  const std::string filename =
+      sdf::filesystem::append(tmpDir, "mapped_file.sdf");
+  const std::string contents("<sdf version='1.9'>\n\0</sdf>", 26);
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << contents;
+  }
+
+  {
+    sdf::MappedFile file(filename);
+    EXPECT_TRUE(file.IsOpen());
+    EXPECT_TRUE(file.IsMapped());
+    EXPECT_EQ(contents, file.Data());
+  }
+
+  // Empty files are read rather than mapped.
+  std::ofstream(filename, std::ios::trunc).close();
+  {
+    sdf::MappedFile file(filename);
+    EXPECT_TRUE(file.IsOpen());
+    EXPECT_FALSE(file.IsMapped());
+    EXPECT_TRUE(file.Data().empty());
+  }
+  std::remove(filename.c_str());
+
+  sdf::MappedFile missing(filename);
+  EXPECT_FALSE(missing.IsOpen());
+  EXPECT_FALSE(missing.IsMapped());
+  EXPECT_TRUE(missing.Data().empty());
+}
@@ -14,8 +14,10 @@
  * limitations under the License.
  *
 */
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 #include <ignition/math/Pose3.hh>
@@ -32,6 +34,7 @@
 #include "sdf/ParserConfig.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 #include "sdf/parser.hh"
@@ -80,6 +83,18 @@ class sdf::Model::Implementation
   /// \brief The nested models specified in this model.
   public: std::vector<Model> models;
 
+  /// \brief Index of the links by name.
+  public: NameIndex linkIndex;
+
+  /// \brief Index of the joints by name.
+  public: NameIndex jointIndex;
+
+  /// \brief Index of the frames by name.
+  public: NameIndex frameIndex;
+
+  /// \brief Index of the nested models by name.
+  public: NameIndex modelIndex;
+
   /// \brief The interface models specified in this model.
   public: std::vector<std::pair<std::optional<sdf::NestedInclude>,
           sdf::InterfaceModelConstPtr>> interfaceModels;
@@ -103,6 +118,10 @@ class sdf::Model::Implementation
   /// \brief Scope name of parent Pose Relative-To Graph (world or __model__).
   public: std::string poseGraphScopeVertexName;
 
+  /// \brief Scoped Pose Relative-To graph of this model, which its links,
+  /// joints, frames and nested models share.
+  public: sdf::ScopedGraph<sdf::PoseRelativeToGraph> childPoseGraph;
+
   /// \brief Optional URI string that specifies where this model was or
   /// can be loaded from.
   public: std::string uri = "";
@@ -137,7 +156,7 @@ Model::Model()
 /////////////////////////////////////////////////
 Errors Model::Load(ElementPtr _sdf)
 {
-  return this->Load(_sdf, ParserConfig::GlobalConfig());
+  return this->Load(_sdf, *globalParserConfig());
 }
 
 /////////////////////////////////////////////////
@@ -198,14 +217,18 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   // Load the pose. Ignore the return value since the model pose is optional.
   loadPose(_sdf, this->dataPtr->pose, this->dataPtr->poseRelativeTo);
 
-  for (const auto &[name, size] :
-       _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
+  // The names are only counted one by one if some of them are not unique.
+  if (!_sdf->HasUniqueChildNames("", Element::NameUniquenessExceptions()))
   {
-    if (size > 1)
+    for (const auto &[name, size] :
+         _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
     {
-      sdfwarn << "Non-unique name[" << name << "] detected " << size
-              << " times in XML children of model with name[" << this->Name()
-              << "].\n";
+      if (size > 1)
+      {
+        sdfwarn << "Non-unique name[" << name << "] detected " << size
+                << " times in XML children of model with name["
+                << this->Name() << "].\n";
+      }
     }
   }
 
@@ -213,16 +236,18 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   // name collisions
   std::unordered_set<std::string> frameNames;
 
-  // Load nested models.
-  Errors nestedModelLoadErrors = loadUniqueRepeated<Model>(_sdf, "model",
-    this->dataPtr->models, _config);
+  // Load nested models, concurrently if the config asks for it.
+  Errors nestedModelLoadErrors = loadUniqueRepeatedInParallel<Model>(
+    _config.LoadThreadCount(), _sdf, "model", this->dataPtr->models, _config);
   errors.insert(errors.end(),
                 nestedModelLoadErrors.begin(),
                 nestedModelLoadErrors.end());
 
-  // Nested models are loaded first, and loadUniqueRepeated ensures there are no
-  // duplicate names, so these names can be added to frameNames without
-  // checking uniqueness.
+  this->dataPtr->modelIndex.Rebuild(this->dataPtr->models);
+
+  // Nested models are loaded first, and loadUniqueRepeatedInParallel ensures
+  // there are no duplicate names, so these names can be added to frameNames
+  // without checking uniqueness.
   for (const auto &model : this->dataPtr->models)
   {
     frameNames.insert(model.Name());
@@ -277,9 +302,9 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
   }
 
-  // Load all the links.
-  Errors linkLoadErrors = loadUniqueRepeated<Link>(_sdf, "link",
-    this->dataPtr->links);
+  // Load all the links, concurrently if the config asks for it.
+  Errors linkLoadErrors = loadUniqueRepeatedInParallel<Link>(
+    _config.LoadThreadCount(), _sdf, "link", this->dataPtr->links);
   errors.insert(errors.end(), linkLoadErrors.begin(), linkLoadErrors.end());
 
   // Check links for name collisions and modify and warn if so.
@@ -313,6 +338,7 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
     frameNames.insert(linkName);
   }
+  this->dataPtr->linkIndex.Rebuild(this->dataPtr->links);
 
   // If the model is not static and has no nested models:
   // Require at least one (interface) link so the implicit model frame can be
@@ -361,6 +387,7 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
     frameNames.insert(jointName);
   }
+  this->dataPtr->jointIndex.Rebuild(this->dataPtr->joints);
 
   // Load all the frames.
   Errors frameLoadErrors = loadUniqueRepeated<Frame>(_sdf, "frame",
@@ -398,6 +425,7 @@ Errors Model::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
     frameNames.insert(frameName);
   }
+  this->dataPtr->frameIndex.Rebuild(this->dataPtr->frames);
 
   // Load the model plugins
   Errors pluginErrors = loadRepeated<Plugin>(_sdf, "plugin",
@@ -441,6 +469,7 @@ std::string Model::Name() const
 void Model::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
@@ -508,6 +537,7 @@ const Link *Model::LinkByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Link *Model::LinkByIndex(uint64_t _index)
 {
+  this->dataPtr->linkIndex.Touch(_index);
   return const_cast<Link*>(
       static_cast<const Model*>(this)->LinkByIndex(_index));
 }
@@ -535,6 +565,7 @@ const Joint *Model::JointByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Joint *Model::JointByIndex(uint64_t _index)
 {
+  this->dataPtr->jointIndex.Touch(_index);
   return const_cast<Joint*>(
       static_cast<const Model*>(this)->JointByIndex(_index));
 }
@@ -551,10 +582,12 @@ const Joint *Model::JointByName(const std::string &_name) const
   auto index = _name.rfind("::");
   if (index != std::string::npos)
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const std::string_view name = _name;
+    const Model *model = this->NestedModelByName(name.substr(0, index));
     if (nullptr != model)
     {
-      return model->JointByName(_name.substr(index + 2));
+      return model->dataPtr->jointIndex.Find(
+          model->dataPtr->joints, name.substr(index + 2));
     }
 
     // The nested model name preceding the last "::" could not be found.
@@ -564,22 +597,26 @@ const Joint *Model::JointByName(const std::string &_name) const
     // return nullptr;
   }
 
-  for (auto const &j : this->dataPtr->joints)
-  {
-    if (j.Name() == _name)
-    {
-      return &j;
-    }
-  }
-  return nullptr;
-
+  return this->dataPtr->jointIndex.Find(this->dataPtr->joints, _name);
 }
 
 /////////////////////////////////////////////////
 Joint *Model::JointByName(const std::string &_name)
 {
-  return const_cast<Joint*>(
-      static_cast<const Model*>(this)->JointByName(_name));
+  auto index = _name.rfind("::");
+  if (index != std::string::npos)
+  {
+    const std::string_view name = _name;
+    Model *model = const_cast<Model *>(
+        this->NestedModelByName(name.substr(0, index)));
+    if (nullptr != model)
+      return model->JointByName(_name.substr(index + 2));
+  }
+
+  Joint *joint = const_cast<Joint *>(
+      this->dataPtr->jointIndex.Find(this->dataPtr->joints, _name));
+  this->dataPtr->jointIndex.Touch(this->dataPtr->joints, joint);
+  return joint;
 }
 
 /////////////////////////////////////////////////
@@ -599,6 +636,7 @@ const Frame *Model::FrameByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Frame *Model::FrameByIndex(uint64_t _index)
 {
+  this->dataPtr->frameIndex.Touch(_index);
   return const_cast<Frame*>(
       static_cast<const Model*>(this)->FrameByIndex(_index));
 }
@@ -615,10 +653,12 @@ const Frame *Model::FrameByName(const std::string &_name) const
   auto index = _name.rfind("::");
   if (index != std::string::npos)
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const std::string_view name = _name;
+    const Model *model = this->NestedModelByName(name.substr(0, index));
     if (nullptr != model)
     {
-      return model->FrameByName(_name.substr(index + 2));
+      return model->dataPtr->frameIndex.Find(
+          model->dataPtr->frames, name.substr(index + 2));
     }
 
     // The nested model name preceding the last "::" could not be found.
@@ -628,21 +668,26 @@ const Frame *Model::FrameByName(const std::string &_name) const
     // return nullptr;
   }
 
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return &f;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->frameIndex.Find(this->dataPtr->frames, _name);
 }
 
 /////////////////////////////////////////////////
 Frame *Model::FrameByName(const std::string &_name)
 {
-  return const_cast<Frame*>(
-      static_cast<const Model*>(this)->FrameByName(_name));
+  auto index = _name.rfind("::");
+  if (index != std::string::npos)
+  {
+    const std::string_view name = _name;
+    Model *model = const_cast<Model *>(
+        this->NestedModelByName(name.substr(0, index)));
+    if (nullptr != model)
+      return model->FrameByName(_name.substr(index + 2));
+  }
+
+  Frame *frame = const_cast<Frame *>(
+      this->dataPtr->frameIndex.Find(this->dataPtr->frames, _name));
+  this->dataPtr->frameIndex.Touch(this->dataPtr->frames, frame);
+  return frame;
 }
 
 /////////////////////////////////////////////////
@@ -662,6 +707,7 @@ const Model *Model::ModelByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Model *Model::ModelByIndex(uint64_t _index)
 {
+  this->dataPtr->modelIndex.Touch(_index);
   return const_cast<Model*>(
       static_cast<const Model*>(this)->ModelByIndex(_index));
 }
@@ -675,32 +721,45 @@ bool Model::ModelNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Model *Model::ModelByName(const std::string &_name) const
 {
-  auto index = _name.find("::");
-  const std::string nextModelName = _name.substr(0, index);
-  const Model *nextModel = nullptr;
-
-  for (auto const &m : this->dataPtr->models)
-  {
-    if (m.Name() == nextModelName)
-    {
-      nextModel = &m;
-      break;
-    }
-  }
+  return this->NestedModelByName(_name);
+}
 
-  if (nullptr != nextModel && index != std::string::npos)
+/////////////////////////////////////////////////
+const Model *Model::NestedModelByName(std::string_view _name) const
+{
+  const Model *model = this;
+  while (true)
   {
-    return nextModel->ModelByName(_name.substr(index + 2));
+    auto index = _name.find("::");
+    const Model *nextModel = model->dataPtr->modelIndex.Find(
+        model->dataPtr->models, _name.substr(0, index));
+    if (nullptr == nextModel || index == std::string_view::npos)
+      return nextModel;
+
+    model = nextModel;
+    _name.remove_prefix(index + 2);
   }
-  return nextModel;
-
 }
 
 /////////////////////////////////////////////////
 Model *Model::ModelByName(const std::string &_name)
 {
-  return const_cast<Model*>(
-      static_cast<const Model*>(this)->ModelByName(_name));
+  std::string_view name = _name;
+  Model *parent = this;
+  auto index = name.rfind("::");
+  if (index != std::string_view::npos)
+  {
+    parent = const_cast<Model *>(
+        this->NestedModelByName(name.substr(0, index)));
+    if (nullptr == parent)
+      return nullptr;
+    name.remove_prefix(index + 2);
+  }
+
+  Model *model = const_cast<Model *>(
+      parent->dataPtr->modelIndex.Find(parent->dataPtr->models, name));
+  parent->dataPtr->modelIndex.Touch(parent->dataPtr->models, model);
+  return model;
 }
 
 /////////////////////////////////////////////////
@@ -821,6 +880,7 @@ void Model::SetPoseRelativeToGraph(sdf::ScopedGraph<PoseRelativeToGraph> _graph)
 
   auto childPoseGraph =
       this->dataPtr->poseGraph.ChildModelScope(this->Name());
+  this->dataPtr->childPoseGraph = childPoseGraph;
   for (auto &model : this->dataPtr->models)
   {
     model.SetPoseRelativeToGraph(childPoseGraph);
@@ -886,16 +946,33 @@ sdf::SemanticPose Model::SemanticPose() const
       this->dataPtr->poseGraph);
 }
 
+/////////////////////////////////////////////////
+Errors Model::ResolveAllPoses(
+    std::map<std::string, ignition::math::Pose3d> &_poses,
+    const std::string &_resolveTo) const
+{
+  if (!this->dataPtr->childPoseGraph)
+  {
+    return {{ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Model has invalid pointer to PoseRelativeToGraph."}};
+  }
+
+  return resolveAllPoses(_poses, this->dataPtr->childPoseGraph,
+      _resolveTo.empty() ? "__model__" : _resolveTo);
+}
+
 /////////////////////////////////////////////////
 const Link *Model::LinkByName(const std::string &_name) const
 {
   auto index = _name.rfind("::");
   if (index != std::string::npos)
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const std::string_view name = _name;
+    const Model *model = this->NestedModelByName(name.substr(0, index));
     if (nullptr != model)
     {
-      return model->LinkByName(_name.substr(index + 2));
+      return model->dataPtr->linkIndex.Find(
+          model->dataPtr->links, name.substr(index + 2));
     }
 
     // The nested model name preceding the last "::" could not be found.
@@ -905,22 +982,26 @@ const Link *Model::LinkByName(const std::string &_name) const
     // return nullptr;
   }
 
-  for (auto const &l : this->dataPtr->links)
-  {
-    if (l.Name() == _name)
-    {
-      return &l;
-    }
-  }
-  return nullptr;
-
+  return this->dataPtr->linkIndex.Find(this->dataPtr->links, _name);
 }
 
 /////////////////////////////////////////////////
 Link *Model::LinkByName(const std::string &_name)
 {
-  return const_cast<Link*>(
-      static_cast<const Model*>(this)->LinkByName(_name));
+  auto index = _name.rfind("::");
+  if (index != std::string::npos)
+  {
+    const std::string_view name = _name;
+    Model *model = const_cast<Model *>(
+        this->NestedModelByName(name.substr(0, index)));
+    if (nullptr != model)
+      return model->LinkByName(_name.substr(index + 2));
+  }
+
+  Link *link = const_cast<Link *>(
+      this->dataPtr->linkIndex.Find(this->dataPtr->links, _name));
+  this->dataPtr->linkIndex.Touch(this->dataPtr->links, link);
+  return link;
 }
 
 /////////////////////////////////////////////////
@@ -1055,27 +1136,33 @@ sdf::ElementPtr Model::ToElement(const OutputConfig &_config) const
 //////////////////////////////////////////////////
 bool Model::AddLink(const Link &_link)
 {
+  this->dataPtr->linkIndex.Sync(this->dataPtr->links);
   if (this->LinkNameExists(_link.Name()))
     return false;
   this->dataPtr->links.push_back(_link);
+  this->dataPtr->linkIndex.AddLast(this->dataPtr->links);
   return true;
 }
 
 //////////////////////////////////////////////////
 bool Model::AddJoint(const Joint &_joint)
 {
+  this->dataPtr->jointIndex.Sync(this->dataPtr->joints);
   if (this->JointNameExists(_joint.Name()))
     return false;
   this->dataPtr->joints.push_back(_joint);
+  this->dataPtr->jointIndex.AddLast(this->dataPtr->joints);
   return true;
 }
 
 //////////////////////////////////////////////////
 bool Model::AddModel(const Model &_model)
 {
+  this->dataPtr->modelIndex.Sync(this->dataPtr->models);
   if (this->ModelNameExists(_model.Name()))
     return false;
   this->dataPtr->models.push_back(_model);
+  this->dataPtr->modelIndex.AddLast(this->dataPtr->models);
   return true;
 }
 
@@ -1083,26 +1170,31 @@ bool Model::AddModel(const Model &_model)
 void Model::ClearLinks()
 {
   this->dataPtr->links.clear();
+  this->dataPtr->linkIndex.Clear();
 }
 
 //////////////////////////////////////////////////
 void Model::ClearJoints()
 {
   this->dataPtr->joints.clear();
+  this->dataPtr->jointIndex.Clear();
 }
 
 //////////////////////////////////////////////////
 void Model::ClearModels()
 {
   this->dataPtr->models.clear();
+  this->dataPtr->modelIndex.Clear();
 }
 
 //////////////////////////////////////////////////
 bool Model::AddFrame(const Frame &_frame)
 {
+  this->dataPtr->frameIndex.Sync(this->dataPtr->frames);
   if (this->FrameNameExists(_frame.Name()))
     return false;
   this->dataPtr->frames.push_back(_frame);
+  this->dataPtr->frameIndex.AddLast(this->dataPtr->frames);
   return true;
 }
 
@@ -1110,6 +1202,7 @@ bool Model::AddFrame(const Frame &_frame)
 void Model::ClearFrames()
 {
   this->dataPtr->frames.clear();
+  this->dataPtr->frameIndex.Clear();
 }
 
 /////////////////////////////////////////////////
@@ -15,6 +15,8 @@
  *
 */
 
+#include <string>
+
 #include <gtest/gtest.h>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Frame.hh"
@@ -622,6 +624,110 @@ TEST(DOMModel, MutableByName)
   EXPECT_TRUE(model.FrameNameExists("frame2"));
 }
 
+/////////////////////////////////////////////////
+TEST(DOMModel, ScopedNames)
+{
+  sdf::Model grandchild;
+  grandchild.SetName("grandchild");
+  for (const std::string name : {"link1", "link2"})
+  {
+    sdf::Link link;
+    link.SetName(name);
+    EXPECT_TRUE(grandchild.AddLink(link));
+  }
+  sdf::Joint joint;
+  joint.SetName("joint1");
+  EXPECT_TRUE(grandchild.AddJoint(joint));
+  sdf::Frame frame;
+  frame.SetName("frame1");
+  EXPECT_TRUE(grandchild.AddFrame(frame));
+
+  sdf::Model child;
+  child.SetName("child");
+  EXPECT_TRUE(child.AddModel(grandchild));
+
+  sdf::Model model;
+  model.SetName("model");
+  EXPECT_TRUE(model.AddModel(child));
+
+  // Copies of the model share no state, so look up names in a copy.
+  const sdf::Model copy = model;
+  const sdf::Model *nested = copy.ModelByName("child::grandchild");
+  ASSERT_NE(nullptr, nested);
+  EXPECT_EQ("grandchild", nested->Name());
+  EXPECT_EQ(nested->LinkByIndex(1),
+            copy.LinkByName("child::grandchild::link2"));
+  EXPECT_EQ(nested->JointByIndex(0),
+            copy.JointByName("child::grandchild::joint1"));
+  EXPECT_EQ(nested->FrameByIndex(0),
+            copy.FrameByName("child::grandchild::frame1"));
+  EXPECT_EQ(nullptr, copy.LinkByName("child::grandchild::link3"));
+  EXPECT_EQ(nullptr, copy.LinkByName("child::link1"));
+  EXPECT_EQ(nullptr, copy.ModelByName("child::grandchild::link1"));
+  EXPECT_EQ(nullptr, copy.ModelByName("child::"));
+
+  // Renaming a link through a pointer changes the result of the lookups.
+  sdf::Model *mutableNested = model.ModelByName("child::grandchild");
+  ASSERT_NE(nullptr, mutableNested);
+  mutableNested->LinkByIndex(0)->SetName("link3");
+  EXPECT_EQ(nullptr, model.LinkByName("child::grandchild::link1"));
+  EXPECT_EQ(mutableNested->LinkByIndex(0),
+            model.LinkByName("child::grandchild::link3"));
+
+  // A link with the name of an earlier link is not added.
+  sdf::Link link;
+  link.SetName("link2");
+  EXPECT_FALSE(mutableNested->AddLink(link));
+  link.SetName("link4");
+  EXPECT_TRUE(mutableNested->AddLink(link));
+  EXPECT_EQ(mutableNested->LinkByIndex(2),
+            model.LinkByName("child::grandchild::link4"));
+
+  // So does renaming a link through a pointer found by name, or giving it
+  // the name of an earlier link.
+  sdf::Link *mutableLink = model.LinkByName("child::grandchild::link4");
+  ASSERT_NE(nullptr, mutableLink);
+  mutableLink->SetName("link5");
+  EXPECT_EQ(nullptr, mutableNested->LinkByName("link4"));
+  EXPECT_EQ(mutableLink, mutableNested->LinkByName("link5"));
+  EXPECT_FALSE(mutableNested->AddLink(*mutableLink));
+  mutableNested->LinkByIndex(2)->SetName("link2");
+  EXPECT_EQ(mutableNested->LinkByIndex(1),
+            model.LinkByName("child::grandchild::link2"));
+  EXPECT_EQ(nullptr, model.LinkByName("child::grandchild::link5"));
+
+  // Pointers kept from before the last lookup rename entities too.
+  sdf::Link *keptLink = mutableNested->LinkByIndex(0);
+  sdf::Joint *keptJoint = mutableNested->JointByIndex(0);
+  sdf::Frame *keptFrame = mutableNested->FrameByIndex(0);
+  sdf::Model *keptModel = model.ModelByIndex(0);
+  EXPECT_TRUE(mutableNested->LinkNameExists("link3"));
+  EXPECT_TRUE(mutableNested->JointNameExists("joint1"));
+  EXPECT_TRUE(mutableNested->FrameNameExists("frame1"));
+  EXPECT_TRUE(model.ModelNameExists("child"));
+  keptLink->SetName("link6");
+  keptJoint->SetName("joint2");
+  keptFrame->SetName("frame2");
+  keptModel->SetName("child2");
+  EXPECT_EQ(keptLink, mutableNested->LinkByName("link6"));
+  EXPECT_EQ(keptJoint, mutableNested->JointByName("joint2"));
+  EXPECT_EQ(keptFrame, mutableNested->FrameByName("frame2"));
+  EXPECT_EQ(keptModel, model.ModelByName("child2"));
+  EXPECT_EQ(keptLink, model.LinkByName("child2::grandchild::link6"));
+  EXPECT_EQ(nullptr, model.LinkByName("child::grandchild::link6"));
+  EXPECT_FALSE(mutableNested->LinkNameExists("link3"));
+  keptModel->SetName("child");
+
+  mutableNested->ClearLinks();
+  EXPECT_EQ(nullptr, model.LinkByName("child::grandchild::link2"));
+  EXPECT_TRUE(mutableNested->AddLink(link));
+  EXPECT_EQ(mutableNested->LinkByIndex(0),
+            model.LinkByName("child::grandchild::link4"));
+
+  // The copy is unchanged.
+  EXPECT_NE(nullptr, copy.LinkByName("child::grandchild::link1"));
+}
+
 /////////////////////////////////////////////////
 TEST(DOMModel, Plugins)
 {
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_NAMEINDEX_HH
+#define SDFORMAT_NAMEINDEX_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Index from the names of the entities in a vector, such as the
+  /// links of a model, to their positions in the vector.
+  ///
+  /// The index holds hashes of the names rather than the names, so that
+  /// names can be looked up from a std::string_view without a copy. It is
+  /// kept exact, so a name that is not found is not in the vector: the
+  /// functions that add or remove entities update it, and the functions
+  /// that hand out a non-const pointer to an entity call Touch, since the
+  /// entity may be replaced through the pointer. The names of touched
+  /// entities are hashed again before the next lookup.
+  ///
+  /// Pointers to entities may also be kept and used to rename them after
+  /// that lookup. The index remembers which entities were handed out, and
+  /// the SetName functions of the indexed kinds of entities call Renamed,
+  /// which counts the renames of the process. A lookup that misses while
+  /// renames were counted since the index was last hashed also compares the
+  /// names of the entities that were handed out, and the next Touch or
+  /// addition hashes their names again. A lookup that hits is always
+  /// correct, since each hit is compared with the name.
+  ///
+  /// Lookups may run on several threads at once, as they do for other
+  /// const functions of the DOM. Touch and the other non-const functions
+  /// may not run at the same time as a lookup.
+  ///
+  /// Positions stay valid when the owner of the vector is copied, so the
+  /// index is copied along with it.
+  class NameIndex
+  {
+    /// \brief Default constructor.
+    public: NameIndex() = default;
+
+    /// \brief Copy constructor.
+    /// \param[in] _index Index to copy.
+    public: NameIndex(const NameIndex &_index)
+    {
+      *this = _index;
+    }
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _index Index to copy.
+    /// \return Reference to this index.
+    public: NameIndex &operator=(const NameIndex &_index)
+    {
+      if (this != &_index)
+      {
+        std::lock_guard<std::mutex> lock(_index.mutex);
+        this->positions = _index.positions;
+        this->hashes = _index.hashes;
+        this->touched = _index.touched;
+        this->touchedPositions = _index.touchedPositions;
+        this->hasTouched = _index.hasTouched.load();
+        this->handedOut = _index.handedOut;
+        this->handedOutPositions = _index.handedOutPositions;
+        this->generation = _index.generation;
+      }
+      return *this;
+    }
+
+    /// \brief Index every entity in a vector, replacing the current index.
+    /// \param[in] _items The entities.
+    public: template <typename T>
+            void Rebuild(const std::vector<T> &_items)
+    {
+      this->Clear();
+      this->positions.reserve(_items.size());
+      this->hashes.reserve(_items.size());
+      for (std::size_t i = 0; i < _items.size(); ++i)
+      {
+        this->hashes.push_back(Hash(_items[i].Name()));
+        this->positions.emplace(this->hashes.back(), i);
+      }
+      this->touched.assign(_items.size(), false);
+      this->handedOut.assign(_items.size(), false);
+    }
+
+    /// \brief Index the last entity in a vector, after it was appended.
+    /// \param[in] _items The entities.
+    public: template <typename T>
+            void AddLast(const std::vector<T> &_items)
+    {
+      if (_items.empty())
+        return;
+
+      this->hashes.push_back(Hash(_items.back().Name()));
+      this->positions.emplace(this->hashes.back(), _items.size() - 1);
+      this->touched.push_back(false);
+      this->handedOut.push_back(false);
+    }
+
+    /// \brief Remove every entity from the index.
+    public: void Clear()
+    {
+      this->positions.clear();
+      this->hashes.clear();
+      this->touched.clear();
+      this->touchedPositions.clear();
+      this->hasTouched = false;
+      this->handedOut.clear();
+      this->handedOutPositions.clear();
+      this->generation = Generation().load(std::memory_order_acquire);
+    }
+
+    /// \brief Note that a non-const pointer to an entity was handed out, so
+    /// that its name is hashed again before the next lookup.
+    /// \param[in] _position Position of the entity. Positions that are not
+    /// indexed are ignored.
+    public: void Touch(std::size_t _position)
+    {
+      if (_position >= this->touched.size())
+        return;
+
+      if (!this->handedOut[_position])
+      {
+        this->handedOut[_position] = true;
+        this->handedOutPositions.push_back(_position);
+      }
+      if (this->touched[_position])
+        return;
+
+      this->touched[_position] = true;
+      this->touchedPositions.push_back(_position);
+      this->hasTouched.store(true, std::memory_order_release);
+    }
+
+    /// \brief Hash the names of the entities that were handed out again if
+    /// entities were renamed since the index was last hashed, so that
+    /// lookups that miss need no fallback. Called by the functions that add
+    /// entities, before they look up the name of the new entity.
+    /// \param[in] _items The entities, which were indexed.
+    public: template <typename T>
+            void Sync(const std::vector<T> &_items)
+    {
+      const uint64_t current = Generation().load(std::memory_order_acquire);
+      if (this->generation == current)
+        return;
+
+      for (std::size_t position : this->handedOutPositions)
+      {
+        if (!this->touched[position])
+        {
+          this->touched[position] = true;
+          this->touchedPositions.push_back(position);
+        }
+      }
+      this->hasTouched = !this->touchedPositions.empty();
+      if (this->hasTouched)
+        this->Refresh(_items);
+      this->generation = current;
+    }
+
+    /// \brief Note that a non-const pointer to an entity was handed out, so
+    /// that its name is hashed again before the next lookup. Calls Sync
+    /// first.
+    /// \param[in] _items The entities, which were indexed.
+    /// \param[in] _item The entity, which may be nullptr.
+    public: template <typename T>
+            void Touch(const std::vector<T> &_items, const T *_item)
+    {
+      this->Sync(_items);
+      if (nullptr != _item && !_items.empty() && _item >= _items.data() &&
+          _item < _items.data() + _items.size())
+      {
+        this->Touch(static_cast<std::size_t>(_item - _items.data()));
+      }
+    }
+
+    /// \brief Find an entity in a vector by its name.
+    /// \param[in] _items The entities, which were indexed.
+    /// \param[in] _name Name of the entity.
+    /// \return The first entity with the name, or nullptr if no entity has
+    /// the name.
+    public: template <typename T>
+            const T *Find(const std::vector<T> &_items,
+                          std::string_view _name) const
+    {
+      if (this->hasTouched.load(std::memory_order_acquire))
+        this->Refresh(_items);
+
+      // Hashes may collide, and several entities may have the same name, so
+      // each hit is checked and the first matching entity is kept.
+      const T *found = nullptr;
+      auto range = this->positions.equal_range(Hash(_name));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second < _items.size() && _items[it->second].Name() == _name &&
+            (nullptr == found || &_items[it->second] < found))
+        {
+          found = &_items[it->second];
+        }
+      }
+
+      // An entity that was handed out may have been renamed through a
+      // pointer that was kept. The index is not changed here, since other
+      // lookups may be reading it.
+      if (nullptr == found && !this->handedOutPositions.empty() &&
+          this->generation != Generation().load(std::memory_order_acquire))
+      {
+        for (std::size_t position : this->handedOutPositions)
+        {
+          if (position < _items.size() && _items[position].Name() == _name &&
+              (nullptr == found || &_items[position] < found))
+          {
+            found = &_items[position];
+          }
+        }
+      }
+      return found;
+    }
+
+    /// \brief Count a rename of an entity of the kinds that are indexed, so
+    /// that lookups that miss compare the names of the entities that were
+    /// handed out until the index is synced. Called by their SetName
+    /// functions.
+    public: static void Renamed()
+    {
+      Generation().fetch_add(1, std::memory_order_release);
+    }
+
+    /// \brief Hash the names of the touched entities again.
+    /// \param[in] _items The entities, which were indexed.
+    private: template <typename T>
+             void Refresh(const std::vector<T> &_items) const
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->hasTouched.load(std::memory_order_relaxed))
+        return;
+
+      for (std::size_t position : this->touchedPositions)
+      {
+        this->touched[position] = false;
+        if (position >= _items.size())
+          continue;
+
+        const std::size_t hash = Hash(_items[position].Name());
+        if (hash == this->hashes[position])
+          continue;
+
+        auto range = this->positions.equal_range(this->hashes[position]);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          if (it->second == position)
+          {
+            this->positions.erase(it);
+            break;
+          }
+        }
+        this->positions.emplace(hash, position);
+        this->hashes[position] = hash;
+      }
+      this->touchedPositions.clear();
+      this->hasTouched.store(false, std::memory_order_release);
+    }
+
+    /// \brief Get the number of renames counted by Renamed.
+    /// \return The count.
+    private: static std::atomic<uint64_t> &Generation()
+    {
+      static std::atomic<uint64_t> generation{0};
+      return generation;
+    }
+
+    /// \brief Hash a name.
+    /// \param[in] _name The name.
+    /// \return The hash.
+    private: static std::size_t Hash(std::string_view _name)
+    {
+      return std::hash<std::string_view>()(_name);
+    }
+
+    /// \brief Positions of the entities, keyed by the hashes of their names.
+    private: mutable std::unordered_multimap<std::size_t, std::size_t>
+             positions;
+
+    /// \brief Hash of the name of each entity, by position.
+    private: mutable std::vector<std::size_t> hashes;
+
+    /// \brief Whether each entity was touched since its name was hashed.
+    private: mutable std::vector<bool> touched;
+
+    /// \brief Positions of the touched entities.
+    private: mutable std::vector<std::size_t> touchedPositions;
+
+    /// \brief Whether any entity was touched since the last lookup.
+    private: mutable std::atomic<bool> hasTouched{false};
+
+    /// \brief Whether a non-const pointer to each entity was handed out
+    /// since the entity was indexed.
+    private: std::vector<bool> handedOut;
+
+    /// \brief Positions of the entities that were handed out.
+    private: std::vector<std::size_t> handedOutPositions;
+
+    /// \brief Value of Generation when the names of the entities that were
+    /// handed out were last hashed.
+    private: uint64_t generation = 0;
+
+    /// \brief Guards the hashing of touched entities by concurrent lookups.
+    private: mutable std::mutex mutex;
+  };
+  }
+}
+#endif
@@ -0,0 +1,499 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+// Floating point std::from_chars is not available in every standard library
+// we support (e.g. libstdc++ before GCC 11). Those fall back to the C
+// library's strtod_l with an explicit "C" locale, which is also locale
+// independent.
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define SDF_FLOATING_FROM_CHARS
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <locale.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+#endif
+
+#include "NumericParsing.hh"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+namespace
+{
+//////////////////////////////////////////////////
+/// \brief Whether a character is whitespace in the classic locale.
+bool isSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' ||
+         _c == '\f' || _c == '\r';
+}
+
+//////////////////////////////////////////////////
+bool isDigit(char _c)
+{
+  return _c >= '0' && _c <= '9';
+}
+
+//////////////////////////////////////////////////
+bool isHexDigit(char _c)
+{
+  return isDigit(_c) || (_c >= 'a' && _c <= 'f') || (_c >= 'A' && _c <= 'F');
+}
+
+//////////////////////////////////////////////////
+/// \brief Whether [_first, _last) starts with a "0x" or "0X" prefix that
+/// strtol/strtod would consume, i.e. one followed by a hex digit.
+/// \param[in] _allowPoint Also accept "0x." followed by a hex digit, as
+/// hexadecimal floating point numbers do.
+bool hasHexPrefix(const char *_first, const char *_last, bool _allowPoint)
+{
+  if (_last - _first < 3 || _first[0] != '0' ||
+      (_first[1] != 'x' && _first[1] != 'X'))
+  {
+    return false;
+  }
+  if (isHexDigit(_first[2]))
+    return true;
+  return _allowPoint && _first[2] == '.' && _last - _first > 3 &&
+         isHexDigit(_first[3]);
+}
+
+//////////////////////////////////////////////////
+/// \brief Skip leading whitespace and a single optional sign, as the
+/// strto* functions do.
+/// \param[out] _negative Set to true if a minus sign was skipped.
+/// \return Pointer to the first character after the sign.
+const char *skipSpaceAndSign(const char *_first, const char *_last,
+                             bool &_negative)
+{
+  while (_first != _last && isSpace(*_first))
+    ++_first;
+
+  _negative = false;
+  if (_first != _last && (*_first == '+' || *_first == '-'))
+  {
+    _negative = *_first == '-';
+    ++_first;
+  }
+  return _first;
+}
+
+#ifndef SDF_FLOATING_FROM_CHARS
+#ifdef _WIN32
+using CLocale = _locale_t;
+#else
+using CLocale = locale_t;
+#endif
+
+//////////////////////////////////////////////////
+/// \brief A "C" numeric locale created once and never modified.
+CLocale classicCLocale()
+{
+#ifdef _WIN32
+  static const CLocale loc = _create_locale(LC_NUMERIC, "C");
+#else
+  static const CLocale loc =
+      newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+#endif
+  return loc;
+}
+
+//////////////////////////////////////////////////
+void strtoClassic(const char *_str, char **_end, double &_value)
+{
+#ifdef _WIN32
+  _value = _strtod_l(_str, _end, classicCLocale());
+#else
+  _value = strtod_l(_str, _end, classicCLocale());
+#endif
+}
+
+//////////////////////////////////////////////////
+void strtoClassic(const char *_str, char **_end, float &_value)
+{
+#ifdef _WIN32
+  _value = _strtof_l(_str, _end, classicCLocale());
+#else
+  _value = strtof_l(_str, _end, classicCLocale());
+#endif
+}
+#endif
+
+//////////////////////////////////////////////////
+/// \brief Parse an unsigned floating point number, without sign, from the
+/// start of [_first, _last).
+/// \param[in] _hex Whether the number is hexadecimal. The "0x" prefix must
+/// already have been skipped.
+/// \param[out] _end Set to one past the last character consumed.
+/// \return std::errc{} on success, otherwise invalid_argument or
+/// result_out_of_range.
+template<typename T>
+std::errc fromChars(const char *_first, const char *_last, bool _hex,
+                    T &_value, const char *&_end)
+{
+#ifdef SDF_FLOATING_FROM_CHARS
+  const auto result = std::from_chars(_first, _last, _value,
+      _hex ? std::chars_format::hex : std::chars_format::general);
+  _end = result.ptr;
+  return result.ec;
+#else
+  // strtod_l needs a null terminated string, and expects the hex prefix.
+  std::string buffer(_hex ? "0x" : "");
+  buffer.append(_first, _last);
+  char *end = nullptr;
+  errno = 0;
+  strtoClassic(buffer.c_str(), &end, _value);
+  const std::ptrdiff_t consumed = end - buffer.c_str();
+  if (consumed == 0)
+  {
+    _end = _first;
+    return std::errc::invalid_argument;
+  }
+  _end = _first + consumed - (_hex ? 2 : 0);
+  if (errno == ERANGE)
+    return std::errc::result_out_of_range;
+  return std::errc{};
+#endif
+}
+
+//////////////////////////////////////////////////
+/// \brief Implementation of parseDouble and parseFloat.
+template<typename T>
+NumericParseResult parseFloating(std::string_view _input, T &_value)
+{
+  const char *last = _input.data() + _input.size();
+  bool negative = false;
+  const char *first = skipSpaceAndSign(_input.data(), last, negative);
+
+  // A second sign or whitespace after the sign is never valid, but
+  // std::from_chars would accept a minus and strtod_l the whitespace.
+  if (first == last || *first == '+' || *first == '-' || isSpace(*first))
+    return NumericParseResult::INVALID_ARGUMENT;
+
+  const bool hex = hasHexPrefix(first, last, true);
+  if (hex)
+    first += 2;
+
+  T value;
+  const char *end = nullptr;
+  const std::errc ec = fromChars(first, last, hex, value, end);
+  if (ec == std::errc::invalid_argument)
+    return NumericParseResult::INVALID_ARGUMENT;
+
+  // The strto* functions report underflow to a subnormal result as a range
+  // error too, which std::stod turns into std::out_of_range.
+  if (ec == std::errc::result_out_of_range ||
+      std::fpclassify(value) == FP_SUBNORMAL)
+  {
+    return NumericParseResult::OUT_OF_RANGE;
+  }
+
+  _value = negative ? -value : value;
+  return NumericParseResult::OK;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse the sign and magnitude of an integer the way strtoul does.
+NumericParseResult parseMagnitude(std::string_view _input, int _base,
+                                  bool &_negative,
+                                  unsigned long long &_magnitude)
+{
+  const char *last = _input.data() + _input.size();
+  const char *first = skipSpaceAndSign(_input.data(), last, _negative);
+  if (_base == 16 && hasHexPrefix(first, last, false))
+    first += 2;
+
+  if (first == last || *first == '+' || *first == '-')
+    return NumericParseResult::INVALID_ARGUMENT;
+
+  const auto result = std::from_chars(first, last, _magnitude, _base);
+  if (result.ec == std::errc::invalid_argument)
+    return NumericParseResult::INVALID_ARGUMENT;
+  if (result.ec == std::errc::result_out_of_range)
+    return NumericParseResult::OUT_OF_RANGE;
+  return NumericParseResult::OK;
+}
+
+//////////////////////////////////////////////////
+/// \brief Whether _token is a plain decimal number, in the form that both
+/// std::num_get and std::from_chars read completely:
+/// -?(digits(.digits?)?|.digits)([eE][+-]?digits)?
+bool isPlainDecimal(std::string_view _token)
+{
+  std::size_t i = 0;
+  const std::size_t n = _token.size();
+  if (i < n && _token[i] == '-')
+    ++i;
+
+  std::size_t digits = 0;
+  while (i < n && isDigit(_token[i]))
+  {
+    ++i;
+    ++digits;
+  }
+  if (i < n && _token[i] == '.')
+  {
+    ++i;
+    while (i < n && isDigit(_token[i]))
+    {
+      ++i;
+      ++digits;
+    }
+  }
+  if (digits == 0)
+    return false;
+
+  if (i < n && (_token[i] == 'e' || _token[i] == 'E'))
+  {
+    ++i;
+    if (i < n && (_token[i] == '+' || _token[i] == '-'))
+      ++i;
+    const std::size_t exponentStart = i;
+    while (i < n && isDigit(_token[i]))
+      ++i;
+    if (i == exponentStart)
+      return false;
+  }
+  return i == n;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse a whole token the way a classic locale stream would, or
+/// return false if the token is not in the plain form handled here.
+bool tryParseToken(std::string_view _token, double &_value)
+{
+  if (!isPlainDecimal(_token))
+    return false;
+
+  const bool negative = _token[0] == '-';
+  const char *first = _token.data() + (negative ? 1 : 0);
+  const char *last = _token.data() + _token.size();
+  double value;
+  const char *end = nullptr;
+  // Leave range errors and subnormal results to the stream, whose handling
+  // of them differs between standard library versions.
+  if (fromChars(first, last, false, value, end) != std::errc{} ||
+      end != last || std::fpclassify(value) == FP_SUBNORMAL)
+  {
+    return false;
+  }
+  _value = negative ? -value : value;
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \copydoc tryParseToken(std::string_view, double &)
+template<typename T>
+bool tryParseToken(std::string_view _token, T &_value)
+{
+  static_assert(std::numeric_limits<T>::is_integer);
+
+  // The stream also accepts a leading '+', and a '-' for unsigned types,
+  // but those are rare enough to leave to the fallback.
+  if (_token.empty() || (_token[0] == '-' && !std::is_signed_v<T>))
+    return false;
+
+  const char *last = _token.data() + _token.size();
+  const auto result = std::from_chars(_token.data(), last, _value);
+  return result.ec == std::errc{} && result.ptr == last;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse the first N whitespace separated tokens of _input, ignoring
+/// anything after them as a stream would.
+template<typename T, std::size_t N>
+bool tryParseTokens(std::string_view _input, std::array<T, N> &_values)
+{
+  const char *p = _input.data();
+  const char *last = p + _input.size();
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    while (p != last && isSpace(*p))
+      ++p;
+    const char *start = p;
+    while (p != last && !isSpace(*p))
+      ++p;
+    if (start == p ||
+        !tryParseToken(std::string_view(start, p - start), _values[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string_view> splitOnWhitespace(std::string_view _input)
+{
+  std::vector<std::string_view> tokens;
+  const char *p = _input.data();
+  const char *last = p + _input.size();
+  while (p != last)
+  {
+    while (p != last && isSpace(*p))
+      ++p;
+    const char *start = p;
+    while (p != last && !isSpace(*p))
+      ++p;
+    if (start != p)
+      tokens.emplace_back(start, p - start);
+  }
+  return tokens;
+}
+
+//////////////////////////////////////////////////
+NumericParseResult parseInt(std::string_view _input, int _base, int &_value)
+{
+  bool negative = false;
+  unsigned long long magnitude = 0;
+  const NumericParseResult result =
+      parseMagnitude(_input, _base, negative, magnitude);
+  if (result != NumericParseResult::OK)
+    return result;
+
+  const unsigned long long limit = negative ?
+      static_cast<unsigned long long>(std::numeric_limits<int>::max()) + 1u :
+      static_cast<unsigned long long>(std::numeric_limits<int>::max());
+  if (magnitude > limit)
+    return NumericParseResult::OUT_OF_RANGE;
+
+  _value = negative ?
+      static_cast<int>(-static_cast<long long>(magnitude)) :
+      static_cast<int>(magnitude);
+  return NumericParseResult::OK;
+}
+
+//////////////////////////////////////////////////
+NumericParseResult parseUnsignedLong(std::string_view _input, int _base,
+                                     unsigned long &_value)
+{
+  bool negative = false;
+  unsigned long long magnitude = 0;
+  const NumericParseResult result =
+      parseMagnitude(_input, _base, negative, magnitude);
+  if (result != NumericParseResult::OK)
+    return result;
+
+  if (magnitude > std::numeric_limits<unsigned long>::max())
+    return NumericParseResult::OUT_OF_RANGE;
+
+  const unsigned long value = static_cast<unsigned long>(magnitude);
+  _value = negative ? 0ul - value : value;
+  return NumericParseResult::OK;
+}
+
+//////////////////////////////////////////////////
+NumericParseResult parseDouble(std::string_view _input, double &_value)
+{
+  return parseFloating(_input, _value);
+}
+
+//////////////////////////////////////////////////
+NumericParseResult parseFloat(std::string_view _input, float &_value)
+{
+  return parseFloating(_input, _value);
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, std::uint64_t &_value)
+{
+  std::array<std::uint64_t, 1> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value = values[0];
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, sdf::Time &_value)
+{
+  std::array<std::int32_t, 2> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value.sec = values[0];
+  _value.nsec = values[1];
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, ignition::math::Angle &_value)
+{
+  std::array<double, 1> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value.Radian(values[0]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, ignition::math::Vector2i &_value)
+{
+  std::array<int, 2> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value.Set(values[0], values[1]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, ignition::math::Vector2d &_value)
+{
+  std::array<double, 2> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value.Set(values[0], values[1]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, ignition::math::Vector3d &_value)
+{
+  std::array<double, 3> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value.Set(values[0], values[1], values[2]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool tryParse(std::string_view _input, ignition::math::Quaterniond &_value)
+{
+  // The stream operator reads roll, pitch and yaw angles.
+  std::array<double, 3> values{};
+  if (!tryParseTokens(_input, values))
+    return false;
+  _value.Euler(ignition::math::Vector3d(values[0], values[1], values[2]));
+  return true;
+}
+}
+}
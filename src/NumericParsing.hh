@@ -0,0 +1,125 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_NUMERICPARSING_HH
+#define SDFORMAT_NUMERICPARSING_HH
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Types.hh"
+
+/// \file NumericParsing.hh
+/// \brief Locale independent number parsing used by sdf::Param.
+///
+/// The functions in this file never consult the global C or C++ locale, so
+/// they can be called concurrently with code that changes the locale. The
+/// scalar functions accept the same syntax and report the same errors as
+/// their std::sto* counterparts in the "C" locale. The tryParse functions
+/// are fast paths for values that sdf::Param used to read with a classic
+/// locale std::stringstream.
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Outcome of a numeric parse, mirroring the exceptions thrown by
+  /// the std::sto* family.
+  enum class NumericParseResult
+  {
+    /// \brief A value was parsed.
+    OK,
+
+    /// \brief No conversion could be performed, like std::invalid_argument.
+    INVALID_ARGUMENT,
+
+    /// \brief The value does not fit the type, like std::out_of_range.
+    OUT_OF_RANGE
+  };
+
+  /// \brief Split a string on whitespace, as `stream >> std::string` does
+  /// in the classic locale.
+  /// \param[in] _input String to split.
+  /// \return Views into _input, one per non-empty token.
+  std::vector<std::string_view> splitOnWhitespace(std::string_view _input);
+
+  /// \brief Parse an int like std::stoi(_input, nullptr, _base).
+  /// \param[in] _input String to parse. Trailing characters are ignored.
+  /// \param[in] _base Numeric base, either 10 or 16.
+  /// \param[out] _value Parsed value, only set on success.
+  /// \return Result of the parse.
+  NumericParseResult parseInt(
+      std::string_view _input, int _base, int &_value);
+
+  /// \brief Parse an unsigned long like std::stoul(_input, nullptr, _base).
+  /// As with std::stoul, a leading minus sign negates the value modulo
+  /// 2^N.
+  /// \param[in] _input String to parse. Trailing characters are ignored.
+  /// \param[in] _base Numeric base, either 10 or 16.
+  /// \param[out] _value Parsed value, only set on success.
+  /// \return Result of the parse.
+  NumericParseResult parseUnsignedLong(
+      std::string_view _input, int _base, unsigned long &_value);
+
+  /// \brief Parse a double like std::stod(_input).
+  /// \param[in] _input String to parse. Trailing characters are ignored.
+  /// \param[out] _value Parsed value, only set on success.
+  /// \return Result of the parse.
+  NumericParseResult parseDouble(std::string_view _input, double &_value);
+
+  /// \brief Parse a float like std::stof(_input).
+  /// \param[in] _input String to parse. Trailing characters are ignored.
+  /// \param[out] _value Parsed value, only set on success.
+  /// \return Result of the parse.
+  NumericParseResult parseFloat(std::string_view _input, float &_value);
+
+  /// \brief Parse _input without a stream. Each tryParse overload returns
+  /// true only when it produced exactly the value that reading the type
+  /// from a classic locale std::stringstream would. A false return means
+  /// the input is not in the common form handled here (or is invalid), and
+  /// the caller should fall back to the stream to get its exact behavior.
+  /// \param[in] _input String to parse.
+  /// \param[out] _value Parsed value, only set on success.
+  /// \return True if _value was set.
+  bool tryParse(std::string_view _input, std::uint64_t &_value);
+
+  /// \copydoc tryParse(std::string_view, std::uint64_t &)
+  bool tryParse(std::string_view _input, sdf::Time &_value);
+
+  /// \copydoc tryParse(std::string_view, std::uint64_t &)
+  bool tryParse(std::string_view _input, ignition::math::Angle &_value);
+
+  /// \copydoc tryParse(std::string_view, std::uint64_t &)
+  bool tryParse(std::string_view _input, ignition::math::Vector2i &_value);
+
+  /// \copydoc tryParse(std::string_view, std::uint64_t &)
+  bool tryParse(std::string_view _input, ignition::math::Vector2d &_value);
+
+  /// \copydoc tryParse(std::string_view, std::uint64_t &)
+  bool tryParse(std::string_view _input, ignition::math::Vector3d &_value);
+
+  /// \copydoc tryParse(std::string_view, std::uint64_t &)
+  bool tryParse(std::string_view _input, ignition::math::Quaterniond &_value);
+  }
+}
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <locale>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "NumericParsing.hh"
+
+using sdf::NumericParseResult;
+
+/// \brief Fragments that random inputs are built from. They are chosen to
+/// hit the corners of the number grammars: signs, hex prefixes, exponents,
+/// special values, range limits and garbage.
+static const std::vector<std::string> kFragments = {
+  "0", "1", "7", "42", "-", "+", ".", "e", "E", "e-", "e+", "x", "0x", "0X",
+  "f", "A", "inf", "nan", "INFINITY", "p3", "1e400", "1e-400", "4.9e-324",
+  "2147483647", "2147483648", "4294967295", "4294967296",
+  "18446744073709551615", "18446744073709551616", "0.1", "3.14159",
+  " ", "  ", "\t", "\n", "abc", ",",
+};
+
+//////////////////////////////////////////////////
+/// \brief Build a random input from kFragments.
+std::string randomInput(std::mt19937 &_gen)
+{
+  std::uniform_int_distribution<std::size_t> count(0, 7);
+  std::uniform_int_distribution<std::size_t> pick(0, kFragments.size() - 1);
+  std::string result;
+  for (std::size_t i = count(_gen); i > 0; --i)
+    result += kFragments[pick(_gen)];
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Run one of the std::sto* functions and map its exceptions to a
+/// NumericParseResult.
+NumericParseResult stdResult(const std::function<void()> &_parse)
+{
+  try
+  {
+    _parse();
+  }
+  catch(std::invalid_argument &)
+  {
+    return NumericParseResult::INVALID_ARGUMENT;
+  }
+  catch(std::out_of_range &)
+  {
+    return NumericParseResult::OUT_OF_RANGE;
+  }
+  return NumericParseResult::OK;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compare floating point values, treating NaNs as equal.
+template<typename T>
+bool sameValue(T _a, T _b)
+{
+  if (std::isnan(_a) || std::isnan(_b))
+    return std::isnan(_a) && std::isnan(_b);
+  return std::memcmp(&_a, &_b, sizeof(T)) == 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that parseInt, parseUnsignedLong, parseDouble and
+/// parseFloat agree with std::stoi, stoul, stod and stof on _input.
+void checkScalars(const std::string &_input)
+{
+  for (int base : {10, 16})
+  {
+    int expected = 0;
+    int value = 0;
+    EXPECT_EQ(stdResult([&]{expected = std::stoi(_input, nullptr, base);}),
+              sdf::parseInt(_input, base, value)) << "[" << _input << "]";
+    EXPECT_EQ(expected, value) << "[" << _input << "]";
+  }
+
+  for (int base : {10, 16})
+  {
+    unsigned long expected = 0;
+    unsigned long value = 0;
+    EXPECT_EQ(stdResult([&]{expected = std::stoul(_input, nullptr, base);}),
+              sdf::parseUnsignedLong(_input, base, value))
+        << "[" << _input << "]";
+    EXPECT_EQ(expected, value) << "[" << _input << "]";
+  }
+
+  {
+    double expected = 0;
+    double value = 0;
+    EXPECT_EQ(stdResult([&]{expected = std::stod(_input);}),
+              sdf::parseDouble(_input, value)) << "[" << _input << "]";
+    EXPECT_TRUE(sameValue(expected, value)) << "[" << _input << "]";
+  }
+
+  {
+    float expected = 0;
+    float value = 0;
+    EXPECT_EQ(stdResult([&]{expected = std::stof(_input);}),
+              sdf::parseFloat(_input, value)) << "[" << _input << "]";
+    EXPECT_TRUE(sameValue(expected, value)) << "[" << _input << "]";
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that, whenever tryParse accepts _input, reading the type
+/// from a classic locale stream succeeds with the same value.
+template<typename T>
+void checkStreamEquivalent(const std::string &_input)
+{
+  T value;
+  if (!sdf::tryParse(_input, value))
+    return;
+
+  std::stringstream ss(_input);
+  ss.imbue(std::locale::classic());
+  T expected;
+  ss >> expected;
+  EXPECT_FALSE(ss.fail()) << "[" << _input << "]";
+  EXPECT_EQ(expected, value) << "[" << _input << "]";
+}
+
+//////////////////////////////////////////////////
+void checkAll(const std::string &_input)
+{
+  checkScalars(_input);
+  checkStreamEquivalent<std::uint64_t>(_input);
+  checkStreamEquivalent<sdf::Time>(_input);
+  checkStreamEquivalent<ignition::math::Angle>(_input);
+  checkStreamEquivalent<ignition::math::Vector2i>(_input);
+  checkStreamEquivalent<ignition::math::Vector2d>(_input);
+  checkStreamEquivalent<ignition::math::Vector3d>(_input);
+  checkStreamEquivalent<ignition::math::Quaterniond>(_input);
+}
+
+/////////////////////////////////////////////////
+TEST(NumericParsing, SplitOnWhitespace)
+{
+  EXPECT_TRUE(sdf::splitOnWhitespace("").empty());
+  EXPECT_TRUE(sdf::splitOnWhitespace(" \t\n\v\f\r").empty());
+
+  const auto tokens = sdf::splitOnWhitespace("  1 2.5\t\n-3e4\rabc ");
+  ASSERT_EQ(4u, tokens.size());
+  EXPECT_EQ("1", tokens[0]);
+  EXPECT_EQ("2.5", tokens[1]);
+  EXPECT_EQ("-3e4", tokens[2]);
+  EXPECT_EQ("abc", tokens[3]);
+}
+
+/////////////////////////////////////////////////
+TEST(NumericParsing, Scalars)
+{
+  int i = 0;
+  EXPECT_EQ(NumericParseResult::OK, sdf::parseInt("  -12abc", 10, i));
+  EXPECT_EQ(-12, i);
+  EXPECT_EQ(NumericParseResult::OK, sdf::parseInt("0x1F", 16, i));
+  EXPECT_EQ(31, i);
+  EXPECT_EQ(NumericParseResult::INVALID_ARGUMENT,
+            sdf::parseInt("abc", 10, i));
+  EXPECT_EQ(NumericParseResult::OUT_OF_RANGE,
+            sdf::parseInt("2147483648", 10, i));
+
+  unsigned long u = 0;
+  EXPECT_EQ(NumericParseResult::OK, sdf::parseUnsignedLong("-1", 10, u));
+  EXPECT_EQ(std::numeric_limits<unsigned long>::max(), u);
+
+  double d = 0;
+  EXPECT_EQ(NumericParseResult::OK, sdf::parseDouble("1.5e3xyz", d));
+  EXPECT_DOUBLE_EQ(1500.0, d);
+  EXPECT_EQ(NumericParseResult::OK, sdf::parseDouble("-0x1p3", d));
+  EXPECT_DOUBLE_EQ(-8.0, d);
+  EXPECT_EQ(NumericParseResult::OK, sdf::parseDouble("inf", d));
+  EXPECT_TRUE(std::isinf(d));
+  EXPECT_EQ(NumericParseResult::INVALID_ARGUMENT, sdf::parseDouble("- 1", d));
+  EXPECT_EQ(NumericParseResult::OUT_OF_RANGE, sdf::parseDouble("1e400", d));
+
+  float f = 0;
+  EXPECT_EQ(NumericParseResult::OUT_OF_RANGE, sdf::parseFloat("1e39", f));
+}
+
+/////////////////////////////////////////////////
+TEST(NumericParsing, TryParse)
+{
+  ignition::math::Vector3d v;
+  EXPECT_TRUE(sdf::tryParse(" 1 -2.5\t3e2 ignored", v));
+  EXPECT_EQ(ignition::math::Vector3d(1, -2.5, 300), v);
+
+  // Forms that are left to the stream fallback.
+  EXPECT_FALSE(sdf::tryParse("1 2", v));
+  EXPECT_FALSE(sdf::tryParse("+1 2 3", v));
+  EXPECT_FALSE(sdf::tryParse("1,2,3", v));
+  EXPECT_FALSE(sdf::tryParse("inf 2 3", v));
+
+  sdf::Time t;
+  EXPECT_TRUE(sdf::tryParse("10 20", t));
+  EXPECT_EQ(sdf::Time(10, 20), t);
+
+  std::uint64_t u = 0;
+  EXPECT_TRUE(sdf::tryParse("18446744073709551615", u));
+  EXPECT_EQ(std::numeric_limits<std::uint64_t>::max(), u);
+  EXPECT_FALSE(sdf::tryParse("18446744073709551616", u));
+  EXPECT_FALSE(sdf::tryParse("-1", u));
+}
+
+/////////////////////////////////////////////////
+/// Compare against the std::sto* functions and classic locale streams
+/// that sdf::Param used before, on random inputs.
+TEST(NumericParsing, FuzzEquivalence)
+{
+  const std::vector<std::string> corpus = {
+    "", " ", "0", "-0", "+0", "1", "-1", "+-1", "--1", "0x", "0x1F", "0X1f",
+    "-0x10", "0xg", "0x.8p1", "1.", ".5", "-.5", "1e", "1e+", "1e5", "1E-5",
+    "1.5abc", "abc", "inf", "-INF", "infinity", "nan", "nan(123)", "1e400",
+    "-1e400", "1e-400", "4.9e-324", "2.2250738585072014e-308",
+    "3.4028235e38", "3.5e38", "2147483647", "-2147483648", "2147483648",
+    "4294967295", "4294967296", "18446744073709551615",
+    "18446744073709551616", "1 2", "1 2 3", "1 2 3 4", " 0.1\t0.2\n0.3 ",
+    "1,2,3", "1 2 x", "10 20", "-5 7",
+  };
+  for (const auto &input : corpus)
+    checkAll(input);
+
+  std::mt19937 gen(1234);
+  for (int i = 0; i < 20000; ++i)
+    checkAll(randomInput(gen));
+}
@@ -17,14 +17,18 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <locale>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <array>
 
-#include <locale.h>
 #include <math.h>
 
 #include "sdf/Assert.hh"
@@ -32,6 +36,8 @@
 #include "sdf/Types.hh"
 #include "sdf/Element.hh"
 
+#include "NumericParsing.hh"
+
 using namespace sdf;
 
 // For some locale, the decimal separator is not a point, but a
@@ -68,14 +74,14 @@ Param::Param(const std::string &_key, const std::string &_typeName,
   this->dataPtr->key = _key;
   this->dataPtr->required = _required;
   this->dataPtr->typeName = _typeName;
-  this->dataPtr->description = _description;
+  this->dataPtr->internedDescription = _description;
   this->dataPtr->set = false;
   this->dataPtr->ignoreParentAttributes = false;
   this->dataPtr->defaultStrValue = _default;
 
   SDF_ASSERT(
       this->dataPtr->ValueFromStringImpl(
-          this->dataPtr->typeName,
+          ParamPrivate::ValueTypeFromName(_typeName),
           _default,
           this->dataPtr->defaultValue),
       "Invalid parameter");
@@ -94,7 +100,7 @@ Param::Param(const std::string &_key, const std::string &_typeName,
   {
     SDF_ASSERT(
         this->dataPtr->ValueFromStringImpl(
-            this->dataPtr->typeName,
+            this->dataPtr->GetValueType(),
             _minValue,
             this->dataPtr->minValue.emplace()),
         std::string("Invalid [min] parameter in SDFormat description of [") +
@@ -105,7 +111,7 @@ Param::Param(const std::string &_key, const std::string &_typeName,
   {
     SDF_ASSERT(
         this->dataPtr->ValueFromStringImpl(
-            this->dataPtr->typeName,
+            this->dataPtr->GetValueType(),
             _maxValue,
             this->dataPtr->maxValue.emplace()),
         std::string("Invalid [max] parameter in SDFormat description of [") +
@@ -134,6 +140,7 @@ Param &Param::operator=(const Param &_param)
 
   // Restore the update func
   this->dataPtr->updateFunc = updateFuncCopy;
+  this->dataPtr->ValueChanged();
   return *this;
 }
 
@@ -296,6 +303,7 @@ void Param::Update()
           using T = std::decay_t<decltype(arg)>;
           arg = std::any_cast<T>(newValue);
         }, this->dataPtr->value);
+      this->dataPtr->ValueChanged();
     }
     catch(...)
     {
@@ -308,12 +316,23 @@ void Param::Update()
 //////////////////////////////////////////////////
 std::string Param::GetAsString(const PrintConfig &_config) const
 {
+  // A value stored by Set<T> has no string. Poses are printed from the
+  // string they were set with, so produce the one Set<T> used to create.
+  std::optional<std::string> originalStr = this->dataPtr->strValue;
+  if (!originalStr.has_value() && this->GetSet() &&
+      this->dataPtr->GetValueType() == ParamPrivate::ValueType::POSE3D)
+  {
+    StringStreamClassicLocale ss;
+    ss << ParamStreamer{this->dataPtr->value};
+    originalStr = ss.str();
+  }
+
   std::string valueStr;
   if (this->GetSet() &&
       this->dataPtr->StringFromValueImpl(_config,
-                                         this->dataPtr->typeName,
+                                         this->dataPtr->GetValueType(),
                                          this->dataPtr->value,
-                                         this->dataPtr->strValue,
+                                         originalStr,
                                          valueStr))
   {
     return valueStr;
@@ -328,7 +347,7 @@ std::string Param::GetDefaultAsString(const PrintConfig &_config) const
   std::string defaultStr;
   if (this->dataPtr->StringFromValueImpl(
         _config,
-        this->dataPtr->typeName,
+        this->dataPtr->GetValueType(),
         this->dataPtr->defaultValue,
         this->dataPtr->defaultStrValue,
         defaultStr))
@@ -351,8 +370,9 @@ std::optional<std::string> Param::GetMinValueAsString(
   {
     std::string valueStr;
     if (!this->dataPtr->StringFromValueImpl(_config,
-                                            this->dataPtr->typeName,
+                                            this->dataPtr->GetValueType(),
                                             this->dataPtr->minValue.value(),
+                                            std::nullopt,
                                             valueStr))
     {
       sdferr << "Unable to get min value as string.\n";
@@ -372,8 +392,9 @@ std::optional<std::string> Param::GetMaxValueAsString(
   {
     std::string valueStr;
     if (!this->dataPtr->StringFromValueImpl(_config,
-                                            this->dataPtr->typeName,
+                                            this->dataPtr->GetValueType(),
                                             this->dataPtr->maxValue.value(),
+                                            std::nullopt,
                                             valueStr))
     {
       sdferr << "Unable to get max value as string.\n";
@@ -395,8 +416,17 @@ template <typename T>
 bool ParseUsingStringStream(const std::string &_input, const std::string &_key,
                             ParamPrivate::ParamVariant &_value)
 {
-  StringStreamClassicLocale ss(_input);
   T _val;
+
+  // Plain numbers are read without constructing a stream. Anything else
+  // falls through so that the stream decides what is accepted.
+  if (sdf::tryParse(_input, _val))
+  {
+    _value = _val;
+    return true;
+  }
+
+  StringStreamClassicLocale ss(_input);
   ss >> _val;
   if (ss.fail())
   {
@@ -420,34 +450,27 @@ bool ParseUsingStringStream(const std::string &_input, const std::string &_key,
 bool ParseColorUsingStringStream(const std::string &_input,
     const std::string &_key, ParamPrivate::ParamVariant &_value)
 {
-  StringStreamClassicLocale ss(_input);
-  std::string token;
   std::vector<float> colors;
   float c;  // r,g,b,a values
   bool isValidColor = true;
-  while (ss >> token)
+  for (const auto token : splitOnWhitespace(_input))
   {
-    try
-    {
-      c = std::stof(token);
-      colors.push_back(c);
-    }
-    // Catch invalid argument exception from std::stof
-    catch(std::invalid_argument &)
+    const NumericParseResult result = parseFloat(token, c);
+    if (result == NumericParseResult::INVALID_ARGUMENT)
     {
       sdferr << "Invalid argument. Unable to set value ["<< token
              << "] for key [" << _key << "].\n";
       isValidColor = false;
       break;
     }
-    // Catch out of range exception from std::stof
-    catch(std::out_of_range &)
+    else if (result == NumericParseResult::OUT_OF_RANGE)
     {
       sdferr << "Out of range. Unable to set value [" << token
              << "] for key [" << _key << "].\n";
       isValidColor = false;
       break;
     }
+    colors.push_back(c);
 
     if (c < 0.0f || c > 1.0f)
     {
@@ -546,28 +569,21 @@ bool ParsePoseUsingStringStream(const std::string &_input,
     return true;
   }
 
-  StringStreamClassicLocale ss(_input);
-  std::string token;
   std::array<double, 7> values;
   std::size_t valueIndex = 0;
   double v;
   bool isValidPose = true;
-  while (ss >> token)
+  for (const auto token : splitOnWhitespace(_input))
   {
-    try
-    {
-      v = std::stod(token);
-    }
-    // Catch invalid argument exception from std::stod
-    catch(std::invalid_argument &)
+    const NumericParseResult result = parseDouble(token, v);
+    if (result == NumericParseResult::INVALID_ARGUMENT)
     {
       sdferr << "Invalid argument. Unable to set value ["<< _input
              << "] for key [" << _key << "].\n";
       isValidPose = false;
       break;
     }
-    // Catch out of range exception from std::stod
-    catch(std::out_of_range &)
+    else if (result == NumericParseResult::OUT_OF_RANGE)
     {
       sdferr << "Out of range. Unable to set value [" << token
              << "] for key [" << _key << "].\n";
@@ -627,21 +643,93 @@ bool ParsePoseUsingStringStream(const std::string &_input,
   return true;
 }
 
+static_assert(static_cast<std::size_t>(ParamPrivate::ValueType::UNKNOWN) ==
+    std::variant_size_v<ParamPrivate::ParamVariant>,
+    "ValueType must have one enumerator per ParamVariant alternative");
+
+/// \brief Check that the value types are in the order of the alternatives
+/// of ParamVariant, which ParamPrivate::GetValueType relies on.
+/// \return True if each alternative has the value type of its index.
+template<std::size_t... I>
+static constexpr bool valueTypesMatchVariant(std::index_sequence<I...>)
+{
+  return ((ParamPrivate::TypeToValueType<
+               std::variant_alternative_t<I, ParamPrivate::ParamVariant>>() ==
+           static_cast<ParamPrivate::ValueType>(I)) && ...);
+}
+
+static_assert(valueTypesMatchVariant(std::make_index_sequence<
+    std::variant_size_v<ParamPrivate::ParamVariant>>()),
+    "ValueType must list the ParamVariant alternatives in the same order");
+
+//////////////////////////////////////////////////
+ParamPrivate::ValueType ParamPrivate::ValueTypeFromName(
+    const std::string &_typeName)
+{
+  static const std::unordered_map<std::string, ValueType> kValueTypes =
+  {
+    {"bool", ValueType::BOOL},
+    {"char", ValueType::CHAR},
+    {"std::string", ValueType::STRING},
+    {"string", ValueType::STRING},
+    {"int", ValueType::INT},
+    {"uint64_t", ValueType::UINT64},
+    {"unsigned int", ValueType::UNSIGNED_INT},
+    {"double", ValueType::DOUBLE},
+    {"float", ValueType::FLOAT},
+    {"sdf::Time", ValueType::TIME},
+    {"time", ValueType::TIME},
+    {"ignition::math::Angle", ValueType::ANGLE},
+    {"angle", ValueType::ANGLE},
+    {"ignition::math::Color", ValueType::COLOR},
+    {"color", ValueType::COLOR},
+    {"ignition::math::Vector2i", ValueType::VECTOR2I},
+    {"vector2i", ValueType::VECTOR2I},
+    {"ignition::math::Vector2d", ValueType::VECTOR2D},
+    {"vector2d", ValueType::VECTOR2D},
+    {"ignition::math::Vector3d", ValueType::VECTOR3D},
+    {"vector3", ValueType::VECTOR3D},
+    {"ignition::math::Quaterniond", ValueType::QUATERNIOND},
+    {"quaternion", ValueType::QUATERNIOND},
+    {"ignition::math::Pose3d", ValueType::POSE3D},
+    {"pose", ValueType::POSE3D},
+    {"Pose", ValueType::POSE3D}
+  };
+
+  auto it = kValueTypes.find(_typeName);
+  if (it == kValueTypes.end())
+  {
+    return ValueType::UNKNOWN;
+  }
+  return it->second;
+}
+
 //////////////////////////////////////////////////
 bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
                                        const std::string &_valueStr,
                                        ParamVariant &_valueToSet) const
 {
-  // Under some circumstances, latin locales (es_ES or pt_BR) will return a
-  // comma for decimal position instead of a dot, making the conversion
-  // to fail. See bug #60 for more information. Force to use always C
-  setlocale(LC_NUMERIC, "C");
+  const ValueType valueType = ValueTypeFromName(_typeName);
+  if (valueType == ValueType::UNKNOWN)
+  {
+    sdferr << "Unknown parameter type[" << _typeName << "]\n";
+    return false;
+  }
+
+  return this->ValueFromStringImpl(valueType, _valueStr, _valueToSet);
+}
+
+//////////////////////////////////////////////////
+bool ParamPrivate::ValueFromStringImpl(ValueType _valueType,
+                                       const std::string &_valueStr,
+                                       ParamVariant &_valueToSet) const
+{
   std::string trimmed = sdf::trim(_valueStr);
   std::string tmp(trimmed);
   std::string lowerTmp = lowercase(trimmed);
 
   // "true" and "false" doesn't work properly (except for string)
-  if (_typeName != "string" && _typeName != "std::string")
+  if (_valueType != ValueType::STRING)
   {
     if (lowerTmp == "true")
     {
@@ -655,18 +743,20 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
 
   bool isHex = lowerTmp.compare(0, 2, "0x") == 0;
 
-  try
+  // Integers and scalar floating point values are parsed with the same
+  // syntax as std::stoi, stoul, stod and stof, but independently of the
+  // global locale. Under some locales (es_ES or pt_BR) those would expect a
+  // comma as the decimal separator. See bug #60 for more information.
+  int numericBase = 10;
+  if (isHex)
   {
-    // Try to use stoi and stoul for integers, and
-    // stof and stod for scalar floating point values.
-    int numericBase = 10;
-    if (isHex)
-    {
-      numericBase = 16;
-    }
+    numericBase = 16;
+  }
 
-    if (_typeName == "bool")
-    {
+  NumericParseResult result = NumericParseResult::OK;
+  switch (_valueType)
+  {
+    case ValueType::BOOL:
       if (lowerTmp == "true" || lowerTmp == "1")
       {
         _valueToSet = true;
@@ -680,76 +770,66 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
         sdferr << "Invalid boolean value\n";
         return false;
       }
-    }
-    else if (_typeName == "char")
-    {
+      break;
+    case ValueType::CHAR:
       _valueToSet = tmp[0];
-    }
-    else if (_typeName == "std::string" ||
-             _typeName == "string")
-    {
+      break;
+    case ValueType::STRING:
       _valueToSet = tmp;
-    }
-    else if (_typeName == "int")
+      break;
+    case ValueType::INT:
     {
-      _valueToSet = std::stoi(tmp, nullptr, numericBase);
+      int value;
+      result = parseInt(tmp, numericBase, value);
+      if (result == NumericParseResult::OK)
+        _valueToSet = value;
+      break;
     }
-    else if (_typeName == "uint64_t")
-    {
+    case ValueType::UINT64:
       return ParseUsingStringStream<std::uint64_t>(tmp, this->key,
                                                    _valueToSet);
-    }
-    else if (_typeName == "unsigned int")
+    case ValueType::UNSIGNED_INT:
     {
-      _valueToSet = static_cast<unsigned int>(
-          std::stoul(tmp, nullptr, numericBase));
+      unsigned long value;
+      result = parseUnsignedLong(tmp, numericBase, value);
+      if (result == NumericParseResult::OK)
+        _valueToSet = static_cast<unsigned int>(value);
+      break;
     }
-    else if (_typeName == "double")
+    case ValueType::DOUBLE:
     {
-      _valueToSet = std::stod(tmp);
+      double value;
+      result = parseDouble(tmp, value);
+      if (result == NumericParseResult::OK)
+        _valueToSet = value;
+      break;
     }
-    else if (_typeName == "float")
+    case ValueType::FLOAT:
     {
-      _valueToSet = std::stof(tmp);
+      float value;
+      result = parseFloat(tmp, value);
+      if (result == NumericParseResult::OK)
+        _valueToSet = value;
+      break;
     }
-    else if (_typeName == "sdf::Time" ||
-             _typeName == "time")
-    {
+    case ValueType::TIME:
       return ParseUsingStringStream<sdf::Time>(tmp, this->key,
                                                _valueToSet);
-    }
-    else if (_typeName == "ignition::math::Angle" ||
-             _typeName == "angle")
-    {
+    case ValueType::ANGLE:
       return ParseUsingStringStream<ignition::math::Angle>(
           tmp, this->key, _valueToSet);
-    }
-    else if (_typeName == "ignition::math::Color" ||
-             _typeName == "color")
-    {
+    case ValueType::COLOR:
       return ParseColorUsingStringStream(tmp, this->key, _valueToSet);
-    }
-    else if (_typeName == "ignition::math::Vector2i" ||
-             _typeName == "vector2i")
-    {
+    case ValueType::VECTOR2I:
       return ParseUsingStringStream<ignition::math::Vector2i>(
           tmp, this->key, _valueToSet);
-    }
-    else if (_typeName == "ignition::math::Vector2d" ||
-             _typeName == "vector2d")
-    {
+    case ValueType::VECTOR2D:
       return ParseUsingStringStream<ignition::math::Vector2d>(
           tmp, this->key, _valueToSet);
-    }
-    else if (_typeName == "ignition::math::Vector3d" ||
-             _typeName == "vector3")
-    {
+    case ValueType::VECTOR3D:
       return ParseUsingStringStream<ignition::math::Vector3d>(
           tmp, this->key, _valueToSet);
-    }
-    else if (_typeName == "ignition::math::Pose3d" ||
-             _typeName == "pose" ||
-             _typeName == "Pose")
+    case ValueType::POSE3D:
     {
       const ElementPtr p = this->parentElement.lock();
       if (!this->ignoreParentAttributes && p)
@@ -760,28 +840,24 @@ bool ParamPrivate::ValueFromStringImpl(const std::string &_typeName,
       return ParsePoseUsingStringStream(
           tmp, this->key, {}, _valueToSet);
     }
-    else if (_typeName == "ignition::math::Quaterniond" ||
-             _typeName == "quaternion")
-    {
+    case ValueType::QUATERNIOND:
       return ParseUsingStringStream<ignition::math::Quaterniond>(
           tmp, this->key, _valueToSet);
-    }
-    else
-    {
-      sdferr << "Unknown parameter type[" << _typeName << "]\n";
+    case ValueType::UNKNOWN:
+    default:
+      sdferr << "Unknown parameter type[" << this->typeName << "] for key["
+             << this->key << "]\n";
       return false;
-    }
   }
-  // Catch invalid argument exception from std::stoi/stoul/stod/stof
-  catch(std::invalid_argument &)
+
+  if (result == NumericParseResult::INVALID_ARGUMENT)
   {
     sdferr << "Invalid argument. Unable to set value ["
            << _valueStr << " ] for key["
            << this->key << "].\n";
     return false;
   }
-  // Catch out of range exception from std::stoi/stoul/stod/stof
-  catch(std::out_of_range &)
+  else if (result == NumericParseResult::OUT_OF_RANGE)
   {
     sdferr << "Out of range. Unable to set value ["
            << _valueStr << " ] for key["
@@ -990,31 +1066,50 @@ bool ParamPrivate::StringFromValueImpl(
     const ParamVariant &_value,
     const std::optional<std::string> &_originalStr,
     std::string &_valueStr) const
+{
+  return this->StringFromValueImpl(
+      _config,
+      ValueTypeFromName(_typeName),
+      _value,
+      _originalStr,
+      _valueStr);
+}
+
+/////////////////////////////////////////////////
+bool ParamPrivate::StringFromValueImpl(
+    const PrintConfig &_config,
+    ValueType _valueType,
+    const ParamVariant &_value,
+    const std::optional<std::string> &_originalStr,
+    std::string &_valueStr) const
 {
   // This will be handled in a type specific manner
-  if (_typeName == "bool")
+  switch (_valueType)
   {
-    const bool *val = std::get_if<bool>(&_value);
-    if (!val)
+    case ValueType::BOOL:
     {
-      sdferr << "Unable to get bool value from variant.\n";
-      return false;
-    }
+      const bool *val = std::get_if<bool>(&_value);
+      if (!val)
+      {
+        sdferr << "Unable to get bool value from variant.\n";
+        return false;
+      }
 
-    _valueStr = *val ? "true" : "false";
-    return true;
-  }
-  else if (_typeName == "ignition::math::Pose3d" ||
-      _typeName == "pose" ||
-      _typeName == "Pose")
-  {
-    const ElementPtr p = this->parentElement.lock();
-    if (!this->ignoreParentAttributes && p)
+      _valueStr = *val ? "true" : "false";
+      return true;
+    }
+    case ValueType::POSE3D:
     {
-      return PoseStringFromValue(
-          _config, p->GetAttributes(), _value, _originalStr, _valueStr);
+      const ElementPtr p = this->parentElement.lock();
+      if (!this->ignoreParentAttributes && p)
+      {
+        return PoseStringFromValue(
+            _config, p->GetAttributes(), _value, _originalStr, _valueStr);
+      }
+      return PoseStringFromValue(_config, {}, _value, _originalStr, _valueStr);
     }
-    return PoseStringFromValue(_config, {}, _value, _originalStr, _valueStr);
+    default:
+      break;
   }
 
   StringStreamClassicLocale ss;
@@ -1040,17 +1135,17 @@ bool Param::SetFromString(const std::string &_value,
   {
     this->dataPtr->value = this->dataPtr->defaultValue;
     this->dataPtr->strValue = str;
+    this->dataPtr->ValueChanged();
     return true;
   }
 
   auto oldValue = this->dataPtr->value;
-  if (!this->dataPtr->ValueFromStringImpl(this->dataPtr->typeName,
+  if (!this->dataPtr->ValueFromStringImpl(this->dataPtr->GetValueType(),
                                           str,
                                           this->dataPtr->value))
   {
     return false;
   }
-  this->dataPtr->strValue = str;
 
   // Check if the value is permitted
   if (!this->ValidateValue())
@@ -1058,6 +1153,8 @@ bool Param::SetFromString(const std::string &_value,
     this->dataPtr->value = oldValue;
     return false;
   }
+  this->dataPtr->strValue = str;
+  this->dataPtr->ValueChanged();
 
   this->dataPtr->set = true;
   return this->dataPtr->set;
@@ -1081,6 +1178,14 @@ bool Param::SetParentElement(ElementPtr _parentElement)
   auto prevParentElement = this->dataPtr->parentElement;
 
   this->dataPtr->parentElement = _parentElement;
+
+  // Values that do not depend on the attributes of the parent element would
+  // be parsed to the same value again, so there is no need to reparse them.
+  if (!this->dataPtr->DependsOnParentAttributes())
+  {
+    return true;
+  }
+
   if (!this->Reparse())
   {
     this->dataPtr->parentElement = prevParentElement;
@@ -1096,11 +1201,18 @@ void Param::Reset()
   this->dataPtr->value = this->dataPtr->defaultValue;
   this->dataPtr->strValue = std::nullopt;
   this->dataPtr->set = false;
+  this->dataPtr->ValueChanged();
 }
 
 //////////////////////////////////////////////////
 bool Param::Reparse()
 {
+  // A value stored by Set<T> was not parsed, so it can't change.
+  if (!this->dataPtr->strValue.has_value() && this->dataPtr->set)
+  {
+    return true;
+  }
+
   std::string strToReparse;
   if (this->dataPtr->strValue.has_value())
   {
@@ -1109,8 +1221,9 @@ bool Param::Reparse()
   // A default PrintConfig can be used here, as Reparse() is not called in the
   // code path from the 'ign sdf -p' command.
   else if (!this->dataPtr->StringFromValueImpl(PrintConfig(),
-                                               this->dataPtr->typeName,
+                                               this->dataPtr->GetValueType(),
                                                this->dataPtr->defaultValue,
+                                               std::nullopt,
                                                strToReparse))
   {
     sdferr << "Failed to obtain string from default value during reparsing.\n";
@@ -1118,7 +1231,7 @@ bool Param::Reparse()
   }
 
   if (!this->dataPtr->ValueFromStringImpl(
-      this->dataPtr->typeName, strToReparse, this->dataPtr->value))
+      this->dataPtr->GetValueType(), strToReparse, this->dataPtr->value))
   {
     if (const auto parentElement = this->dataPtr->parentElement.lock())
     {
@@ -1145,6 +1258,168 @@ bool Param::Reparse()
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Helper function for ParamPrivate::ConvertNumeric, converting a
+/// single number.
+/// \param[in] _from Value to convert. Must not be a bool.
+/// \param[out] _to Set to the converted value on success.
+/// \return True if _from is representable as a To.
+template<typename To, typename From>
+bool ConvertNumber(From _from, To &_to)
+{
+  if constexpr (std::is_same_v<To, bool>)
+  {
+    if (_from != From(0) && _from != From(1))
+      return false;
+    _to = _from == From(1);
+  }
+  else if constexpr (std::is_floating_point_v<To>)
+  {
+    if constexpr (std::is_floating_point_v<From> &&
+                  sizeof(From) > sizeof(To))
+    {
+      if (std::isfinite(_from) &&
+          std::abs(_from) > std::numeric_limits<To>::max())
+      {
+        return false;
+      }
+    }
+    _to = static_cast<To>(_from);
+  }
+  else if constexpr (std::is_floating_point_v<From>)
+  {
+    if (!std::isfinite(_from))
+      return false;
+
+    // Compare against powers of two, which are exact in any floating point
+    // type, to find out whether the truncated value fits.
+    const long double truncated = std::trunc(static_cast<long double>(_from));
+    const long double limit =
+        std::ldexp(1.0L, std::numeric_limits<To>::digits);
+    const long double lowest = std::is_signed_v<To> ? -limit : 0.0L;
+    if (truncated >= limit || truncated < lowest)
+      return false;
+    _to = static_cast<To>(truncated);
+  }
+  else
+  {
+    if constexpr (std::is_signed_v<From> && !std::is_signed_v<To>)
+    {
+      if (_from < 0 ||
+          static_cast<std::make_unsigned_t<From>>(_from) >
+          std::numeric_limits<To>::max())
+      {
+        return false;
+      }
+    }
+    else if constexpr (!std::is_signed_v<From> && std::is_signed_v<To>)
+    {
+      if (_from > static_cast<std::make_unsigned_t<To>>(
+              std::numeric_limits<To>::max()))
+      {
+        return false;
+      }
+    }
+    else if (_from < std::numeric_limits<To>::lowest() ||
+             _from > std::numeric_limits<To>::max())
+    {
+      return false;
+    }
+    _to = static_cast<To>(_from);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Helper function for ParamPrivate::ConvertNumeric, converting a
+/// number and storing it in a ParamVariant.
+template<typename To, typename From>
+bool ConvertNumberToVariant(From _from, ParamPrivate::ParamVariant &_to)
+{
+  To value;
+  if (!ConvertNumber(_from, value))
+    return false;
+  _to = value;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ParamPrivate::ConvertNumeric(const ParamVariant &_value,
+                                  ValueType _valueType,
+                                  ParamVariant &_converted)
+{
+  return std::visit(
+      [&](const auto &_val) -> bool
+      {
+        using T = std::decay_t<decltype(_val)>;
+        // cppcheck-suppress syntaxError
+        // cppcheck-suppress unmatchedSuppression
+        if constexpr (std::is_same_v<T, bool>)
+        {
+          // Convert bool as the integer it prints as.
+          return ConvertNumeric(ParamVariant(std::in_place_type<int>, _val),
+                                _valueType, _converted);
+        }
+        else if constexpr (std::is_same_v<T, int> ||
+                           std::is_same_v<T, std::uint64_t> ||
+                           std::is_same_v<T, unsigned int> ||
+                           std::is_same_v<T, double> ||
+                           std::is_same_v<T, float>)
+        {
+          switch (_valueType)
+          {
+            case ValueType::BOOL:
+              return ConvertNumberToVariant<bool>(_val, _converted);
+            case ValueType::INT:
+              return ConvertNumberToVariant<int>(_val, _converted);
+            case ValueType::UINT64:
+              return ConvertNumberToVariant<std::uint64_t>(_val, _converted);
+            case ValueType::UNSIGNED_INT:
+              return ConvertNumberToVariant<unsigned int>(_val, _converted);
+            case ValueType::DOUBLE:
+              return ConvertNumberToVariant<double>(_val, _converted);
+            case ValueType::FLOAT:
+              return ConvertNumberToVariant<float>(_val, _converted);
+            default:
+              return false;
+          }
+        }
+        else
+        {
+          return false;
+        }
+      }, _value);
+}
+
+//////////////////////////////////////////////////
+bool ParamPrivate::DependsOnParentAttributes() const
+{
+  if (this->ignoreParentAttributes)
+  {
+    return false;
+  }
+
+  return this->GetValueType() == ValueType::POSE3D;
+}
+
+//////////////////////////////////////////////////
+void ParamPrivate::ValueChanged() const
+{
+  if (this->key != "name")
+  {
+    return;
+  }
+
+  // The parent of the element counts the names of its children.
+  if (const auto elem = this->parentElement.lock())
+  {
+    if (const auto parent = elem->GetParent())
+    {
+      parent->dataPtr->ChildNamesChanged();
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 ParamPtr Param::Clone() const
 {
@@ -1160,13 +1435,13 @@ const std::string &Param::GetTypeName() const
 /////////////////////////////////////////////////
 void Param::SetDescription(const std::string &_desc)
 {
-  this->dataPtr->description = _desc;
+  this->dataPtr->internedDescription = _desc;
 }
 
 /////////////////////////////////////////////////
 std::string Param::GetDescription() const
 {
-  return this->dataPtr->description;
+  return this->dataPtr->internedDescription;
 }
 
 /////////////////////////////////////////////////
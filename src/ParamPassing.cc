@@ -453,7 +453,7 @@ void handleIndividualChildActions(const ParserConfig &_config,
       continue;
     }
 
-    ElementPtr elemChild = elemDesc->GetElementDescription(elemName);
+    ElementPtr elemChild = elemDesc->GetElementDescription(elemName)->Clone();
 
     if (!xmlToSdf(_config, _source, xmlChild, elemChild, _errors))
     {
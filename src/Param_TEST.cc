@@ -470,6 +470,92 @@ TEST(Param, SetTemplate)
   EXPECT_DOUBLE_EQ(value, 25.456);
 }
 
+////////////////////////////////////////////////////
+TEST(Param, SetTemplateKeepsExactValue)
+{
+  // Values set with Set<T> are stored as is, not rounded through a string.
+  const double third = 1.0 / 3.0;
+  sdf::Param doubleParam("key", "double", "1.0", false, "description");
+  EXPECT_TRUE(doubleParam.Set<double>(third));
+  double value;
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_EQ(third, value);
+  EXPECT_TRUE(doubleParam.GetSet());
+  EXPECT_EQ("0.33333333333333331", doubleParam.GetAsString());
+
+  // Reparsing doesn't change a value that was set with Set<T>.
+  EXPECT_TRUE(doubleParam.Reparse());
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_EQ(third, value);
+
+  // Poses are printed the same way as when they were set from a string.
+  using Pose = ignition::math::Pose3d;
+  sdf::Param poseParam("key", "pose", "0 0 0 0 0 0", false, "description");
+  EXPECT_TRUE(poseParam.Set<Pose>(Pose(1, 2, 3, 0, 0, 0)));
+  EXPECT_EQ("1 2 3 0 0 0", poseParam.GetAsString());
+}
+
+////////////////////////////////////////////////////
+TEST(Param, NumericConversions)
+{
+  sdf::Param doubleParam("key", "double", "1.5", false, "description");
+  sdf::Param intParam("key", "int", "-3", false, "description");
+  sdf::Param uintParam("key", "unsigned int", "7", false, "description");
+  sdf::Param boolParam("key", "bool", "true", false, "description");
+
+  // Get with a different numeric type.
+  int intValue = 0;
+  EXPECT_TRUE(doubleParam.Get<int>(intValue));
+  EXPECT_EQ(1, intValue);
+  double doubleValue = 0;
+  EXPECT_TRUE(intParam.Get<double>(doubleValue));
+  EXPECT_DOUBLE_EQ(-3.0, doubleValue);
+  std::uint64_t uint64Value = 0;
+  EXPECT_TRUE(uintParam.Get<std::uint64_t>(uint64Value));
+  EXPECT_EQ(7u, uint64Value);
+  EXPECT_TRUE(boolParam.Get<int>(intValue));
+  EXPECT_EQ(1, intValue);
+
+  // Set with a different numeric type.
+  EXPECT_TRUE(doubleParam.Set<int>(4));
+  EXPECT_TRUE(doubleParam.Get<double>(doubleValue));
+  EXPECT_DOUBLE_EQ(4.0, doubleValue);
+  EXPECT_TRUE(intParam.Set<float>(2.75f));
+  EXPECT_TRUE(intParam.Get<int>(intValue));
+  EXPECT_EQ(2, intValue);
+  EXPECT_TRUE(boolParam.Set<int>(0));
+  bool boolValue = true;
+  EXPECT_TRUE(boolParam.Get<bool>(boolValue));
+  EXPECT_FALSE(boolValue);
+  EXPECT_FALSE(boolParam.Set<int>(2));
+
+  // GetDefault with the same and a different type.
+  EXPECT_TRUE(doubleParam.GetDefault<double>(doubleValue));
+  EXPECT_DOUBLE_EQ(1.5, doubleValue);
+  EXPECT_TRUE(uintParam.GetDefault<int>(intValue));
+  EXPECT_EQ(7, intValue);
+
+  // Values that don't fit the target type are not converted.
+  using ParamPrivate = sdf::ParamPrivate;
+  using ValueType = ParamPrivate::ValueType;
+  ParamPrivate::ParamVariant converted;
+  EXPECT_FALSE(ParamPrivate::ConvertNumeric(
+      ParamPrivate::ParamVariant(-1), ValueType::UNSIGNED_INT, converted));
+  EXPECT_FALSE(ParamPrivate::ConvertNumeric(
+      ParamPrivate::ParamVariant(1e10), ValueType::INT, converted));
+  EXPECT_FALSE(ParamPrivate::ConvertNumeric(
+      ParamPrivate::ParamVariant(std::numeric_limits<double>::infinity()),
+      ValueType::UINT64, converted));
+  EXPECT_FALSE(ParamPrivate::ConvertNumeric(
+      ParamPrivate::ParamVariant(1e300), ValueType::FLOAT, converted));
+  EXPECT_FALSE(ParamPrivate::ConvertNumeric(
+      ParamPrivate::ParamVariant(std::string("1")), ValueType::INT,
+      converted));
+  EXPECT_TRUE(ParamPrivate::ConvertNumeric(
+      ParamPrivate::ParamVariant(-2147483648.5), ValueType::INT, converted));
+  EXPECT_EQ(std::numeric_limits<int>::min(), std::get<int>(converted));
+}
+
 ////////////////////////////////////////////////////
 TEST(Param, MinMaxViolation)
 {
@@ -515,6 +601,62 @@ TEST(Param, SettingParentElement)
   EXPECT_EQ(nullptr, doubleParam.GetParentElement());
 }
 
+//////////////////////////////////////////////////
+TEST(Param, ValueTypeFromName)
+{
+  using ValueType = sdf::ParamPrivate::ValueType;
+  EXPECT_EQ(ValueType::BOOL, sdf::ParamPrivate::ValueTypeFromName("bool"));
+  EXPECT_EQ(ValueType::STRING,
+            sdf::ParamPrivate::ValueTypeFromName("string"));
+  EXPECT_EQ(ValueType::STRING,
+            sdf::ParamPrivate::ValueTypeFromName("std::string"));
+  EXPECT_EQ(ValueType::UNSIGNED_INT,
+            sdf::ParamPrivate::ValueTypeFromName("unsigned int"));
+  EXPECT_EQ(ValueType::VECTOR3D,
+            sdf::ParamPrivate::ValueTypeFromName("vector3"));
+  EXPECT_EQ(ValueType::VECTOR3D,
+            sdf::ParamPrivate::ValueTypeFromName("ignition::math::Vector3d"));
+  EXPECT_EQ(ValueType::POSE3D, sdf::ParamPrivate::ValueTypeFromName("pose"));
+  EXPECT_EQ(ValueType::POSE3D, sdf::ParamPrivate::ValueTypeFromName("Pose"));
+  EXPECT_EQ(ValueType::UNKNOWN,
+            sdf::ParamPrivate::ValueTypeFromName("vector4"));
+
+  // The value types match the alternatives of the variant.
+  sdf::Param poseParam("key", "pose", "1 2 3 0 0 0", false, "description");
+  EXPECT_TRUE(poseParam.IsType<ignition::math::Pose3d>());
+  EXPECT_EQ(static_cast<std::size_t>(ValueType::POSE3D),
+            sdf::ParamPrivate::ParamVariant(
+                ignition::math::Pose3d::Zero).index());
+  EXPECT_EQ(static_cast<std::size_t>(ValueType::TIME),
+            sdf::ParamPrivate::ParamVariant(sdf::Time()).index());
+}
+
+//////////////////////////////////////////////////
+TEST(Param, SettingParentElementKeepsParsedValue)
+{
+  sdf::Param doubleParam("key", "double", "1.0", false, "description");
+  ASSERT_TRUE(doubleParam.SetFromString("2.0"));
+
+  // Change the value without changing its string representation. Since the
+  // value does not depend on the attributes of the parent element, it is not
+  // reparsed when the parent element changes.
+  doubleParam.SetUpdateFunc([]() -> std::any { return 3.0; });
+  doubleParam.Update();
+
+  sdf::ElementPtr parentElement = std::make_shared<sdf::Element>();
+  ASSERT_TRUE(doubleParam.SetParentElement(parentElement));
+
+  double value = 0.0;
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(3.0, value);
+
+  sdf::ParamPtr clonedParam = doubleParam.Clone();
+  sdf::ElementPtr newParentElement = std::make_shared<sdf::Element>();
+  ASSERT_TRUE(clonedParam->SetParentElement(newParentElement));
+  EXPECT_TRUE(clonedParam->Get<double>(value));
+  EXPECT_DOUBLE_EQ(3.0, value);
+}
+
 //////////////////////////////////////////////////
 TEST(Param, CopyConstructor)
 {
@@ -15,16 +15,79 @@
  *
  */
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
 
 #include "sdf/ParserConfig.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/Types.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
 class sdf::ParserConfig::Implementation
 {
+  /// \brief Number that changes each time a config changes, and that is
+  /// copied along with the config, so that two configs with the same
+  /// revision have the same settings.
+  public: class Revision
+  {
+    /// \brief Constructor, which takes a new number.
+    public: Revision()
+            : value(Next())
+    {
+    }
+
+    /// \brief Copy constructor.
+    /// \param[in] _revision Revision to copy.
+    public: Revision(const Revision &_revision)
+            : value(_revision.Value())
+    {
+    }
+
+    /// \brief Copy assignment operator.
+    /// \param[in] _revision Revision to copy.
+    /// \return Reference to this revision.
+    public: Revision &operator=(const Revision &_revision)
+    {
+      this->value.store(_revision.Value(), std::memory_order_release);
+      return *this;
+    }
+
+    /// \brief Take a new number, after the config changed.
+    public: void Update()
+    {
+      this->value.store(Next(), std::memory_order_release);
+    }
+
+    /// \brief Get the number.
+    /// \return The number.
+    public: std::uint64_t Value() const
+    {
+      return this->value.load(std::memory_order_acquire);
+    }
+
+    /// \brief Get a number that no config had before.
+    /// \return The number.
+    private: static std::uint64_t Next()
+    {
+      static std::atomic<std::uint64_t> next{0};
+      return ++next;
+    }
+
+    /// \brief The number, which is atomic so that globalParserConfig can
+    /// compare it while sdf::setFindCallback or sdf::addURIPath changes the
+    /// global config.
+    private: std::atomic<std::uint64_t> value;
+  };
+
+  /// \brief Revision of the settings below.
+  public: Revision revision;
+
   public: ParserConfig::SchemeToPathMap uriPathMap;
   public: std::function<std::string(const std::string &)> findFileCB;
 
@@ -50,9 +113,33 @@ class sdf::ParserConfig::Implementation
   /// reading the SDF/URDF file.
   public: bool preserveFixedJoint = false;
 
+  /// \brief Flag to record the line number and XML path of elements.
+  public: bool trackSourceLocations = true;
+
   /// \brief Flag to use <include> tags within ToElement methods instead of
   /// the fully included model.
   public: bool toElementUseIncludeTag = true;
+
+  /// \brief Number of threads used to read sibling included files. 0 means
+  /// one per hardware thread.
+  public: unsigned int includeThreadCount = 1;
+
+  /// \brief Number of threads used to load DOM objects. 0 means one per
+  /// hardware thread.
+  public: unsigned int loadThreadCount = 1;
+
+  /// \brief Cache of included files, shared by copies of this config.
+  public: IncludeCachePtr includeCache;
+
+  /// \brief Cache of file lookups, shared by copies of this config.
+  public: FileLookupCachePtr fileLookupCache;
+
+  /// \brief Cache of converted files, shared by copies of this config.
+  public: ConversionCachePtr conversionCache;
+
+  /// \brief Flag to load precompiled files instead of the files they were
+  /// read from.
+  public: bool usePrecompiledFiles = false;
 };
 
 
@@ -82,6 +169,7 @@ void ParserConfig::SetFindCallback(
     std::function<std::string(const std::string &)> _cb)
 {
   this->dataPtr->findFileCB = _cb;
+  this->dataPtr->revision.Update();
 }
 
 /////////////////////////////////////////////////
@@ -109,11 +197,13 @@ void ParserConfig::AddURIPath(const std::string &_uri, const std::string &_path)
       this->dataPtr->uriPathMap[_uri].push_back(part);
     }
   }
+  this->dataPtr->revision.Update();
 }
 
 void ParserConfig::SetWarningsPolicy(EnforcementPolicy policy)
 {
   this->dataPtr->warningsPolicy = policy;
+  this->dataPtr->revision.Update();
 }
 
 EnforcementPolicy ParserConfig::WarningsPolicy() const
@@ -124,6 +214,7 @@ EnforcementPolicy ParserConfig::WarningsPolicy() const
 void ParserConfig::SetUnrecognizedElementsPolicy(EnforcementPolicy _policy)
 {
   this->dataPtr->unrecognizedElementsPolicy = _policy;
+  this->dataPtr->revision.Update();
 }
 
 EnforcementPolicy ParserConfig::UnrecognizedElementsPolicy() const
@@ -135,12 +226,14 @@ EnforcementPolicy ParserConfig::UnrecognizedElementsPolicy() const
 void ParserConfig::SetDeprecatedElementsPolicy(EnforcementPolicy _policy)
 {
   this->dataPtr->deprecatedElementsPolicy = _policy;
+  this->dataPtr->revision.Update();
 }
 
 /////////////////////////////////////////////////
 void ParserConfig::ResetDeprecatedElementsPolicy()
 {
   this->dataPtr->deprecatedElementsPolicy.reset();
+  this->dataPtr->revision.Update();
 }
 
 /////////////////////////////////////////////////
@@ -154,6 +247,7 @@ EnforcementPolicy ParserConfig::DeprecatedElementsPolicy() const
 void ParserConfig::RegisterCustomModelParser(CustomModelParser _modelParser)
 {
   this->dataPtr->customParsers.push_back(_modelParser);
+  this->dataPtr->revision.Update();
 }
 
 /////////////////////////////////////////////////
@@ -166,6 +260,7 @@ const std::vector<CustomModelParser> &ParserConfig::CustomModelParsers() const
 void ParserConfig::URDFSetPreserveFixedJoint(bool _preserveFixedJoint)
 {
   this->dataPtr->preserveFixedJoint = _preserveFixedJoint;
+  this->dataPtr->revision.Update();
 }
 
 /////////////////////////////////////////////////
@@ -173,3 +268,120 @@ bool ParserConfig::URDFPreserveFixedJoint() const
 {
   return this->dataPtr->preserveFixedJoint;
 }
+
+/////////////////////////////////////////////////
+void ParserConfig::SetTrackSourceLocations(bool _track)
+{
+  this->dataPtr->trackSourceLocations = _track;
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::TrackSourceLocations() const
+{
+  return this->dataPtr->trackSourceLocations;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetIncludeThreadCount(unsigned int _threadCount)
+{
+  this->dataPtr->includeThreadCount = _threadCount;
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+unsigned int ParserConfig::IncludeThreadCount() const
+{
+  return this->dataPtr->includeThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetLoadThreadCount(unsigned int _threadCount)
+{
+  this->dataPtr->loadThreadCount = _threadCount;
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+unsigned int ParserConfig::LoadThreadCount() const
+{
+  return this->dataPtr->loadThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetIncludeCache(IncludeCachePtr _cache)
+{
+  this->dataPtr->includeCache = std::move(_cache);
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+const IncludeCachePtr &ParserConfig::IncludeCache() const
+{
+  return this->dataPtr->includeCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetFileLookupCache(FileLookupCachePtr _cache)
+{
+  this->dataPtr->fileLookupCache = std::move(_cache);
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+const FileLookupCachePtr &ParserConfig::FileLookupCache() const
+{
+  return this->dataPtr->fileLookupCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetConversionCache(ConversionCachePtr _cache)
+{
+  this->dataPtr->conversionCache = std::move(_cache);
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+const ConversionCachePtr &ParserConfig::ConversionCache() const
+{
+  return this->dataPtr->conversionCache;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetUsePrecompiledFiles(bool _use)
+{
+  this->dataPtr->usePrecompiledFiles = _use;
+  this->dataPtr->revision.Update();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::UsePrecompiledFiles() const
+{
+  return this->dataPtr->usePrecompiledFiles;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const ParserConfig> sdf::globalParserConfig()
+{
+  static std::shared_ptr<const ParserConfig> snapshot;
+  const ParserConfig &global = ParserConfig::GlobalConfig();
+  auto current = std::atomic_load(&snapshot);
+  if (current && current->dataPtr->revision.Value() ==
+      global.dataPtr->revision.Value())
+  {
+    return current;
+  }
+
+  // The global config changed since the snapshot was taken, either through
+  // sdf::setFindCallback and sdf::addURIPath, which hold the mutex, or
+  // directly.
+  std::lock_guard<std::mutex> lock(globalParserConfigMutex());
+  current = std::atomic_load(&snapshot);
+  if (!current || current->dataPtr->revision.Value() !=
+      global.dataPtr->revision.Value())
+  {
+    current = std::make_shared<const ParserConfig>(global);
+    std::atomic_store(&snapshot, current);
+  }
+  return current;
+}
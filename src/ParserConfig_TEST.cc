@@ -51,6 +51,18 @@ TEST(ParserConfig, Construction)
   config.SetFindCallback(testFunc);
   ASSERT_TRUE(config.FindFileCallback());
   EXPECT_EQ("test/dir2", config.FindFileCallback()("empty"));
+
+  EXPECT_TRUE(config.TrackSourceLocations());
+  config.SetTrackSourceLocations(false);
+  EXPECT_FALSE(config.TrackSourceLocations());
+
+  EXPECT_EQ(1u, config.LoadThreadCount());
+  config.SetLoadThreadCount(0);
+  EXPECT_EQ(0u, config.LoadThreadCount());
+
+  EXPECT_FALSE(config.UsePrecompiledFiles());
+  config.SetUsePrecompiledFiles(true);
+  EXPECT_TRUE(config.UsePrecompiledFiles());
 }
 
 /////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 
 #include "sdf/parser.hh"
 #include "sdf/Physics.hh"
+#include "NameIndex.hh"
 #include "Utils.hh"
 
 using namespace sdf;
@@ -133,6 +134,7 @@ std::string Physics::Name() const
 void Physics::SetName(const std::string &_name)
 {
   this->dataPtr->name = _name;
+  NameIndex::Renamed();
 }
 
 /////////////////////////////////////////////////
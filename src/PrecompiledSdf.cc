@@ -0,0 +1,1234 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Color.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Param.hh"
+#include "sdf/Types.hh"
+#include "sdf/parser.hh"
+#include "ElementState.hh"
+#include "MappedFile.hh"
+#include "PrecompiledSdf.hh"
+#include "Utils.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief First bytes of every precompiled file.
+constexpr char kMagic[4] = {'S', 'D', 'F', 'B'};
+
+/// \brief Version of the format of precompiled files. Increment it when
+/// the format changes.
+constexpr uint32_t kFormatVersion = 1;
+
+/// \brief Written in the byte order of the host, so that files written on
+/// a host with another byte order are not loaded.
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+/// \brief Extension of precompiled files.
+constexpr char kExtension[] = ".sdfb";
+
+/// \brief How an element is created when a precompiled file is loaded.
+enum class ElementKind : uint8_t
+{
+  /// \brief The element the file is loaded into, which is the root.
+  EXISTING,
+
+  /// \brief Cloned from the element description of its parent.
+  DESCRIBED,
+
+  /// \brief Cloned from the element description of its parent, and then
+  /// replaced with the spec that the description refers to, like the
+  /// nested <model> of a <model>.
+  REFERENCED,
+
+  /// \brief Cloned from the element description of its parent, with the
+  /// element descriptions of its parent, as Element::AddElement does for
+  /// elements that refer to the spec of their parent.
+  PARENT_DESCRIBED,
+
+  /// \brief Not defined in the spec, and copied as is from the XML.
+  GENERIC
+};
+
+/// \brief Flags of the state of a parameter.
+enum ParamFlags : uint8_t
+{
+  /// \brief Param::GetSet.
+  PARAM_SET = 1,
+
+  /// \brief ParamPrivate::ignoreParentAttributes.
+  PARAM_IGNORE_PARENT_ATTRIBUTES = 2,
+
+  /// \brief ParamPrivate::strValue has a value.
+  PARAM_STR_VALUE = 4
+};
+
+/// \brief Flags of the source location of an element.
+enum ElementFlags : uint8_t
+{
+  /// \brief The element has a line number.
+  ELEMENT_LINE_NUMBER = 1,
+
+  /// \brief The XML path of the element is stored relative to the XML path
+  /// of its parent, which it extends by "/" and the stored string.
+  ELEMENT_RELATIVE_XML_PATH = 2,
+
+  /// \brief Element::GetExplicitlySetInFile.
+  ELEMENT_EXPLICITLY_SET = 4
+};
+
+/// \brief Flags of the optional fields of an error.
+enum ErrorFlags : uint8_t
+{
+  /// \brief The error has a file path.
+  ERROR_FILE_PATH = 1,
+
+  /// \brief The error has a line number.
+  ERROR_LINE_NUMBER = 2,
+
+  /// \brief The error has an XML path.
+  ERROR_XML_PATH = 4
+};
+
+/////////////////////////////////////////////////
+/// \brief Build the string that identifies the library and settings that a
+/// precompiled file was written with.
+/// \param[in] _convert True if the file was converted to the latest
+/// version.
+/// \param[in] _config Parser configuration.
+/// \param[in] _source Source of the file given by the caller.
+/// \return The key, or nullopt if the configuration cannot be part of a
+/// key, see parserConfigKey.
+std::optional<std::string> precompiledKey(bool _convert,
+    const ParserConfig &_config, const std::string &_source)
+{
+  const std::optional<std::string> configKey = parserConfigKey(_config);
+  if (!configKey)
+    return std::nullopt;
+  return std::string(SDF_VERSION_FULL) + '\n' + std::to_string(_convert) +
+      '\n' + *configKey + '\n' + _source;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a number to a buffer in the byte order of the host.
+/// \param[in,out] _out The buffer.
+/// \param[in] _value The number.
+template<typename T>
+void appendNumber(std::string &_out, T _value)
+{
+  static_assert(std::is_arithmetic_v<T>, "Only numbers are appended");
+  _out.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a string to a buffer, preceded by its size.
+/// \param[in,out] _out The buffer.
+/// \param[in] _str The string.
+void appendString(std::string &_out, std::string_view _str)
+{
+  appendNumber<uint32_t>(_out, static_cast<uint32_t>(_str.size()));
+  _out.append(_str.data(), _str.size());
+}
+}
+
+/// \brief Reads the contents of a precompiled file. Every read checks that
+/// the data is long enough, so that a truncated file is rejected rather
+/// than read past its end.
+class sdf::PrecompiledSdf::Decoder
+{
+  /// \brief Constructor.
+  /// \param[in] _data Contents of the file.
+  /// \param[in] _config Configuration the file is loaded with.
+  public: Decoder(std::string_view _data, const ParserConfig &_config)
+    : data(_data), config(_config)
+  {
+  }
+
+  /// \brief Read a number.
+  /// \param[out] _value Set to the number.
+  /// \return False if the data ends first.
+  public: template<typename T>
+  bool ReadNumber(T &_value)
+  {
+    if (this->data.size() - this->pos < sizeof(T))
+      return false;
+    std::memcpy(&_value, this->data.data() + this->pos, sizeof(T));
+    this->pos += sizeof(T);
+    return true;
+  }
+
+  /// \brief Read a string that is preceded by its size.
+  /// \param[out] _str Set to the string, which points into the data.
+  /// \return False if the data ends first.
+  public: bool ReadString(std::string_view &_str)
+  {
+    uint32_t size = 0;
+    if (!this->ReadNumber(size) || this->data.size() - this->pos < size)
+      return false;
+    _str = this->data.substr(this->pos, size);
+    this->pos += size;
+    return true;
+  }
+
+  /// \brief Read the table of strings that the rest of the file refers to
+  /// by index.
+  /// \return False if the data ends first.
+  public: bool ReadStringTable()
+  {
+    uint32_t count = 0;
+    if (!this->ReadNumber(count) || count > this->data.size() - this->pos)
+      return false;
+    this->strings.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      std::string_view str;
+      if (!this->ReadString(str))
+        return false;
+      this->strings.emplace_back(str);
+    }
+    this->paths.resize(count);
+    return true;
+  }
+
+  /// \brief Read a string from the string table.
+  /// \param[out] _str Set to the string.
+  /// \return False if the data ends first or the index is invalid.
+  public: bool ReadId(const std::string *&_str)
+  {
+    uint32_t id = 0;
+    if (!this->ReadNumber(id) || id >= this->strings.size())
+      return false;
+    _str = &this->strings[id];
+    return true;
+  }
+
+  /// \brief Read a file path from the string table. The elements that
+  /// refer to the same path share one copy of it.
+  /// \param[out] _path Set to the path, or to null if it is empty.
+  /// \return False if the data ends first or the index is invalid.
+  public: bool ReadPath(std::shared_ptr<const std::string> &_path)
+  {
+    uint32_t id = 0;
+    if (!this->ReadNumber(id) || id >= this->strings.size())
+      return false;
+    if (!this->paths[id] && !this->strings[id].empty())
+      this->paths[id] = std::make_shared<const std::string>(this->strings[id]);
+    _path = this->paths[id];
+    return true;
+  }
+
+  /// \brief Check whether all the data was read.
+  /// \return True if it was.
+  public: bool AtEnd() const
+  {
+    return this->pos == this->data.size();
+  }
+
+  /// \brief Create an element from the element descriptions of its parent.
+  /// The writer uses this to check that an element can be created again.
+  /// \param[in] _kind How the element is created, one of DESCRIBED,
+  /// REFERENCED and PARENT_DESCRIBED.
+  /// \param[in] _name Name of the element.
+  /// \param[in] _source The element whose descriptions are used.
+  /// \param[in] _config Parser configuration, used to load referenced
+  /// specs.
+  /// \return The element, or nullptr if it cannot be created.
+  public: static ElementPtr Describe(ElementKind _kind,
+      const std::string &_name, const ElementPtr &_source,
+      const ParserConfig &_config)
+  {
+    ElementPtr desc = _source->GetElementDescription(_name);
+    if (!desc)
+      return nullptr;
+
+    ElementPtr elem = desc->Clone();
+    if (_kind == ElementKind::REFERENCED)
+    {
+      if (elem->ReferenceSDF().empty())
+        return nullptr;
+      ElementPtr refSDF(new Element);
+      initFile(elem->ReferenceSDF() + ".sdf", _config, refSDF);
+      elem->Copy(refSDF);
+    }
+    else if (_kind == ElementKind::PARENT_DESCRIBED)
+    {
+      elem->dataPtr->state->elementDescriptions =
+          _source->dataPtr->state->elementDescriptions;
+    }
+    return elem;
+  }
+
+  /// \brief Read an element and its descendants.
+  /// \param[in] _source The element whose descriptions are used to create
+  /// the element, which is its parent except for <include> elements.
+  /// \param[in] _target The existing element to read into, if any.
+  /// \param[in] _isChild True if the element is a child of _source, so
+  /// that its XML path may be stored relative to it.
+  /// \return The element, or nullptr if the data is invalid.
+  public: ElementPtr ReadElement(const ElementPtr &_source,
+                                 const ElementPtr &_target,
+                                 bool _isChild)
+  {
+    uint8_t kindValue = 0;
+    const std::string *name = nullptr;
+    if (!this->ReadNumber(kindValue) || !this->ReadId(name))
+      return nullptr;
+
+    const ElementKind kind = static_cast<ElementKind>(kindValue);
+    ElementPtr elem;
+    switch (kind)
+    {
+      case ElementKind::EXISTING:
+        elem = _target;
+        break;
+      case ElementKind::DESCRIBED:
+      case ElementKind::REFERENCED:
+      case ElementKind::PARENT_DESCRIBED:
+        if (_source)
+          elem = Describe(kind, *name, _source, this->config);
+        break;
+      case ElementKind::GENERIC:
+        elem.reset(new Element);
+        elem->dataPtr->name = *name;
+        break;
+    }
+    if (!elem)
+      return nullptr;
+
+    ElementPrivate &elemData = *elem->dataPtr;
+    uint8_t flags = 0;
+    const std::string *xmlPath = nullptr;
+    const std::string *originalVersion = nullptr;
+    int32_t lineNumber = 0;
+    if (!this->ReadNumber(flags) || !this->ReadPath(elemData.state->path) ||
+        !this->ReadId(xmlPath) || !this->ReadId(originalVersion))
+    {
+      return nullptr;
+    }
+    elemData.lineNumber.reset();
+    if (flags & ELEMENT_LINE_NUMBER)
+    {
+      if (!this->ReadNumber(lineNumber))
+        return nullptr;
+      elemData.lineNumber = lineNumber;
+    }
+    // A relative XML path is kept as is, and resolved against the parent
+    // when it is asked for.
+    if ((flags & ELEMENT_RELATIVE_XML_PATH) && !_isChild)
+      return nullptr;
+    elemData.xmlPath = *xmlPath;
+    elemData.state->xmlPathRelative = (flags & ELEMENT_RELATIVE_XML_PATH) != 0;
+    elemData.originalVersion = *originalVersion;
+    elemData.explicitlySetInFile = (flags & ELEMENT_EXPLICITLY_SET) != 0;
+
+    // Attributes are stored in order, so the list is rebuilt rather than
+    // updated.
+    uint32_t attributeCount = 0;
+    if (!this->ReadNumber(attributeCount))
+      return nullptr;
+    Param_V attributes;
+    attributes.reserve(attributeCount);
+    for (uint32_t i = 0; i < attributeCount; ++i)
+    {
+      const std::string *key = nullptr;
+      if (!this->ReadId(key))
+        return nullptr;
+      ParamPtr attribute = this->ReadParam(elem, kind, *key,
+          elemData.FindAttributeByKey(*key));
+      if (!attribute)
+        return nullptr;
+      attributes.push_back(attribute);
+    }
+    elemData.attributes = std::move(attributes);
+    elemData.state->attributeIndex.clear();
+    for (const auto &attribute : elemData.attributes)
+      elemData.AddToAttributeIndex(attribute);
+
+    uint8_t hasValue = 0;
+    if (!this->ReadNumber(hasValue))
+      return nullptr;
+    if (hasValue)
+    {
+      elemData.value = this->ReadParam(elem, kind, *name, elemData.value);
+      if (!elemData.value)
+        return nullptr;
+    }
+    else
+    {
+      elemData.value.reset();
+    }
+
+    // The <include> element of an entity is cloned from the descriptions
+    // of the element that the <include> was a child of.
+    uint8_t hasInclude = 0;
+    if (!this->ReadNumber(hasInclude))
+      return nullptr;
+    elemData.includeElement.reset();
+    if (hasInclude)
+    {
+      elemData.includeElement =
+          this->ReadElement(_source, nullptr, false);
+      if (!elemData.includeElement)
+        return nullptr;
+    }
+
+    uint32_t childCount = 0;
+    if (!this->ReadNumber(childCount) ||
+        childCount > this->data.size() - this->pos)
+    {
+      return nullptr;
+    }
+    if (kind != ElementKind::EXISTING)
+    {
+      elemData.elements.clear();
+      elemData.state->elementIndex.clear();
+      elemData.ChildNamesChanged();
+    }
+    elemData.elements.reserve(elemData.elements.size() + childCount);
+    for (uint32_t i = 0; i < childCount; ++i)
+    {
+      ElementPtr child =
+          this->ReadElement(elem, nullptr, true);
+      if (!child)
+        return nullptr;
+      child->dataPtr->parent = elem;
+      elem->InsertElement(child);
+    }
+    return elem;
+  }
+
+  /// \brief Read a parameter.
+  /// \param[in] _elem The element the parameter belongs to.
+  /// \param[in] _kind How the element was created.
+  /// \param[in] _key Key of the parameter.
+  /// \param[in] _described The parameter of the same key that the element
+  /// already has, if any.
+  /// \return The parameter, or nullptr if the data is invalid.
+  private: ParamPtr ReadParam(const ElementPtr &_elem, ElementKind _kind,
+                              const std::string &_key,
+                              const ParamPtr &_described)
+  {
+    uint8_t described = 0;
+    if (!this->ReadNumber(described))
+      return nullptr;
+
+    ParamPtr param;
+    if (described)
+    {
+      param = _described;
+    }
+    else
+    {
+      const std::string *typeName = nullptr;
+      const std::string *defaultValue = nullptr;
+      const std::string *description = nullptr;
+      uint8_t required = 0;
+      if (!this->ReadId(typeName) || !this->ReadId(defaultValue) ||
+          !this->ReadNumber(required) || !this->ReadId(description))
+      {
+        return nullptr;
+      }
+
+      // The parameters of the element that is read into are kept if they
+      // have the same type.
+      if (_kind == ElementKind::EXISTING && _described &&
+          _described->GetTypeName() == *typeName)
+      {
+        param = _described;
+      }
+      else
+      {
+        param = _elem->CreateParam(_key, *typeName, *defaultValue,
+                                   required != 0, *description);
+      }
+    }
+    if (!param)
+      return nullptr;
+
+    ParamPrivate &paramData = *param->dataPtr;
+    uint8_t flags = 0;
+    if (!this->ReadNumber(flags))
+      return nullptr;
+    paramData.set = (flags & PARAM_SET) != 0;
+    paramData.ignoreParentAttributes =
+        (flags & PARAM_IGNORE_PARENT_ATTRIBUTES) != 0;
+    paramData.strValue.reset();
+    if (flags & PARAM_STR_VALUE)
+    {
+      const std::string *strValue = nullptr;
+      if (!this->ReadId(strValue))
+        return nullptr;
+      paramData.strValue = *strValue;
+    }
+    if (!this->ReadValue(paramData.value))
+      return nullptr;
+    return param;
+  }
+
+  /// \brief Read the value of a parameter.
+  /// \param[out] _value Set to the value.
+  /// \return False if the data is invalid.
+  private: bool ReadValue(ParamPrivate::ParamVariant &_value)
+  {
+    using ValueType = ParamPrivate::ValueType;
+
+    uint8_t index = 0;
+    if (!this->ReadNumber(index))
+      return false;
+
+    switch (static_cast<ValueType>(index))
+    {
+      case ValueType::BOOL:
+      {
+        uint8_t value = 0;
+        if (!this->ReadNumber(value))
+          return false;
+        _value = value != 0;
+        return true;
+      }
+      case ValueType::CHAR:
+        return this->ReadAlternative<char>(_value);
+      case ValueType::STRING:
+      {
+        const std::string *value = nullptr;
+        if (!this->ReadId(value))
+          return false;
+        _value = *value;
+        return true;
+      }
+      case ValueType::INT:
+        return this->ReadAlternative<int>(_value);
+      case ValueType::UINT64:
+        return this->ReadAlternative<std::uint64_t>(_value);
+      case ValueType::UNSIGNED_INT:
+        return this->ReadAlternative<unsigned int>(_value);
+      case ValueType::DOUBLE:
+        return this->ReadAlternative<double>(_value);
+      case ValueType::FLOAT:
+        return this->ReadAlternative<float>(_value);
+      case ValueType::TIME:
+      {
+        int32_t v[2];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = Time(v[0], v[1]);
+        return true;
+      }
+      case ValueType::ANGLE:
+      {
+        double v[1];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Angle(v[0]);
+        return true;
+      }
+      case ValueType::COLOR:
+      {
+        float v[4];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Color(v[0], v[1], v[2], v[3]);
+        return true;
+      }
+      case ValueType::VECTOR2I:
+      {
+        int v[2];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Vector2i(v[0], v[1]);
+        return true;
+      }
+      case ValueType::VECTOR2D:
+      {
+        double v[2];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Vector2d(v[0], v[1]);
+        return true;
+      }
+      case ValueType::VECTOR3D:
+      {
+        double v[3];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Vector3d(v[0], v[1], v[2]);
+        return true;
+      }
+      case ValueType::QUATERNIOND:
+      {
+        double v[4];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Quaterniond(v[0], v[1], v[2], v[3]);
+        return true;
+      }
+      case ValueType::POSE3D:
+      {
+        double v[7];
+        if (!this->ReadNumbers(v))
+          return false;
+        _value = ignition::math::Pose3d(
+            ignition::math::Vector3d(v[0], v[1], v[2]),
+            ignition::math::Quaterniond(v[3], v[4], v[5], v[6]));
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  /// \brief Read a value that is stored as a single number.
+  /// \param[out] _value Set to the value.
+  /// \return False if the data ends first.
+  private: template<typename T>
+  bool ReadAlternative(ParamPrivate::ParamVariant &_value)
+  {
+    T value{};
+    if (!this->ReadNumber(value))
+      return false;
+    _value = value;
+    return true;
+  }
+
+  /// \brief Read an array of numbers.
+  /// \param[out] _values Set to the numbers.
+  /// \return False if the data ends first.
+  private: template<typename T, std::size_t N>
+  bool ReadNumbers(T (&_values)[N])
+  {
+    for (T &value : _values)
+    {
+      if (!this->ReadNumber(value))
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Contents of the file.
+  private: std::string_view data;
+
+  /// \brief Position of the next read in data.
+  private: std::size_t pos = 0;
+
+  /// \brief The string table.
+  private: std::vector<std::string> strings;
+
+  /// \brief The file paths of the string table that elements refer to, by
+  /// index.
+  private: std::vector<std::shared_ptr<const std::string>> paths;
+
+  /// \brief Configuration the file is loaded with.
+  private: const ParserConfig &config;
+};
+
+/// \brief Writes the contents of a precompiled file. Strings are collected
+/// in a table, so that each one is only stored once.
+class sdf::PrecompiledSdf::Encoder
+{
+  /// \brief Constructor.
+  /// \param[in] _config Configuration the file was read with.
+  public: explicit Encoder(const ParserConfig &_config)
+    : config(_config)
+  {
+  }
+
+  /// \brief Append a number.
+  /// \param[in] _value The number.
+  public: template<typename T>
+  void WriteNumber(T _value)
+  {
+    appendNumber(this->body, _value);
+  }
+
+  /// \brief Append the index of a string in the string table, adding the
+  /// string to the table if needed.
+  /// \param[in] _str The string.
+  public: void WriteId(const std::string &_str)
+  {
+    auto inserted = this->ids.emplace(_str,
+        static_cast<uint32_t>(this->strings.size()));
+    if (inserted.second)
+      this->strings.push_back(&inserted.first->first);
+    this->WriteNumber<uint32_t>(inserted.first->second);
+  }
+
+  /// \brief Append an element and its descendants.
+  /// \param[in] _elem The element.
+  /// \param[in] _source The element whose descriptions are used to create
+  /// the element when loaded, or nullptr for the element that the file is
+  /// loaded into.
+  /// \param[in] _parentXmlPath XML path of the parent of the element, or
+  /// nullptr to store the XML path of the element in full.
+  /// \param[out] _errors Errors for elements that cannot be created again
+  /// when loaded.
+  /// \return True on success.
+  public: bool WriteElement(const ElementPtr &_elem,
+                            const ElementPtr &_source,
+                            const std::string *_parentXmlPath,
+                            Errors &_errors)
+  {
+    const ElementPrivate &elemData = *_elem->dataPtr;
+
+    // The full XML path, which the XML paths of the children may extend.
+    const std::string xmlPath =
+        _parentXmlPath && elemData.state->xmlPathRelative ?
+        *_parentXmlPath + "/" + elemData.xmlPath : _elem->BuildXmlPath();
+
+    // Find out how the element can be created again.
+    ElementKind kind = ElementKind::EXISTING;
+    ElementPtr created;
+    if (_source)
+    {
+      for (ElementKind describedKind : {ElementKind::DESCRIBED,
+           ElementKind::REFERENCED, ElementKind::PARENT_DESCRIBED})
+      {
+        ElementPtr described = Decoder::Describe(
+            describedKind, elemData.name, _source, this->config);
+        if (described && sameDescription(*described->dataPtr, elemData))
+        {
+          kind = describedKind;
+          created = described;
+          break;
+        }
+      }
+
+      if (!created)
+      {
+        ElementPtr generic(new Element);
+        generic->dataPtr->name = elemData.name;
+        if (!sameDescription(*generic->dataPtr, elemData))
+        {
+          Error err(ErrorCode::ELEMENT_INVALID,
+              "Element[" + elemData.name + "] is not defined by the spec "
+              "of its parent, and cannot be precompiled.");
+          err.SetXmlPath(xmlPath);
+          _errors.push_back(err);
+          return false;
+        }
+        kind = ElementKind::GENERIC;
+        created = generic;
+      }
+    }
+
+    // Most XML paths extend the one of the parent, so only the rest is
+    // stored, which is shared by many elements.
+    const bool relativeXmlPath = _parentXmlPath &&
+        xmlPath.size() > _parentXmlPath->size() &&
+        xmlPath.compare(0, _parentXmlPath->size(), *_parentXmlPath) == 0 &&
+        xmlPath[_parentXmlPath->size()] == '/';
+
+    uint8_t flags = 0;
+    if (elemData.lineNumber.has_value())
+      flags |= ELEMENT_LINE_NUMBER;
+    if (relativeXmlPath)
+      flags |= ELEMENT_RELATIVE_XML_PATH;
+    if (elemData.explicitlySetInFile)
+      flags |= ELEMENT_EXPLICITLY_SET;
+
+    this->WriteNumber(static_cast<uint8_t>(kind));
+    this->WriteId(elemData.name);
+    this->WriteNumber(flags);
+    this->WriteId(_elem->FilePath());
+    this->WriteId(relativeXmlPath ?
+        xmlPath.substr(_parentXmlPath->size() + 1) : xmlPath);
+    this->WriteId(elemData.originalVersion);
+    if (elemData.lineNumber.has_value())
+      this->WriteNumber<int32_t>(*elemData.lineNumber);
+
+    this->WriteNumber(static_cast<uint32_t>(elemData.attributes.size()));
+    for (const auto &attribute : elemData.attributes)
+    {
+      this->WriteId(attribute->GetKey());
+      this->WriteParam(*attribute, created ?
+          created->dataPtr->FindAttributeByKey(attribute->GetKey()) :
+          nullptr);
+    }
+
+    this->WriteNumber<uint8_t>(elemData.value != nullptr);
+    if (elemData.value)
+    {
+      this->WriteParam(*elemData.value,
+          created ? created->dataPtr->value : nullptr);
+    }
+
+    this->WriteNumber<uint8_t>(elemData.includeElement != nullptr);
+    if (elemData.includeElement)
+    {
+      if (!_source)
+      {
+        Error err(ErrorCode::ELEMENT_INVALID,
+            "The <include> element of element[" + elemData.name +
+            "] cannot be precompiled.");
+        err.SetXmlPath(xmlPath);
+        _errors.push_back(err);
+        return false;
+      }
+      if (!this->WriteElement(elemData.includeElement, _source, nullptr,
+                              _errors))
+      {
+        return false;
+      }
+    }
+
+    this->WriteNumber(static_cast<uint32_t>(elemData.elements.size()));
+    for (const auto &child : elemData.elements)
+    {
+      if (child->GetParent() != _elem)
+      {
+        Error err(ErrorCode::ELEMENT_INVALID,
+            "Element[" + child->GetName() + "] is not a child of its "
+            "parent element[" + elemData.name + "], and cannot be "
+            "precompiled.");
+        err.SetXmlPath(child->XmlPath());
+        _errors.push_back(err);
+        return false;
+      }
+      if (!this->WriteElement(child, _elem, &xmlPath, _errors))
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Get the string table followed by the elements and errors that
+  /// were written.
+  /// \param[out] _out The string table and body are appended to this.
+  public: void Finish(std::string &_out) const
+  {
+    appendNumber(_out, static_cast<uint32_t>(this->strings.size()));
+    for (const std::string *str : this->strings)
+      appendString(_out, *str);
+    _out += this->body;
+  }
+
+  /// \brief Check whether an element is created with the same description
+  /// as another.
+  /// \param[in] _created Data of the created element.
+  /// \param[in] _elem Data of the element.
+  /// \return True if both have the same description.
+  private: static bool sameDescription(const ElementPrivate &_created,
+                                       const ElementPrivate &_elem)
+  {
+    return _created.state->elementDescriptions ==
+               _elem.state->elementDescriptions &&
+           _created.name == _elem.name &&
+           _created.required == _elem.required &&
+           _created.state->description == _elem.state->description &&
+           _created.copyChildren == _elem.copyChildren &&
+           _created.referenceSDF == _elem.referenceSDF;
+  }
+
+  /// \brief Append a parameter.
+  /// \param[in] _param The parameter.
+  /// \param[in] _described The parameter of the same key that the element
+  /// has when created, if any. Its definition is only stored if it differs.
+  private: void WriteParam(const Param &_param, const ParamPtr &_described)
+  {
+    const ParamPrivate &paramData = *_param.dataPtr;
+    const bool described = _described &&
+        _described->dataPtr->typeName == paramData.typeName &&
+        _described->dataPtr->defaultStrValue == paramData.defaultStrValue &&
+        _described->dataPtr->required == paramData.required &&
+        _described->dataPtr->internedDescription ==
+            paramData.internedDescription;
+    this->WriteNumber<uint8_t>(described);
+    if (!described)
+    {
+      this->WriteId(paramData.typeName);
+      this->WriteId(paramData.defaultStrValue);
+      this->WriteNumber<uint8_t>(paramData.required);
+      this->WriteId(paramData.internedDescription);
+    }
+
+    uint8_t flags = 0;
+    if (paramData.set)
+      flags |= PARAM_SET;
+    if (paramData.ignoreParentAttributes)
+      flags |= PARAM_IGNORE_PARENT_ATTRIBUTES;
+    if (paramData.strValue.has_value())
+      flags |= PARAM_STR_VALUE;
+    this->WriteNumber(flags);
+    if (paramData.strValue.has_value())
+      this->WriteId(*paramData.strValue);
+
+    this->WriteNumber(static_cast<uint8_t>(paramData.value.index()));
+    std::visit([this](const auto &_value)
+    {
+      this->WriteAlternative(_value);
+    }, paramData.value);
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(bool _value)
+  {
+    this->WriteNumber<uint8_t>(_value);
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const std::string &_value)
+  {
+    this->WriteId(_value);
+  }
+
+  /// \brief Append a value that is stored as a single number.
+  /// \param[in] _value The value.
+  private: template<typename T>
+  std::enable_if_t<std::is_arithmetic_v<T>> WriteAlternative(T _value)
+  {
+    this->WriteNumber(_value);
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const Time &_value)
+  {
+    this->WriteNumber<int32_t>(_value.sec);
+    this->WriteNumber<int32_t>(_value.nsec);
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Angle &_value)
+  {
+    this->WriteNumber(_value.Radian());
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Color &_value)
+  {
+    this->WriteNumber(_value.R());
+    this->WriteNumber(_value.G());
+    this->WriteNumber(_value.B());
+    this->WriteNumber(_value.A());
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Vector2i &_value)
+  {
+    this->WriteNumber<int>(_value.X());
+    this->WriteNumber<int>(_value.Y());
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Vector2d &_value)
+  {
+    this->WriteNumber(_value.X());
+    this->WriteNumber(_value.Y());
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Vector3d &_value)
+  {
+    this->WriteNumber(_value.X());
+    this->WriteNumber(_value.Y());
+    this->WriteNumber(_value.Z());
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Quaterniond &_value)
+  {
+    this->WriteNumber(_value.W());
+    this->WriteNumber(_value.X());
+    this->WriteNumber(_value.Y());
+    this->WriteNumber(_value.Z());
+  }
+
+  /// \brief Append a value.
+  /// \param[in] _value The value.
+  private: void WriteAlternative(const ignition::math::Pose3d &_value)
+  {
+    this->WriteAlternative(_value.Pos());
+    this->WriteAlternative(_value.Rot());
+  }
+
+  /// \brief Elements, errors and other data that refer to the string table.
+  public: std::string body;
+
+  /// \brief Index of each string in the string table.
+  private: std::unordered_map<std::string, uint32_t> ids;
+
+  /// \brief The string table, pointing to the keys of ids.
+  private: std::vector<const std::string *> strings;
+
+  /// \brief Configuration the file was read with.
+  private: const ParserConfig &config;
+};
+
+/////////////////////////////////////////////////
+std::string PrecompiledSdf::FilePath(const std::string &_filename)
+{
+  const std::string sdfExtension = ".sdf";
+  if (_filename.size() > sdfExtension.size() &&
+      _filename.compare(_filename.size() - sdfExtension.size(),
+                        sdfExtension.size(), sdfExtension) == 0)
+  {
+    return _filename + "b";
+  }
+  return _filename + kExtension;
+}
+
+/////////////////////////////////////////////////
+bool PrecompiledSdf::Write(const std::string &_path,
+    const SDFPtr &_sdf, const Errors &_readErrors,
+    const StampedFiles &_files, bool _convert,
+    const ParserConfig &_config, Errors &_errors,
+    const std::string &_source)
+{
+  const std::optional<std::string> key =
+      precompiledKey(_convert, _config, _source);
+  if (!key)
+  {
+    _errors.push_back({ErrorCode::FILE_READ,
+        "Unable to write precompiled file[" + _path + "]: files read with a "
+        "find file callback are not precompiled."});
+    return false;
+  }
+
+  Encoder encoder(_config);
+  encoder.WriteId(_sdf->FilePath());
+  encoder.WriteId(_sdf->OriginalVersion());
+
+  encoder.WriteNumber(static_cast<uint32_t>(_readErrors.size()));
+  for (const auto &error : _readErrors)
+  {
+    uint8_t flags = 0;
+    if (error.FilePath().has_value())
+      flags |= ERROR_FILE_PATH;
+    if (error.LineNumber().has_value())
+      flags |= ERROR_LINE_NUMBER;
+    if (error.XmlPath().has_value())
+      flags |= ERROR_XML_PATH;
+    encoder.WriteNumber(static_cast<int32_t>(error.Code()));
+    encoder.WriteId(error.Message());
+    encoder.WriteNumber(flags);
+    if (error.FilePath().has_value())
+      encoder.WriteId(*error.FilePath());
+    if (error.LineNumber().has_value())
+      encoder.WriteNumber<int32_t>(*error.LineNumber());
+    if (error.XmlPath().has_value())
+      encoder.WriteId(*error.XmlPath());
+  }
+
+  if (!encoder.WriteElement(_sdf->Root(), nullptr, nullptr, _errors))
+    return false;
+
+  std::string out(kMagic, sizeof(kMagic));
+  appendNumber(out, kFormatVersion);
+  appendNumber(out, kByteOrderMark);
+  appendString(out, *key);
+  appendNumber(out, static_cast<uint32_t>(_files.size()));
+  for (const auto &[file, stamp] : _files)
+  {
+    appendString(out, file);
+    appendNumber(out, stamp.mtime);
+    appendNumber(out, stamp.mtimeNsec);
+    appendNumber(out, stamp.size);
+  }
+  encoder.Finish(out);
+
+  // The file is written under another name first, so that it is never
+  // loaded while partially written. The name is random, since the same file
+  // may be written by several threads or processes at once.
+  const std::string tmpPath =
+      _path + ".tmp" + std::to_string(std::random_device()());
+  {
+    std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+    stream.write(out.data(), static_cast<std::streamsize>(out.size()));
+    if (!stream)
+    {
+      _errors.push_back({ErrorCode::FILE_READ,
+          "Unable to write precompiled file[" + tmpPath + "]."});
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+#ifdef _WIN32
+  std::remove(_path.c_str());
+#endif
+  if (std::rename(tmpPath.c_str(), _path.c_str()) != 0)
+  {
+    _errors.push_back({ErrorCode::FILE_READ,
+        "Unable to write precompiled file[" + _path + "]."});
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool PrecompiledSdf::Read(const std::string &_path, bool _convert,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors,
+    StampedFiles &_files, const std::string &_source)
+{
+  const std::optional<std::string> expectedKey =
+      precompiledKey(_convert, _config, _source);
+  if (!expectedKey)
+    return false;
+
+  MappedFile file(_path);
+  if (!file.IsOpen() || file.Data().size() < sizeof(kMagic) ||
+      file.Data().compare(0, sizeof(kMagic),
+                          std::string_view(kMagic, sizeof(kMagic))) != 0)
+  {
+    return false;
+  }
+
+  Decoder decoder(file.Data().substr(sizeof(kMagic)), _config);
+  uint32_t formatVersion = 0;
+  uint32_t byteOrderMark = 0;
+  std::string_view key;
+  if (!decoder.ReadNumber(formatVersion) ||
+      formatVersion != kFormatVersion ||
+      !decoder.ReadNumber(byteOrderMark) ||
+      byteOrderMark != kByteOrderMark ||
+      !decoder.ReadString(key) || key != *expectedKey)
+  {
+    return false;
+  }
+
+  // Every file that was read must be unchanged.
+  uint32_t fileCount = 0;
+  if (!decoder.ReadNumber(fileCount))
+    return false;
+  StampedFiles files;
+  for (uint32_t i = 0; i < fileCount; ++i)
+  {
+    std::string_view path;
+    FileStamp stamp;
+    if (!decoder.ReadString(path) || !decoder.ReadNumber(stamp.mtime) ||
+        !decoder.ReadNumber(stamp.mtimeNsec) ||
+        !decoder.ReadNumber(stamp.size))
+    {
+      return false;
+    }
+    files.emplace_back(path, stamp);
+    if (stamp.mtime < 0 || !(fileStamp(files.back().first) == stamp))
+      return false;
+  }
+
+  const std::string *filePath = nullptr;
+  const std::string *originalVersion = nullptr;
+  uint32_t errorCount = 0;
+  if (!decoder.ReadStringTable() || !decoder.ReadId(filePath) ||
+      !decoder.ReadId(originalVersion) || !decoder.ReadNumber(errorCount))
+  {
+    return false;
+  }
+
+  Errors errors;
+  for (uint32_t i = 0; i < errorCount; ++i)
+  {
+    int32_t code = 0;
+    const std::string *message = nullptr;
+    uint8_t flags = 0;
+    if (!decoder.ReadNumber(code) || !decoder.ReadId(message) ||
+        !decoder.ReadNumber(flags))
+    {
+      return false;
+    }
+    Error error(static_cast<ErrorCode>(code), *message);
+    const std::string *str = nullptr;
+    int32_t lineNumber = 0;
+    if (flags & ERROR_FILE_PATH)
+    {
+      if (!decoder.ReadId(str))
+        return false;
+      error.SetFilePath(*str);
+    }
+    if (flags & ERROR_LINE_NUMBER)
+    {
+      if (!decoder.ReadNumber(lineNumber))
+        return false;
+      error.SetLineNumber(lineNumber);
+    }
+    if (flags & ERROR_XML_PATH)
+    {
+      if (!decoder.ReadId(str))
+        return false;
+      error.SetXmlPath(*str);
+    }
+    errors.push_back(std::move(error));
+  }
+
+  // The root is read into a copy without children, so that it is only
+  // changed once the whole file was read.
+  ElementPtr root = _sdf->Root();
+  ElementPtr staging = root->Clone();
+  staging->dataPtr->elements.clear();
+  staging->dataPtr->state->elementIndex.clear();
+  if (!decoder.ReadElement(nullptr, staging, false) || !decoder.AtEnd())
+    return false;
+
+  ElementPrivate &rootData = *root->dataPtr;
+  ElementPrivate &stagingData = *staging->dataPtr;
+  rootData.attributes = std::move(stagingData.attributes);
+  rootData.state->attributeIndex.clear();
+  for (const auto &attribute : rootData.attributes)
+  {
+    attribute->dataPtr->parentElement = root;
+    rootData.AddToAttributeIndex(attribute);
+  }
+  rootData.value = std::move(stagingData.value);
+  if (rootData.value)
+    rootData.value->dataPtr->parentElement = root;
+  rootData.includeElement = std::move(stagingData.includeElement);
+  rootData.state->path = stagingData.state->path;
+  rootData.lineNumber = stagingData.lineNumber;
+  rootData.xmlPath = std::move(stagingData.xmlPath);
+  rootData.state->xmlPathRelative = stagingData.state->xmlPathRelative;
+  rootData.ResetFullXmlPath();
+  rootData.originalVersion = std::move(stagingData.originalVersion);
+  rootData.explicitlySetInFile = stagingData.explicitlySetInFile;
+  for (const auto &child : stagingData.elements)
+  {
+    child->dataPtr->parent = root;
+    root->InsertElement(child);
+  }
+
+  _sdf->SetFilePath(*filePath);
+  if (_sdf->OriginalVersion().empty())
+    _sdf->SetOriginalVersion(*originalVersion);
+  _errors.insert(_errors.end(), errors.begin(), errors.end());
+  _files = std::move(files);
+  return true;
+}
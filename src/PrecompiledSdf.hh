@@ -0,0 +1,114 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_PRECOMPILEDSDF_HH
+#define SDFORMAT_PRECOMPILEDSDF_HH
+
+#include <string>
+#include <vector>
+
+#include "sdf/Element.hh"
+#include "sdf/Error.hh"
+#include "sdf/FileStamp.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Reads and writes precompiled files, which hold the result of
+  /// reading an SDFormat file in a binary form.
+  ///
+  /// A precompiled file stores the element tree with the parsed values of
+  /// its parameters, the source location of each element and the errors
+  /// found while reading, so that loading it involves neither XML, version
+  /// conversion, includes nor parsing of values. Elements that are defined
+  /// in the spec are stored by name and cloned from the element
+  /// descriptions of their parent when loaded.
+  ///
+  /// The file also stores the names and stamps of every file that was read
+  /// along with the SDFormat file, and the parser settings it was read
+  /// with. It is only loaded while all of them are unchanged. Settings that
+  /// have no key, see parserConfigKey, are neither written nor loaded.
+  class PrecompiledSdf
+  {
+    /// \brief Get the name of the precompiled file of an SDFormat file.
+    /// The ".sdf" extension is replaced by ".sdfb", and other names get
+    /// ".sdfb" appended.
+    /// \param[in] _filename Name of the SDFormat file.
+    /// \return Name of the precompiled file.
+    public: static std::string FilePath(const std::string &_filename);
+
+    /// \brief Write the precompiled file of an SDFormat file.
+    /// \param[in] _path Path of the precompiled file, such as
+    /// FilePath() of the SDFormat file.
+    /// \param[in] _sdf The result of reading the file.
+    /// \param[in] _readErrors Errors found when reading the file.
+    /// \param[in] _files The files read along with the file, each stamped
+    /// before it was read.
+    /// \param[in] _convert True if the file was converted to the latest
+    /// version when read.
+    /// \param[in] _config Configuration the file was read with.
+    /// \param[out] _errors Errors found when writing the file.
+    /// \param[in] _source Identifies the source of the file for callers
+    /// that do not stamp it, such as its contents. Read only loads the
+    /// precompiled file with the same value.
+    /// \return True if the precompiled file was written.
+    public: static bool Write(const std::string &_path,
+                              const SDFPtr &_sdf,
+                              const Errors &_readErrors,
+                              const StampedFiles &_files,
+                              bool _convert,
+                              const ParserConfig &_config,
+                              Errors &_errors,
+                              const std::string &_source = "");
+
+    /// \brief Load the precompiled file of an SDFormat file, if it exists
+    /// and was written from the same files and with the same settings.
+    /// \param[in] _path Path of the precompiled file.
+    /// \param[in] _convert True if the file is converted to the latest
+    /// version.
+    /// \param[in] _config Configuration the file is read with.
+    /// \param[in,out] _sdf Set to the result of reading the file, which is
+    /// left unchanged if the precompiled file cannot be used.
+    /// \param[out] _errors The errors found when the file was read are
+    /// appended to this.
+    /// \param[out] _files Set to the files read along with the file, and
+    /// their stamps from when the precompiled file was written.
+    /// \param[in] _source Source the precompiled file must have been
+    /// written with, see Write.
+    /// \return True if the precompiled file was loaded.
+    public: static bool Read(const std::string &_path,
+                             bool _convert,
+                             const ParserConfig &_config,
+                             SDFPtr _sdf,
+                             Errors &_errors,
+                             StampedFiles &_files,
+                             const std::string &_source = "");
+
+    /// \brief Writes the contents of a precompiled file.
+    private: class Encoder;
+
+    /// \brief Reads the contents of a precompiled file.
+    private: class Decoder;
+  };
+  }
+}
+#endif
@@ -90,6 +90,8 @@ sdf::ScopedGraph<FrameAttachedToGraph> createFrameAttachedToGraph(
   sdf::Errors validateErrors = sdf::validateFrameAttachedToGraph(frameGraph);
   _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
 
+  // The graph is only read from now on.
+  frameGraph.Freeze();
   return frameGraph;
 }
 
@@ -119,6 +121,8 @@ ScopedGraph<PoseRelativeToGraph> createPoseRelativeToGraph(
   Errors validateErrors = validatePoseRelativeToGraph(poseGraph);
   _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
 
+  // The graph is only read from now on.
+  poseGraph.Freeze();
   return poseGraph;
 }
 
@@ -143,7 +147,7 @@ Root::Root()
 /////////////////////////////////////////////////
 Errors Root::Load(const std::string &_filename)
 {
-  return this->Load(_filename, ParserConfig::GlobalConfig());
+  return this->Load(_filename, *globalParserConfig());
 }
 
 /////////////////////////////////////////////////
@@ -171,21 +175,34 @@ Errors Root::Load(const std::string &_filename, const ParserConfig &_config)
 /////////////////////////////////////////////////
 Errors Root::LoadSdfString(const std::string &_sdf)
 {
-  return this->LoadSdfString(_sdf, ParserConfig::GlobalConfig());
+  return this->LoadSdfString(_sdf, *globalParserConfig());
 }
 
 /////////////////////////////////////////////////
 Errors Root::LoadSdfString(const std::string &_sdf, const ParserConfig &_config)
+{
+  return this->LoadSdfString(_sdf.data(), _sdf.size(), _config);
+}
+
+/////////////////////////////////////////////////
+Errors Root::LoadSdfString(const char *_data, std::size_t _size)
+{
+  return this->LoadSdfString(_data, _size, *globalParserConfig());
+}
+
+/////////////////////////////////////////////////
+Errors Root::LoadSdfString(const char *_data, std::size_t _size,
+    const ParserConfig &_config)
 {
   Errors errors;
   SDFPtr sdfParsed(new SDF());
   init(sdfParsed);
 
   // Read an SDF string, and store the result in sdfParsed.
-  if (!readString(_sdf, _config, sdfParsed, errors))
+  if (!readString(_data, _size, _config, sdfParsed, errors))
   {
-    errors.push_back(
-        {ErrorCode::STRING_READ, "Unable to read SDF string: " + _sdf});
+    errors.push_back({ErrorCode::STRING_READ,
+        "Unable to read SDF string: " + std::string(_data, _size)});
     return errors;
   }
 
@@ -198,7 +215,7 @@ Errors Root::LoadSdfString(const std::string &_sdf, const ParserConfig &_config)
 /////////////////////////////////////////////////
 Errors Root::Load(SDFPtr _sdf)
 {
-  return this->Load(_sdf, ParserConfig::GlobalConfig());
+  return this->Load(_sdf, *globalParserConfig());
 }
 
 /////////////////////////////////////////////////
@@ -235,40 +252,54 @@ Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
 
   this->dataPtr->version = versionPair.first;
 
-  // Read all the worlds
+  // Read all the worlds, loading them concurrently if the config asks for
+  // it. Their graphs are then built one after another, in document order.
+  std::vector<ElementPtr> worldElems;
   if (this->dataPtr->sdf->HasElement("world"))
   {
-    ElementPtr elem = this->dataPtr->sdf->GetElement("world");
-    while (elem)
+    for (ElementPtr elem = this->dataPtr->sdf->GetElement("world"); elem;
+         elem = elem->GetNextElement("world"))
     {
-      World world;
+      worldElems.push_back(elem);
+    }
+  }
 
-      Errors worldErrors = world.Load(elem, _config);
+  std::vector<World> loadedWorlds(worldElems.size());
+  std::vector<Errors> worldLoadErrors(worldElems.size());
+  forEachLoadTask(_config.LoadThreadCount(), worldElems.size(),
+      [&](std::size_t _index)
+      {
+        worldLoadErrors[_index] =
+            loadedWorlds[_index].Load(worldElems[_index], _config);
+      });
 
-      this->dataPtr->UpdateGraphs(world, worldErrors);
+  for (std::size_t w = 0; w < loadedWorlds.size(); ++w)
+  {
+    World &world = loadedWorlds[w];
+    Errors &worldErrors = worldLoadErrors[w];
 
-      // Attempt to load the world
-      if (worldErrors.empty())
-      {
-        // Check that the world's name does not exist.
-        if (this->WorldNameExists(world.Name()))
-        {
-          errors.push_back({ErrorCode::DUPLICATE_NAME,
-                "World with name[" + world.Name() + "] already exists."
-                " Each world must have a unique name. Skipping this world."});
-        }
-      }
-      else
+    this->dataPtr->UpdateGraphs(world, worldErrors);
+
+    // Attempt to load the world
+    if (worldErrors.empty())
+    {
+      // Check that the world's name does not exist.
+      if (this->WorldNameExists(world.Name()))
       {
-        std::move(worldErrors.begin(), worldErrors.end(),
-                  std::back_inserter(errors));
-        errors.push_back({ErrorCode::ELEMENT_INVALID,
-                          "Failed to load a world."});
+        errors.push_back({ErrorCode::DUPLICATE_NAME,
+              "World with name[" + world.Name() + "] already exists."
+              " Each world must have a unique name. Skipping this world."});
       }
-
-      this->dataPtr->worlds.push_back(std::move(world));
-      elem = elem->GetNextElement("world");
     }
+    else
+    {
+      std::move(worldErrors.begin(), worldErrors.end(),
+                std::back_inserter(errors));
+      errors.push_back({ErrorCode::ELEMENT_INVALID,
+                        "Failed to load a world."});
+    }
+
+    this->dataPtr->worlds.push_back(std::move(world));
   }
 
   // Load all the models.
@@ -161,6 +161,33 @@ TEST(DOMRoot, StringLightSdfParse)
   EXPECT_EQ(0u, root.WorldCount());
 }
 
+/////////////////////////////////////////////////
+TEST(DOMRoot, BufferSdfParse)
+{
+  // Only the first part of the buffer is a document, so the buffer is read
+  // up to the given size, and need not be null terminated.
+  const std::string buffer = "<?xml version=\"1.0\"?>"
+    " <sdf version=\"1.9\">"
+    "   <model name='buffer_model'>"
+    "     <link name='link'/>"
+    "   </model>"
+    " </sdf>"
+    "<not part of the document>";
+  const std::size_t size = buffer.find("<not");
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(buffer.data(), size);
+  EXPECT_TRUE(errors.empty());
+  const sdf::Model *model = root.Model();
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ("buffer_model", model->Name());
+
+  sdf::Root invalidRoot;
+  errors = invalidRoot.LoadSdfString(buffer.data(), buffer.size());
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::STRING_READ, errors.back().Code());
+}
+
 /////////////////////////////////////////////////
 TEST(DOMRoot, StringActorSdfParse)
 {
@@ -238,7 +265,7 @@ TEST(DOMRoot, FrameSemanticsOnMove)
     EXPECT_EQ("frame1", frame->Name());
     ignition::math::Pose3d pose;
     sdf::Errors errors = frame->SemanticPose().Resolve(pose);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
     EXPECT_EQ(ignition::math::Pose3d(0, 1, 0, 0, 0, 0), pose);
   };
 
@@ -251,28 +278,28 @@ TEST(DOMRoot, FrameSemanticsOnMove)
     EXPECT_EQ("frame2", frame->Name());
     ignition::math::Pose3d pose;
     sdf::Errors errors = frame->SemanticPose().Resolve(pose);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
     EXPECT_EQ(ignition::math::Pose3d(1, 1, 0, 0, 0, 0), pose);
   };
 
   {
     sdf::Root root1;
     sdf::Errors errors = root1.LoadSdfString(sdfString1);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
     testFrame1(root1);
   }
 
   {
     sdf::Root root2;
     sdf::Errors errors = root2.LoadSdfString(sdfString2);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
     testFrame2(root2);
   }
 
   {
     sdf::Root root1;
     sdf::Errors errors = root1.LoadSdfString(sdfString1);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
 
     // then root1 is moved into root2 via the move constructor
     sdf::Root root2(std::move(root1));
@@ -282,10 +309,10 @@ TEST(DOMRoot, FrameSemanticsOnMove)
   {
     sdf::Root root1;
     sdf::Errors errors = root1.LoadSdfString(sdfString1);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
     sdf::Root root2;
     errors = root2.LoadSdfString(sdfString2);
-    EXPECT_TRUE(errors.empty()) << errors;
+    EXPECT_TRUE(errors.empty());
 
     testFrame1(root1);
     testFrame2(root2);
@@ -21,17 +21,20 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "sdf/parser.hh"
 #include "sdf/Assert.hh"
 #include "sdf/Console.hh"
+#include "sdf/FileLookupCache.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/SDFImpl.hh"
 #include "SDFImplPrivate.hh"
 #include "sdf/sdf_config.h"
 #include "EmbeddedSdf.hh"
+#include "Utils.hh"
 
 namespace sdf
 {
@@ -44,6 +47,7 @@ std::string SDF::version = SDF_VERSION;  // NOLINT(runtime/string)
 /////////////////////////////////////////////////
 void setFindCallback(std::function<std::string(const std::string &)> _cb)
 {
+  std::lock_guard<std::mutex> lock(globalParserConfigMutex());
   ParserConfig::GlobalConfig().SetFindCallback(_cb);
 }
 
@@ -52,13 +56,35 @@ std::string findFile(
     const std::string &_filename, bool _searchLocalPath, bool _useCallback)
 {
   return findFile(
-      _filename, _searchLocalPath, _useCallback, ParserConfig::GlobalConfig());
+      _filename, _searchLocalPath, _useCallback, *globalParserConfig());
 }
 
 /////////////////////////////////////////////////
 std::string findFile(const std::string &_filename, bool _searchLocalPath,
                           bool _useCallback, const ParserConfig &_config)
 {
+  if (_config.FileLookupCache())
+  {
+    return _config.FileLookupCache()->FindFile(
+        _filename, _searchLocalPath, _useCallback, _config);
+  }
+
+  std::size_t queries = 0;
+  return findFileUncached(
+      _filename, _searchLocalPath, _useCallback, _config, queries);
+}
+
+/////////////////////////////////////////////////
+std::string findFileUncached(const std::string &_filename,
+    bool _searchLocalPath, bool _useCallback, const ParserConfig &_config,
+    std::size_t &_queries)
+{
+  auto exists = [&_queries](const std::string &_path)
+  {
+    ++_queries;
+    return sdf::filesystem::exists(_path);
+  };
+
   // Check to see if _filename is URI. If so, resolve the URI path.
   for (const auto &[uriScheme, paths] : _config.URIPathMap())
   {
@@ -78,7 +104,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
       {
         // Return the path string if the path + suffix exists.
         std::string pathSuffix = sdf::filesystem::append(path, suffix);
-        if (sdf::filesystem::exists(pathSuffix))
+        if (exists(pathSuffix))
         {
           return pathSuffix;
         }
@@ -97,7 +123,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
 
   // Next check the install path.
   std::string path = sdf::filesystem::append(SDF_SHARE_PATH, filename);
-  if (sdf::filesystem::exists(path))
+  if (exists(path))
   {
     return path;
   }
@@ -106,14 +132,14 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   path = sdf::filesystem::append(SDF_SHARE_PATH,
                                  "sdformat" SDF_MAJOR_VERSION_STR,
                                  sdf::SDF::Version(), filename);
-  if (sdf::filesystem::exists(path))
+  if (exists(path))
   {
     return path;
   }
 
   // Next check to see if the given file exists.
   path = filename;
-  if (sdf::filesystem::exists(path))
+  if (exists(path))
   {
     return path;
   }
@@ -134,7 +160,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
          iter != paths.end(); ++iter)
     {
       path = sdf::filesystem::append(*iter, filename);
-      if (sdf::filesystem::exists(path))
+      if (exists(path))
       {
         return path;
       }
@@ -145,7 +171,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   if (_searchLocalPath)
   {
     path = sdf::filesystem::append(sdf::filesystem::current_path(), filename);
-    if (sdf::filesystem::exists(path))
+    if (exists(path))
     {
       return path;
     }
@@ -173,6 +199,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
 /////////////////////////////////////////////////
 void addURIPath(const std::string &_uri, const std::string &_path)
 {
+  std::lock_guard<std::mutex> lock(globalParserConfigMutex());
   ParserConfig::GlobalConfig().AddURIPath(_uri, _path);
 }
 
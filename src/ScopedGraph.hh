@@ -19,8 +19,11 @@
 #define SDF_SCOPED_GRAPH_HH
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,6 +37,22 @@ namespace sdf
 // Inline bracket to help doxygen filtering.
 inline namespace SDF_VERSION_NAMESPACE {
 
+/// \brief Poses of the vertices of a PoseRelativeToGraph relative to the
+/// scope vertex of a scope, memoized by resolvePoseRelativeToRoot.
+struct ScopedPoseCache
+{
+  /// \brief Guards the cache, which is filled by functions that take the
+  /// graph as const, and which may therefore run on several threads at once.
+  std::mutex mutex;
+
+  /// \brief Version of the graph that the poses were resolved in.
+  std::size_t graphVersion = 0;
+
+  /// \brief Poses relative to the scope vertex, keyed by vertex ID.
+  std::unordered_map<ignition::math::graph::VertexId,
+                     ignition::math::Pose3d> poses;
+};
+
 /// \brief Data structure that holds information associated with each scope
 struct ScopedGraphData
 {
@@ -46,6 +65,10 @@ struct ScopedGraphData
 
   /// \brief The context name of this scope. Either world or __model__
   std::string scopeContextName {};
+
+  /// \brief Poses memoized in this scope, if the graph is a
+  /// PoseRelativeToGraph.
+  ScopedPoseCache poseCache;
 };
 
 // Forward declarations for static_assert
@@ -115,6 +138,7 @@ class ScopedGraph
   public: using Vertex = ignition::math::graph::Vertex<VertexType>;
   public: using Edge = ignition::math::graph::DirectedEdge<EdgeType>;
   public: using MapType = typename T::MapType;
+  public: using FrozenType = typename T::FrozenType;
 
   /// \brief Default constructor. The constructed object is invalid as it
   /// doesn't point to any graph.
@@ -149,11 +173,13 @@ class ScopedGraph
   public: explicit operator bool() const;
 
   /// \brief Immutable reference to the underlying PoseRelativeTo::graph or
-  /// FrameAttachedTo::graph.
+  /// FrameAttachedTo::graph. If Freeze released the graph, it is rebuilt
+  /// from the frozen copy first.
   public: const MathGraphType &Graph() const;
 
   /// \brief Immutable reference to the underlying PoseRelativeTo::map or
-  /// FrameAttachedTo::map.
+  /// FrameAttachedTo::map. If Freeze released the map, it is rebuilt from
+  /// the frozen copy first.
   public: const MapType &Map() const;
 
   /// \brief Adds a scope vertex to the graph. This creates a new
@@ -232,6 +258,31 @@ class ScopedGraph
   /// \return True if this scope points to the same graph as the input.
   public: bool PointsTo(const std::shared_ptr<T> &_graph) const;
 
+  /// \brief Get the version of the graph, which changes each time a vertex
+  /// or edge is added or updated through any scope.
+  /// \return The version.
+  public: std::size_t GraphVersion() const;
+
+  /// \brief Make a compact copy of the whole graph, which VertexIdByName,
+  /// Count, VertexLocalName and the frame semantics functions use instead of
+  /// the graph until a vertex or edge is added or updated. It is meant to be
+  /// called once the graph is built, as sdf::Root does.
+  /// \remark The graph and its map are released once the copy is made, and
+  /// are only rebuilt from it if they are read through Graph or Map, or
+  /// changed, as validateFrameAttachedToGraph and
+  /// validatePoseRelativeToGraph do.
+  public: void Freeze();
+
+  /// \brief Get the compact copy of the graph made by Freeze.
+  /// \return The copy, or nullptr if there is none or if the graph changed
+  /// since it was made.
+  public: const FrozenType *Frozen() const;
+
+  /// \brief Get the poses memoized in this scope. Copies of the scope share
+  /// them.
+  /// \return The memoized poses.
+  public: ScopedPoseCache &PoseCache() const;
+
   /// \brief Set the context name of the scope.
   /// \param[in] _name New context name.
   public: void SetScopeContextName(const std::string &_name);
@@ -253,6 +304,10 @@ class ScopedGraph
   public: std::pair<std::string, bool> FindAndRemovePrefix(
               const std::string &_name) const;
 
+  /// \brief Rebuild the graph and its map from the frozen copy if Freeze
+  /// released them.
+  private: void Thaw() const;
+
   /// \brief Shared pointer to either a FrameAttachedToGraph or
   /// PoseRelativeToGraph.
   private: std::shared_ptr<T> graphPtr;
@@ -307,6 +362,7 @@ ScopedGraph<T>::operator bool() const
 template <typename T>
 auto ScopedGraph<T>::Graph() const -> const MathGraphType &
 {
+  this->Thaw();
   return this->graphPtr->graph;
 }
 
@@ -314,6 +370,7 @@ auto ScopedGraph<T>::Graph() const -> const MathGraphType &
 template <typename T>
 auto ScopedGraph<T>::Map() const -> const MapType &
 {
+  this->Thaw();
   return this->graphPtr->map;
 }
 
@@ -337,9 +394,12 @@ template <typename T>
 auto ScopedGraph<T>::AddVertex(
     const std::string &_name, const VertexType &_data) -> Vertex &
 {
+  this->Thaw();
   const std::string newName = this->AddPrefix(_name);
   Vertex &vert = this->graphPtr->graph.AddVertex(newName, _data);
   this->graphPtr->map[newName] = vert.Id();
+  ++this->graphPtr->version;
+  this->graphPtr->frozen.reset();
   return vert;
 }
 
@@ -349,7 +409,10 @@ auto ScopedGraph<T>::AddEdge(
     const ignition::math::graph::VertexId_P &_vertexPair, const EdgeType &_data)
     -> Edge &
 {
+  this->Thaw();
   Edge &edge = this->graphPtr->graph.AddEdge(_vertexPair, _data);
+  ++this->graphPtr->version;
+  this->graphPtr->frozen.reset();
   return edge;
 }
 
@@ -380,6 +443,13 @@ std::string ScopedGraph<T>::VertexLocalName(const Vertex &_vert) const
 template <typename T>
 std::string ScopedGraph<T>::VertexLocalName(const VertexId &_id) const
 {
+  if (const FrozenType *frozen = this->Frozen())
+  {
+    const auto index = frozen->IndexOf(_id);
+    if (index == FrozenType::kNone)
+      return this->VertexLocalName(Vertex::NullVertex);
+    return this->FindAndRemovePrefix(frozen->Name(index)).first;
+  }
   return this->VertexLocalName(this->Graph().VertexFromId(_id));
 }
 
@@ -394,6 +464,62 @@ void ScopedGraph<T>::UpdateEdge(Edge &_edge, const EdgeType &_data)
   auto &graph = this->graphPtr->graph;
   graph.RemoveEdge(_edge.Id());
   _edge = graph.AddEdge({tailVertexId, headVertexId}, _data);
+  ++this->graphPtr->version;
+  this->graphPtr->frozen.reset();
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+std::size_t ScopedGraph<T>::GraphVersion() const
+{
+  return this->graphPtr->version;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::Freeze()
+{
+  this->Thaw();
+  this->graphPtr->frozen = std::make_shared<const FrozenType>(
+      this->graphPtr->graph, this->graphPtr->map, this->graphPtr->version);
+
+  // The copy holds everything the graph and the map do, so they are
+  // released, and only rebuilt if they are read again.
+  this->graphPtr->graph = MathGraphType();
+  this->graphPtr->map = MapType();
+  this->graphPtr->released = true;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::Thaw() const
+{
+  if (!this->graphPtr->released.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(this->graphPtr->releaseMutex);
+  if (this->graphPtr->released.load(std::memory_order_relaxed))
+  {
+    this->graphPtr->frozen->Thaw(this->graphPtr->graph, this->graphPtr->map);
+    this->graphPtr->released.store(false, std::memory_order_release);
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+auto ScopedGraph<T>::Frozen() const -> const FrozenType *
+{
+  const auto &frozen = this->graphPtr->frozen;
+  if (frozen && frozen->Version() == this->graphPtr->version)
+    return frozen.get();
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+ScopedPoseCache &ScopedGraph<T>::PoseCache() const
+{
+  return this->dataPtr->poseCache;
 }
 
 /////////////////////////////////////////////////
@@ -414,6 +540,8 @@ void ScopedGraph<T>::SetScopeContextName(const std::string &_name)
 template <typename T>
 std::size_t ScopedGraph<T>::Count(const std::string &_name) const
 {
+  if (const FrozenType *frozen = this->Frozen())
+    return frozen->Find(this->dataPtr->prefix, _name) != FrozenType::kNone;
   return this->graphPtr->map.count(this->AddPrefix(_name));
 }
 
@@ -421,6 +549,14 @@ std::size_t ScopedGraph<T>::Count(const std::string &_name) const
 template <typename T>
 auto ScopedGraph<T>::VertexIdByName(const std::string &_name) const -> VertexId
 {
+  if (const FrozenType *frozen = this->Frozen())
+  {
+    const auto index = frozen->Find(this->dataPtr->prefix, _name);
+    if (index == FrozenType::kNone)
+      return ignition::math::graph::kNullId;
+    return frozen->Id(index);
+  }
+
   auto &map = this->Map();
   auto it = map.find(this->AddPrefix(_name));
   if (it != map.end())
@@ -433,7 +569,7 @@ auto ScopedGraph<T>::VertexIdByName(const std::string &_name) const -> VertexId
 template <typename T>
 auto ScopedGraph<T>::ScopeVertex() const -> const Vertex &
 {
-  return this->graphPtr->graph.VertexFromId(
+  return this->Graph().VertexFromId(
       this->dataPtr->scopeVertexId);
 }
 
@@ -14,9 +14,17 @@
  * limitations under the License.
  *
 */
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <limits>
+#include <mutex>
 #include <string>
 #include <utility>
+#include "sdf/Filesystem.hh"
 #include "sdf/SDFImpl.hh"
 #include "Utils.hh"
 
@@ -362,5 +370,168 @@ void copyChildren(ElementPtr _sdf, tinyxml2::XMLElement *_xml,
     }
   }
 }
+
+/////////////////////////////////////////////////
+FileStamp fileStamp(const std::string &_path)
+{
+  FileStamp stamp;
+#ifndef _WIN32
+  struct stat pathStat;
+  if (::stat(_path.c_str(), &pathStat) != 0)
+    return stamp;
+#if defined(__linux__)
+  stamp.mtimeNsec = pathStat.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+  stamp.mtimeNsec = pathStat.st_mtimespec.tv_nsec;
+#endif
+#else
+  struct _stat64 pathStat;
+  if (::_stat64(_path.c_str(), &pathStat) != 0)
+    return stamp;
+#endif
+  stamp.mtime = static_cast<int64_t>(pathStat.st_mtime);
+  stamp.size = static_cast<int64_t>(pathStat.st_size);
+  return stamp;
+}
+
+/////////////////////////////////////////////////
+std::optional<std::string> parserConfigKey(const ParserConfig &_config)
+{
+  if (_config.FindFileCallback())
+    return std::nullopt;
+
+  std::string key = SDF::Version();
+  key += '\n' + std::to_string(static_cast<int>(_config.WarningsPolicy()));
+  key += ' ' + std::to_string(
+      static_cast<int>(_config.UnrecognizedElementsPolicy()));
+  key += ' ' + std::to_string(
+      static_cast<int>(_config.DeprecatedElementsPolicy()));
+  key += ' ' + std::to_string(_config.URDFPreserveFixedJoint());
+  key += ' ' + std::to_string(_config.TrackSourceLocations());
+  key += ' ' + std::to_string(_config.CustomModelParsers().size());
+  for (const auto &[scheme, paths] : _config.URIPathMap())
+  {
+    key += '\n' + scheme;
+    for (const auto &path : paths)
+      key += ':' + path;
+  }
+
+  // findFile searches SDF_PATH and then the current directory.
+#ifndef _WIN32
+  const char *sdfPath = std::getenv("SDF_PATH");
+#else
+  char *sdfPath = nullptr;
+  size_t sz = 0;
+  _dupenv_s(&sdfPath, &sz, "SDF_PATH");
+#endif
+  key += "\nSDF_PATH=";
+  if (sdfPath)
+    key += sdfPath;
+#ifdef _WIN32
+  free(sdfPath);
+#endif
+  key += '\n' + sdf::filesystem::current_path();
+  return key;
+}
+
+/////////////////////////////////////////////////
+std::string sha256(std::string_view _data)
+{
+  static const uint32_t kRoundConstants[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+      0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+      0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+      0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+      0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+      0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+      0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+      0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+  uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+  auto rotr = [](uint32_t _x, int _n)
+  {
+    return (_x >> _n) | (_x << (32 - _n));
+  };
+  auto compress = [&](const unsigned char *_block)
+  {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i)
+    {
+      w[i] = (uint32_t(_block[4 * i]) << 24) |
+             (uint32_t(_block[4 * i + 1]) << 16) |
+             (uint32_t(_block[4 * i + 2]) << 8) | uint32_t(_block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; ++i)
+    {
+      const uint32_t s0 =
+          rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const uint32_t s1 =
+          rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i)
+    {
+      const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) +
+          ((e & f) ^ (~e & g)) + kRoundConstants[i] + w[i];
+      const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) +
+          ((a & b) ^ (a & c) ^ (b & c));
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  };
+
+  // Whole blocks are read from the data, and the rest is padded with a one
+  // bit, zeros and the length of the data in bits.
+  const auto *data = reinterpret_cast<const unsigned char *>(_data.data());
+  std::size_t offset = 0;
+  for (; offset + 64 <= _data.size(); offset += 64)
+    compress(data + offset);
+
+  unsigned char tail[128] = {0};
+  const std::size_t rest = _data.size() - offset;
+  std::copy(data + offset, data + _data.size(), tail);
+  tail[rest] = 0x80;
+  const std::size_t tailSize = rest < 56 ? 64 : 128;
+  const uint64_t bitCount = static_cast<uint64_t>(_data.size()) * 8;
+  for (int i = 0; i < 8; ++i)
+    tail[tailSize - 1 - i] = static_cast<unsigned char>(bitCount >> (8 * i));
+  compress(tail);
+  if (tailSize == 128)
+    compress(tail + 64);
+
+  static const char kDigits[] = "0123456789abcdef";
+  std::string digest(64, '0');
+  for (int i = 0; i < 64; ++i)
+    digest[i] = kDigits[(state[i / 8] >> (28 - 4 * (i % 8))) & 0xf];
+  return digest;
+}
+
+/////////////////////////////////////////////////
+std::mutex &globalParserConfigMutex()
+{
+  static std::mutex globalConfigMutex;
+  return globalConfigMutex;
+}
 }
 }
@@ -18,16 +18,24 @@
 #define SDFORMAT_UTILS_HH
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <tinyxml2.h>
 #include "sdf/Error.hh"
 #include "sdf/Element.hh"
+#include "sdf/FileStamp.hh"
 #include "sdf/InterfaceElements.hh"
 #include "sdf/ParserConfig.hh"
 #include "sdf/Types.hh"
+#include "LoadThreadPool.hh"
 
 namespace sdf
 {
@@ -101,7 +109,7 @@ namespace sdf
   {
     Errors errors;
 
-    std::vector<std::string> names;
+    std::unordered_set<std::string> names;
 
     // Check that an element exists.
     if (_sdf->HasElement(_sdfName))
@@ -124,7 +132,7 @@ namespace sdf
           sdf::loadName(elem, name);
 
           // Check that the name does not exist.
-          if (std::find(names.begin(), names.end(), name) != names.end())
+          if (!names.insert(name).second)
           {
             errors.push_back({ErrorCode::DUPLICATE_NAME,
                 _sdfName + " with name[" + name + "] already exists."});
@@ -133,7 +141,6 @@ namespace sdf
           {
             // Add the object to the result if no errors have been encountered.
             _objs.push_back(std::move(obj));
-            names.push_back(name);
           }
 
           // Add the load errors to the master error list.
@@ -150,6 +157,66 @@ namespace sdf
     return errors;
   }
 
+  /// \brief Load all objects of a specific sdf element type, like
+  /// loadUniqueRepeated, with forEachLoadTask. The objects are loaded
+  /// concurrently, and then checked for duplicate names and added to _objs
+  /// one after another, so the objects and errors are the same as those of
+  /// loadUniqueRepeated.
+  /// \param[in] _threadCount Number of threads, as given to forEachLoadTask.
+  /// \param[in] _sdf The SDF element that contains zero or more elements.
+  /// \param[in] _sdfName Name of the sdf element, such as "model".
+  /// \param[out] _objs Elements that match _sdfName in _sdf are added to this
+  /// vector, unless an error is encountered during load or a duplicate name
+  /// exists.
+  /// \param[in] _args Arguments passed to the Load function of each object,
+  /// after its element.
+  /// \return The vector of errors. An empty vector indicates no errors were
+  /// experienced.
+  template <typename Class, typename... Args>
+  sdf::Errors loadUniqueRepeatedInParallel(unsigned int _threadCount,
+      sdf::ElementPtr _sdf, const std::string &_sdfName,
+      std::vector<Class> &_objs, const Args&... _args)
+  {
+    if (!loadTasksRunInParallel(_threadCount))
+      return loadUniqueRepeated<Class>(_sdf, _sdfName, _objs, _args...);
+
+    std::vector<sdf::ElementPtr> elems;
+    if (_sdf->HasElement(_sdfName))
+    {
+      for (sdf::ElementPtr elem = _sdf->GetElement(_sdfName); elem;
+           elem = elem->GetNextElement(_sdfName))
+      {
+        elems.push_back(elem);
+      }
+    }
+
+    std::vector<Class> objs(elems.size());
+    std::vector<Errors> loadErrors(elems.size());
+    forEachLoadTask(_threadCount, elems.size(), [&](std::size_t _index)
+    {
+      loadErrors[_index] = objs[_index].Load(elems[_index], _args...);
+    });
+
+    Errors errors;
+    std::unordered_set<std::string> names;
+    for (std::size_t i = 0; i < elems.size(); ++i)
+    {
+      std::string name;
+      sdf::loadName(elems[i], name);
+      if (!names.insert(name).second)
+      {
+        errors.push_back({ErrorCode::DUPLICATE_NAME,
+            _sdfName + " with name[" + name + "] already exists."});
+      }
+      else
+      {
+        _objs.push_back(std::move(objs[i]));
+      }
+      errors.insert(errors.end(), loadErrors[i].begin(), loadErrors[i].end());
+    }
+    return errors;
+  }
+
   /// \brief Load all objects of a specific sdf element type. No error
   /// is returned if an element is not present.
   /// \param[in] _sdf The SDF element that contains zero or more elements.
@@ -239,6 +306,65 @@ namespace sdf
   /// do not have a matching description in the provided sdf element pointer.
   void copyChildren(ElementPtr _sdf, tinyxml2::XMLElement *_xml,
       const bool _onlyUnknown);
+
+  /// \brief Get the current stamp of a file.
+  /// \param[in] _path Path to the file.
+  /// \return The stamp, with an mtime of -1 if the file cannot be found.
+  FileStamp fileStamp(const std::string &_path);
+
+  /// \brief Build a string that holds every setting of a parser
+  /// configuration that can change the elements read from a file, including
+  /// the inputs of resolving included files: the URI path map, SDF_PATH and
+  /// the current directory. Results stored for later reads are only reused
+  /// with an equal key.
+  /// \param[in] _config Parser configuration.
+  /// \return The key, or nullopt if the configuration has a find file
+  /// callback. The results of the callback cannot be part of a key, so
+  /// results read with it are not stored.
+  std::optional<std::string> parserConfigKey(const ParserConfig &_config);
+
+  /// \brief Compute the SHA-256 digest of data, which identifies the
+  /// contents of a file across processes.
+  /// \param[in] _data The data.
+  /// \return The digest, as 64 lowercase hexadecimal digits.
+  std::string sha256(std::string_view _data);
+
+  /// \brief Get the mutex that guards ParserConfig::GlobalConfig().
+  /// sdf::setFindCallback and sdf::addURIPath hold it while they update the
+  /// global config.
+  /// \return Reference to the mutex.
+  std::mutex &globalParserConfigMutex();
+
+  /// \brief Get a snapshot of ParserConfig::GlobalConfig(). Overloads that
+  /// do not take a ParserConfig parse with the snapshot, so that they can run
+  /// concurrently with each other and with sdf::setFindCallback and
+  /// sdf::addURIPath. The snapshot is shared by all callers, and is only
+  /// copied again from the global config after the global config changes.
+  /// It is defined in ParserConfig.cc, where the revisions of configs are
+  /// known.
+  /// \return Snapshot of the global parser config.
+  std::shared_ptr<const ParserConfig> globalParserConfig();
+
+  /// \brief Implementation of sdf::findFile that does not use
+  /// ParserConfig::FileLookupCache().
+  /// \param[in] _filename Name of the file to find.
+  /// \param[in] _searchLocalPath True to search the current directory.
+  /// \param[in] _useCallback True to use the find file callback.
+  /// \param[in] _config Parser configuration to use for the search.
+  /// \param[in,out] _queries Incremented for each file system query.
+  /// \return File's full path, or an empty string if it was not found.
+  std::string findFileUncached(const std::string &_filename,
+      bool _searchLocalPath, bool _useCallback, const ParserConfig &_config,
+      std::size_t &_queries);
+
+  /// \brief Implementation of sdf::getModelFilePath that does not use
+  /// ParserConfig::FileLookupCache().
+  /// \param[in] _modelDirPath Directory of the model.
+  /// \param[in,out] _queries Incremented for each file system query,
+  /// including the read of the model.config file.
+  /// \return Path of the best supported model file, or an empty string.
+  std::string getModelFilePathUncached(const std::string &_modelDirPath,
+      std::size_t &_queries);
 }
 }
 #endif
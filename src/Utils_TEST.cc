@@ -19,6 +19,8 @@
 #include <string>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Element.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
 #include "Utils.hh"
 
 /////////////////////////////////////////////////
@@ -153,3 +155,57 @@ TEST(PolicyUtils, EnforcementPolicyErrors)
   ASSERT_TRUE(errors[0].LineNumber().has_value());
   EXPECT_EQ(errors[0].LineNumber().value(), 10);
 }
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, GlobalParserConfig)
+{
+  sdf::ParserConfig::GlobalConfig() = sdf::ParserConfig();
+
+  // The snapshot is shared until the global config changes.
+  auto snapshot = sdf::globalParserConfig();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_EQ(snapshot, sdf::globalParserConfig());
+  EXPECT_FALSE(snapshot->FindFileCallback());
+
+  sdf::setFindCallback([](const std::string &)
+  {
+    return "found";
+  });
+  auto withCallback = sdf::globalParserConfig();
+  EXPECT_NE(snapshot, withCallback);
+  ASSERT_TRUE(withCallback->FindFileCallback());
+  EXPECT_EQ("found", withCallback->FindFileCallback()("file"));
+  EXPECT_FALSE(snapshot->FindFileCallback());
+  EXPECT_EQ(withCallback, sdf::globalParserConfig());
+
+  // Changes made to the global config directly are seen too.
+  sdf::ParserConfig::GlobalConfig().SetWarningsPolicy(
+      sdf::EnforcementPolicy::ERR);
+  auto withPolicy = sdf::globalParserConfig();
+  EXPECT_NE(withCallback, withPolicy);
+  EXPECT_EQ(sdf::EnforcementPolicy::ERR, withPolicy->WarningsPolicy());
+
+  sdf::ParserConfig::GlobalConfig() = sdf::ParserConfig();
+  EXPECT_EQ(sdf::EnforcementPolicy::WARN,
+            sdf::globalParserConfig()->WarningsPolicy());
+  EXPECT_FALSE(sdf::globalParserConfig()->FindFileCallback());
+}
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, Sha256)
+{
+  EXPECT_EQ(
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+      sdf::sha256(""));
+  EXPECT_EQ(
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+      sdf::sha256("abc"));
+  // Padding that takes a second block.
+  EXPECT_EQ(
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+      sdf::sha256(
+          "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+  EXPECT_EQ(
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+      sdf::sha256(std::string(1000000, 'a')));
+}
@@ -14,7 +14,9 @@
  * limitations under the License.
  *
 */
+#include <map>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 #include <optional>
@@ -33,6 +35,7 @@
 #include "sdf/Types.hh"
 #include "sdf/World.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 #include "sdf/parser.hh"
@@ -65,12 +68,21 @@ class sdf::World::Implementation
   /// \brief The frames specified in this world.
   public: std::vector<Frame> frames;
 
+  /// \brief Index of the frames by name.
+  public: NameIndex frameIndex;
+
   /// \brief The lights specified in this world.
   public: std::vector<Light> lights;
 
+  /// \brief Index of the lights by name.
+  public: NameIndex lightIndex;
+
   /// \brief The actors specified in this world.
   public: std::vector<Actor> actors;
 
+  /// \brief Index of the actors by name.
+  public: NameIndex actorIndex;
+
   /// \brief Magnetic field.
   public: ignition::math::Vector3d magneticField =
            ignition::math::Vector3d(5.5645e-6, 22.8758e-6, -42.3884e-6);
@@ -82,6 +94,9 @@ class sdf::World::Implementation
   /// \brief The models specified in this world.
   public: std::vector<Model> models;
 
+  /// \brief Index of the models by name.
+  public: NameIndex modelIndex;
+
   /// \brief The interface models specified in this world.
   public: std::vector<std::pair<sdf::NestedInclude, sdf::InterfaceModelPtr>>
       interfaceModels;
@@ -92,6 +107,9 @@ class sdf::World::Implementation
   /// \brief The physics profiles specified in this world.
   public: std::vector<Physics> physics;
 
+  /// \brief Index of the physics profiles by name.
+  public: NameIndex physicsIndex;
+
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf;
 
@@ -116,12 +134,13 @@ World::World()
   : dataPtr(ignition::utils::MakeImpl<Implementation>())
 {
   this->dataPtr->physics.emplace_back(Physics());
+  this->dataPtr->physicsIndex.Rebuild(this->dataPtr->physics);
 }
 
 /////////////////////////////////////////////////
 Errors World::Load(sdf::ElementPtr _sdf)
 {
-  return this->Load(_sdf, ParserConfig::GlobalConfig());
+  return this->Load(_sdf, *globalParserConfig());
 }
 
 /////////////////////////////////////////////////
@@ -201,25 +220,18 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
         sphericalCoordsErrors.end());
   }
 
-  for (const auto &[name, size] :
-       _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
-  {
-    if (size > 1)
-    {
-      sdfwarn << "Non-unique name[" << name << "] detected " << size
-              << " times in XML children of world with name[" << this->Name()
-              << "].\n";
-    }
-  }
-
-  for (const auto &[name, size] :
-       _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
+  // The names are only counted one by one if some of them are not unique.
+  if (!_sdf->HasUniqueChildNames("", Element::NameUniquenessExceptions()))
   {
-    if (size > 1)
+    for (const auto &[name, size] :
+         _sdf->CountNamedElements("", Element::NameUniquenessExceptions()))
     {
-      sdfwarn << "Non-unique name[" << name << "] detected " << size
-              << " times in XML children of world with name[" << this->Name()
-              << "].\n";
+      if (size > 1)
+      {
+        sdfwarn << "Non-unique name[" << name << "] detected " << size
+                << " times in XML children of world with name["
+                << this->Name() << "].\n";
+      }
     }
   }
 
@@ -227,13 +239,15 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
   // name collisions
   std::unordered_set<std::string> frameNames;
 
-  // Load all the models.
-  Errors modelLoadErrors =
-      loadUniqueRepeated<Model>(_sdf, "model", this->dataPtr->models, _config);
+  // Load all the models, concurrently if the config asks for it.
+  Errors modelLoadErrors = loadUniqueRepeatedInParallel<Model>(
+      _config.LoadThreadCount(), _sdf, "model", this->dataPtr->models,
+      _config);
   errors.insert(errors.end(), modelLoadErrors.begin(), modelLoadErrors.end());
+  this->dataPtr->modelIndex.Rebuild(this->dataPtr->models);
 
-  // Models are loaded first, and loadUniqueRepeated ensures there are no
-  // duplicate names, so these names can be added to frameNames without
+  // Models are loaded first, and loadUniqueRepeatedInParallel ensures there
+  // are no duplicate names, so these names can be added to frameNames without
   // checking uniqueness.
   for (const auto &model : this->dataPtr->models)
   {
@@ -259,17 +273,20 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
         this->dataPtr->physics);
     errors.insert(errors.end(), physicsLoadErrors.begin(),
         physicsLoadErrors.end());
+    this->dataPtr->physicsIndex.Rebuild(this->dataPtr->physics);
   }
 
   // Load all the actors.
   Errors actorLoadErrors = loadUniqueRepeated<Actor>(_sdf, "actor",
       this->dataPtr->actors);
   errors.insert(errors.end(), actorLoadErrors.begin(), actorLoadErrors.end());
+  this->dataPtr->actorIndex.Rebuild(this->dataPtr->actors);
 
   // Load all the lights.
   Errors lightLoadErrors = loadUniqueRepeated<Light>(_sdf, "light",
       this->dataPtr->lights);
   errors.insert(errors.end(), lightLoadErrors.begin(), lightLoadErrors.end());
+  this->dataPtr->lightIndex.Rebuild(this->dataPtr->lights);
 
   // Load all the frames.
   Errors frameLoadErrors = loadUniqueRepeated<Frame>(_sdf, "frame",
@@ -296,6 +313,7 @@ Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
     }
     frameNames.insert(frameName);
   }
+  this->dataPtr->frameIndex.Rebuild(this->dataPtr->frames);
 
   // Load the Gui
   if (_sdf->HasElement("gui"))
@@ -333,6 +351,21 @@ Errors World::ValidateGraphs() const
   return errors;
 }
 
+/////////////////////////////////////////////////
+Errors World::ResolveAllPoses(
+    std::map<std::string, ignition::math::Pose3d> &_poses,
+    const std::string &_resolveTo) const
+{
+  if (!this->dataPtr->poseRelativeToGraph)
+  {
+    return {{ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "World has invalid pointer to PoseRelativeToGraph."}};
+  }
+
+  return resolveAllPoses(_poses, this->dataPtr->poseRelativeToGraph,
+      _resolveTo.empty() ? "world" : _resolveTo);
+}
+
 /////////////////////////////////////////////////
 std::string World::Name() const
 {
@@ -410,6 +443,7 @@ const Model *World::ModelByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Model *World::ModelByIndex(uint64_t _index)
 {
+  this->dataPtr->modelIndex.Touch(_index);
   return const_cast<Model*>(
       static_cast<const World*>(this)->ModelByIndex(_index));
 }
@@ -423,22 +457,19 @@ bool World::ModelNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Model *World::ModelByName(const std::string &_name) const
 {
-  auto index = _name.find("::");
-  const std::string nextModelName = _name.substr(0, index);
-  const Model *nextModel = nullptr;
+  return this->NestedModelByName(_name);
+}
 
-  for (auto const &m : this->dataPtr->models)
-  {
-    if (m.Name() == nextModelName)
-    {
-      nextModel = &m;
-      break;
-    }
-  }
+/////////////////////////////////////////////////
+const Model *World::NestedModelByName(std::string_view _name) const
+{
+  auto index = _name.find("::");
+  const Model *nextModel = this->dataPtr->modelIndex.Find(
+      this->dataPtr->models, _name.substr(0, index));
 
-  if (nullptr != nextModel && index != std::string::npos)
+  if (nullptr != nextModel && index != std::string_view::npos)
   {
-    return nextModel->ModelByName(_name.substr(index + 2));
+    return nextModel->NestedModelByName(_name.substr(index + 2));
   }
   return nextModel;
 }
@@ -446,8 +477,21 @@ const Model *World::ModelByName(const std::string &_name) const
 /////////////////////////////////////////////////
 Model *World::ModelByName(const std::string &_name)
 {
-  return const_cast<Model*>(
-      static_cast<const World*>(this)->ModelByName(_name));
+  auto index = _name.rfind("::");
+  if (index != std::string::npos)
+  {
+    const std::string_view name = _name;
+    Model *parent = const_cast<Model *>(
+        this->NestedModelByName(name.substr(0, index)));
+    if (nullptr == parent)
+      return nullptr;
+    return parent->ModelByName(_name.substr(index + 2));
+  }
+
+  Model *model = const_cast<Model *>(
+      this->dataPtr->modelIndex.Find(this->dataPtr->models, _name));
+  this->dataPtr->modelIndex.Touch(this->dataPtr->models, model);
+  return model;
 }
 
 /////////////////////////////////////////////////
@@ -523,6 +567,7 @@ const Frame *World::FrameByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Frame *World::FrameByIndex(uint64_t _index)
 {
+  this->dataPtr->frameIndex.Touch(_index);
   return const_cast<Frame*>(
       static_cast<const World*>(this)->FrameByIndex(_index));
 }
@@ -539,10 +584,11 @@ const Frame *World::FrameByName(const std::string &_name) const
   auto index = _name.rfind("::");
   if (index != std::string::npos)
   {
-    const Model *model = this->ModelByName(_name.substr(0, index));
+    const std::string_view name = _name;
+    const Model *model = this->NestedModelByName(name.substr(0, index));
     if (nullptr != model)
     {
-      return model->FrameByName(_name.substr(index + 2));
+      return model->FrameByName(std::string(name.substr(index + 2)));
     }
 
     // The nested model name preceding the last "::" could not be found.
@@ -552,21 +598,26 @@ const Frame *World::FrameByName(const std::string &_name) const
     // return nullptr;
   }
 
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return &f;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->frameIndex.Find(this->dataPtr->frames, _name);
 }
 
 /////////////////////////////////////////////////
 Frame *World::FrameByName(const std::string &_name)
 {
-  return const_cast<Frame*>(
-      static_cast<const World*>(this)->FrameByName(_name));
+  auto index = _name.rfind("::");
+  if (index != std::string::npos)
+  {
+    const std::string_view name = _name;
+    Model *model = const_cast<Model *>(
+        this->NestedModelByName(name.substr(0, index)));
+    if (nullptr != model)
+      return model->FrameByName(_name.substr(index + 2));
+  }
+
+  Frame *frame = const_cast<Frame *>(
+      this->dataPtr->frameIndex.Find(this->dataPtr->frames, _name));
+  this->dataPtr->frameIndex.Touch(this->dataPtr->frames, frame);
+  return frame;
 }
 
 /////////////////////////////////////////////////
@@ -586,6 +637,7 @@ const Light *World::LightByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Light *World::LightByIndex(uint64_t _index)
 {
+  this->dataPtr->lightIndex.Touch(_index);
   return const_cast<Light*>(
       static_cast<const World*>(this)->LightByIndex(_index));
 }
@@ -593,14 +645,8 @@ Light *World::LightByIndex(uint64_t _index)
 /////////////////////////////////////////////////
 bool World::LightNameExists(const std::string &_name) const
 {
-  for (auto const &l : this->dataPtr->lights)
-  {
-    if (l.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr !=
+      this->dataPtr->lightIndex.Find(this->dataPtr->lights, _name);
 }
 
 /////////////////////////////////////////////////
@@ -620,6 +666,7 @@ const Actor *World::ActorByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 Actor *World::ActorByIndex(uint64_t _index)
 {
+  this->dataPtr->actorIndex.Touch(_index);
   return const_cast<Actor*>(
       static_cast<const World*>(this)->ActorByIndex(_index));
 }
@@ -627,14 +674,8 @@ Actor *World::ActorByIndex(uint64_t _index)
 /////////////////////////////////////////////////
 bool World::ActorNameExists(const std::string &_name) const
 {
-  for (auto const &a : this->dataPtr->actors)
-  {
-    if (a.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr !=
+      this->dataPtr->actorIndex.Find(this->dataPtr->actors, _name);
 }
 
 //////////////////////////////////////////////////
@@ -654,6 +695,7 @@ const Physics *World::PhysicsByIndex(const uint64_t _index) const
 //////////////////////////////////////////////////
 Physics *World::PhysicsByIndex(uint64_t _index)
 {
+  this->dataPtr->physicsIndex.Touch(_index);
   return const_cast<Physics*>(
       static_cast<const World*>(this)->PhysicsByIndex(_index));
 }
@@ -678,15 +720,8 @@ const Physics *World::PhysicsDefault() const
 //////////////////////////////////////////////////
 bool World::PhysicsNameExists(const std::string &_name) const
 {
-  for (const Physics &physics : this->dataPtr->physics)
-  {
-    if (physics.Name() == _name)
-    {
-      return true;
-    }
-  }
-
-  return false;
+  return nullptr !=
+      this->dataPtr->physicsIndex.Find(this->dataPtr->physics, _name);
 }
 
 /////////////////////////////////////////////////
@@ -929,47 +964,56 @@ sdf::ElementPtr World::ToElement(const OutputConfig &_config) const
 void World::ClearModels()
 {
   this->dataPtr->models.clear();
+  this->dataPtr->modelIndex.Clear();
 }
 
 /////////////////////////////////////////////////
 void World::ClearActors()
 {
   this->dataPtr->actors.clear();
+  this->dataPtr->actorIndex.Clear();
 }
 
 /////////////////////////////////////////////////
 void World::ClearLights()
 {
   this->dataPtr->lights.clear();
+  this->dataPtr->lightIndex.Clear();
 }
 
 /////////////////////////////////////////////////
 void World::ClearPhysics()
 {
   this->dataPtr->physics.clear();
+  this->dataPtr->physicsIndex.Clear();
 }
 
 /////////////////////////////////////////////////
 void World::ClearFrames()
 {
   this->dataPtr->frames.clear();
+  this->dataPtr->frameIndex.Clear();
 }
 
 /////////////////////////////////////////////////
 bool World::AddModel(const Model &_model)
 {
+  this->dataPtr->modelIndex.Sync(this->dataPtr->models);
   if (this->ModelNameExists(_model.Name()))
     return false;
   this->dataPtr->models.push_back(_model);
+  this->dataPtr->modelIndex.AddLast(this->dataPtr->models);
   return true;
 }
 
 /////////////////////////////////////////////////
 bool World::AddActor(const Actor &_actor)
 {
+  this->dataPtr->actorIndex.Sync(this->dataPtr->actors);
   if (this->ActorNameExists(_actor.Name()))
     return false;
   this->dataPtr->actors.push_back(_actor);
+  this->dataPtr->actorIndex.AddLast(this->dataPtr->actors);
 
   return true;
 }
@@ -977,9 +1021,11 @@ bool World::AddActor(const Actor &_actor)
 /////////////////////////////////////////////////
 bool World::AddLight(const Light &_light)
 {
+  this->dataPtr->lightIndex.Sync(this->dataPtr->lights);
   if (this->LightNameExists(_light.Name()))
     return false;
   this->dataPtr->lights.push_back(_light);
+  this->dataPtr->lightIndex.AddLast(this->dataPtr->lights);
 
   return true;
 }
@@ -987,9 +1033,11 @@ bool World::AddLight(const Light &_light)
 /////////////////////////////////////////////////
 bool World::AddPhysics(const Physics &_physics)
 {
+  this->dataPtr->physicsIndex.Sync(this->dataPtr->physics);
   if (this->PhysicsNameExists(_physics.Name()))
     return false;
   this->dataPtr->physics.push_back(_physics);
+  this->dataPtr->physicsIndex.AddLast(this->dataPtr->physics);
 
   return true;
 }
@@ -997,9 +1045,11 @@ bool World::AddPhysics(const Physics &_physics)
 /////////////////////////////////////////////////
 bool World::AddFrame(const Frame &_frame)
 {
+  this->dataPtr->frameIndex.Sync(this->dataPtr->frames);
   if (this->FrameNameExists(_frame.Name()))
     return false;
   this->dataPtr->frames.push_back(_frame);
+  this->dataPtr->frameIndex.AddLast(this->dataPtr->frames);
 
   return true;
 }
@@ -15,6 +15,8 @@
  *
 */
 
+#include <string>
+
 #include <gtest/gtest.h>
 #include <ignition/math/Color.hh>
 #include <ignition/math/Vector3.hh>
@@ -668,6 +670,70 @@ TEST(DOMWorld, MutableByName)
   EXPECT_TRUE(world.FrameByName("frame2"));
 }
 
+/////////////////////////////////////////////////
+TEST(DOMWorld, NameLookup)
+{
+  sdf::World world;
+  EXPECT_TRUE(world.PhysicsNameExists(""));
+
+  for (const std::string name : {"light1", "light2"})
+  {
+    sdf::Light light;
+    light.SetName(name);
+    EXPECT_TRUE(world.AddLight(light));
+  }
+  EXPECT_FALSE(world.AddLight(*world.LightByIndex(1)));
+  EXPECT_TRUE(world.LightNameExists("light2"));
+  world.LightByIndex(1)->SetName("light3");
+  EXPECT_FALSE(world.LightNameExists("light2"));
+  EXPECT_TRUE(world.LightNameExists("light3"));
+  world.ClearLights();
+  EXPECT_FALSE(world.LightNameExists("light1"));
+
+  sdf::Actor actor;
+  actor.SetName("actor1");
+  EXPECT_TRUE(world.AddActor(actor));
+  EXPECT_TRUE(world.ActorNameExists("actor1"));
+  EXPECT_FALSE(world.ActorNameExists("actor2"));
+
+  sdf::Physics physics;
+  physics.SetName("physics1");
+  EXPECT_TRUE(world.AddPhysics(physics));
+  EXPECT_TRUE(world.PhysicsNameExists("physics1"));
+  world.ClearPhysics();
+  EXPECT_FALSE(world.PhysicsNameExists(""));
+  EXPECT_FALSE(world.PhysicsNameExists("physics1"));
+
+  sdf::Model child;
+  child.SetName("child");
+  sdf::Frame frame;
+  frame.SetName("frame1");
+  EXPECT_TRUE(child.AddFrame(frame));
+  sdf::Model model;
+  model.SetName("model");
+  EXPECT_TRUE(model.AddModel(child));
+  EXPECT_TRUE(world.AddModel(model));
+  EXPECT_TRUE(world.AddFrame(frame));
+
+  const sdf::World copy = world;
+  const sdf::Model *nested = copy.ModelByName("model::child");
+  ASSERT_NE(nullptr, nested);
+  EXPECT_EQ("child", nested->Name());
+  EXPECT_EQ(nested->FrameByIndex(0), copy.FrameByName("model::child::frame1"));
+  EXPECT_EQ(copy.FrameByIndex(0), copy.FrameByName("frame1"));
+  EXPECT_EQ(nullptr, copy.FrameByName("model::frame1"));
+  EXPECT_EQ(nullptr, copy.ModelByName("model::frame1"));
+
+  // A model renamed through a pointer kept from before the last lookup is
+  // found by its new name.
+  sdf::Model *keptModel = world.ModelByIndex(0);
+  EXPECT_TRUE(world.ModelNameExists("model"));
+  keptModel->SetName("renamed");
+  EXPECT_EQ(keptModel, world.ModelByName("renamed"));
+  EXPECT_FALSE(world.ModelNameExists("model"));
+  EXPECT_NE(nullptr, world.FrameByName("renamed::child::frame1"));
+}
+
 /////////////////////////////////////////////////
 TEST(DOMWorld, Plugins)
 {
@@ -0,0 +1,474 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "XmlStreamReader.hh"
+
+using namespace sdf;
+
+namespace
+{
+/// \brief An entity that is replaced in text and attribute values.
+struct XmlEntity
+{
+  /// \brief Name of the entity, between '&' and ';'.
+  std::string_view name;
+
+  /// \brief Character that replaces the entity.
+  char value;
+};
+
+/// \brief The entities that tinyxml2 replaces.
+constexpr XmlEntity kEntities[] = {
+  {"quot", '"'}, {"amp", '&'}, {"apos", '\''}, {"lt", '<'}, {"gt", '>'}};
+
+/////////////////////////////////////////////////
+/// \brief Whitespace as defined by tinyxml2.
+/// \param[in] _c Character to check.
+/// \return True if _c is whitespace.
+bool isWhiteSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' || _c == '\f' ||
+         _c == '\r';
+}
+
+/////////////////////////////////////////////////
+/// \brief Whether a character may start an XML name, as defined by
+/// tinyxml2.
+/// \param[in] _c Character to check.
+/// \return True if _c may start a name.
+bool isNameStartChar(char _c)
+{
+  const unsigned char c = static_cast<unsigned char>(_c);
+  return c >= 128 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         c == ':' || c == '_';
+}
+
+/////////////////////////////////////////////////
+/// \brief Whether a character may be part of an XML name, as defined by
+/// tinyxml2.
+/// \param[in] _c Character to check.
+/// \return True if _c may be part of a name.
+bool isNameChar(char _c)
+{
+  return isNameStartChar(_c) || (_c >= '0' && _c <= '9') || _c == '.' ||
+         _c == '-';
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the entity at the start of a string.
+/// \param[in] _str String that starts with '&'.
+/// \return The entity, or nullptr if _str does not start with one.
+const XmlEntity *entityAt(std::string_view _str)
+{
+  for (const auto &entity : kEntities)
+  {
+    if (_str.size() > entity.name.size() + 1 &&
+        _str.compare(1, entity.name.size(), entity.name) == 0 &&
+        _str[entity.name.size() + 1] == ';')
+    {
+      return &entity;
+    }
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that every '&' in raw text starts an entity that
+/// XmlStreamReader replaces.
+/// \param[in] _raw Raw text.
+/// \return True if all the entities are known.
+bool knownEntities(std::string_view _raw)
+{
+  for (std::size_t amp = _raw.find('&'); amp != std::string_view::npos;
+       amp = _raw.find('&', amp + 1))
+  {
+    if (!entityAt(_raw.substr(amp)))
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Normalize line endings and replace entities, as tinyxml2 does.
+/// \param[in] _raw Raw text.
+/// \return The decoded text.
+std::string decode(std::string_view _raw)
+{
+  std::string result;
+  result.reserve(_raw.size());
+  for (std::size_t i = 0; i < _raw.size();)
+  {
+    const char c = _raw[i];
+    if (c == '\r' || c == '\n')
+    {
+      // CR LF, LF CR and a lone CR all become LF.
+      const char other = c == '\r' ? '\n' : '\r';
+      result += '\n';
+      i += (i + 1 < _raw.size() && _raw[i + 1] == other) ? 2 : 1;
+    }
+    else if (c == '&' && entityAt(_raw.substr(i)))
+    {
+      const XmlEntity *entity = entityAt(_raw.substr(i));
+      result += entity->value;
+      i += entity->name.size() + 2;
+    }
+    else
+    {
+      result += c;
+      ++i;
+    }
+  }
+  return result;
+}
+}
+
+/////////////////////////////////////////////////
+XmlStreamReader::XmlStreamReader(std::string_view _data)
+  : data(_data)
+{
+  // Like tinyxml2, stop at the first null character and skip a UTF-8 byte
+  // order mark.
+  const void *null = std::memchr(this->data.data(), 0, this->data.size());
+  if (null)
+  {
+    this->data = this->data.substr(0,
+        static_cast<std::size_t>(static_cast<const char *>(null) -
+                                 this->data.data()));
+  }
+  if (this->data.substr(0, 3) == "\xEF\xBB\xBF")
+    this->pos = 3;
+}
+
+/////////////////////////////////////////////////
+XmlStreamReader::Token XmlStreamReader::Next()
+{
+  if (this->token == Token::ERROR)
+    return this->token;
+
+  this->attributes.clear();
+  this->text = std::string_view();
+
+  if (this->closedInStartTag)
+  {
+    this->closedInStartTag = false;
+    this->tokenBegin = this->tokenEnd;
+    this->token = Token::END_ELEMENT;
+    return this->token;
+  }
+
+  this->SkipWhiteSpace();
+  this->tokenBegin = this->pos;
+  this->tokenLine = this->line;
+  this->depth = this->openElements.size();
+
+  if (this->pos == this->data.size())
+  {
+    if (!this->openElements.empty())
+      return this->Error();
+    this->tokenEnd = this->pos;
+    this->token = Token::END_DOCUMENT;
+    return this->token;
+  }
+
+  const std::string_view rest = this->data.substr(this->pos);
+
+  // Text
+  if (rest[0] != '<')
+  {
+    const std::size_t textEnd = this->data.find('<', this->pos);
+    if (this->openElements.empty() || textEnd == std::string_view::npos)
+      return this->Error();
+
+    this->text = this->data.substr(this->pos, textEnd - this->pos);
+    if (!knownEntities(this->text))
+      return this->Error();
+
+    this->Advance(textEnd);
+    this->tokenEnd = this->pos;
+    this->token = Token::TEXT;
+    return this->token;
+  }
+
+  // Declarations and comments
+  const bool isDeclaration = rest.substr(0, 2) == "<?";
+  if (isDeclaration || rest.substr(0, 4) == "<!--")
+  {
+    const std::string_view end = isDeclaration ? "?>" : "-->";
+    const std::size_t close =
+        this->data.find(end, this->pos + (isDeclaration ? 2 : 4));
+    if (close == std::string_view::npos)
+      return this->Error();
+    this->Advance(close + end.size());
+    this->tokenEnd = this->pos;
+    this->token = isDeclaration ? Token::DECLARATION : Token::COMMENT;
+    return this->token;
+  }
+
+  // CDATA sections and document type declarations are not supported.
+  if (rest.substr(0, 2) == "<!")
+    return this->Error();
+
+  // End tag
+  if (rest.substr(0, 2) == "</")
+  {
+    this->pos += 2;
+    this->name = this->ParseName();
+    this->SkipWhiteSpace();
+    if (this->name.empty() || this->pos == this->data.size() ||
+        this->data[this->pos] != '>' || this->openElements.empty() ||
+        this->openElements.back() != this->name)
+    {
+      return this->Error();
+    }
+    ++this->pos;
+    this->openElements.pop_back();
+    this->tokenEnd = this->pos;
+    this->token = Token::END_ELEMENT;
+    return this->token;
+  }
+
+  // Start tag
+  ++this->pos;
+  this->name = this->ParseName();
+  if (this->name.empty())
+    return this->Error();
+
+  while (true)
+  {
+    this->SkipWhiteSpace();
+    if (this->pos == this->data.size())
+      return this->Error();
+
+    const char c = this->data[this->pos];
+    if (isNameStartChar(c))
+    {
+      Attribute attribute;
+      attribute.lineNumber = this->line;
+      attribute.name = this->ParseName();
+      this->SkipWhiteSpace();
+      if (this->pos == this->data.size() || this->data[this->pos] != '=')
+        return this->Error();
+      ++this->pos;
+      this->SkipWhiteSpace();
+      if (this->pos == this->data.size() ||
+          (this->data[this->pos] != '"' && this->data[this->pos] != '\''))
+      {
+        return this->Error();
+      }
+      const std::size_t valueEnd =
+          this->data.find(this->data[this->pos], this->pos + 1);
+      if (valueEnd == std::string_view::npos)
+        return this->Error();
+      attribute.rawValue =
+          this->data.substr(this->pos + 1, valueEnd - this->pos - 1);
+      if (!knownEntities(attribute.rawValue) ||
+          this->FindAttribute(attribute.name))
+      {
+        return this->Error();
+      }
+      this->Advance(valueEnd + 1);
+      this->attributes.push_back(attribute);
+    }
+    else if (c == '>')
+    {
+      ++this->pos;
+      this->openElements.push_back(this->name);
+      break;
+    }
+    else if (c == '/' && this->pos + 1 < this->data.size() &&
+             this->data[this->pos + 1] == '>')
+    {
+      this->pos += 2;
+      this->closedInStartTag = true;
+      break;
+    }
+    else
+    {
+      return this->Error();
+    }
+  }
+
+  this->depth = this->openElements.size() + (this->closedInStartTag ? 1 : 0);
+  this->tokenEnd = this->pos;
+  this->token = Token::START_ELEMENT;
+  return this->token;
+}
+
+/////////////////////////////////////////////////
+bool XmlStreamReader::SkipElement()
+{
+  const std::size_t elementDepth = this->depth;
+  while (true)
+  {
+    switch (this->Next())
+    {
+      case Token::END_ELEMENT:
+        if (this->depth == elementDepth)
+          return true;
+        break;
+      case Token::END_DOCUMENT:
+      case Token::ERROR:
+        return false;
+      default:
+        break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+XmlStreamReader::Token XmlStreamReader::CurrentToken() const
+{
+  return this->token;
+}
+
+/////////////////////////////////////////////////
+std::string_view XmlStreamReader::Name() const
+{
+  return this->name;
+}
+
+/////////////////////////////////////////////////
+const std::vector<XmlStreamReader::Attribute> &
+XmlStreamReader::Attributes() const
+{
+  return this->attributes;
+}
+
+/////////////////////////////////////////////////
+const XmlStreamReader::Attribute *XmlStreamReader::FindAttribute(
+    std::string_view _name) const
+{
+  for (const auto &attribute : this->attributes)
+  {
+    if (attribute.name == _name)
+      return &attribute;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+std::string_view XmlStreamReader::RawText() const
+{
+  return this->text;
+}
+
+/////////////////////////////////////////////////
+int XmlStreamReader::LineNumber() const
+{
+  return this->tokenLine;
+}
+
+/////////////////////////////////////////////////
+std::size_t XmlStreamReader::Begin() const
+{
+  return this->tokenBegin;
+}
+
+/////////////////////////////////////////////////
+std::size_t XmlStreamReader::End() const
+{
+  return this->tokenEnd;
+}
+
+/////////////////////////////////////////////////
+std::size_t XmlStreamReader::Depth() const
+{
+  return this->depth;
+}
+
+/////////////////////////////////////////////////
+std::string_view XmlStreamReader::Data() const
+{
+  return this->data;
+}
+
+/////////////////////////////////////////////////
+std::string XmlStreamReader::DecodeText(std::string_view _raw)
+{
+  const std::string decoded = decode(_raw);
+
+  // Collapse whitespace like tinyxml2::StrPair::CollapseWhitespace.
+  std::string result;
+  result.reserve(decoded.size());
+  std::size_t i = 0;
+  while (i < decoded.size() && isWhiteSpace(decoded[i]))
+    ++i;
+  while (i < decoded.size())
+  {
+    if (isWhiteSpace(decoded[i]))
+    {
+      while (i < decoded.size() && isWhiteSpace(decoded[i]))
+        ++i;
+      if (i == decoded.size())
+        break;
+      result += ' ';
+    }
+    result += decoded[i++];
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::string XmlStreamReader::DecodeAttribute(std::string_view _raw)
+{
+  return decode(_raw);
+}
+
+/////////////////////////////////////////////////
+XmlStreamReader::Token XmlStreamReader::Error()
+{
+  this->openElements.clear();
+  this->closedInStartTag = false;
+  this->token = Token::ERROR;
+  return this->token;
+}
+
+/////////////////////////////////////////////////
+void XmlStreamReader::Advance(std::size_t _pos)
+{
+  this->line += static_cast<int>(std::count(
+      this->data.begin() + static_cast<std::ptrdiff_t>(this->pos),
+      this->data.begin() + static_cast<std::ptrdiff_t>(_pos), '\n'));
+  this->pos = _pos;
+}
+
+/////////////////////////////////////////////////
+void XmlStreamReader::SkipWhiteSpace()
+{
+  while (this->pos < this->data.size() && isWhiteSpace(this->data[this->pos]))
+  {
+    if (this->data[this->pos] == '\n')
+      ++this->line;
+    ++this->pos;
+  }
+}
+
+/////////////////////////////////////////////////
+std::string_view XmlStreamReader::ParseName()
+{
+  const std::size_t start = this->pos;
+  if (this->pos < this->data.size() && isNameStartChar(this->data[this->pos]))
+  {
+    ++this->pos;
+    while (this->pos < this->data.size() && isNameChar(this->data[this->pos]))
+      ++this->pos;
+  }
+  return this->data.substr(start, this->pos - start);
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef SDFORMAT_XMLSTREAMREADER_HH
+#define SDFORMAT_XMLSTREAMREADER_HH
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief A pull parser for an XML document held in memory.
+  ///
+  /// The reader lets the parser build sdf::Element trees directly from the
+  /// document, without building a tinyxml2::XMLDocument first. It accepts a
+  /// subset of what tinyxml2 accepts, and reports the same element names,
+  /// attributes, text and line numbers as a tinyxml2 document that collapses
+  /// whitespace. Everything outside of that subset, such as malformed XML,
+  /// CDATA sections, document type declarations and numeric character
+  /// references, gives an ERROR token. Such documents should be parsed with
+  /// tinyxml2, which also reports the errors.
+  ///
+  /// The reader does not copy the document, which must outlive it.
+  class XmlStreamReader
+  {
+    /// \brief Kinds of tokens.
+    public: enum class Token
+    {
+      /// \brief The start tag of an element. An element that is closed in
+      /// its start tag, like <a/>, is followed by an END_ELEMENT token.
+      START_ELEMENT,
+
+      /// \brief The end tag of an element.
+      END_ELEMENT,
+
+      /// \brief Text that is not only whitespace.
+      TEXT,
+
+      /// \brief A comment.
+      COMMENT,
+
+      /// \brief A declaration, like <?xml version="1.0"?>.
+      DECLARATION,
+
+      /// \brief The end of the document.
+      END_DOCUMENT,
+
+      /// \brief Input that the reader does not accept. No tokens follow.
+      ERROR
+    };
+
+    /// \brief An attribute of a start tag.
+    public: struct Attribute
+    {
+      /// \brief Name of the attribute.
+      std::string_view name;
+
+      /// \brief Value of the attribute, before entities are replaced. See
+      /// DecodeAttribute.
+      std::string_view rawValue;
+
+      /// \brief Line on which the attribute starts.
+      int lineNumber;
+    };
+
+    /// \brief Constructor.
+    /// \param[in] _data The document.
+    public: explicit XmlStreamReader(std::string_view _data);
+
+    /// \brief Read the next token.
+    /// \return The token.
+    public: Token Next();
+
+    /// \brief Read up to and including the end tag of the element whose
+    /// start tag is the current token.
+    /// \return True on success, false if an ERROR token was reached.
+    public: bool SkipElement();
+
+    /// \brief Get the current token.
+    /// \return The token, or END_DOCUMENT before Next is first called.
+    public: Token CurrentToken() const;
+
+    /// \brief Get the name of the element of the current START_ELEMENT or
+    /// END_ELEMENT token.
+    /// \return The name.
+    public: std::string_view Name() const;
+
+    /// \brief Get the attributes of the current START_ELEMENT token.
+    /// \return The attributes, in document order.
+    public: const std::vector<Attribute> &Attributes() const;
+
+    /// \brief Find an attribute of the current START_ELEMENT token.
+    /// \param[in] _name Name of the attribute.
+    /// \return The attribute, or nullptr if there is none with that name.
+    public: const Attribute *FindAttribute(std::string_view _name) const;
+
+    /// \brief Get the text of the current TEXT token, before entities are
+    /// replaced and whitespace is collapsed. See DecodeText.
+    /// \return The text.
+    public: std::string_view RawText() const;
+
+    /// \brief Get the line on which the current token starts.
+    /// \return The line number, starting at 1.
+    public: int LineNumber() const;
+
+    /// \brief Get the offset of the first byte of the current token.
+    /// \return Offset in the document.
+    public: std::size_t Begin() const;
+
+    /// \brief Get the offset just past the last byte of the current token.
+    /// After SkipElement, this is the end of the skipped element.
+    /// \return Offset in the document.
+    public: std::size_t End() const;
+
+    /// \brief Get the depth of the current token. Elements at the top of
+    /// the document have a depth of 1, and text and comments have the
+    /// depth of the element they are in.
+    /// \return The depth.
+    public: std::size_t Depth() const;
+
+    /// \brief Get the document that is being read.
+    /// \return The document.
+    public: std::string_view Data() const;
+
+    /// \brief Get the value of a text token, as tinyxml2 gives it with
+    /// COLLAPSE_WHITESPACE: line endings are normalized, entities are
+    /// replaced, and whitespace is collapsed.
+    /// \param[in] _raw Raw text, from RawText.
+    /// \return The text.
+    public: static std::string DecodeText(std::string_view _raw);
+
+    /// \brief Get the value of an attribute as tinyxml2 gives it: line
+    /// endings are normalized and entities are replaced.
+    /// \param[in] _raw Raw value, from Attribute::rawValue.
+    /// \return The value.
+    public: static std::string DecodeAttribute(std::string_view _raw);
+
+    /// \brief Set the current token to ERROR.
+    /// \return Token::ERROR.
+    private: Token Error();
+
+    /// \brief Move the read position, counting the lines that are passed.
+    /// \param[in] _pos New position.
+    private: void Advance(std::size_t _pos);
+
+    /// \brief Move the read position past whitespace.
+    private: void SkipWhiteSpace();
+
+    /// \brief Read an XML name at the read position.
+    /// \return The name, or an empty view if there is none.
+    private: std::string_view ParseName();
+
+    /// \brief The document.
+    private: std::string_view data;
+
+    /// \brief Read position.
+    private: std::size_t pos = 0;
+
+    /// \brief Line of the read position.
+    private: int line = 1;
+
+    /// \brief Names of the elements that are open.
+    private: std::vector<std::string_view> openElements;
+
+    /// \brief True if the current token is the start tag of an element that
+    /// is closed in its start tag.
+    private: bool closedInStartTag = false;
+
+    /// \brief Current token.
+    private: Token token = Token::END_DOCUMENT;
+
+    /// \brief Element name of the current token.
+    private: std::string_view name;
+
+    /// \brief Attributes of the current token.
+    private: std::vector<Attribute> attributes;
+
+    /// \brief Text of the current token.
+    private: std::string_view text;
+
+    /// \brief Line of the current token.
+    private: int tokenLine = 1;
+
+    /// \brief Offset of the current token.
+    private: std::size_t tokenBegin = 0;
+
+    /// \brief Offset past the end of the current token.
+    private: std::size_t tokenEnd = 0;
+
+    /// \brief Depth of the current token.
+    private: std::size_t depth = 0;
+  };
+  }
+}
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include "XmlStreamReader.hh"
+
+using Token = sdf::XmlStreamReader::Token;
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Tokens)
+{
+  const std::string xml =
+      "<?xml version='1.0'?>\n"
+      "<sdf version=\"1.9\">\n"
+      "  <!-- a comment -->\n"
+      "  <model name='m'>\n"
+      "    <static>true</static>\n"
+      "    <link name='l'/>\n"
+      "  </model>\n"
+      "</sdf>\n";
+  sdf::XmlStreamReader reader(xml);
+  EXPECT_EQ(Token::END_DOCUMENT, reader.CurrentToken());
+
+  EXPECT_EQ(Token::DECLARATION, reader.Next());
+  EXPECT_EQ(1, reader.LineNumber());
+
+  EXPECT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("sdf", reader.Name());
+  EXPECT_EQ(2, reader.LineNumber());
+  EXPECT_EQ(1u, reader.Depth());
+  ASSERT_EQ(1u, reader.Attributes().size());
+  EXPECT_EQ("version", reader.Attributes()[0].name);
+  EXPECT_EQ("1.9", reader.Attributes()[0].rawValue);
+  EXPECT_EQ(xml.find("<sdf"), reader.Begin());
+
+  EXPECT_EQ(Token::COMMENT, reader.Next());
+  EXPECT_EQ(3, reader.LineNumber());
+  EXPECT_EQ(1u, reader.Depth());
+
+  EXPECT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("model", reader.Name());
+  EXPECT_EQ(4, reader.LineNumber());
+  EXPECT_EQ(2u, reader.Depth());
+  ASSERT_NE(nullptr, reader.FindAttribute("name"));
+  EXPECT_EQ("m", reader.FindAttribute("name")->rawValue);
+  EXPECT_EQ(nullptr, reader.FindAttribute("version"));
+
+  EXPECT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("static", reader.Name());
+  EXPECT_EQ(Token::TEXT, reader.Next());
+  EXPECT_EQ("true", reader.RawText());
+  EXPECT_EQ(3u, reader.Depth());
+  EXPECT_EQ(Token::END_ELEMENT, reader.Next());
+  EXPECT_EQ("static", reader.Name());
+  EXPECT_EQ(3u, reader.Depth());
+
+  // An element closed in its start tag gives both tokens.
+  EXPECT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("link", reader.Name());
+  EXPECT_EQ(6, reader.LineNumber());
+  EXPECT_EQ(3u, reader.Depth());
+  EXPECT_EQ(Token::END_ELEMENT, reader.Next());
+  EXPECT_EQ("link", reader.Name());
+  EXPECT_EQ(3u, reader.Depth());
+
+  EXPECT_EQ(Token::END_ELEMENT, reader.Next());
+  EXPECT_EQ("model", reader.Name());
+  EXPECT_EQ(Token::END_ELEMENT, reader.Next());
+  EXPECT_EQ("sdf", reader.Name());
+  EXPECT_EQ(xml.size() - 1, reader.End());
+  EXPECT_EQ(Token::END_DOCUMENT, reader.Next());
+  EXPECT_EQ(Token::END_DOCUMENT, reader.Next());
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, SkipElement)
+{
+  const std::string xml =
+      "<sdf><a><b>1</b><c/></a><d/></sdf>";
+  sdf::XmlStreamReader reader(xml);
+  ASSERT_EQ(Token::START_ELEMENT, reader.Next());
+  ASSERT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("a", reader.Name());
+  const std::size_t begin = reader.Begin();
+  EXPECT_TRUE(reader.SkipElement());
+  EXPECT_EQ("<a><b>1</b><c/></a>", xml.substr(begin, reader.End() - begin));
+
+  ASSERT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("d", reader.Name());
+  EXPECT_TRUE(reader.SkipElement());
+  EXPECT_EQ(Token::END_ELEMENT, reader.Next());
+  EXPECT_EQ("sdf", reader.Name());
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, LineNumbers)
+{
+  // Like tinyxml2, only LF ends a line, so a lone CR does not count.
+  const std::string xml =
+      "<sdf\r\n  version='1.9'>\r<a\n b='1'/>\n\n<c/></sdf>";
+  sdf::XmlStreamReader reader(xml);
+  ASSERT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ(1, reader.LineNumber());
+  ASSERT_EQ(1u, reader.Attributes().size());
+  EXPECT_EQ(2, reader.Attributes()[0].lineNumber);
+
+  ASSERT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("a", reader.Name());
+  EXPECT_EQ(2, reader.LineNumber());
+  ASSERT_EQ(1u, reader.Attributes().size());
+  EXPECT_EQ(3, reader.Attributes()[0].lineNumber);
+  ASSERT_EQ(Token::END_ELEMENT, reader.Next());
+
+  ASSERT_EQ(Token::START_ELEMENT, reader.Next());
+  EXPECT_EQ("c", reader.Name());
+  EXPECT_EQ(5, reader.LineNumber());
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Decode)
+{
+  EXPECT_EQ("a b c", sdf::XmlStreamReader::DecodeText("  a \n\t b\r\nc  "));
+  EXPECT_EQ("<&>\"'",
+      sdf::XmlStreamReader::DecodeText("&lt;&amp;&gt;&quot;&apos;"));
+  EXPECT_EQ("", sdf::XmlStreamReader::DecodeText(" \n "));
+
+  // Attribute values keep their whitespace, but line endings are
+  // normalized.
+  EXPECT_EQ(" a\n\nb ",
+      sdf::XmlStreamReader::DecodeAttribute(" a\r\n\rb "));
+  EXPECT_EQ("a&b", sdf::XmlStreamReader::DecodeAttribute("a&amp;b"));
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Errors)
+{
+  // Input that tinyxml2 either rejects or reads differently from the
+  // subset of XML that the reader accepts.
+  const char *documents[] = {
+    "<sdf><a></b></sdf>",
+    "<sdf><a>",
+    "<sdf a='1' a='2'/>",
+    "<sdf>&unknown;</sdf>",
+    "<sdf>&#65;</sdf>",
+    "<sdf><![CDATA[text]]></sdf>",
+    "<!DOCTYPE sdf><sdf/>",
+    "text<sdf/>",
+    "< sdf/>",
+    "<sdf",
+  };
+
+  for (const char *xml : documents)
+  {
+    sdf::XmlStreamReader reader(xml);
+    Token token = reader.Next();
+    while (token != Token::ERROR && token != Token::END_DOCUMENT)
+      token = reader.Next();
+    EXPECT_EQ(Token::ERROR, token) << xml;
+    EXPECT_EQ(Token::ERROR, reader.Next()) << xml;
+  }
+}
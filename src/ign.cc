@@ -23,9 +23,11 @@
 #include <vector>
 
 #include "sdf/sdf_config.h"
+#include "sdf/ConversionCache.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
 #include "sdf/Root.hh"
 #include "sdf/parser.hh"
 #include "sdf/PrintConfig.hh"
@@ -35,6 +37,7 @@
 
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "Utils.hh"
 #include "ign.hh"
 
 //////////////////////////////////////////////////
@@ -379,3 +382,110 @@ extern "C" SDFORMAT_VISIBLE int cmdInertialStats(
 
   return 0;
 }
+
+//////////////////////////////////////////////////
+/// \brief Read a file and store the result in a precompiled file next to
+/// it, see sdf::precompileFile.
+/// \return 0 on success, -1 if the file could not be read or the
+/// precompiled file could not be written.
+extern "C" SDFORMAT_VISIBLE int cmdPrecompile(const char *_path)
+{
+  if (!sdf::filesystem::exists(_path))
+  {
+    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    return -1;
+  }
+
+  sdf::Errors errors;
+  const bool result = sdf::precompileFile(
+      _path, *sdf::globalParserConfig(), errors);
+  for (auto &error : errors)
+  {
+    std::cerr << error << std::endl;
+  }
+
+  if (!result)
+  {
+    std::cerr << "Error: Unable to precompile [" << _path << "].\n";
+    return -1;
+  }
+
+  std::cout << "Precompiled.\n";
+  return 0;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the SDFormat and URDF files in a directory and its
+/// subdirectories.
+/// \param[in] _dir The directory.
+/// \param[out] _files The files that were found.
+static void findModelFiles(const std::string &_dir,
+                           std::vector<std::string> &_files)
+{
+  for (sdf::filesystem::DirIter it(_dir); it != sdf::filesystem::DirIter();
+       ++it)
+  {
+    const std::string path = *it;
+    if (sdf::filesystem::is_directory(path))
+    {
+      findModelFiles(path, _files);
+      continue;
+    }
+
+    const std::size_t dot = path.rfind('.');
+    const std::string extension =
+        dot == std::string::npos ? "" : path.substr(dot);
+    if (extension == ".sdf" || extension == ".world" || extension == ".urdf")
+      _files.push_back(path);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the SDFormat and URDF files in a directory, or a single
+/// file, and store the ones that are converted in a conversion cache, see
+/// sdf::ConversionCache.
+/// \return 0 on success, -1 if the cache directory could not be created or
+/// a file could not be read.
+extern "C" SDFORMAT_VISIBLE int cmdCache(const char *_path,
+                                         const char *_cacheDir)
+{
+  if (!sdf::filesystem::exists(_path))
+  {
+    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    return -1;
+  }
+
+  auto cache = std::make_shared<sdf::ConversionCache>(_cacheDir);
+  if (!sdf::filesystem::is_directory(_cacheDir))
+  {
+    std::cerr << "Error: Unable to create cache directory [" << _cacheDir
+              << "].\n";
+    return -1;
+  }
+
+  std::vector<std::string> files;
+  if (sdf::filesystem::is_directory(_path))
+    findModelFiles(_path, files);
+  else
+    files.push_back(_path);
+
+  sdf::ParserConfig config = *sdf::globalParserConfig();
+  config.SetConversionCache(cache);
+
+  int result = 0;
+  for (const auto &file : files)
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    if (!sdf::readFile(file, config, sdf, errors))
+    {
+      std::cerr << "Error: Unable to read [" << file << "].\n";
+      result = -1;
+    }
+  }
+
+  if (result == 0)
+    std::cout << "Cached.\n";
+  return result;
+}
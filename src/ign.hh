@@ -32,6 +32,20 @@ inline namespace SDF_VERSION_NAMESPACE {
 /// \return Zero on success, negative one otherwise.
 extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path);
 
+/// \brief External hook to execute 'ign sdf --precompile' from the command
+/// line.
+/// \param[in] _path Path to the file to precompile.
+/// \return Zero on success, negative one otherwise.
+extern "C" SDFORMAT_VISIBLE int cmdPrecompile(const char *_path);
+
+/// \brief External hook to execute 'ign sdf -c' from the command line.
+/// \param[in] _path Path to the file, or to the directory of files, to
+/// read.
+/// \param[in] _cacheDir Directory of the conversion cache.
+/// \return Zero on success, negative one otherwise.
+extern "C" SDFORMAT_VISIBLE int cmdCache(const char *_path,
+                                         const char *_cacheDir);
+
 /// \brief External hook to read the library version.
 /// \return C-string representing the version. Ex.: 0.1.2
 extern "C" SDFORMAT_VISIBLE char *ignitionVersion();
@@ -18,10 +18,12 @@
 #include <gtest/gtest.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <fstream>
 #include <string>
 
 #include <ignition/utils/ExtraTestMacros.hh>
 
+#include "sdf/Filesystem.hh"
 #include "sdf/parser.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/sdf_config.h"
@@ -1878,6 +1880,81 @@ TEST(inertial_stats, IGN_UTILS_TEST_DISABLED_ON_WIN32(SDF))
   }
 }
 
+/////////////////////////////////////////////////
+TEST(precompile, IGN_UTILS_TEST_DISABLED_ON_WIN32(SDF))
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  sdf::filesystem::create_directory(tmpDir);
+  const std::string path =
+      sdf::filesystem::append(tmpDir, "ign_precompile.sdf");
+  {
+    std::ofstream out(path);
+    out << "<?xml version='1.0'?>\n"
+        << "<sdf version='1.9'>\n"
+        << "  <model name='model'>\n"
+        << "    <link name='link'/>\n"
+        << "  </model>\n"
+        << "</sdf>\n";
+  }
+
+  std::string output = custom_exec_str(
+      IgnCommand() + " sdf --precompile " + path + SdfVersion());
+  EXPECT_EQ("Precompiled.\n", output);
+  EXPECT_TRUE(sdf::filesystem::exists(
+      sdf::filesystem::append(tmpDir, "ign_precompile.sdfb")));
+
+  // The file is still checked from its XML, since precompiled files are
+  // only loaded when the parser config asks for them.
+  output = custom_exec_str(IgnCommand() + " sdf -k " + path + SdfVersion());
+  EXPECT_EQ("Valid.\n", output);
+
+  // A file that does not exist
+  output = custom_exec_str(IgnCommand() + " sdf --precompile " +
+      sdf::filesystem::append(tmpDir, "missing.sdf") + SdfVersion());
+  EXPECT_NE(std::string::npos, output.find("does not exist")) << output;
+}
+
+/////////////////////////////////////////////////
+TEST(cache, IGN_UTILS_TEST_DISABLED_ON_WIN32(SDF))
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  sdf::filesystem::create_directory(tmpDir);
+  const std::string modelDir =
+      sdf::filesystem::append(tmpDir, "ign_cache_models");
+  const std::string cacheDir = sdf::filesystem::append(tmpDir, "ign_cache");
+  sdf::filesystem::create_directory(modelDir);
+  {
+    std::ofstream out(sdf::filesystem::append(modelDir, "model.sdf"));
+    out << "<?xml version='1.0'?>\n"
+        << "<sdf version='1.6'>\n"
+        << "  <model name='model'>\n"
+        << "    <link name='link'/>\n"
+        << "  </model>\n"
+        << "</sdf>\n";
+  }
+
+  std::string output = custom_exec_str(IgnCommand() + " sdf -c " + cacheDir +
+      " " + modelDir + SdfVersion());
+  EXPECT_EQ("Cached.\n", output);
+
+  // The converted file is stored in the cache directory.
+  bool stored = false;
+  for (sdf::filesystem::DirIter it(cacheDir); it != sdf::filesystem::DirIter();
+       ++it)
+  {
+    const std::string path = *it;
+    stored |= path.size() > 5 && path.substr(path.size() - 5) == ".sdfb";
+  }
+  EXPECT_TRUE(stored);
+
+  // A path that does not exist
+  output = custom_exec_str(IgnCommand() + " sdf -c " + cacheDir + " " +
+      sdf::filesystem::append(tmpDir, "missing") + SdfVersion());
+  EXPECT_NE(std::string::npos, output.find("does not exist")) << output;
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
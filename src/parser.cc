@@ -15,18 +15,32 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <cstdlib>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <ignition/math/SemanticVersion.hh>
 
 #include "sdf/Console.hh"
+#include "sdf/ConversionCache.hh"
+#include "sdf/FileLookupCache.hh"
 #include "sdf/Filesystem.hh"
 #include "sdf/Frame.hh"
+#include "sdf/IncludeCache.hh"
 #include "sdf/Joint.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
@@ -40,9 +54,12 @@
 
 #include "Converter.hh"
 #include "FrameSemantics.hh"
+#include "MappedFile.hh"
 #include "ParamPassing.hh"
+#include "PrecompiledSdf.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
+#include "XmlStreamReader.hh"
 #include "parser_private.hh"
 #include "parser_urdf.hh"
 
@@ -85,6 +102,111 @@ struct SourceLocation
     }
   }
 };
+
+//////////////////////////////////////////////////
+/// \brief A tinyxml2 document that holds one element of a document that is
+/// read with an XmlStreamReader. It is used for the elements that readXml
+/// reads through the DOM, such as <include> and <plugin>.
+class XmlFragmentDocument : public tinyxml2::XMLDocument
+{
+  /// \brief Parse an element of a streamed document.
+  /// \param[in] _data The streamed document.
+  /// \param[in] _begin Offset of the start tag of the element.
+  /// \param[in] _end Offset past the end tag of the element.
+  /// \param[in] _lineNumber Line of the start tag of the element.
+  public: XmlFragmentDocument(std::string_view _data, std::size_t _begin,
+              std::size_t _end, int _lineNumber)
+    : tinyxml2::XMLDocument(true, tinyxml2::COLLAPSE_WHITESPACE),
+      lineOffset(_lineNumber - 1)
+  {
+    // The element is given a parent, so that it can be passed to functions
+    // that read the children of an element, such as copyChildren.
+    std::string xml = "<fragment>";
+    xml.append(_data.substr(_begin, _end - _begin));
+    xml += "</fragment>";
+    this->Parse(xml.c_str(), xml.size());
+  }
+
+  /// \brief Get the parent that was given to the element.
+  /// \return The parent, or nullptr if the element could not be parsed.
+  public: tinyxml2::XMLElement *Parent()
+  {
+    return this->FirstChildElement();
+  }
+
+  /// \brief Get the element.
+  /// \return The element, or nullptr if it could not be parsed.
+  public: tinyxml2::XMLElement *Element()
+  {
+    return this->Parent() ? this->Parent()->FirstChildElement() : nullptr;
+  }
+
+  /// \brief Number of lines in the streamed document before the element.
+  public: const int lineOffset;
+};
+
+//////////////////////////////////////////////////
+/// \brief An attribute of an XML element, read either from a tinyxml2
+/// document or with an XmlStreamReader.
+struct XmlAttributeValue
+{
+  /// \brief Name of the attribute.
+  std::string_view name;
+
+  /// \brief Value of the attribute.
+  std::string_view value;
+
+  /// \brief Line of the attribute.
+  int lineNumber;
+};
+
+//////////////////////////////////////////////////
+/// \brief Offsets and line of an element in a streamed document.
+struct XmlElementSpan
+{
+  /// \brief Offset of the start tag.
+  std::size_t begin;
+
+  /// \brief Offset past the end tag.
+  std::size_t end;
+
+  /// \brief Line of the start tag.
+  int lineNumber;
+};
+
+//////////////////////////////////////////////////
+/// \brief What scanXmlStream finds in a document before readSdfStream
+/// builds its elements.
+struct XmlStreamIndex
+{
+  /// \brief Value of the version attribute of <sdf>.
+  std::string version;
+
+  /// \brief Line of <sdf>.
+  int rootLineNumber = 0;
+
+  /// \brief The <include> children of each element, keyed by the offset of
+  /// the start tag of the element.
+  std::unordered_map<std::size_t, std::vector<XmlElementSpan>> includes;
+
+  /// \brief Value of //sdf/model/pose/@relative_to, for the first <pose> of
+  /// the first <model>, if it is set.
+  std::optional<std::string> topLevelPoseRelativeTo;
+
+  /// \brief Line of the <pose> of topLevelPoseRelativeTo.
+  int topLevelPoseLineNumber = 0;
+};
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the line of an XML node in the document it was read from.
+/// \param[in] _node The node.
+/// \return The line number.
+static int lineNumber(const tinyxml2::XMLNode *_node)
+{
+  auto fragment =
+      dynamic_cast<const XmlFragmentDocument *>(_node->GetDocument());
+  return _node->GetLineNum() + (fragment ? fragment->lineOffset : 0);
 }
 //////////////////////////////////////////////////
 /// \brief Internal helper for readFile, which populates the SDF values
@@ -119,12 +241,31 @@ bool readFileInternal(
 /// \param[out] _errors Parsing errors will be appended to this variable.
 /// \return True if successful.
 bool readStringInternal(
-    const std::string &_xmlString,
+    std::string_view _xmlString,
     const bool _convert,
     const ParserConfig &_config,
     SDFPtr _sdf,
     Errors &_errors);
 
+/// \brief Read a document into an SDF object without building a tinyxml2
+/// document of it, like readDoc does.
+///
+/// Documents that would need to be converted to the latest SDF version,
+/// that are not <sdf> documents, or that XmlStreamReader cannot read, are
+/// left to readDoc, which this does not do itself.
+/// \param[in] _data The document.
+/// \param[out] _sdf Pointer to an SDF object.
+/// \param[in] _source Source of the document.
+/// \param[in] _convert Convert to the latest version if true.
+/// \param[in] _config Custom parser configuration
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return The result that readDoc would give, or std::nullopt if the
+/// document should be read with readDoc. In that case, _sdf and _errors
+/// are not changed.
+std::optional<bool> readSdfStream(std::string_view _data, SDFPtr _sdf,
+    const std::string &_source, bool _convert, const ParserConfig &_config,
+    Errors &_errors);
+
 //////////////////////////////////////////////////
 /// \brief Internal helper for creating XMLDocuments
 ///
@@ -141,6 +282,52 @@ inline auto makeSdfDoc()
   return tinyxml2::XMLDocument(true, tinyxml2::COLLAPSE_WHITESPACE);
 }
 
+//////////////////////////////////////////////////
+/// \brief Internal helper that returns the description tree compiled from
+/// an embedded spec file.
+///
+/// Building a description tree requires parsing the spec XML and running
+/// initXml recursively over it, including every referenced spec file. The
+/// result only depends on the spec file name and the spec version, so each
+/// tree is built once per process and cached. The returned Element is shared
+/// and must not be modified; use Element::Copy or Element::Clone to obtain a
+/// mutable instance.
+/// \param[in] _filename Name of the spec file, such as "link.sdf".
+/// \param[in] _xmlData Contents of the embedded spec file.
+/// \param[in] _config Custom parser configuration
+/// \return The cached description tree, or nullptr if the spec could not be
+/// parsed.
+static ElementPtr cachedSpecDescription(const std::string &_filename,
+                                        const std::string &_xmlData,
+                                        const ParserConfig &_config)
+{
+  static std::mutex cacheMutex;
+  static std::map<std::pair<std::string, std::string>, ElementPtr> cache;
+
+  const auto key = std::make_pair(SDF::Version(), _filename);
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+      return it->second;
+    }
+  }
+
+  // The lock is not held while parsing, since initXml recurses into this
+  // function for referenced spec files.
+  ElementPtr description(new Element);
+  auto xmlDoc = makeSdfDoc();
+  xmlDoc.Parse(_xmlData.c_str());
+  if (!initDoc(&xmlDoc, _config, description))
+  {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return cache.emplace(key, description).first->second;
+}
+
 //////////////////////////////////////////////////
 static bool isSdfFile(const std::string &_fileName)
 {
@@ -370,34 +557,44 @@ static void insertIncludedElement(sdf::SDFPtr _includeSDF,
 //////////////////////////////////////////////////
 bool init(SDFPtr _sdf)
 {
-  return init(_sdf, ParserConfig::GlobalConfig());
+  return init(_sdf, *globalParserConfig());
 }
 
 //////////////////////////////////////////////////
 bool init(SDFPtr _sdf, const ParserConfig &_config)
 {
-  std::string xmldata = SDF::EmbeddedSpec("root.sdf", false);
-  auto xmlDoc = makeSdfDoc();
-  xmlDoc.Parse(xmldata.c_str());
-  return initDoc(&xmlDoc, _config, _sdf);
+  const std::string &xmldata = SDF::EmbeddedSpec("root.sdf", false);
+  ElementPtr description = cachedSpecDescription("root.sdf", xmldata, _config);
+  if (!description)
+  {
+    return false;
+  }
+
+  _sdf->Root()->Copy(description);
+  return true;
 }
 
 //////////////////////////////////////////////////
 bool initFile(const std::string &_filename, SDFPtr _sdf)
 {
-  return initFile(_filename, ParserConfig::GlobalConfig(), _sdf);
+  return initFile(_filename, *globalParserConfig(), _sdf);
 }
 
 //////////////////////////////////////////////////
 bool initFile(
     const std::string &_filename, const ParserConfig &_config, SDFPtr _sdf)
 {
-  std::string xmldata = SDF::EmbeddedSpec(_filename, true);
+  const std::string &xmldata = SDF::EmbeddedSpec(_filename, true);
   if (!xmldata.empty())
   {
-    auto xmlDoc = makeSdfDoc();
-    xmlDoc.Parse(xmldata.c_str());
-    return initDoc(&xmlDoc, _config, _sdf);
+    ElementPtr description = cachedSpecDescription(_filename, xmldata, _config);
+    if (!description)
+    {
+      return false;
+    }
+
+    _sdf->Root()->Copy(description);
+    return true;
   }
   return _initFile(sdf::findFile(_filename, true, false, _config), _config,
                    _sdf);
@@ -406,19 +603,24 @@ bool initFile(
 //////////////////////////////////////////////////
 bool initFile(const std::string &_filename, ElementPtr _sdf)
 {
-  return initFile(_filename, ParserConfig::GlobalConfig(), _sdf);
+  return initFile(_filename, *globalParserConfig(), _sdf);
 }
 
 //////////////////////////////////////////////////
 bool initFile(
     const std::string &_filename, const ParserConfig &_config, ElementPtr _sdf)
 {
-  std::string xmldata = SDF::EmbeddedSpec(_filename, true);
+  const std::string &xmldata = SDF::EmbeddedSpec(_filename, true);
   if (!xmldata.empty())
   {
-    auto xmlDoc = makeSdfDoc();
-    xmlDoc.Parse(xmldata.c_str());
-    return initDoc(&xmlDoc, _config, _sdf);
+    ElementPtr description = cachedSpecDescription(_filename, xmldata, _config);
+    if (!description)
+    {
+      return false;
+    }
+
+    _sdf->Copy(description);
+    return true;
   }
   return _initFile(sdf::findFile(_filename, true, false, _config), _config,
                    _sdf);
@@ -441,7 +643,7 @@ bool initString(
 //////////////////////////////////////////////////
 bool initString(const std::string &_xmlString, SDFPtr _sdf)
 {
-  return initString(_xmlString, ParserConfig::GlobalConfig(), _sdf);
+  return initString(_xmlString, *globalParserConfig(), _sdf);
 }
 
 //////////////////////////////////////////////////
@@ -643,7 +845,7 @@ bool initXml(tinyxml2::XMLElement *_xml,
 //////////////////////////////////////////////////
 SDFPtr readFile(const std::string &_filename, Errors &_errors)
 {
-  return readFile(_filename, ParserConfig::GlobalConfig(), _errors);
+  return readFile(_filename, *globalParserConfig(), _errors);
 }
 
 //////////////////////////////////////////////////
@@ -692,7 +894,7 @@ bool readFile(const std::string &_filename, SDFPtr _sdf)
 //////////////////////////////////////////////////
 bool readFile(const std::string &_filename, SDFPtr _sdf, Errors &_errors)
 {
-  return readFile(_filename, ParserConfig::GlobalConfig(), _sdf, _errors);
+  return readFile(_filename, *globalParserConfig(), _sdf, _errors);
 }
 
 //////////////////////////////////////////////////
@@ -707,7 +909,7 @@ bool readFileWithoutConversion(
     const std::string &_filename, SDFPtr _sdf, Errors &_errors)
 {
   return readFileWithoutConversion(
-      _filename, ParserConfig::GlobalConfig(), _sdf, _errors);
+      _filename, *globalParserConfig(), _sdf, _errors);
 }
 
 //////////////////////////////////////////////////
@@ -718,47 +920,100 @@ bool readFileWithoutConversion(const std::string &_filename,
 }
 
 //////////////////////////////////////////////////
-bool readFileInternal(const std::string &_filename, const bool _convert,
-    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+/// \brief Check whether a path is a directory, using the file lookup cache
+/// of a ParserConfig if it has one.
+/// \param[in] _path The path to check.
+/// \param[in] _config Custom parser configuration
+/// \return True if _path is a directory.
+static bool isDirectory(const std::string &_path, const ParserConfig &_config)
+{
+  if (_config.FileLookupCache())
+    return _config.FileLookupCache()->IsDirectory(_path);
+  return filesystem::is_directory(_path);
+}
+
+//////////////////////////////////////////////////
+/// \brief While readIncludedFile reads a file, the files that are included
+/// while reading it are added to this, each stamped before it is read.
+static thread_local StampedFiles *tIncludedFiles = nullptr;
+
+//////////////////////////////////////////////////
+/// \brief Find the file that readFile reads.
+/// \param[in] _filename Name of the file or model directory to find.
+/// \param[in] _config Custom parser configuration
+/// \return Full path of the file, or an empty string if there is none.
+static std::string resolveFile(const std::string &_filename,
+                               const ParserConfig &_config)
 {
-  auto xmlDoc = makeSdfDoc();
   std::string filename = sdf::findFile(_filename, true, true, _config);
 
   if (filename.empty())
   {
     sdferr << "Error finding file [" << _filename << "].\n";
-    return false;
+    return "";
   }
 
-  if (filesystem::is_directory(filename))
+  if (isDirectory(filename, _config))
   {
-    filename = getModelFilePath(filename);
+    filename = getModelFilePath(filename, _config);
   }
 
   if (!filesystem::exists(filename))
   {
     sdferr << "File [" << filename << "] doesn't exist.\n";
-    return false;
+    return "";
   }
+  return filename;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a file found by resolveFile, as SDFormat or URDF.
+/// \param[in] _filename Full path of the file.
+/// \param[in] _contents The file, mapped into memory.
+/// \param[in] _convert Convert to the latest version if true.
+/// \param[in] _config Custom parser configuration
+/// \param[out] _sdf Pointer to an SDF object.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if successful.
+static bool readResolvedFile(const std::string &_filename,
+    const MappedFile &_contents, const bool _convert,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  auto xmlDoc = makeSdfDoc();
 
-  auto error_code = xmlDoc.LoadFile(filename.c_str());
-  if (error_code)
+  // The file is mapped rather than read, so that documents that are read
+  // without building a tinyxml2 document are never copied.
+  std::optional<bool> result;
+  if (_contents.IsOpen() && !_contents.Data().empty())
   {
-    sdferr << "Error parsing XML in file [" << filename << "]: "
-           << xmlDoc.ErrorStr() << '\n';
-    return false;
+    result = readSdfStream(
+        _contents.Data(), _sdf, _filename, _convert, _config, _errors);
+  }
+
+  if (!result.has_value())
+  {
+    auto error_code = _contents.Data().empty() ?
+        xmlDoc.LoadFile(_filename.c_str()) :
+        xmlDoc.Parse(_contents.Data().data(), _contents.Data().size());
+    if (error_code)
+    {
+      sdferr << "Error parsing XML in file [" << _filename << "]: "
+             << xmlDoc.ErrorStr() << '\n';
+      return false;
+    }
+    result = readDoc(&xmlDoc, _sdf, _filename, _convert, _config, _errors);
   }
 
   // Suppress deprecation for sdf::URDF2SDF
-  if (readDoc(&xmlDoc, _sdf, filename, _convert, _config, _errors))
+  if (*result)
   {
     return true;
   }
-  else if (URDF2SDF::IsURDF(filename))
+  else if (URDF2SDF::IsURDF(_filename))
   {
     URDF2SDF u2g;
     auto doc = makeSdfDoc();
-    u2g.InitModelFile(filename, _config, &doc);
+    u2g.InitModelFile(_filename, _config, &doc);
     if (sdf::readDoc(&doc, _sdf, "urdf file", _convert, _config, _errors))
     {
       sdfdbg << "parse from urdf file [" << _filename << "].\n";
@@ -774,6 +1029,140 @@ bool readFileInternal(const std::string &_filename, const bool _convert,
   return false;
 }
 
+//////////////////////////////////////////////////
+/// \brief Read a file found by resolveFile, and record the files that are
+/// read along with it, such as the files it includes.
+/// \param[in] _filename Full path of the file.
+/// \param[in] _contents The file, mapped into memory.
+/// \param[in] _config Custom parser configuration
+/// \param[out] _sdf Pointer to an SDF object.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \param[in,out] _files The files that are read are appended to this.
+/// \return True if successful.
+static bool readResolvedFile(const std::string &_filename,
+    const MappedFile &_contents, const ParserConfig &_config, SDFPtr _sdf,
+    Errors &_errors, StampedFiles &_files)
+{
+  StampedFiles *parentFiles = tIncludedFiles;
+  tIncludedFiles = &_files;
+  bool result = false;
+  try
+  {
+    result = readResolvedFile(
+        _filename, _contents, true, _config, _sdf, _errors);
+  }
+  catch(...)
+  {
+    tIncludedFiles = parentFiles;
+    throw;
+  }
+  tIncludedFiles = parentFiles;
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a file found by resolveFile, converted to the latest
+/// version, using ParserConfig::ConversionCache(). The file is loaded from
+/// the cache if it has an entry for the file. Otherwise the file is read,
+/// and stored in the cache if it was converted.
+/// \param[in] _filename Full path of the file.
+/// \param[in] _config Custom parser configuration
+/// \param[out] _sdf Pointer to an SDF object.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if successful.
+static bool readConvertedFile(const std::string &_filename,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  ConversionCache &cache = *_config.ConversionCache();
+  MappedFile contents(_filename);
+  StampedFiles files;
+  bool result = false;
+  if (contents.IsOpen() &&
+      cache.Find(_filename, contents.Data(), _config, _sdf, _errors, files))
+  {
+    result = true;
+  }
+  else
+  {
+    Errors errors;
+    result = readResolvedFile(
+        _filename, contents, _config, _sdf, errors, files);
+    if (result && contents.IsOpen() &&
+        _sdf->OriginalVersion() != SDF::Version())
+    {
+      cache.Insert(_filename, contents.Data(), _config, _sdf, errors, files);
+    }
+    _errors.insert(_errors.end(), errors.begin(), errors.end());
+  }
+
+  if (tIncludedFiles)
+  {
+    tIncludedFiles->insert(tIncludedFiles->end(), files.begin(),
+                           files.end());
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool readFileInternal(const std::string &_filename, const bool _convert,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  const std::string filename = resolveFile(_filename, _config);
+  if (filename.empty())
+    return false;
+
+  // If the config asks for it, the precompiled file is loaded instead while
+  // none of the files that it was read from changed.
+  StampedFiles files;
+  if (_config.UsePrecompiledFiles() &&
+      PrecompiledSdf::Read(PrecompiledSdf::FilePath(filename), _convert,
+                           _config, _sdf, _errors, files))
+  {
+    if (tIncludedFiles)
+    {
+      tIncludedFiles->insert(tIncludedFiles->end(), files.begin(),
+                             files.end());
+    }
+    return true;
+  }
+
+  if (_convert && _config.ConversionCache())
+    return readConvertedFile(filename, _config, _sdf, _errors);
+
+  return readResolvedFile(
+      filename, MappedFile(filename), _convert, _config, _sdf, _errors);
+}
+
+//////////////////////////////////////////////////
+bool precompileFile(const std::string &_filename,
+    const ParserConfig &_config, Errors &_errors)
+{
+  const std::string filename = resolveFile(_filename, _config);
+  if (filename.empty())
+  {
+    _errors.push_back({ErrorCode::FILE_READ,
+        "Unable to find file[" + _filename + "]."});
+    return false;
+  }
+
+  // Record the files that are read along with this one. Each is stamped
+  // before it is read, so that the precompiled file is not loaded if one
+  // of them changed while it was read.
+  StampedFiles files{{filename, fileStamp(filename)}};
+  SDFPtr sdf(new SDF);
+  init(sdf, _config);
+  Errors errors;
+  const bool result = readResolvedFile(
+      filename, MappedFile(filename), _config, sdf, errors, files);
+
+  _errors.insert(_errors.end(), errors.begin(), errors.end());
+  if (!result)
+    return false;
+
+  return PrecompiledSdf::Write(PrecompiledSdf::FilePath(filename), sdf,
+                               errors, files, true, _config, _errors);
+}
+
 //////////////////////////////////////////////////
 bool readString(const std::string &_xmlString, SDFPtr _sdf)
 {
@@ -790,7 +1179,7 @@ bool readString(const std::string &_xmlString, SDFPtr _sdf)
 //////////////////////////////////////////////////
 bool readString(const std::string &_xmlString, SDFPtr _sdf, Errors &_errors)
 {
-  return readString(_xmlString, ParserConfig::GlobalConfig(), _sdf, _errors);
+  return readString(_xmlString, *globalParserConfig(), _sdf, _errors);
 }
 
 //////////////////////////////////////////////////
@@ -800,12 +1189,20 @@ bool readString(const std::string &_xmlString, const ParserConfig &_config,
   return readStringInternal(_xmlString, true, _config, _sdf, _errors);
 }
 
+//////////////////////////////////////////////////
+bool readString(const char *_data, std::size_t _size,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  return readStringInternal(std::string_view(_data, _size), true, _config,
+                            _sdf, _errors);
+}
+
 //////////////////////////////////////////////////
 bool readStringWithoutConversion(
     const std::string &_filename, SDFPtr _sdf, Errors &_errors)
 {
   return readStringWithoutConversion(
-      _filename, ParserConfig::GlobalConfig(), _sdf, _errors);
+      _filename, *globalParserConfig(), _sdf, _errors);
 }
 
 //////////////////////////////////////////////////
@@ -816,18 +1213,26 @@ bool readStringWithoutConversion(const std::string &_filename,
 }
 
 //////////////////////////////////////////////////
-bool readStringInternal(const std::string &_xmlString, const bool _convert,
+bool readStringInternal(std::string_view _xmlString, const bool _convert,
     const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
 {
-  auto xmlDoc = makeSdfDoc();
-  xmlDoc.Parse(_xmlString.c_str());
-  if (xmlDoc.Error())
+  std::optional<bool> result = readSdfStream(_xmlString, _sdf,
+      std::string(kSdfStringSource), _convert, _config, _errors);
+  if (!result.has_value())
   {
-    sdferr << "Error parsing XML from string: " << xmlDoc.ErrorStr() << '\n';
-    return false;
+    auto xmlDoc = makeSdfDoc();
+    xmlDoc.Parse(_xmlString.data(), _xmlString.size());
+    if (xmlDoc.Error())
+    {
+      sdferr << "Error parsing XML from string: " << xmlDoc.ErrorStr()
+             << '\n';
+      return false;
+    }
+    result = readDoc(&xmlDoc, _sdf, std::string(kSdfStringSource), _convert,
+                     _config, _errors);
   }
-  if (readDoc(&xmlDoc, _sdf, std::string(kSdfStringSource), _convert, _config,
-              _errors))
+
+  if (*result)
   {
     return true;
   }
@@ -835,7 +1240,7 @@ bool readStringInternal(const std::string &_xmlString, const bool _convert,
   {
     URDF2SDF u2g;
     auto doc = makeSdfDoc();
-    u2g.InitModelString(_xmlString, _config, &doc);
+    u2g.InitModelString(std::string(_xmlString), _config, &doc);
 
     if (sdf::readDoc(&doc, _sdf, std::string(kUrdfStringSource), _convert,
                     _config, _errors))
@@ -869,7 +1274,7 @@ bool readString(const std::string &_xmlString, ElementPtr _sdf)
 //////////////////////////////////////////////////
 bool readString(const std::string &_xmlString, ElementPtr _sdf, Errors &_errors)
 {
-  return readString(_xmlString, ParserConfig::GlobalConfig(), _sdf, _errors);
+  return readString(_xmlString, *globalParserConfig(), _sdf, _errors);
 }
 
 //////////////////////////////////////////////////
@@ -896,6 +1301,58 @@ bool readString(const std::string &_xmlString, const ParserConfig &_config,
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Set the original version of an SDF object and its root, and the
+/// line and XML path of the root, unless they are already set.
+/// \param[in,out] _sdf The SDF object.
+/// \param[in] _version Value of the version attribute of <sdf>.
+/// \param[in] _lineNumber Line of <sdf>.
+static void setRootSource(SDFPtr _sdf, const std::string &_version,
+                          int _lineNumber)
+{
+  if (_sdf->OriginalVersion().empty())
+  {
+    _sdf->SetOriginalVersion(_version);
+  }
+
+  if (_sdf->Root()->OriginalVersion().empty())
+  {
+    _sdf->Root()->SetOriginalVersion(_version);
+  }
+
+  if (!_sdf->Root()->LineNumber().has_value())
+  {
+    _sdf->Root()->SetLineNumber(_lineNumber);
+  }
+
+  if (_sdf->Root()->XmlPath().empty())
+  {
+    _sdf->Root()->SetXmlPath("/sdf");
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that no names in a document that was read contain the '::'
+/// delimiter, which is not allowed in SDFormat >= 1.8.
+/// \param[in] _sdf The SDF object that was read.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return False if a name contains the delimiter.
+static bool checkNoDoubleColonInNames(SDFPtr _sdf, Errors &_errors)
+{
+  // delimiter '::' in element names not allowed in SDFormat >= 1.8
+  ignition::math::SemanticVersion sdfVersion(_sdf->Root()->OriginalVersion());
+  if (sdfVersion >= ignition::math::SemanticVersion(1, 8)
+      && !recursiveSiblingNoDoubleColonInNames(_sdf->Root()))
+  {
+    _errors.push_back({ErrorCode::RESERVED_NAME,
+        "Delimiter '::' found in attribute names of element <"
+        + _sdf->Root()->GetName() +
+        ">, which is not allowed in SDFormat >= 1.8"});
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
     const std::string &_source, bool _convert, const ParserConfig &_config,
@@ -928,25 +1385,7 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
 
   if (sdfNode->Attribute("version"))
   {
-    if (_sdf->OriginalVersion().empty())
-    {
-      _sdf->SetOriginalVersion(sdfNode->Attribute("version"));
-    }
-
-    if (_sdf->Root()->OriginalVersion().empty())
-    {
-      _sdf->Root()->SetOriginalVersion(sdfNode->Attribute("version"));
-    }
-
-    if (!_sdf->Root()->LineNumber().has_value())
-    {
-      _sdf->Root()->SetLineNumber(sdfNode->GetLineNum());
-    }
-
-    if (_sdf->Root()->XmlPath().empty())
-    {
-      _sdf->Root()->SetXmlPath("/sdf");
-    }
+    setRootSource(_sdf, sdfNode->Attribute("version"), sdfNode->GetLineNum());
 
     if (_convert
         && strcmp(sdfNode->Attribute("version"), SDF::Version().c_str()) != 0)
@@ -974,17 +1413,8 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
       return false;
     }
 
-    // delimiter '::' in element names not allowed in SDFormat >= 1.8
-    ignition::math::SemanticVersion sdfVersion(_sdf->Root()->OriginalVersion());
-    if (sdfVersion >= ignition::math::SemanticVersion(1, 8)
-        && !recursiveSiblingNoDoubleColonInNames(_sdf->Root()))
-    {
-      _errors.push_back({ErrorCode::RESERVED_NAME,
-          "Delimiter '::' found in attribute names of element <"
-          + _sdf->Root()->GetName() +
-          ">, which is not allowed in SDFormat >= 1.8"});
+    if (!checkNoDoubleColonInNames(_sdf, _errors))
       return false;
-    }
   }
   else
   {
@@ -1090,6 +1520,36 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the relative_to attribute of the pose of a top level model,
+/// which must be left empty.
+/// \param[in] _relativeTo Value of the attribute.
+/// \param[in] _lineNumber Line of the pose.
+/// \param[in] _source Source of the XML document
+/// \param[out] _errors Captures errors found during parsing.
+/// \return False if the attribute is not empty.
+static bool checkTopLevelPoseRelativeTo(const std::string &_relativeTo,
+    int _lineNumber, const std::string &_source, Errors &_errors)
+{
+  if (_relativeTo.empty())
+    return true;
+
+  std::string errorSourcePath = _source;
+  if (_source == kSdfStringSource || _source == kUrdfStringSource)
+    errorSourcePath = "<" + _source + ">";
+
+  std::stringstream sstream;
+  sstream << "Attribute //pose[@relative_to] of top level model "
+      << "must be left empty, found //pose[@relative_to='"
+      << _relativeTo << "'].\n";
+  _errors.push_back({
+      ErrorCode::ATTRIBUTE_INVALID,
+      sstream.str(),
+      errorSourcePath,
+      _lineNumber});
+  return false;
+}
+
 //////////////////////////////////////////////////
 bool checkXmlFromRoot(tinyxml2::XMLElement *_xmlRoot,
     const std::string &_source, Errors &_errors)
@@ -1100,36 +1560,17 @@ bool checkXmlFromRoot(tinyxml2::XMLElement *_xmlRoot,
   if (!_xmlRoot)
     return true;
 
-  std::string errorSourcePath = _source;
-  if (_source == kSdfStringSource || _source == kUrdfStringSource)
-    errorSourcePath = "<" + _source + ">";
-
   // Top level models must have an empty relative_to frame on the top level
   // pose.
+  if (tinyxml2::XMLElement *topLevelElem = _xmlRoot->FirstChildElement("model"))
   {
-    if (tinyxml2::XMLElement *topLevelElem =
-        _xmlRoot->FirstChildElement("model"))
+    if (tinyxml2::XMLElement *topLevelPose =
+        topLevelElem->FirstChildElement("pose"))
     {
-      if (tinyxml2::XMLElement *topLevelPose =
-          topLevelElem->FirstChildElement("pose"))
+      if (const char *relativeTo = topLevelPose->Attribute("relative_to"))
       {
-        if (const char *relativeTo = topLevelPose->Attribute("relative_to"))
-        {
-          const std::string relativeToStr(relativeTo);
-          if (!relativeToStr.empty())
-          {
-            std::stringstream sstream;
-            sstream << "Attribute //pose[@relative_to] of top level model "
-                << "must be left empty, found //pose[@relative_to='"
-                << relativeToStr << "'].\n";
-            _errors.push_back({
-                ErrorCode::ATTRIBUTE_INVALID,
-                sstream.str(),
-                errorSourcePath,
-                topLevelPose->GetLineNum()});
-            return false;
-          }
-        }
+        return checkTopLevelPoseRelativeTo(relativeTo,
+            topLevelPose->GetLineNum(), _source, _errors);
       }
     }
   }
@@ -1202,16 +1643,35 @@ std::string getBestSupportedModelVersion(tinyxml2::XMLElement *_modelXML,
 
 //////////////////////////////////////////////////
 std::string getModelFilePath(const std::string &_modelDirPath)
+{
+  std::size_t queries = 0;
+  return getModelFilePathUncached(_modelDirPath, queries);
+}
+
+//////////////////////////////////////////////////
+std::string getModelFilePath(const std::string &_modelDirPath,
+                             const ParserConfig &_config)
+{
+  if (_config.FileLookupCache())
+    return _config.FileLookupCache()->ModelFilePath(_modelDirPath);
+  return getModelFilePath(_modelDirPath);
+}
+
+//////////////////////////////////////////////////
+std::string getModelFilePathUncached(const std::string &_modelDirPath,
+                                     std::size_t &_queries)
 {
   std::string configFilePath;
 
   /// \todo This hardcoded bit is very Gazebo centric. It should
   /// be abstracted away, possibly through a plugin to SDF.
   configFilePath = sdf::filesystem::append(_modelDirPath, "model.config");
+  ++_queries;
   if (!sdf::filesystem::exists(configFilePath))
   {
     // We didn't find model.config, look for manifest.xml instead
     configFilePath = sdf::filesystem::append(_modelDirPath, "manifest.xml");
+    ++_queries;
     if (!sdf::filesystem::exists(configFilePath))
     {
       // We didn't find manifest.xml either, output an error and get out.
@@ -1229,6 +1689,7 @@ std::string getModelFilePath(const std::string &_modelDirPath)
   }
 
   auto configFileDoc = makeSdfDoc();
+  ++_queries;
   if (tinyxml2::XML_SUCCESS != configFileDoc.LoadFile(configFilePath.c_str()))
   {
     sdferr << "Error parsing XML in file ["
@@ -1255,15 +1716,18 @@ std::string getModelFilePath(const std::string &_modelDirPath)
 }
 
 //////////////////////////////////////////////////
-/// Helper function that reads all the attributes of an element from TinyXML to
+/// Helper function that reads all the attributes of an element to
 /// sdf::Element.
-/// \param[in] _xml Pointer to XML element to read the attributes from.
+/// \param[in] _xmlName Name of the XML element.
+/// \param[in] _xmlLineNumber Line of the XML element.
+/// \param[in] _attributes The attributes of the XML element.
 /// \param[in,out] _sdf sdf::Element pointer to parse the attribute data into.
 /// \param[in] _config Custom parser configuration
 /// \param[in] _errorSourcePath Source of the XML document.
 /// \param[out] _errors Captures errors found during parsing.
 /// \return True on success, false on error.
-static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+static bool readAttributes(const std::string &_xmlName, int _xmlLineNumber,
+    const std::vector<XmlAttributeValue> &_attributes, ElementPtr _sdf,
     const ParserConfig &_config, const std::string &_errorSourcePath,
     Errors &_errors)
 {
@@ -1281,56 +1745,58 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
       // //sensor/imu/orientation_reference_frame/custom_rpy/[@parent_frame]
       {"custom_rpy", "parent_frame"}};
 
-  const tinyxml2::XMLAttribute *attribute = _xml->FirstAttribute();
-
   unsigned int i = 0;
 
   // Iterate over all the attributes defined in the give XML element
-  while (attribute)
+  for (const auto &attribute : _attributes)
   {
+    const std::string name(attribute.name);
+    const std::string value(attribute.value);
+
     // Avoid printing a warning message for missing attributes if a namespaced
     // attribute is found
-    if (std::strchr(attribute->Name(), ':') != nullptr)
+    if (name.find(':') != std::string::npos)
     {
-      _sdf->AddAttribute(attribute->Name(), "string", "", 1, "");
-      _sdf->GetAttribute(attribute->Name())->SetFromString(attribute->Value());
-      attribute = attribute->Next();
+      _sdf->AddAttribute(name, "string", "", 1, "");
+      _sdf->GetAttribute(name)->SetFromString(value);
       continue;
     }
 
-    // Construct the Xml path of the current attribute
-    const std::string attributeXmlPath = _sdf->XmlPath() + "[@" +
-        attribute->Name() + "=\"" + attribute->Value() + "\"]";
+    // The Xml path of the current attribute is only built for errors
+    auto attributeXmlPath = [&]()
+    {
+      return _sdf->BuildXmlPath() + "[@" + name + "=\"" + value + "\"]";
+    };
 
     // Find the matching attribute in SDF
     for (i = 0; i < _sdf->GetAttributeCount(); ++i)
     {
       ParamPtr p = _sdf->GetAttribute(i);
-      if (p->GetKey() == attribute->Name())
+      if (p->GetKey() == name)
       {
         if (frameReferenceAttributes.count(
-                std::make_pair(_sdf->GetName(), attribute->Name())) != 0)
+                std::make_pair(_sdf->GetName(), name)) != 0)
         {
-          if (!isValidFrameReference(attribute->Value()))
+          if (!isValidFrameReference(value))
           {
             Error err(
                 ErrorCode::ATTRIBUTE_INVALID,
-                "'" + std::string(attribute->Value()) +
+                "'" + value +
                 "' is reserved; it cannot be used as a value of "
                 "attribute [" + p->GetKey() + "]",
-                _errorSourcePath, attribute->GetLineNum());
-            err.SetXmlPath(attributeXmlPath);
+                _errorSourcePath, attribute.lineNumber);
+            err.SetXmlPath(attributeXmlPath());
             _errors.push_back(err);
           }
         }
         // Set the value of the SDF attribute
-        if (!p->SetFromString(attribute->Value()))
+        if (!p->SetFromString(value))
         {
           Error err(
               ErrorCode::ATTRIBUTE_INVALID,
               "Unable to read attribute[" + p->GetKey() + "]",
-              _errorSourcePath, attribute->GetLineNum());
-          err.SetXmlPath(attributeXmlPath);
+              _errorSourcePath, attribute.lineNumber);
+          err.SetXmlPath(attributeXmlPath());
           _errors.push_back(err);
           return false;
         }
@@ -1341,18 +1807,16 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
     if (i == _sdf->GetAttributeCount())
     {
       std::stringstream ss;
-      ss << "XML Attribute[" << attribute->Name()
-              << "] in element[" << _xml->Value()
+      ss << "XML Attribute[" << name
+              << "] in element[" << _xmlName
               << "] not defined in SDF.\n";
       Error err(
           ErrorCode::ATTRIBUTE_INCORRECT_TYPE,
-          ss.str(), _errorSourcePath, _xml->GetLineNum());
-      err.SetXmlPath(attributeXmlPath);
+          ss.str(), _errorSourcePath, _xmlLineNumber);
+      err.SetXmlPath(attributeXmlPath());
       enforceConfigurablePolicyCondition(
           _config.WarningsPolicy(), err, _errors);
     }
-
-    attribute = attribute->Next();
   }
 
   // Check that all required attributes have been set
@@ -1363,9 +1827,9 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
     {
       Error err(
           ErrorCode::ATTRIBUTE_MISSING,
-          "Required attribute[" + p->GetKey() + "] in element[" + _xml->Value()
+          "Required attribute[" + p->GetKey() + "] in element[" + _xmlName
           + "] is not specified in SDF.",
-          _errorSourcePath, _xml->GetLineNum());
+          _errorSourcePath, _xmlLineNumber);
       err.SetXmlPath(_sdf->XmlPath());
       _errors.push_back(err);
       return false;
@@ -1375,6 +1839,33 @@ static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
   return true;
 }
 
+//////////////////////////////////////////////////
+/// Helper function that reads all the attributes of an element from TinyXML to
+/// sdf::Element.
+/// \param[in] _xml Pointer to XML element to read the attributes from.
+/// \param[in,out] _sdf sdf::Element pointer to parse the attribute data into.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _errorSourcePath Source of the XML document.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return True on success, false on error.
+static bool readAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+    const ParserConfig &_config, const std::string &_errorSourcePath,
+    Errors &_errors)
+{
+  // Attributes are not nodes, so they get the line offset of the element.
+  const int offset = lineNumber(_xml) - _xml->GetLineNum();
+  std::vector<XmlAttributeValue> attributes;
+  for (const tinyxml2::XMLAttribute *attribute = _xml->FirstAttribute();
+       attribute; attribute = attribute->Next())
+  {
+    attributes.push_back(
+        {attribute->Name(), attribute->Value(),
+         attribute->GetLineNum() + offset});
+  }
+  return readAttributes(_xml->Value(), lineNumber(_xml), attributes, _sdf,
+                        _config, _errorSourcePath, _errors);
+}
+
 //////////////////////////////////////////////////
 /// Helper function to resolve file name from an //include/uri element.
 /// \param[in] _includeXml Pointer to TinyXML object that corresponds to the
@@ -1402,17 +1893,17 @@ static bool resolveFileNameFromUri(tinyxml2::XMLElement *_includeXml,
     if (modelPath.empty())
     {
       Error err(ErrorCode::URI_LOOKUP, "Unable to find uri[" + uri + "]",
-          _errorSourcePath, uriElement->GetLineNum());
+          _errorSourcePath, lineNumber(uriElement));
       err.SetXmlPath(uriXmlPath);
       _errors.push_back(err);
       return false;
     }
     else
     {
-      if (sdf::filesystem::is_directory(modelPath))
+      if (isDirectory(modelPath, _config))
       {
         // Get the model.config filename
-        _fileName = getModelFilePath(modelPath);
+        _fileName = getModelFilePath(modelPath, _config);
 
         if (_fileName.empty())
         {
@@ -1421,7 +1912,7 @@ static bool resolveFileNameFromUri(tinyxml2::XMLElement *_includeXml,
               "Unable to resolve uri[" + uri + "] to model path [" +
               modelPath + "] since it does not contain a model.config " +
               "file.",
-              _errorSourcePath, uriElement->GetLineNum());
+              _errorSourcePath, lineNumber(uriElement));
           err.SetXmlPath(uriXmlPath);
           _errors.push_back(err);
           return false;
@@ -1440,7 +1931,7 @@ static bool resolveFileNameFromUri(tinyxml2::XMLElement *_includeXml,
   {
     Error err(ErrorCode::ATTRIBUTE_MISSING,
         "<include> element missing 'uri' attribute", _errorSourcePath,
-        _includeXml->GetLineNum());
+        lineNumber(_includeXml));
     err.SetXmlPath(_includeXmlPath);
     _errors.push_back(err);
     return false;
@@ -1448,6 +1939,252 @@ static bool resolveFileNameFromUri(tinyxml2::XMLElement *_includeXml,
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief An included file that readIncludesAhead resolved and read before
+/// readXml reaches its <include> element.
+struct IncludeReadAhead
+{
+  /// \brief Whether resolveFileNameFromUri succeeded.
+  bool resolved = false;
+
+  /// \brief Resolved file name.
+  std::string filename;
+
+  /// \brief Errors from resolveFileNameFromUri.
+  Errors resolveErrors;
+
+  /// \brief The file that was read, or nullptr if it was not read ahead.
+  SDFPtr sdf;
+
+  /// \brief Return value of readFile.
+  bool readResult = false;
+
+  /// \brief Errors from readFile.
+  Errors readErrors;
+
+  /// \brief Exception thrown while reading the file, if any.
+  std::exception_ptr exception;
+
+  /// \brief Files read along with this one, see readIncludedFile.
+  StampedFiles includedFiles;
+};
+
+//////////////////////////////////////////////////
+/// \brief Read the file referenced by an <include> element, from the
+/// ParserConfig::IncludeCache() if it has an unchanged copy of the file.
+/// Files that are read from disk are added to the cache.
+/// \param[in] _filename Resolved name of the included file.
+/// \param[in] _config Custom parser configuration
+/// \param[out] _sdf Set to the SDF object the file is read into.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return The result of readFile.
+static bool readIncludedFile(const std::string &_filename,
+    const ParserConfig &_config, SDFPtr &_sdf, Errors &_errors)
+{
+  // The root description is built once per process and cached, so init
+  // only copies it. This keeps readXml free of shared mutable state, which
+  // allows several documents to be read concurrently.
+  _sdf.reset(new SDF);
+  const IncludeCachePtr &cache = _config.IncludeCache();
+  if (!cache)
+  {
+    if (tIncludedFiles)
+      tIncludedFiles->emplace_back(_filename, fileStamp(_filename));
+    init(_sdf, _config);
+    return readFile(_filename, _config, _sdf, _errors);
+  }
+
+  // The file is stamped before it is read, so that a change made while it
+  // is read invalidates the cache entry.
+  StampedFiles files{{_filename, fileStamp(_filename)}};
+  if (!cache->Find(_filename, _config, _sdf, _errors, files))
+  {
+    Errors errors;
+    bool result = false;
+    StampedFiles *parentFiles = tIncludedFiles;
+    tIncludedFiles = &files;
+    try
+    {
+      init(_sdf, _config);
+      result = readFile(_filename, _config, _sdf, errors);
+    }
+    catch(...)
+    {
+      tIncludedFiles = parentFiles;
+      throw;
+    }
+    tIncludedFiles = parentFiles;
+
+    if (result)
+      cache->Insert(_filename, _config, _sdf, errors, files);
+    _errors.insert(_errors.end(), errors.begin(), errors.end());
+    if (!result)
+    {
+      if (tIncludedFiles)
+        tIncludedFiles->push_back(files.front());
+      return false;
+    }
+  }
+
+  if (tIncludedFiles)
+  {
+    tIncludedFiles->insert(tIncludedFiles->end(), files.begin(), files.end());
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check whether readInclude can fail after the file of an <include>
+/// was read, which stops readXml before the <include> elements that follow.
+/// This is the case for a <placement_frame> without a <pose>, and for a
+/// <plugin> that lacks a required attribute.
+/// \param[in] _includeXml The <include> element.
+/// \return True if readInclude can fail for the element.
+static bool includeCanFailAfterRead(tinyxml2::XMLElement *_includeXml)
+{
+  if (_includeXml->FirstChildElement("placement_frame") &&
+      !_includeXml->FirstChildElement("pose"))
+  {
+    return true;
+  }
+  for (auto *plugin = _includeXml->FirstChildElement("plugin"); plugin;
+       plugin = plugin->NextSiblingElement("plugin"))
+  {
+    if (!plugin->Attribute("name") || !plugin->Attribute("filename"))
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+/// \brief Resolve and read the files of a run of sibling <include> elements
+/// as tasks of the LoadThreadPool, with ParserConfig::IncludeThreadCount()
+/// threads. Everything that readXml would otherwise add to its errors while
+/// doing this is stored instead, so that readXml can add it when it reaches
+/// each <include> and the errors keep their order. Once the file of an
+/// <include> cannot be read, the includes after it are not read, since
+/// readXml stops there.
+/// \param[in] _includes The <include> children of the element being read by
+/// readXml, in document order.
+/// \param[in] _begin Index of the first <include> of the run.
+/// \param[in] _end Index past the last <include> of the run.
+/// \param[in] _sdf SDF element that is being read.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \return One entry per <include> of the run, in document order, or an
+/// empty vector if the includes should be read serially.
+static std::vector<IncludeReadAhead> readIncludesAhead(
+    const std::vector<tinyxml2::XMLElement *> &_includes, std::size_t _begin,
+    std::size_t _end, ElementPtr _sdf, const ParserConfig &_config,
+    const std::string &_source)
+{
+  const unsigned int threadCount = _config.IncludeThreadCount();
+  if (_end - _begin < 2 || threadCount == 1)
+    return {};
+
+  std::vector<IncludeReadAhead> includes(_end - _begin);
+  const std::string xmlPath = _sdf->BuildXmlPath();
+  std::atomic<std::size_t> firstFailure{includes.size()};
+  forEachLoadTask(threadCount, includes.size(), [&](std::size_t _index)
+  {
+    if (_index > firstFailure)
+      return;
+
+    IncludeReadAhead &include = includes[_index];
+    // The thread may be running the task while it waits for tasks of its
+    // own, whose caller may be recording the files it reads.
+    StampedFiles *parentFiles = tIncludedFiles;
+    tIncludedFiles = &include.includedFiles;
+    bool failed = false;
+    try
+    {
+      include.resolved = resolveFileNameFromUri(_includes[_begin + _index],
+          _config, xmlPath + "/include[" + std::to_string(_begin + _index) +
+          "]", _source, include.filename, include.resolveErrors);
+      if (include.resolved && (sdf::isSdfFile(include.filename) ||
+                               _config.CustomModelParsers().empty()))
+      {
+        include.readResult = readIncludedFile(
+            include.filename, _config, include.sdf, include.readErrors);
+        failed = !include.readResult;
+      }
+    }
+    catch(...)
+    {
+      include.exception = std::current_exception();
+      failed = true;
+    }
+    tIncludedFiles = parentFiles;
+
+    if (failed)
+    {
+      std::size_t failure = firstFailure;
+      while (_index < failure &&
+             !firstFailure.compare_exchange_weak(failure, _index))
+      {
+      }
+    }
+  });
+
+  return includes;
+}
+
+//////////////////////////////////////////////////
+/// \brief The <include> children of an element that readXml or
+/// readXmlStream reads ahead, one run at a time. A run is a sequence of
+/// <include> elements with no other child element in between, so readXml
+/// reaches each of them unless the file of an earlier one in the run
+/// cannot be read.
+struct IncludeRun
+{
+  /// \brief Entries of readIncludesAhead for the current run, or empty if
+  /// it is read serially.
+  std::vector<IncludeReadAhead> entries;
+
+  /// \brief Index of the first <include> of the current run.
+  std::size_t begin = 0;
+
+  /// \brief Index past the last <include> of the current run.
+  std::size_t end = 0;
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the entry of readIncludesAhead for an <include> that readXml
+/// reached, first reading ahead the run that starts with it if it is past
+/// the current run.
+/// \param[in,out] _run The current run.
+/// \param[in] _includes The <include> children of the element being read,
+/// in document order.
+/// \param[in] _index Index of the <include> that readXml reached.
+/// \param[in] _adjacent Function that returns true if no other child
+/// element is between the <include> with the given index and the next one.
+/// \param[in] _sdf SDF element that is being read.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \return The entry, or nullptr if the <include> is read serially.
+static IncludeReadAhead *includeReadAhead(IncludeRun &_run,
+    const std::vector<tinyxml2::XMLElement *> &_includes, std::size_t _index,
+    const std::function<bool(std::size_t)> &_adjacent, ElementPtr _sdf,
+    const ParserConfig &_config, const std::string &_source)
+{
+  if (_index >= _run.end)
+  {
+    _run.begin = _index;
+    _run.end = _index + 1;
+    while (_run.end < _includes.size() && _adjacent(_run.end - 1) &&
+           !includeCanFailAfterRead(_includes[_run.end - 1]))
+    {
+      ++_run.end;
+    }
+    _run.entries = readIncludesAhead(
+        _includes, _run.begin, _run.end, _sdf, _config, _source);
+  }
+
+  if (_run.entries.empty())
+    return nullptr;
+  return &_run.entries[_index - _run.begin];
+}
+
 //////////////////////////////////////////////////
 // Helper function called from readXml to validate the //include tag by calling
 // readXml on it. This is only here for error checking. We won't use the
@@ -1469,19 +2206,551 @@ static void validateIncludeElement(tinyxml2::XMLElement *_xml,
     ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
     if (elemDesc->GetName() == _xml->Value())
     {
-      ElementPtr element = elemDesc->Clone();
-      if (!readXml(_xml, element, _config, _source, _errors))
+      ElementPtr element = elemDesc->Clone();
+      if (!readXml(_xml, element, _config, _source, _errors))
+      {
+        Error err(
+            ErrorCode::ELEMENT_INVALID,
+            std::string("Error reading element <") +
+            _xml->Value() + ">",
+            _source,
+            lineNumber(_xml));
+        _errors.push_back(err);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read an <include> child of an element, and add the entity that it
+/// includes to the element.
+/// \param[in] _includeXml Pointer to the TinyXML element of the <include>.
+/// \param[in,out] _sdf SDF element that _includeXml is a child of.
+/// \param[in] _includeIndex Index of the <include> among the <include>
+/// children of the element.
+/// \param[in] _readAhead The entry of readIncludesAhead for the <include>,
+/// or nullptr if it was not read ahead.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \param[out] _handled Set to false if the included file is left to a
+/// custom parser, in which case the <include> should be read like any other
+/// child element.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return False on an error that stops the element from being read.
+static bool readInclude(tinyxml2::XMLElement *_includeXml, ElementPtr _sdf,
+    int _includeIndex, IncludeReadAhead *_readAhead,
+    const ParserConfig &_config, const std::string &_source, bool &_handled,
+    Errors &_errors)
+{
+  _handled = true;
+  validateIncludeElement(_includeXml, _sdf, _config, _source, _errors);
+
+  tinyxml2::XMLElement *uriElement = _includeXml->FirstChildElement("uri");
+
+  const std::string includeXmlPath = _sdf->BuildXmlPath() + "/include[" +
+      std::to_string(_includeIndex) + "]";
+  const std::string uriXmlPath = includeXmlPath + "/uri";
+
+  std::string filename;
+  if (_readAhead)
+  {
+    if (_readAhead->exception)
+      std::rethrow_exception(_readAhead->exception);
+    _errors.insert(_errors.end(), _readAhead->resolveErrors.begin(),
+                   _readAhead->resolveErrors.end());
+    if (!_readAhead->resolved)
+      return true;
+    filename = _readAhead->filename;
+  }
+  else if (!resolveFileNameFromUri(_includeXml, _config, includeXmlPath,
+          _source, filename, _errors))
+  {
+    return true;
+  }
+
+  // If the file is not an SDFormat file, it is assumed that it will
+  // handled by a custom parser, so fall through and add the include
+  // element into _sdf.
+  if (sdf::isSdfFile(filename) || _config.CustomModelParsers().empty())
+  {
+    SDFPtr includeSDF;
+    bool readResult = false;
+    if (_readAhead && _readAhead->sdf)
+    {
+      includeSDF = _readAhead->sdf;
+      readResult = _readAhead->readResult;
+      _errors.insert(_errors.end(), _readAhead->readErrors.begin(),
+                     _readAhead->readErrors.end());
+      if (tIncludedFiles)
+      {
+        tIncludedFiles->insert(tIncludedFiles->end(),
+            _readAhead->includedFiles.begin(),
+            _readAhead->includedFiles.end());
+      }
+    }
+    else
+    {
+      readResult = readIncludedFile(
+          filename, _config, includeSDF, _errors);
+    }
+
+    if (!readResult)
+    {
+      Error err(
+          ErrorCode::FILE_READ,
+          "Unable to read file[" + filename + "]",
+          _source,
+          lineNumber(uriElement));
+      err.SetXmlPath(uriXmlPath);
+      _errors.push_back(err);
+      return false;
+    }
+
+    // Emit an error if there is more than one model, actor or light
+    // element, or two different types of those elements. For
+    // compatibility with old behavior, this chooses the first element in
+    // the preference order: model->actor->light
+    sdf::ElementPtr topLevelElem;
+    for (const auto &elementType : {"model", "actor", "light"})
+    {
+      if (includeSDF->Root()->HasElement(elementType))
+      {
+        if (nullptr == topLevelElem)
+        {
+          topLevelElem = includeSDF->Root()->GetElement(elementType);
+        }
+        else
+        {
+          std::stringstream ss;
+          ss << "Found other top level element <" << elementType
+            << "> in addition to <" << topLevelElem->GetName()
+            << "> in include file.";
+          Error err(
+              ErrorCode::ELEMENT_INCORRECT_TYPE, ss.str(), filename);
+          err.SetXmlPath("/sdf/" + std::string(elementType));
+          _errors.push_back(err);
+        }
+      }
+    }
+
+    if (nullptr == topLevelElem)
+    {
+      Error err(
+          ErrorCode::ELEMENT_MISSING,
+          "Failed to find top level <model> / <actor> / <light> for "
+          "<include>\n",
+          _source,
+          lineNumber(uriElement));
+      err.SetXmlPath(uriXmlPath);
+      _errors.push_back(err);
+      return true;
+    }
+
+    const auto topLevelElementType = topLevelElem->GetName();
+    // Check for more than one of the discovered top-level element type
+    auto nextTopLevelElem =
+        topLevelElem->GetNextElement(topLevelElementType);
+    if (nullptr != nextTopLevelElem)
+    {
+      std::stringstream ss;
+      ss << "Found more than one " << topLevelElem->GetName()
+        << " for <include>.";
+      Error err(
+          ErrorCode::ELEMENT_INCORRECT_TYPE, ss.str(), filename);
+      err.SetXmlPath("/sdf/" + topLevelElementType);
+      _errors.push_back(err);
+    }
+
+    bool isModel = topLevelElementType == "model";
+    bool isActor = topLevelElementType == "actor";
+
+    if (_includeXml->FirstChildElement("name"))
+    {
+      const std::string overrideName =
+          _includeXml->FirstChildElement("name")->GetText();
+      topLevelElem->GetAttribute("name")->SetFromString(overrideName);
+      if (_config.TrackSourceLocations())
+      {
+        topLevelElem->SetXmlPath("/sdf/" + topLevelElementType +
+            "[@name=\"" + overrideName + "\"]");
+      }
+    }
+
+    tinyxml2::XMLElement *poseElemXml =
+        _includeXml->FirstChildElement("pose");
+    if (poseElemXml)
+    {
+      sdf::ElementPtr poseElem = topLevelElem->GetElement("pose");
+
+      auto setAttribute =
+          [&poseElem, &poseElemXml](const std::string &_attribName)
+      {
+        const char *attrib = poseElemXml->Attribute(_attribName.c_str());
+        auto attribParam = poseElem->GetAttribute(_attribName);
+        if (attrib && attribParam)
+        {
+          attribParam->SetFromString(attrib);
+        }
+        else if (attribParam)
+        {
+          attribParam->Reset();
+        }
+      };
+
+      setAttribute("relative_to");
+      setAttribute("degrees");
+      setAttribute("rotation_format");
+
+      if (poseElemXml->GetText())
+      {
+        poseElem->GetValue()->SetFromString(poseElemXml->GetText());
+      }
+      else
+      {
+        poseElem->GetValue()->Reset();
+      }
+    }
+
+    if (isModel && _includeXml->FirstChildElement("static"))
+    {
+      topLevelElem->GetElement("static")->GetValue()->SetFromString(
+          _includeXml->FirstChildElement("static")->GetText());
+    }
+
+    auto *placementFrameElem =
+        _includeXml->FirstChildElement("placement_frame");
+    if (isModel && placementFrameElem)
+    {
+      const std::string placementFrameXmlPath =
+          includeXmlPath + "/placement_frame";
+      if (nullptr == _includeXml->FirstChildElement("pose"))
+      {
+        Error err(
+            ErrorCode::MODEL_PLACEMENT_FRAME_INVALID,
+            "<pose> is required when specifying the placement_frame "
+            "element",
+            _source,
+            lineNumber(_includeXml));
+        err.SetXmlPath(placementFrameXmlPath);
+        _errors.push_back(err);
+        return false;
+      }
+
+      const std::string placementFrameVal = placementFrameElem->GetText();
+
+      if (!isValidFrameReference(placementFrameVal))
+      {
+        Error err(
+            ErrorCode::RESERVED_NAME,
+            "'" + placementFrameVal +
+            "' is reserved; it cannot be used as a value of "
+            "element [placement_frame]",
+            _source,
+            lineNumber(placementFrameElem));
+        err.SetXmlPath(placementFrameXmlPath);
+        _errors.push_back(err);
+      }
+      topLevelElem->GetAttribute("placement_frame")
+          ->SetFromString(placementFrameVal);
+    }
+
+    if (isModel || isActor)
+    {
+      // Using indices for plugins as duplicated plugin names are
+      // allowed.
+      int pluginIndex = -1;
+      for (auto *childElemXml = _includeXml->FirstChildElement();
+           childElemXml;
+           childElemXml = childElemXml->NextSiblingElement())
+      {
+        if (std::string("plugin") == childElemXml->Value())
+        {
+          const std::string pluginXmlPath = includeXmlPath + "/plugin[" +
+              std::to_string(++pluginIndex) + "]";
+
+          sdf::ElementPtr pluginElem;
+          pluginElem = topLevelElem->AddElement("plugin");
+          if (_config.TrackSourceLocations())
+          {
+            pluginElem->SetLineNumber(lineNumber(childElemXml));
+            pluginElem->SetXmlPath(pluginXmlPath);
+          }
+
+          if (!readXml(
+              childElemXml, pluginElem, _config, _source, _errors))
+          {
+            Error err(
+                ErrorCode::ELEMENT_INVALID,
+                "Error reading plugin element",
+                _source,
+                lineNumber(childElemXml));
+            err.SetXmlPath(pluginXmlPath);
+            _errors.push_back(err);
+            return false;
+          }
+        }
+      }
+    }
+
+    // TODO(jenn) prototyping parameter passing
+    // ref: sdformat.org > Documentation > Proposal for parameter passing
+    if (_includeXml->FirstChildElement("experimental:params"))
+    {
+      ParamPassing::updateParams(
+          _config,
+          _source,
+          _includeXml->FirstChildElement("experimental:params"),
+          includeSDF->Root(),
+          _errors);
+    }
+
+    auto includeSDFFirstElem = includeSDF->Root()->GetFirstElement();
+    auto includeDesc = _sdf->GetElementDescription("include");
+    if (includeDesc)
+    {
+      // Store the contents of the <include> tag as the includeElement of
+      // the entity that was loaded from the included URI.
+      auto includeInfo = includeDesc->Clone();
+      copyChildren(includeInfo, _includeXml, false);
+      includeSDFFirstElem->SetIncludeElement(includeInfo);
+    }
+    bool toMerge = _includeXml->BoolAttribute("merge", false);
+    SourceLocation sourceLoc{includeXmlPath, _source,
+                             lineNumber(_includeXml)};
+
+    insertIncludedElement(includeSDF, sourceLoc, toMerge, _sdf, _config,
+                          _errors);
+    return true;
+  }
+
+  _handled = false;
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Report an element that is deprecated.
+/// \param[in] _sdf The element.
+/// \param[in] _config Custom parser configuration
+/// \param[out] _errors Captures errors found during parsing.
+static void checkDeprecatedElement(ElementPtr _sdf,
+    const ParserConfig &_config, Errors &_errors)
+{
+  if (_sdf->GetRequired() == "-1")
+  {
+    std::stringstream ss;
+    ss << "SDF Element[" + _sdf->GetName() + "] is deprecated\n";
+    Error err(ErrorCode::ELEMENT_DEPRECATED, ss.str());
+    err.SetXmlPath(_sdf->XmlPath());
+    enforceConfigurablePolicyCondition(
+        _config.DeprecatedElementsPolicy(), err, _errors);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Replace the description of an element that refers to the spec of
+/// another element, like the nested <model> of a <model>, with that spec.
+/// \param[in,out] _sdf The element.
+/// \param[in] _config Custom parser configuration
+static void loadReferenceSDF(ElementPtr _sdf, const ParserConfig &_config)
+{
+  std::string refSDFStr = _sdf->ReferenceSDF();
+  if (!refSDFStr.empty())
+  {
+    const std::string filePath = _sdf->FilePath();
+    const std::string xmlPath = _sdf->BuildXmlPath();
+    auto sdfLineNumber = _sdf->LineNumber();
+
+    ElementPtr refSDF;
+    refSDF.reset(new Element);
+    std::string refFilename = refSDFStr + ".sdf";
+    initFile(refFilename, _config, refSDF);
+    _sdf->RemoveFromParent();
+    _sdf->Copy(refSDF);
+
+    _sdf->SetFilePath(filePath);
+    _sdf->SetXmlPath(xmlPath);
+    if (sdfLineNumber.has_value())
+      _sdf->SetLineNumber(sdfLineNumber.value());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the XML path of a child element relative to its parent.
+/// \param[in] _name Name of the child XML element.
+/// \param[in] _nameAttribute Value of the name attribute of the child, or
+/// nullptr if it has none.
+/// \return The relative XML path.
+static std::string relativeXmlPath(const std::string &_name,
+                                   const char *_nameAttribute)
+{
+  if (!_nameAttribute)
+    return _name;
+  return _name + "[@name=\"" + _nameAttribute + "\"]";
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the XML path of a child element.
+/// \param[in] _sdf The parent element.
+/// \param[in] _name Name of the child XML element.
+/// \param[in] _nameAttribute Value of the name attribute of the child, or
+/// nullptr if it has none.
+/// \return The XML path.
+static std::string childXmlPath(ElementPtr _sdf, const std::string &_name,
+                                const char *_nameAttribute)
+{
+  return _sdf->BuildXmlPath() + "/" + relativeXmlPath(_name, _nameAttribute);
+}
+
+//////////////////////////////////////////////////
+/// \brief Report a child element that is not defined in the spec of its
+/// parent, and will be copied as is.
+/// \param[in] _name Name of the child XML element.
+/// \param[in] _parentName Name of the parent XML element.
+/// \param[in] _xmlPath XML path of the child.
+/// \param[in] _lineNumber Line of the child.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \param[out] _errors Captures errors found during parsing.
+static void reportUnknownElement(const std::string &_name,
+    const std::string &_parentName, const std::string &_xmlPath,
+    int _lineNumber, const ParserConfig &_config, const std::string &_source,
+    Errors &_errors)
+{
+  std::stringstream ss;
+  ss << "XML Element[" << _name
+     << "], child of element[" << _parentName
+     << "], not defined in SDF. Copying[" << _name << "] "
+     << "as children of [" << _parentName << "].\n";
+
+  Error err(
+      ErrorCode::ELEMENT_INCORRECT_TYPE,
+      ss.str(),
+      _source,
+      _lineNumber);
+  err.SetXmlPath(_xmlPath);
+  enforceConfigurablePolicyCondition(
+      _config.UnrecognizedElementsPolicy(), err, _errors);
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a child element that is not an <include> and add it to its
+/// parent. Children that are not defined in the spec of the parent are only
+/// reported; copyChildren copies them.
+/// \param[in] _xml Pointer to the TinyXML element of the child.
+/// \param[in] _parentName Name of the parent XML element.
+/// \param[in,out] _sdf SDF element of the parent.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \param[out] _errors Captures errors found during parsing.
+/// \return False on an error that stops the parent from being read.
+static bool readChildXml(tinyxml2::XMLElement *_xml,
+    const std::string &_parentName, ElementPtr _sdf,
+    const ParserConfig &_config, const std::string &_source, Errors &_errors)
+{
+  // Find the matching element in SDF
+  ElementPtr elemDesc = _sdf->GetElementDescription(_xml->Value());
+  if (elemDesc)
+  {
+    ElementPtr element = elemDesc->Clone();
+    element->SetParent(_sdf);
+    if (_config.TrackSourceLocations())
+    {
+      element->SetLineNumber(lineNumber(_xml));
+      element->SetRelativeXmlPath(
+          relativeXmlPath(_xml->Value(), _xml->Attribute("name")));
+    }
+    if (readXml(_xml, element, _config, _source, _errors))
+    {
+      _sdf->InsertElement(element);
+    }
+    else
+    {
+      Error err(
+          ErrorCode::ELEMENT_INVALID,
+          std::string("Error reading element <") +
+          _xml->Value() + ">",
+          _source,
+          lineNumber(_xml));
+      err.SetXmlPath(
+          childXmlPath(_sdf, _xml->Value(), _xml->Attribute("name")));
+      _errors.push_back(err);
+      return false;
+    }
+  }
+  else if (std::strchr(_xml->Value(), ':') == nullptr)
+  {
+    reportUnknownElement(_xml->Value(), _parentName,
+        childXmlPath(_sdf, _xml->Value(), _xml->Attribute("name")),
+        lineNumber(_xml), _config, _source, _errors);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the required children that an element is missing, with their
+/// default values.
+/// \param[in,out] _sdf The element, after all its children were read.
+/// \param[in] _xmlLineNumber Line of the XML element.
+/// \param[in] _source Source of the XML document
+/// \param[out] _errors Captures errors found during parsing.
+/// \return False if a required child cannot be defaulted.
+static bool addRequiredElements(ElementPtr _sdf, int _xmlLineNumber,
+    const std::string &_source, Errors &_errors)
+{
+  // Mark the descriptions that have a matching child element, so that
+  // checking the required elements does not search the children.
+  const std::size_t descCount = _sdf->GetElementDescriptionCount();
+  std::vector<bool> hasElement(descCount, false);
+  for (ElementPtr child = _sdf->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    auto descIndex = _sdf->GetElementDescriptionIndex(child->GetName());
+    if (descIndex.has_value())
+    {
+      hasElement[*descIndex] = true;
+    }
+  }
+
+  // Check that all required elements have been set
+  for (std::size_t descCounter = 0; descCounter != descCount; ++descCounter)
+  {
+    ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+
+    if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
+    {
+      // Descriptions are indexed by the first one with a given name
+      auto descIndex = _sdf->GetElementDescriptionIndex(elemDesc->GetName());
+      if (!descIndex.has_value() || !hasElement[*descIndex])
       {
-        Error err(
-            ErrorCode::ELEMENT_INVALID,
-            std::string("Error reading element <") +
-            _xml->Value() + ">",
-            _source,
-            _xml->GetLineNum());
-        _errors.push_back(err);
+        const std::string elemXmlPath = _sdf->XmlPath() + "/" +
+            elemDesc->GetName();
+        if (_sdf->GetName() == "joint" &&
+            _sdf->Get<std::string>("type") != "ball")
+        {
+          Error missingElementError(
+              ErrorCode::ELEMENT_MISSING,
+              "XML Missing required element[" + elemDesc->GetName() +
+              "], child of element[" + _sdf->GetName() + "]",
+              _source,
+              _xmlLineNumber);
+          missingElementError.SetXmlPath(elemXmlPath);
+          _errors.push_back(missingElementError);
+          return false;
+        }
+        else
+        {
+          // Add default element
+          ElementPtr defaultElement = _sdf->AddElement(elemDesc->GetName());
+          defaultElement->SetExplicitlySetInFile(false);
+          if (descIndex.has_value())
+          {
+            hasElement[*descIndex] = true;
+          }
+        }
       }
     }
   }
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -1489,15 +2758,7 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
     const ParserConfig &_config, const std::string &_source, Errors &_errors)
 {
   // Check if the element pointer is deprecated.
-  if (_sdf->GetRequired() == "-1")
-  {
-    std::stringstream ss;
-    ss << "SDF Element[" + _sdf->GetName() + "] is deprecated\n";
-    Error err(ErrorCode::ELEMENT_DEPRECATED, ss.str());
-    err.SetXmlPath(_sdf->XmlPath());
-    enforceConfigurablePolicyCondition(
-        _config.DeprecatedElementsPolicy(), err, _errors);
-  }
+  checkDeprecatedElement(_sdf, _config, _errors);
 
   if (!_xml)
   {
@@ -1518,25 +2779,7 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
   }
 
   // check for nested sdf
-  std::string refSDFStr = _sdf->ReferenceSDF();
-  if (!refSDFStr.empty())
-  {
-    const std::string filePath = _sdf->FilePath();
-    const std::string xmlPath = _sdf->XmlPath();
-    auto lineNumber = _sdf->LineNumber();
-
-    ElementPtr refSDF;
-    refSDF.reset(new Element);
-    std::string refFilename = refSDFStr + ".sdf";
-    initFile(refFilename, _config, refSDF);
-    _sdf->RemoveFromParent();
-    _sdf->Copy(refSDF);
-
-    _sdf->SetFilePath(filePath);
-    _sdf->SetXmlPath(xmlPath);
-    if (lineNumber.has_value())
-      _sdf->SetLineNumber(lineNumber.value());
-  }
+  loadReferenceSDF(_sdf, _config);
 
   if (!readAttributes(_xml, _sdf, _config, _source, _errors))
     return false;
@@ -1560,11 +2803,21 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
   }
   else
   {
-    std::string filename;
-
     // Keep count of the include indices
     int includeElemIndex = -1;
 
+    std::vector<tinyxml2::XMLElement *> includes;
+    for (auto *elemXml = _xml->FirstChildElement("include"); elemXml;
+         elemXml = elemXml->NextSiblingElement("include"))
+    {
+      includes.push_back(elemXml);
+    }
+    auto adjacent = [&includes](std::size_t _index)
+    {
+      return includes[_index]->NextSiblingElement() == includes[_index + 1];
+    };
+    IncludeRun includeRun;
+
     // Iterate over all the child elements
     tinyxml2::XMLElement *elemXml = nullptr;
     for (elemXml = _xml->FirstChildElement(); elemXml;
@@ -1572,372 +2825,465 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
     {
       if (std::string("include") == elemXml->Value())
       {
-        validateIncludeElement(elemXml, _sdf, _config, _source, _errors);
+        ++includeElemIndex;
+        IncludeReadAhead *readAhead = includeReadAhead(includeRun, includes,
+            static_cast<std::size_t>(includeElemIndex), adjacent, _sdf,
+            _config, _source);
+
+        bool handled = true;
+        if (!readInclude(elemXml, _sdf, includeElemIndex, readAhead, _config,
+                         _source, handled, _errors))
+        {
+          return false;
+        }
+        if (handled)
+          continue;
+      }
 
-        tinyxml2::XMLElement *uriElement = elemXml->FirstChildElement("uri");
+      if (!readChildXml(elemXml, _xml->Value(), _sdf, _config, _source,
+                        _errors))
+      {
+        return false;
+      }
+    }
 
-        const std::string includeXmlPath = _sdf->XmlPath() + "/include[" +
-            std::to_string(++includeElemIndex) + "]";
-        const std::string uriXmlPath = includeXmlPath + "/uri";
+    // Copy unknown elements outside the loop so it only happens one time
+    copyChildren(_sdf, _xml, true);
 
-        if (!resolveFileNameFromUri(elemXml, _config, includeXmlPath,
-                _source, filename, _errors))
-          continue;
+    if (!addRequiredElements(_sdf, lineNumber(_xml), _source, _errors))
+      return false;
+  }
 
-        // If the file is not an SDFormat file, it is assumed that it will
-        // handled by a custom parser, so fall through and add the include
-        // element into _sdf.
-        if (sdf::isSdfFile(filename) || _config.CustomModelParsers().empty())
-        {
-          // NOTE: sdf::init is an expensive call. For performance reason,
-          // a new sdf pointer is created here by cloning a fresh sdf template
-          // pointer instead of calling init every iteration.
-          // SDFPtr includeSDF(new SDF);
-          // init(includeSDF, _config);
-          static SDFPtr includeSDFTemplate;
-          if (!includeSDFTemplate)
-          {
-            includeSDFTemplate.reset(new SDF);
-            init(includeSDFTemplate, _config);
-          }
-          SDFPtr includeSDF(new SDF);
-          includeSDF->Root(includeSDFTemplate->Root()->Clone());
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Find what readSdfStream needs to know about a document before it
+/// builds the elements of the document, and check that XmlStreamReader can
+/// read all of it.
+/// \param[in] _data The document.
+/// \param[out] _index What was found in the document.
+/// \return True if the document is a single <sdf> element with a version,
+/// that XmlStreamReader can read.
+static bool scanXmlStream(std::string_view _data, XmlStreamIndex &_index)
+{
+  XmlStreamReader reader(_data);
 
-          if (!readFile(filename, _config, includeSDF, _errors))
+  // Start tag offsets of the open elements.
+  std::vector<std::size_t> openElements;
+  bool firstToken = true;
+  bool inFirstModel = false;
+  bool seenModel = false;
+  bool seenPose = false;
+
+  while (true)
+  {
+    const XmlStreamReader::Token token = reader.Next();
+    switch (token)
+    {
+      case XmlStreamReader::Token::START_ELEMENT:
+      {
+        const std::size_t depth = reader.Depth();
+        if (depth == 1)
+        {
+          const XmlStreamReader::Attribute *version =
+              reader.FindAttribute("version");
+          if (!openElements.empty() || _index.rootLineNumber != 0 ||
+              reader.Name() != "sdf" || !version)
           {
-            Error err(
-                ErrorCode::FILE_READ,
-                "Unable to read file[" + filename + "]",
-                _source,
-                uriElement->GetLineNum());
-            err.SetXmlPath(uriXmlPath);
-            _errors.push_back(err);
             return false;
           }
+          _index.version = XmlStreamReader::DecodeAttribute(version->rawValue);
+          _index.rootLineNumber = reader.LineNumber();
+        }
+        else if (reader.Name() == "include")
+        {
+          _index.includes[openElements.back()].push_back(
+              {reader.Begin(), 0u, reader.LineNumber()});
+        }
 
-          // Emit an error if there is more than one model, actor or light
-          // element, or two different types of those elements. For
-          // compatibility with old behavior, this chooses the first element in
-          // the preference order: model->actor->light
-          sdf::ElementPtr topLevelElem;
-          for (const auto &elementType : {"model", "actor", "light"})
+        // The first <pose> of the first <model> is checked by
+        // checkXmlFromRoot.
+        if (depth == 2 && !seenModel && reader.Name() == "model")
+        {
+          seenModel = true;
+          inFirstModel = true;
+        }
+        else if (depth == 3 && inFirstModel && !seenPose &&
+                 reader.Name() == "pose")
+        {
+          seenPose = true;
+          if (auto *relativeTo = reader.FindAttribute("relative_to"))
           {
-            if (includeSDF->Root()->HasElement(elementType))
-            {
-              if (nullptr == topLevelElem)
-              {
-                topLevelElem = includeSDF->Root()->GetElement(elementType);
-              }
-              else
-              {
-                std::stringstream ss;
-                ss << "Found other top level element <" << elementType
-                  << "> in addition to <" << topLevelElem->GetName()
-                  << "> in include file.";
-                Error err(
-                    ErrorCode::ELEMENT_INCORRECT_TYPE, ss.str(), filename);
-                err.SetXmlPath("/sdf/" + std::string(elementType));
-                _errors.push_back(err);
-              }
-            }
+            _index.topLevelPoseRelativeTo =
+                XmlStreamReader::DecodeAttribute(relativeTo->rawValue);
+            _index.topLevelPoseLineNumber = reader.LineNumber();
           }
+        }
 
-          if (nullptr == topLevelElem)
-          {
-            Error err(
-                ErrorCode::ELEMENT_MISSING,
-                "Failed to find top level <model> / <actor> / <light> for "
-                "<include>\n",
-                _source,
-                uriElement->GetLineNum());
-            err.SetXmlPath(uriXmlPath);
-            _errors.push_back(err);
-            continue;
-          }
+        openElements.push_back(reader.Begin());
+        break;
+      }
+      case XmlStreamReader::Token::END_ELEMENT:
+      {
+        openElements.pop_back();
+        if (reader.Name() == "include" && !openElements.empty())
+          _index.includes[openElements.back()].back().end = reader.End();
+        if (reader.Depth() == 2)
+          inFirstModel = false;
+        break;
+      }
+      case XmlStreamReader::Token::DECLARATION:
+      {
+        // tinyxml2 only accepts a declaration at the start of a document.
+        if (!firstToken)
+          return false;
+        break;
+      }
+      case XmlStreamReader::Token::END_DOCUMENT:
+        return _index.rootLineNumber != 0;
+      case XmlStreamReader::Token::ERROR:
+        return false;
+      default:
+        break;
+    }
+    firstToken = false;
+  }
+}
 
-          const auto topLevelElementType = topLevelElem->GetName();
-          // Check for more than one of the discovered top-level element type
-          auto nextTopLevelElem =
-              topLevelElem->GetNextElement(topLevelElementType);
-          if (nullptr != nextTopLevelElem)
-          {
-            std::stringstream ss;
-            ss << "Found more than one " << topLevelElem->GetName()
-              << " for <include>.";
-            Error err(
-                ErrorCode::ELEMENT_INCORRECT_TYPE, ss.str(), filename);
-            err.SetXmlPath("/sdf/" + topLevelElementType);
-            _errors.push_back(err);
-          }
+//////////////////////////////////////////////////
+/// \brief Copy an element that is not defined in the spec of its parent,
+/// like copyChildren does.
+/// \param[in,out] _reader Reader whose current token is the start tag of the
+/// element. It is moved past the end tag.
+/// \param[in] _parent Element to set as the parent of the copy.
+/// \return The copy.
+static ElementPtr copyElementStream(XmlStreamReader &_reader,
+                                    ElementPtr _parent)
+{
+  sdf::ElementPtr element(new sdf::Element);
+  element->SetParent(_parent);
+  element->SetName(std::string(_reader.Name()));
+  for (const auto &attribute : _reader.Attributes())
+  {
+    const std::string name(attribute.name);
+    element->AddAttribute(name, "string", "", 1, "");
+    element->GetAttribute(name)->SetFromString(
+        XmlStreamReader::DecodeAttribute(attribute.rawValue));
+  }
 
-          bool isModel = topLevelElementType == "model";
-          bool isActor = topLevelElementType == "actor";
+  XmlStreamReader::Token token = _reader.Next();
+  if (token == XmlStreamReader::Token::TEXT)
+  {
+    element->AddValue("string",
+        XmlStreamReader::DecodeText(_reader.RawText()), true);
+  }
 
-          if (elemXml->FirstChildElement("name"))
-          {
-            const std::string overrideName =
-                elemXml->FirstChildElement("name")->GetText();
-            topLevelElem->GetAttribute("name")->SetFromString(overrideName);
-            topLevelElem->SetXmlPath("/sdf/" + topLevelElementType +
-                "[@name=\"" + overrideName + "\"]");
-          }
+  for (; token != XmlStreamReader::Token::END_ELEMENT &&
+         token != XmlStreamReader::Token::ERROR; token = _reader.Next())
+  {
+    if (token == XmlStreamReader::Token::START_ELEMENT)
+      element->InsertElement(copyElementStream(_reader, element));
+  }
+  return element;
+}
 
-          tinyxml2::XMLElement *poseElemXml =
-              elemXml->FirstChildElement("pose");
-          if (poseElemXml)
-          {
-            sdf::ElementPtr poseElem = topLevelElem->GetElement("pose");
-
-            auto setAttribute =
-                [&poseElem, &poseElemXml](const std::string &_attribName)
-            {
-              const char *attrib = poseElemXml->Attribute(_attribName.c_str());
-              auto attribParam = poseElem->GetAttribute(_attribName);
-              if (attrib && attribParam)
-              {
-                attribParam->SetFromString(attrib);
-              }
-              else if (attribParam)
-              {
-                attribParam->Reset();
-              }
-            };
-
-            setAttribute("relative_to");
-            setAttribute("degrees");
-            setAttribute("rotation_format");
-
-            if (poseElemXml->GetText())
-            {
-              poseElem->GetValue()->SetFromString(poseElemXml->GetText());
-            }
-            else
-            {
-              poseElem->GetValue()->Reset();
-            }
-          }
+//////////////////////////////////////////////////
+/// \brief Same as readXml, but reading the element with an XmlStreamReader.
+/// The elements that readXml reads through the DOM, <include> and the
+/// elements that copy their children, are parsed with tinyxml2 on their own
+/// and passed to readXml.
+/// \param[in,out] _reader Reader whose current token is the start tag of the
+/// element. On success, it is moved past the end tag.
+/// \param[in] _index What scanXmlStream found in the document.
+/// \param[in,out] _sdf SDF element to read the element into.
+/// \param[in] _config Custom parser configuration
+/// \param[in] _source Source of the XML document
+/// \param[out] _errors Captures errors found during parsing.
+/// \return True on success, false on error.
+static bool readXmlStream(XmlStreamReader &_reader,
+    const XmlStreamIndex &_index, ElementPtr _sdf,
+    const ParserConfig &_config, const std::string &_source, Errors &_errors)
+{
+  const std::size_t begin = _reader.Begin();
+  const int xmlLineNumber = _reader.LineNumber();
 
-          if (isModel && elemXml->FirstChildElement("static"))
-          {
-            topLevelElem->GetElement("static")->GetValue()->SetFromString(
-                elemXml->FirstChildElement("static")->GetText());
-          }
+  if (_sdf->GetCopyChildren())
+  {
+    if (!_reader.SkipElement())
+      return false;
+    XmlFragmentDocument fragment(
+        _reader.Data(), begin, _reader.End(), xmlLineNumber);
+    if (!fragment.Element())
+    {
+      _errors.push_back({ErrorCode::ELEMENT_INVALID,
+          std::string("Error parsing XML: ") + fragment.ErrorStr(),
+          _source, xmlLineNumber});
+      return false;
+    }
+    return readXml(fragment.Element(), _sdf, _config, _source, _errors);
+  }
 
-          auto *placementFrameElem =
-              elemXml->FirstChildElement("placement_frame");
-          if (isModel && placementFrameElem)
-          {
-            const std::string placementFrameXmlPath =
-                includeXmlPath + "/placement_frame";
-            if (nullptr == elemXml->FirstChildElement("pose"))
-            {
-              Error err(
-                  ErrorCode::MODEL_PLACEMENT_FRAME_INVALID,
-                  "<pose> is required when specifying the placement_frame "
-                  "element",
-                  _source,
-                  elemXml->GetLineNum());
-              err.SetXmlPath(placementFrameXmlPath);
-              _errors.push_back(err);
-              return false;
-            }
-
-            const std::string placementFrameVal = placementFrameElem->GetText();
-
-            if (!isValidFrameReference(placementFrameVal))
-            {
-              Error err(
-                  ErrorCode::RESERVED_NAME,
-                  "'" + placementFrameVal +
-                  "' is reserved; it cannot be used as a value of "
-                  "element [placement_frame]",
-                  _source,
-                  placementFrameElem->GetLineNum());
-              err.SetXmlPath(placementFrameXmlPath);
-              _errors.push_back(err);
-            }
-            topLevelElem->GetAttribute("placement_frame")
-                ->SetFromString(placementFrameVal);
-          }
+  // Check if the element pointer is deprecated.
+  checkDeprecatedElement(_sdf, _config, _errors);
 
-          if (isModel || isActor)
-          {
-            // Using indices for plugins as duplicated plugin names are
-            // allowed.
-            int pluginIndex = -1;
-            for (auto *childElemXml = elemXml->FirstChildElement();
-                 childElemXml;
-                 childElemXml = childElemXml->NextSiblingElement())
-            {
-              if (std::string("plugin") == childElemXml->Value())
-              {
-                const std::string pluginXmlPath = includeXmlPath + "/plugin[" +
-                    std::to_string(++pluginIndex) + "]";
-
-                sdf::ElementPtr pluginElem;
-                pluginElem = topLevelElem->AddElement("plugin");
-                pluginElem->SetLineNumber(childElemXml->GetLineNum());
-                pluginElem->SetXmlPath(pluginXmlPath);
-
-                if (!readXml(
-                    childElemXml, pluginElem, _config, _source, _errors))
-                {
-                  Error err(
-                      ErrorCode::ELEMENT_INVALID,
-                      "Error reading plugin element",
-                      _source,
-                      childElemXml->GetLineNum());
-                  err.SetXmlPath(pluginXmlPath);
-                  _errors.push_back(err);
-                  return false;
-                }
-              }
-            }
-          }
+  // check for nested sdf
+  loadReferenceSDF(_sdf, _config);
 
-          // TODO(jenn) prototyping parameter passing
-          // ref: sdformat.org > Documentation > Proposal for parameter passing
-          if (elemXml->FirstChildElement("experimental:params"))
-          {
-            ParamPassing::updateParams(
-                _config,
-                _source,
-                elemXml->FirstChildElement("experimental:params"),
-                includeSDF->Root(),
-                _errors);
-          }
+  const std::string xmlName(_reader.Name());
+  {
+    std::vector<std::string> values;
+    values.reserve(_reader.Attributes().size());
+    std::vector<XmlAttributeValue> attributes;
+    for (const auto &attribute : _reader.Attributes())
+    {
+      values.push_back(XmlStreamReader::DecodeAttribute(attribute.rawValue));
+      attributes.push_back(
+          {attribute.name, values.back(), attribute.lineNumber});
+    }
+    if (!readAttributes(xmlName, xmlLineNumber, attributes, _sdf, _config,
+                        _source, _errors))
+    {
+      return false;
+    }
+  }
+
+  // Like tinyxml2::XMLElement::GetText, only text that comes before any
+  // child or comment is the value of the element.
+  XmlStreamReader::Token token = _reader.Next();
+  if (token == XmlStreamReader::Token::TEXT && _sdf->GetValue())
+  {
+    if (!_sdf->GetValue()->SetFromString(
+            XmlStreamReader::DecodeText(_reader.RawText())))
+    {
+      return false;
+    }
+  }
+  else if (_sdf->GetValue())
+  {
+    if (!_sdf->GetValue()->Reparse())
+      return false;
+    if (!_sdf->GetValue()->SetFromString(""))
+      return false;
+  }
+
+  // The <include> children are parsed with tinyxml2 when the first of them
+  // is reached, so that they can be read ahead.
+  std::vector<std::unique_ptr<XmlFragmentDocument>> includes;
+  std::vector<tinyxml2::XMLElement *> includeElements;
+  IncludeRun includeRun;
+  int includeElemIndex = -1;
+
+  // Children that are not defined in the spec are added after the others,
+  // like copyChildren does.
+  std::vector<ElementPtr> unknownElements;
+
+  for (; token != XmlStreamReader::Token::END_ELEMENT; token = _reader.Next())
+  {
+    if (token == XmlStreamReader::Token::ERROR ||
+        token == XmlStreamReader::Token::END_DOCUMENT)
+    {
+      return false;
+    }
+    if (token != XmlStreamReader::Token::START_ELEMENT)
+      continue;
+
+    const std::string name(_reader.Name());
+    const int elemLineNumber = _reader.LineNumber();
 
-          auto includeSDFFirstElem = includeSDF->Root()->GetFirstElement();
-          auto includeDesc = _sdf->GetElementDescription("include");
-          if (includeDesc)
+    if (name == "include")
+    {
+      const std::vector<XmlElementSpan> &spans = _index.includes.at(begin);
+      if (includes.empty())
+      {
+        for (const auto &span : spans)
+        {
+          includes.push_back(std::make_unique<XmlFragmentDocument>(
+              _reader.Data(), span.begin, span.end, span.lineNumber));
+          if (!includes.back()->Element())
           {
-            // Store the contents of the <include> tag as the includeElement of
-            // the entity that was loaded from the included URI.
-            auto includeInfo = includeDesc->Clone();
-            copyChildren(includeInfo, elemXml, false);
-            includeSDFFirstElem->SetIncludeElement(includeInfo);
+            _errors.push_back({ErrorCode::ELEMENT_INVALID,
+                std::string("Error parsing XML: ") +
+                includes.back()->ErrorStr(), _source, span.lineNumber});
+            return false;
           }
-          bool toMerge = elemXml->BoolAttribute("merge", false);
-          SourceLocation sourceLoc{includeXmlPath, _source,
-                                   elemXml->GetLineNum()};
-
-          insertIncludedElement(includeSDF, sourceLoc, toMerge, _sdf, _config,
-                                _errors);
-          continue;
+          includeElements.push_back(includes.back()->Element());
         }
       }
 
-      // Find the matching element in SDF
-      unsigned int descCounter = 0;
-      for (descCounter = 0;
-           descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
+      if (!_reader.SkipElement())
+        return false;
+
+      ++includeElemIndex;
+      XmlFragmentDocument &fragment =
+          *includes[static_cast<std::size_t>(includeElemIndex)];
+      // Comments and other markup between two <include> elements may hold
+      // something that looks like a start tag, which only ends the run
+      // early.
+      auto adjacent = [&](std::size_t _index)
       {
-        ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
-        if (elemDesc->GetName() == elemXml->Value())
+        const std::string_view between = _reader.Data().substr(
+            spans[_index].end, spans[_index + 1].begin - spans[_index].end);
+        for (std::size_t i = between.find('<'); i != std::string_view::npos;
+             i = between.find('<', i + 1))
         {
-          std::string elemXmlPath = _sdf->XmlPath() + "/" + elemXml->Value();
-          const char *name = elemXml->Attribute("name");
-          if (name)
-            elemXmlPath += "[@name=\"" + std::string(name) + "\"]";
-
-          ElementPtr element = elemDesc->Clone();
-          element->SetParent(_sdf);
-          element->SetLineNumber(elemXml->GetLineNum());
-          element->SetXmlPath(elemXmlPath);
-          if (readXml(elemXml, element, _config, _source, _errors))
-          {
-            _sdf->InsertElement(element);
-          }
-          else
+          if (i + 1 < between.size() && between[i + 1] != '!' &&
+              between[i + 1] != '?')
           {
-            Error err(
-                ErrorCode::ELEMENT_INVALID,
-                std::string("Error reading element <") +
-                elemXml->Value() + ">",
-                _source,
-                elemXml->GetLineNum());
-            err.SetXmlPath(elemXmlPath);
-            _errors.push_back(err);
             return false;
           }
-          break;
         }
+        return true;
+      };
+      IncludeReadAhead *readAhead = includeReadAhead(includeRun,
+          includeElements, static_cast<std::size_t>(includeElemIndex),
+          adjacent, _sdf, _config, _source);
+
+      bool handled = true;
+      if (!readInclude(fragment.Element(), _sdf, includeElemIndex, readAhead,
+                       _config, _source, handled, _errors))
+      {
+        return false;
+      }
+      if (!handled && !readChildXml(fragment.Element(), xmlName, _sdf,
+                                    _config, _source, _errors))
+      {
+        return false;
       }
 
-      if (descCounter == _sdf->GetElementDescriptionCount()
-            && std::strchr(elemXml->Value(), ':') == nullptr)
+      if (!_sdf->HasElementDescription(name))
       {
-        std::string elemXmlPath = _sdf->XmlPath() + "/" + elemXml->Value();
-        const char *name = elemXml->Attribute("name");
-        if (name)
-          elemXmlPath += "[@name=\"" + std::string(name) + "\"]";
+        // The copies take their file path and original version from _sdf,
+        // like the ones copyChildren adds to _sdf directly.
+        ElementPtr copies(new Element);
+        copies->SetParent(_sdf);
+        copyChildren(copies, fragment.Parent(), true);
+        for (ElementPtr copy = copies->GetFirstElement(); copy;
+             copy = copy->GetNextElement())
+        {
+          copy->SetParent(_sdf);
+          unknownElements.push_back(copy);
+        }
+      }
+      continue;
+    }
 
-        std::stringstream ss;
-        ss << "XML Element[" << elemXml->Value()
-           << "], child of element[" << _xml->Value()
-           << "], not defined in SDF. Copying[" << elemXml->Value() << "] "
-           << "as children of [" << _xml->Value() << "].\n";
+    // The XML path of the element is only built when it is recorded or
+    // reported.
+    const XmlStreamReader::Attribute *nameAttribute =
+        _reader.FindAttribute("name");
+    const std::optional<std::string> nameValue = nameAttribute ?
+        std::make_optional(
+            XmlStreamReader::DecodeAttribute(nameAttribute->rawValue)) :
+        std::nullopt;
+    auto elemXmlPath = [&](bool _relative)
+    {
+      const char *nameAttr = nameValue ? nameValue->c_str() : nullptr;
+      return _relative ? relativeXmlPath(name, nameAttr) :
+          childXmlPath(_sdf, name, nameAttr);
+    };
 
+    // Find the matching element in SDF
+    ElementPtr elemDesc = _sdf->GetElementDescription(name);
+    if (elemDesc)
+    {
+      ElementPtr element = elemDesc->Clone();
+      element->SetParent(_sdf);
+      if (_config.TrackSourceLocations())
+      {
+        element->SetLineNumber(elemLineNumber);
+        element->SetRelativeXmlPath(elemXmlPath(true));
+      }
+      if (readXmlStream(_reader, _index, element, _config, _source, _errors))
+      {
+        _sdf->InsertElement(element);
+      }
+      else
+      {
         Error err(
-            ErrorCode::ELEMENT_INCORRECT_TYPE,
-            ss.str(),
+            ErrorCode::ELEMENT_INVALID,
+            "Error reading element <" + name + ">",
             _source,
-            elemXml->GetLineNum());
-        err.SetXmlPath(elemXmlPath);
-        enforceConfigurablePolicyCondition(
-            _config.UnrecognizedElementsPolicy(), err, _errors);
-
-        continue;
+            elemLineNumber);
+        err.SetXmlPath(elemXmlPath(false));
+        _errors.push_back(err);
+        return false;
       }
     }
-
-    // Copy unknown elements outside the loop so it only happens one time
-    copyChildren(_sdf, _xml, true);
-
-    // Check that all required elements have been set
-    for (unsigned int descCounter = 0;
-         descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
+    else
     {
-      ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
-
-      if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
+      if (name.find(':') == std::string::npos)
       {
-        if (!_sdf->HasElement(elemDesc->GetName()))
-        {
-          const std::string elemXmlPath = _sdf->XmlPath() + "/" +
-              elemDesc->GetName();
-          if (_sdf->GetName() == "joint" &&
-              _sdf->Get<std::string>("type") != "ball")
-          {
-            Error missingElementError(
-                ErrorCode::ELEMENT_MISSING,
-                "XML Missing required element[" + elemDesc->GetName() +
-                "], child of element[" + _sdf->GetName() + "]",
-                _source,
-                _xml->GetLineNum());
-            missingElementError.SetXmlPath(elemXmlPath);
-            _errors.push_back(missingElementError);
-            return false;
-          }
-          else
-          {
-            // Add default element
-            ElementPtr defaultElement = _sdf->AddElement(elemDesc->GetName());
-            defaultElement->SetExplicitlySetInFile(false);
-          }
-        }
+        reportUnknownElement(name, xmlName, elemXmlPath(false),
+                             elemLineNumber, _config, _source, _errors);
       }
+      unknownElements.push_back(copyElementStream(_reader, _sdf));
     }
   }
 
-  return true;
+  for (auto &element : unknownElements)
+    _sdf->InsertElement(element);
+
+  return addRequiredElements(_sdf, xmlLineNumber, _source, _errors);
+}
+
+//////////////////////////////////////////////////
+std::optional<bool> readSdfStream(std::string_view _data, SDFPtr _sdf,
+    const std::string &_source, bool _convert, const ParserConfig &_config,
+    Errors &_errors)
+{
+  if (nullptr == _sdf || nullptr == _sdf->Root() ||
+      _sdf->Root()->GetName() != "sdf")
+  {
+    return std::nullopt;
+  }
+
+  XmlStreamIndex index;
+  if (!scanXmlStream(_data, index) ||
+      (_convert && index.version != SDF::Version()))
+  {
+    return std::nullopt;
+  }
+
+  if (_source != std::string(kSdfStringSource))
+  {
+    _sdf->SetFilePath(_source);
+  }
+
+  setRootSource(_sdf, index.version, index.rootLineNumber);
+
+  // Perform all the pre-checks necessary for the XML elements before reading
+  if (index.topLevelPoseRelativeTo.has_value() &&
+      !checkTopLevelPoseRelativeTo(*index.topLevelPoseRelativeTo,
+          index.topLevelPoseLineNumber, _source, _errors))
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Errors were found when checking the XML of element<"
+        + _sdf->Root()->GetName() + ">."});
+    return false;
+  }
+
+  XmlStreamReader reader(_data);
+  while (reader.Next() != XmlStreamReader::Token::START_ELEMENT)
+  {
+  }
+
+  // parse new sdf xml
+  if (!readXmlStream(reader, index, _sdf->Root(), _config, _source, _errors))
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Error reading element <" + _sdf->Root()->GetName() + ">"});
+    return false;
+  }
+
+  return checkNoDoubleColonInNames(_sdf, _errors);
 }
 
 /////////////////////////////////////////////////
 bool convertFile(const std::string &_filename, const std::string &_version,
                  SDFPtr _sdf)
 {
-  return convertFile(_filename, _version, ParserConfig::GlobalConfig(), _sdf);
+  return convertFile(_filename, _version, *globalParserConfig(), _sdf);
 }
 
 /////////////////////////////////////////////////
@@ -1999,7 +3345,7 @@ bool convertString(const std::string &_sdfString, const std::string &_version,
                    SDFPtr _sdf)
 {
   return convertString(
-      _sdfString, _version, ParserConfig::GlobalConfig(), _sdf);
+      _sdfString, _version, *globalParserConfig(), _sdf);
 }
 
 /////////////////////////////////////////////////
@@ -2241,7 +3587,11 @@ bool recursiveSameTypeUniqueNames(sdf::ElementPtr _elem)
     return true;
 
   bool result = true;
-  auto typeNames = _elem->GetElementTypeNames();
+
+  // The names of child elements of the same type are unique if the names of
+  // all the child elements are, which is known without counting them again.
+  const auto typeNames = _elem->HasUniqueChildNames() ?
+      std::set<std::string>() : _elem->GetElementTypeNames();
   for (const std::string &typeName : typeNames)
   {
     if (!_elem->HasUniqueChildNames(typeName))
@@ -49,19 +49,25 @@ typedef std::shared_ptr<SDFExtension> SDFExtensionPtr;
 typedef std::map<std::string, std::vector<SDFExtensionPtr> >
   StringSDFExtensionPtrMap;
 
-/// create SDF geometry block based on URDF
-StringSDFExtensionPtrMap g_extensions;
-bool g_reduceFixedJoints;
-bool g_enforceLimits;
 const char kCollisionExt[] = "_collision";
 const char kVisualExt[] = "_visual";
 const char kLumpPrefix[] = "_fixed_joint_lump__";
-urdf::Pose g_initialRobotPose;
-bool g_initialRobotPoseValid = false;
-std::set<std::string> g_fixedJointsTransformedInRevoluteJoints;
-std::set<std::string> g_fixedJointsTransformedInFixedJoints;
 const int g_outputDecimalPrecision = 16;
 
+// State of the conversion in progress. A conversion runs entirely on the
+// thread that called URDF2SDF::InitModel*, and the state is reset when it
+// starts, so keeping it per thread lets URDF files be converted on several
+// threads at once.
+
+/// create SDF geometry block based on URDF
+thread_local StringSDFExtensionPtrMap g_extensions;
+thread_local bool g_reduceFixedJoints;
+thread_local bool g_enforceLimits;
+thread_local urdf::Pose g_initialRobotPose;
+thread_local bool g_initialRobotPoseValid = false;
+thread_local std::set<std::string> g_fixedJointsTransformedInRevoluteJoints;
+thread_local std::set<std::string> g_fixedJointsTransformedInFixedJoints;
+
 
 /// \brief parser xml string into urdf::Vector3
 /// \param[in] _key XML key where vector3 value might be
@@ -3255,6 +3261,7 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
   this->ParseSDFExtension(urdfXml);
 
   // Parse robot pose
+  g_initialRobotPoseValid = false;
   ParseRobotOrigin(urdfXml);
 
   urdf::LinkConstSharedPtr rootLink = robotModel->getRoot();
@@ -0,0 +1,330 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/World.hh"
+#include "test_config.h"
+#include "test_utils.hh"
+
+/// \brief Number of threads that load at the same time.
+static const std::size_t kThreadCount = 8u;
+
+/// \brief Number of loads done by each thread.
+static const std::size_t kLoadsPerThread = 10u;
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::testing::TestFile("integration", "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// \brief Load a file and print the resulting element tree followed by
+/// any errors.
+/// \param[in] _file File to load.
+/// \param[in] _config Parser configuration.
+/// \return The printed element tree and errors, or an empty string if the
+/// file could not be read.
+std::string loadToString(const std::string &_file,
+                         const sdf::ParserConfig &_config)
+{
+  sdf::Root root;
+  sdf::Errors errors = root.Load(_file, _config);
+  if (nullptr == root.Element())
+    return "";
+
+  std::string result = root.Element()->ToString("");
+  for (const auto &error : errors)
+    result += error.Message() + "\n";
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Load each file on many threads at once, and check that every load
+/// gives the same result as loading the file serially.
+/// \param[in] _files Files to load. Thread i loads _files[i % size].
+/// \param[in] _configs Configurations, used with the file of the same index.
+void checkConcurrentLoads(const std::vector<std::string> &_files,
+                          const std::vector<sdf::ParserConfig> &_configs)
+{
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < _files.size(); ++i)
+  {
+    expected.push_back(loadToString(_files[i], _configs[i]));
+    ASSERT_FALSE(expected.back().empty()) << _files[i];
+  }
+
+  std::atomic<std::size_t> mismatches{0};
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kThreadCount; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      const std::size_t index = t % _files.size();
+      for (std::size_t i = 0; i < kLoadsPerThread; ++i)
+      {
+        if (loadToString(_files[index], _configs[index]) != expected[index])
+          ++mismatches;
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0u, mismatches);
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentLoad, SdfWithIncludes)
+{
+  sdf::ParserConfig config;
+  config.SetFindCallback(findFileCb);
+
+  checkConcurrentLoads(
+      {sdf::testing::TestFile("sdf", "includes.sdf"),
+       sdf::testing::TestFile("sdf", "world_complete.sdf")},
+      {config, config});
+}
+
+/////////////////////////////////////////////////
+/// Reading sibling includes on several threads must give the same elements
+/// and errors, in the same order, as reading them one after another.
+TEST(ConcurrentLoad, ParallelIncludes)
+{
+  sdf::ParserConfig serial;
+  serial.SetFindCallback(findFileCb);
+  EXPECT_EQ(1u, serial.IncludeThreadCount());
+
+  sdf::ParserConfig parallel = serial;
+  parallel.SetIncludeThreadCount(4u);
+  EXPECT_EQ(4u, parallel.IncludeThreadCount());
+
+  sdf::ParserConfig hardware = serial;
+  hardware.SetIncludeThreadCount(0u);
+
+  for (const std::string file :
+           {"includes.sdf", "includes_1.5.sdf", "include_pose_1_9.sdf"})
+  {
+    const std::string path = sdf::testing::TestFile("sdf", file);
+    const std::string expected = loadToString(path, serial);
+    ASSERT_FALSE(expected.empty()) << file;
+    EXPECT_EQ(expected, loadToString(path, parallel)) << file;
+    EXPECT_EQ(expected, loadToString(path, hardware)) << file;
+  }
+
+  checkConcurrentLoads(
+      {sdf::testing::TestFile("sdf", "includes.sdf")}, {parallel});
+}
+
+/////////////////////////////////////////////////
+/// Includes are only read ahead while reading them one after another would
+/// reach them, so an include after a child element that fails to read is
+/// never resolved.
+TEST(ConcurrentLoad, ParallelIncludesStopAtFailure)
+{
+  std::mutex mutex;
+  std::set<std::string> found;
+  sdf::ParserConfig config;
+  config.SetIncludeThreadCount(4u);
+  config.SetFindCallback([&](const std::string &_file)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    found.insert(_file);
+    return findFileCb(_file);
+  });
+
+  const std::string worldString = R"(
+    <sdf version="1.8">
+      <world name="default">
+        <include><uri>test_model</uri><name>first</name></include>
+        <include><uri>test_model</uri><name>second</name></include>
+        <model/>
+        <include><uri>box</uri></include>
+        <include><uri>simple_model</uri></include>
+      </world>
+    </sdf>)";
+  const std::string worldFile = sdf::filesystem::append(
+      sdf::testing::TmpDirectory("concurrent_load"), "stop_at_failure.sdf");
+  {
+    std::ofstream out(worldFile);
+    out << worldString;
+  }
+
+  sdf::Root root;
+  EXPECT_FALSE(root.LoadSdfString(worldString, config).empty());
+  EXPECT_FALSE(root.Load(worldFile, config).empty());
+  EXPECT_EQ(1u, found.count("test_model"));
+  EXPECT_EQ(0u, found.count("box"));
+  EXPECT_EQ(0u, found.count("simple_model"));
+}
+
+/////////////////////////////////////////////////
+/// URDF conversion keeps its state per thread. Converting with and without
+/// fixed joint reduction at the same time must not mix the two.
+TEST(ConcurrentLoad, Urdf)
+{
+  const std::string urdfFile =
+      sdf::testing::TestFile("integration", "fixed_joint_reduction.urdf");
+
+  sdf::ParserConfig reduce;
+  sdf::ParserConfig preserve;
+  preserve.URDFSetPreserveFixedJoint(true);
+
+  const std::string reduced = loadToString(urdfFile, reduce);
+  const std::string preserved = loadToString(urdfFile, preserve);
+  EXPECT_NE(reduced, preserved);
+
+  checkConcurrentLoads(
+      {urdfFile, urdfFile,
+       sdf::testing::TestFile("integration", "urdf_gazebo_extensions.urdf")},
+      {reduce, preserve, reduce});
+}
+
+/////////////////////////////////////////////////
+/// The overloads that use the global config may run while it is updated
+/// through sdf::addURIPath.
+TEST(ConcurrentLoad, GlobalConfig)
+{
+  const std::string worldFile =
+      sdf::testing::TestFile("sdf", "world_complete.sdf");
+
+  std::thread writer([&]()
+  {
+    for (std::size_t i = 0; i < 1000u; ++i)
+    {
+      sdf::addURIPath("concurrent" + std::to_string(i % 16) + "://",
+          sdf::testing::TestFile("integration", "model"));
+    }
+  });
+
+  std::atomic<std::size_t> failures{0};
+  std::vector<std::thread> readers;
+  for (std::size_t t = 0; t < kThreadCount; ++t)
+  {
+    readers.emplace_back([&]()
+    {
+      for (std::size_t i = 0; i < kLoadsPerThread; ++i)
+      {
+        sdf::Root root;
+        if (!root.Load(worldFile).empty() || nullptr == root.WorldByIndex(0))
+          ++failures;
+      }
+    });
+  }
+  for (auto &reader : readers)
+    reader.join();
+  writer.join();
+
+  EXPECT_EQ(0u, failures);
+  sdf::ParserConfig::GlobalConfig() = sdf::ParserConfig();
+}
+
+/////////////////////////////////////////////////
+/// \brief Load a file or SDFormat string into DOM objects and print the
+/// element tree generated from them, followed by any errors.
+/// \param[in] _file File to load, or an empty string to load _string.
+/// \param[in] _string SDFormat string to load if _file is empty.
+/// \param[in] _config Parser configuration.
+/// \return The printed element tree and errors.
+std::string loadDomToString(const std::string &_file,
+                            const std::string &_string,
+                            const sdf::ParserConfig &_config)
+{
+  sdf::Root root;
+  sdf::Errors errors = _file.empty() ? root.LoadSdfString(_string, _config)
+                                     : root.Load(_file, _config);
+
+  std::string result = root.ToElement()->ToString("");
+  for (const auto &error : errors)
+  {
+    result += std::to_string(static_cast<int>(error.Code())) + " " +
+              error.Message() + "\n";
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// Loading the DOM objects of worlds, models and links on several threads
+/// must give the same objects and errors, in the same order, as loading them
+/// one after another.
+TEST(ConcurrentLoad, ParallelDomLoad)
+{
+  sdf::ParserConfig serial;
+  serial.SetFindCallback(findFileCb);
+  EXPECT_EQ(1u, serial.LoadThreadCount());
+
+  sdf::ParserConfig parallel = serial;
+  parallel.SetLoadThreadCount(4u);
+
+  sdf::ParserConfig hardware = serial;
+  hardware.SetLoadThreadCount(0u);
+
+  for (const std::string file :
+           {"world_complete.sdf", "includes.sdf", "nested_model.sdf",
+            "model_multi_nested_model.sdf", "world_duplicate.sdf",
+            "nested_multiple_elements_error_world.sdf"})
+  {
+    const std::string path = sdf::testing::TestFile("sdf", file);
+    const std::string expected = loadDomToString(path, "", serial);
+    EXPECT_EQ(expected, loadDomToString(path, "", parallel)) << file;
+    EXPECT_EQ(expected, loadDomToString(path, "", hardware)) << file;
+  }
+
+  // Two worlds with the same name, whose models have nested models with
+  // reserved and duplicate names at several levels.
+  std::string worlds = "<sdf version='1.9'>";
+  for (int w = 0; w < 2; ++w)
+  {
+    worlds += "<world name='default'>";
+    for (int m = 0; m < 20; ++m)
+    {
+      const std::string name = "model_" + std::to_string(m % 18);
+      worlds += "<model name='" + name + "'>";
+      for (int n = 0; n < 4; ++n)
+      {
+        worlds += "<model name='nested_" + std::to_string(n % 3) + "'>"
+                  "<link name='link'/><link name='__link_" + std::to_string(n) +
+                  "__'/><link name='link'/>"
+                  "<joint name='joint' type='fixed'><parent>link</parent>"
+                  "<child>link</child></joint></model>";
+      }
+      worlds += "<link name='base'/></model>";
+    }
+    worlds += "</world>";
+  }
+  worlds += "</sdf>";
+
+  const std::string expected = loadDomToString("", worlds, serial);
+  EXPECT_NE(std::string::npos, expected.find("already exists"));
+  EXPECT_NE(std::string::npos, expected.find("is reserved"));
+  EXPECT_EQ(expected, loadDomToString("", worlds, parallel));
+  EXPECT_EQ(expected, loadDomToString("", worlds, hardware));
+}
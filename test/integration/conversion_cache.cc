@@ -0,0 +1,404 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/ConversionCache.hh"
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+#include "test_utils.hh"
+
+/////////////////////////////////////////////////
+/// \brief Write a 1.6 model with one link.
+/// \param[in] _filename Name of the file.
+/// \param[in] _linkName Name of the link.
+/// \param[in] _include URI of a model to include, if not empty.
+void writeModel(const std::string &_filename, const std::string &_linkName,
+                const std::string &_include = "")
+{
+  std::ofstream out(_filename);
+  out << "<sdf version='1.6'><model name='m'>"
+      << "<link name='" << _linkName << "'><pose frame=''>1 0 0 0 0 0</pose>"
+      << "</link>";
+  if (!_include.empty())
+    out << "<include><uri>" << _include << "</uri></include>";
+  out << "</model></sdf>";
+}
+
+/////////////////////////////////////////////////
+TEST(ConversionCache, Construction)
+{
+  const std::string dir =
+      sdf::filesystem::append(
+          sdf::testing::TmpDirectory("conversion_cache"), "new");
+  sdf::ConversionCache cache(dir, 1000u);
+  EXPECT_TRUE(sdf::filesystem::is_directory(dir));
+  EXPECT_EQ(dir, cache.Directory());
+  EXPECT_EQ(1000u, cache.MaxSize());
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_EQ(0u, cache.HitCount());
+  EXPECT_EQ(0u, cache.MissCount());
+
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, config.ConversionCache());
+
+  auto cachePtr = std::make_shared<sdf::ConversionCache>(dir);
+  EXPECT_EQ(sdf::ConversionCache::kDefaultMaxSize, cachePtr->MaxSize());
+  config.SetConversionCache(cachePtr);
+  EXPECT_EQ(cachePtr, config.ConversionCache());
+
+  // Copies of the config share the cache.
+  sdf::ParserConfig copy = config;
+  EXPECT_EQ(cachePtr, copy.ConversionCache());
+
+  config.SetConversionCache(nullptr);
+  EXPECT_EQ(nullptr, config.ConversionCache());
+}
+
+/////////////////////////////////////////////////
+/// Files loaded from the cache give the same elements, sources and errors
+/// as converting them again.
+TEST(ConversionCache, SameResultAsUncached)
+{
+  std::vector<std::string> files;
+  sdf::testing::FindSdfFiles(sdf::testing::TestFile("integration"), files);
+  ASSERT_GT(files.size(), 50u);
+
+  // The cache is not used with a find file callback, so included models
+  // are found through SDF_PATH.
+  sdf::testing::setenv("SDF_PATH",
+      sdf::testing::TestFile("integration", "model"));
+  sdf::ParserConfig uncached;
+
+  auto cache = std::make_shared<sdf::ConversionCache>(
+      sdf::testing::TmpDirectory("conversion_cache_files"));
+  sdf::ParserConfig cached = uncached;
+  cached.SetConversionCache(cache);
+
+  for (const auto &file : files)
+  {
+    const std::string expected = sdf::testing::ReadFileToString(file, uncached);
+    EXPECT_EQ(expected, sdf::testing::ReadFileToString(file, cached)) << file;
+    EXPECT_EQ(expected, sdf::testing::ReadFileToString(file, cached)) << file;
+  }
+
+  // Converted files, and the older models they include, are stored.
+  // Files of the latest version are not.
+  EXPECT_GT(cache->HitCount(), 20u);
+  EXPECT_GT(cache->Size(), 0u);
+
+  // Nothing is looked up or stored while a find file callback is set.
+  cache->Clear();
+  cached.SetFindCallback([](const std::string &_file)
+  {
+    return sdf::testing::TestFile("integration", "model", _file);
+  });
+  const std::size_t hits = cache->HitCount();
+  for (const auto &file : files)
+    sdf::testing::ReadFileToString(file, cached);
+  EXPECT_EQ(hits, cache->HitCount());
+  EXPECT_EQ(0u, cache->Size());
+}
+
+/////////////////////////////////////////////////
+/// Entries are keyed by the contents of the file, and are only used while
+/// the files it includes are unchanged.
+TEST(ConversionCache, Invalidation)
+{
+  const std::string dir = sdf::testing::TmpDirectory("conversion_cache_models");
+  const std::string innerFile = sdf::filesystem::append(dir, "inner.sdf");
+  const std::string outerFile = sdf::filesystem::append(dir, "outer.sdf");
+  writeModel(innerFile, "inner_link");
+  writeModel(outerFile, "outer_link", innerFile);
+
+  auto cache = std::make_shared<sdf::ConversionCache>(
+      sdf::testing::TmpDirectory("conversion_cache_entries"));
+  sdf::ParserConfig config;
+  config.SetConversionCache(cache);
+
+  auto readLinkNames = [&]() -> std::string
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(outerFile, config, sdf, errors));
+    EXPECT_TRUE(errors.empty()) << errors;
+    sdf::ElementPtr model = sdf->Root()->GetElement("model");
+    EXPECT_EQ("1.6", sdf->OriginalVersion());
+    return model->GetElement("link")->Get<std::string>("name") + ' ' +
+        model->GetElement("model")->GetElement("link")->Get<std::string>(
+            "name");
+  };
+
+  // Both files are stored, and loaded by the second read.
+  EXPECT_EQ("outer_link inner_link", readLinkNames());
+  EXPECT_EQ(0u, cache->HitCount());
+  EXPECT_EQ(2u, cache->MissCount());
+  EXPECT_EQ("outer_link inner_link", readLinkNames());
+  EXPECT_EQ(1u, cache->HitCount());
+  EXPECT_EQ(2u, cache->MissCount());
+
+  // Changing the included file invalidates the entry of the outer file.
+  writeModel(innerFile, "renamed_link");
+  EXPECT_EQ("outer_link renamed_link", readLinkNames());
+  EXPECT_EQ(1u, cache->HitCount());
+  EXPECT_EQ(4u, cache->MissCount());
+
+  // Rewriting a file with the same contents keeps its entry, while other
+  // contents are a new entry. The included file is then loaded from the
+  // cache.
+  writeModel(outerFile, "outer_link", innerFile);
+  EXPECT_EQ("outer_link renamed_link", readLinkNames());
+  EXPECT_EQ(2u, cache->HitCount());
+  writeModel(outerFile, "other_link", innerFile);
+  EXPECT_EQ("other_link renamed_link", readLinkNames());
+  EXPECT_EQ(3u, cache->HitCount());
+  EXPECT_EQ(5u, cache->MissCount());
+
+  // Other settings use other entries.
+  config.SetWarningsPolicy(sdf::EnforcementPolicy::ERR);
+  EXPECT_EQ("other_link renamed_link", readLinkNames());
+  EXPECT_EQ(3u, cache->HitCount());
+  EXPECT_EQ(7u, cache->MissCount());
+}
+
+/////////////////////////////////////////////////
+/// An entry is only loaded for the contents it was written from, even when
+/// it is found under the name of the entry of other contents.
+TEST(ConversionCache, VerifiedHits)
+{
+  const std::string dir =
+      sdf::testing::TmpDirectory("conversion_cache_verified");
+  const std::string file = sdf::filesystem::append(dir, "model.sdf");
+  const std::string cacheDir =
+      sdf::testing::TmpDirectory("conversion_cache_verified_entries");
+  auto cache = std::make_shared<sdf::ConversionCache>(cacheDir);
+  sdf::ParserConfig config;
+  config.SetConversionCache(cache);
+
+  auto readLinkName = [&]() -> std::string
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(file, config, sdf, errors));
+    EXPECT_TRUE(errors.empty()) << errors;
+    return sdf->Root()->GetElement("model")->GetElement("link")->Get<
+        std::string>("name");
+  };
+  auto entries = [&]()
+  {
+    std::vector<std::string> paths;
+    for (sdf::filesystem::DirIter it(cacheDir);
+         it != sdf::filesystem::DirIter(); ++it)
+    {
+      paths.push_back(*it);
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+  };
+
+  writeModel(file, "first_link");
+  EXPECT_EQ("first_link", readLinkName());
+  const std::vector<std::string> firstEntries = entries();
+  ASSERT_EQ(1u, firstEntries.size());
+  writeModel(file, "second_link");
+  EXPECT_EQ("second_link", readLinkName());
+  std::vector<std::string> bothEntries = entries();
+  ASSERT_EQ(2u, bothEntries.size());
+  const std::string secondEntry = bothEntries[0] == firstEntries[0] ?
+      bothEntries[1] : bothEntries[0];
+
+  // The entry of the first contents is copied over the entry of the second.
+  {
+    std::ifstream in(firstEntries[0], std::ios::binary);
+    std::ofstream out(secondEntry, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  EXPECT_EQ(0u, cache->HitCount());
+  EXPECT_EQ("second_link", readLinkName());
+  EXPECT_EQ(0u, cache->HitCount());
+  EXPECT_EQ(3u, cache->MissCount());
+
+  // The miss rewrote the entry.
+  EXPECT_EQ("second_link", readLinkName());
+  EXPECT_EQ(1u, cache->HitCount());
+  EXPECT_EQ(2u, entries().size());
+}
+
+/////////////////////////////////////////////////
+/// The files included by a file that are read on include threads are
+/// recorded as dependencies of its entry too.
+TEST(ConversionCache, InvalidationWithIncludeThreads)
+{
+  const std::string dir =
+      sdf::testing::TmpDirectory("conversion_cache_thread_models");
+  const std::string innerFile1 = sdf::filesystem::append(dir, "inner1.sdf");
+  const std::string innerFile2 = sdf::filesystem::append(dir, "inner2.sdf");
+  const std::string outerFile = sdf::filesystem::append(dir, "outer.sdf");
+  writeModel(innerFile1, "inner_link");
+  writeModel(innerFile2, "inner_link");
+  {
+    std::ofstream out(outerFile);
+    out << "<sdf version='1.6'><model name='outer'>"
+        << "<include><uri>" << innerFile1 << "</uri>"
+        << "<name>inner1</name></include>"
+        << "<include><uri>" << innerFile2 << "</uri>"
+        << "<name>inner2</name></include>"
+        << "</model></sdf>";
+  }
+
+  auto cache = std::make_shared<sdf::ConversionCache>(
+      sdf::testing::TmpDirectory("conversion_cache_thread_entries"));
+  sdf::ParserConfig config;
+  config.SetConversionCache(cache);
+  config.SetIncludeThreadCount(2);
+
+  auto readLinkNames = [&]() -> std::string
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(outerFile, config, sdf, errors));
+    EXPECT_TRUE(errors.empty()) << errors;
+    std::string names;
+    for (auto model = sdf->Root()->GetElement("model")->GetElement("model");
+         model; model = model->GetNextElement("model"))
+    {
+      names += model->GetElement("link")->Get<std::string>("name") + " ";
+    }
+    return names;
+  };
+
+  EXPECT_EQ("inner_link inner_link ", readLinkNames());
+  EXPECT_EQ("inner_link inner_link ", readLinkNames());
+  EXPECT_EQ(1u, cache->HitCount());
+
+  writeModel(innerFile2, "renamed_link");
+  EXPECT_EQ("inner_link renamed_link ", readLinkNames());
+}
+
+/////////////////////////////////////////////////
+/// The entries that were used least recently are removed when the total
+/// size goes over the limit.
+TEST(ConversionCache, Eviction)
+{
+  const std::string dir =
+      sdf::testing::TmpDirectory("conversion_cache_eviction");
+  std::vector<std::string> files;
+  for (const std::string name : {"a", "b", "c"})
+  {
+    files.push_back(sdf::filesystem::append(dir, name + ".sdf"));
+    writeModel(files.back(), name + "_link");
+  }
+
+  const std::string cacheDir =
+      sdf::testing::TmpDirectory("conversion_cache_eviction_entries");
+  sdf::ParserConfig config;
+  config.SetConversionCache(std::make_shared<sdf::ConversionCache>(cacheDir));
+
+  auto read = [&](const std::string &_file)
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(_file, config, sdf, errors));
+    // File times have a coarse resolution.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  };
+
+  read(files[0]);
+  const std::uintmax_t entrySize = config.ConversionCache()->Size();
+  ASSERT_GT(entrySize, 0u);
+
+  // A limit of two entries.
+  auto cache = std::make_shared<sdf::ConversionCache>(
+      cacheDir, entrySize * 2 + entrySize / 2);
+  config.SetConversionCache(cache);
+  read(files[1]);
+  read(files[0]);
+  EXPECT_EQ(1u, cache->HitCount());
+
+  // b was used least recently.
+  read(files[2]);
+  EXPECT_LE(cache->Size(), cache->MaxSize());
+  read(files[0]);
+  read(files[2]);
+  EXPECT_EQ(3u, cache->HitCount());
+  read(files[1]);
+  EXPECT_EQ(3u, cache->HitCount());
+  EXPECT_EQ(3u, cache->MissCount());
+}
+
+/////////////////////////////////////////////////
+/// The limit holds when several caches, such as those of several processes,
+/// share a directory.
+TEST(ConversionCache, SharedDirectory)
+{
+  const std::string dir =
+      sdf::testing::TmpDirectory("conversion_cache_shared");
+  std::vector<std::string> files;
+  for (const std::string name : {"a", "b", "c", "d"})
+  {
+    files.push_back(sdf::filesystem::append(dir, name + ".sdf"));
+    writeModel(files.back(), name + "_link");
+  }
+
+  const std::string cacheDir =
+      sdf::testing::TmpDirectory("conversion_cache_shared_entries");
+  auto read = [&](const std::string &_file,
+                  const std::shared_ptr<sdf::ConversionCache> &_cache)
+  {
+    sdf::ParserConfig config;
+    config.SetConversionCache(_cache);
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(_file, config, sdf, errors));
+    // File times have a coarse resolution.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  };
+
+  auto sizeCache = std::make_shared<sdf::ConversionCache>(cacheDir);
+  read(files[0], sizeCache);
+  const std::uintmax_t entrySize = sizeCache->Size();
+  ASSERT_GT(entrySize, 0u);
+  sizeCache->Clear();
+
+  // A limit of two entries, which each cache alone would stay within.
+  const std::uintmax_t maxSize = entrySize * 2 + entrySize / 2;
+  auto first = std::make_shared<sdf::ConversionCache>(cacheDir, maxSize);
+  auto second = std::make_shared<sdf::ConversionCache>(cacheDir, maxSize);
+  read(files[0], first);
+  read(files[1], second);
+  read(files[2], first);
+  EXPECT_LE(first->Size(), maxSize);
+  read(files[3], second);
+  EXPECT_LE(second->Size(), maxSize);
+}
@@ -100,3 +100,55 @@ TEST(ElementMemoryLeak, SDFCreateDestroy)
             << getMemoryUsage()
             << std::endl;
 }
+
+//////////////////////////////////////////////////
+TEST(ElementMemoryLeak, LargeWorld)
+{
+  // Build a world with many models so that per-element overhead, such as
+  // the element descriptions of each link, dominates memory usage.
+  const unsigned int modelCount = 5000;
+  std::string worldString =
+      "<?xml version='1.0'?>\n"
+      "<sdf version='1.9'>\n"
+      "  <world name='default'>\n";
+  for (unsigned int i = 0; i < modelCount; ++i)
+  {
+    worldString +=
+        "    <model name='model_" + std::to_string(i) + "'>\n"
+        "      <link name='link'>\n"
+        "        <collision name='collision'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </collision>\n"
+        "        <visual name='visual'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </visual>\n"
+        "      </link>\n"
+        "    </model>\n";
+  }
+  worldString +=
+      "  </world>\n"
+      "</sdf>";
+
+  int initialMemory = getMemoryUsage();
+  std::cout << "initial memory: " << initialMemory << std::endl;
+
+  {
+    sdf::SDF worldSDF;
+    worldSDF.SetFromString(worldString);
+    ASSERT_NE(nullptr, worldSDF.Root()->GetElement("world"));
+
+    int memoryUsage = getMemoryUsage();
+    std::cout << "memory with " << modelCount << " models: " << memoryUsage
+              << " (" << (memoryUsage - initialMemory) / modelCount
+              << " per model)" << std::endl;
+
+    // Element descriptions are shared between instances, so each model
+    // should only cost a few tens of kilobytes.
+    EXPECT_LT(memoryUsage - initialMemory,
+        static_cast<int>(modelCount) * 100 * 1024);
+  }
+
+  std::cout << "  final memory: "
+            << getMemoryUsage()
+            << std::endl;
+}
@@ -28,6 +28,7 @@
 #include "sdf/World.hh"
 #include "sdf/Actor.hh"
 #include "sdf/Light.hh"
+#include "sdf/ParserConfig.hh"
 #include "test_config.h"
 
 //////////////////////////////////////////////////
@@ -147,6 +148,39 @@ TEST(ElementTracing, NestedModels)
   EXPECT_EQ(nestedNestedLinkXmlPath, nestedNestedLinkElem->XmlPath());
 }
 
+//////////////////////////////////////////////////
+TEST(ElementTracing, Untracked)
+{
+  const std::string testFile =
+    sdf::testing::TestFile("sdf", "nested_model.sdf");
+
+  sdf::ParserConfig config;
+  config.SetTrackSourceLocations(false);
+  sdf::Root root;
+  auto errors = root.Load(testFile, config);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::Model *model = root.Model();
+  ASSERT_NE(nullptr, model);
+  EXPECT_EQ(2u, model->LinkCount());
+  EXPECT_EQ(1u, model->JointCount());
+  EXPECT_EQ(1u, model->ModelCount());
+
+  // The file path is still recorded
+  const sdf::Model *nestedModel = model->ModelByName("nested_model");
+  ASSERT_NE(nullptr, nestedModel);
+  const sdf::Link *nestedLink = nestedModel->LinkByName("nested_link01");
+  ASSERT_NE(nullptr, nestedLink);
+  for (const auto &elem :
+       {model->Element(), nestedModel->Element(), nestedLink->Element()})
+  {
+    ASSERT_NE(nullptr, elem);
+    EXPECT_EQ(testFile, elem->FilePath());
+    EXPECT_FALSE(elem->LineNumber().has_value());
+    EXPECT_TRUE(elem->XmlPath().empty());
+  }
+}
+
 //////////////////////////////////////////////////
 TEST(ElementTracing, includes)
 {
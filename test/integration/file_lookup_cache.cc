@@ -0,0 +1,189 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Element.hh"
+#include "sdf/FileLookupCache.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+std::string findFileCb(const std::string &_input)
+{
+  return sdf::testing::TestFile("integration", "model", _input);
+}
+
+/////////////////////////////////////////////////
+/// \brief Load a file and print the resulting element tree followed by
+/// any errors.
+/// \param[in] _file File to load.
+/// \param[in] _config Parser configuration.
+/// \return The printed element tree and errors.
+std::string loadToString(const std::string &_file,
+                         const sdf::ParserConfig &_config)
+{
+  sdf::Root root;
+  sdf::Errors errors = root.Load(_file, _config);
+  std::string result;
+  if (nullptr != root.Element())
+    result = root.Element()->ToString("");
+  for (const auto &error : errors)
+    result += error.Message() + "\n";
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST(FileLookupCache, Construction)
+{
+  sdf::FileLookupCache cache;
+  EXPECT_EQ(0u, cache.HitCount());
+  EXPECT_EQ(0u, cache.MissCount());
+  EXPECT_EQ(0u, cache.QueriesAvoided());
+
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, config.FileLookupCache());
+
+  auto cachePtr = std::make_shared<sdf::FileLookupCache>();
+  config.SetFileLookupCache(cachePtr);
+  EXPECT_EQ(cachePtr, config.FileLookupCache());
+
+  // Copies of the config share the cache.
+  sdf::ParserConfig copy = config;
+  EXPECT_EQ(cachePtr, copy.FileLookupCache());
+
+  config.SetFileLookupCache(nullptr);
+  EXPECT_EQ(nullptr, config.FileLookupCache());
+}
+
+/////////////////////////////////////////////////
+/// Loading a world with the cache gives the same result as without it, and
+/// the lookups of models that are included several times are reused.
+TEST(FileLookupCache, SameResultAsUncached)
+{
+  const std::string worldFile =
+      sdf::testing::TestFile("sdf", "includes.sdf");
+
+  sdf::ParserConfig uncached;
+  uncached.SetFindCallback(findFileCb);
+
+  auto cache = std::make_shared<sdf::FileLookupCache>();
+  sdf::ParserConfig cached = uncached;
+  cached.SetFileLookupCache(cache);
+
+  const std::string expected = loadToString(worldFile, uncached);
+  ASSERT_FALSE(expected.empty());
+
+  EXPECT_EQ(expected, loadToString(worldFile, cached));
+  EXPECT_GT(cache->MissCount(), 0u);
+  EXPECT_GT(cache->HitCount(), 0u);
+  EXPECT_GT(cache->QueriesAvoided(), 0u);
+
+  // A second load only hits.
+  const std::size_t misses = cache->MissCount();
+  const std::size_t avoided = cache->QueriesAvoided();
+  EXPECT_EQ(expected, loadToString(worldFile, cached));
+  EXPECT_EQ(misses, cache->MissCount());
+  EXPECT_GT(cache->QueriesAvoided(), avoided);
+}
+
+/////////////////////////////////////////////////
+/// Files that are not found are cached too, until the cache is cleared.
+TEST(FileLookupCache, NegativeResults)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  tmpDir = sdf::filesystem::append(tmpDir, "file_lookup_cache");
+  sdf::filesystem::create_directory(tmpDir);
+  const std::string newFile = sdf::filesystem::append(tmpDir, "new.sdf");
+  std::remove(newFile.c_str());
+
+  sdf::ParserConfig config;
+  config.AddURIPath("lookup://", tmpDir);
+  auto cache = std::make_shared<sdf::FileLookupCache>();
+  config.SetFileLookupCache(cache);
+
+  EXPECT_TRUE(sdf::findFile("lookup://new.sdf", false, false,
+                            config).empty());
+  EXPECT_EQ(1u, cache->MissCount());
+  EXPECT_TRUE(sdf::findFile("lookup://new.sdf", false, false,
+                            config).empty());
+  EXPECT_EQ(1u, cache->HitCount());
+  EXPECT_GT(cache->QueriesAvoided(), 0u);
+
+  // The cache does not notice new files on its own.
+  std::ofstream(newFile) << "<sdf version='1.8'/>";
+  EXPECT_TRUE(sdf::findFile("lookup://new.sdf", false, false,
+                            config).empty());
+  EXPECT_EQ(2u, cache->HitCount());
+
+  cache->Clear();
+  EXPECT_EQ(newFile, sdf::findFile("lookup://new.sdf", false, false,
+                                   config));
+  EXPECT_EQ(2u, cache->MissCount());
+
+  // Changing the search paths changes the key.
+  config.AddURIPath("other://", tmpDir);
+  EXPECT_EQ(newFile, sdf::findFile("lookup://new.sdf", false, false,
+                                   config));
+  EXPECT_EQ(3u, cache->MissCount());
+}
+
+/////////////////////////////////////////////////
+/// The model file chosen from a model.config is cached.
+TEST(FileLookupCache, ModelFilePath)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  tmpDir = sdf::filesystem::append(tmpDir, "file_lookup_cache_model");
+  sdf::filesystem::create_directory(tmpDir);
+  {
+    std::ofstream out(sdf::filesystem::append(tmpDir, "model.config"));
+    out << "<?xml version='1.0'?><model><name>m</name>"
+        << "<sdf version='1.6'>model_1_6.sdf</sdf>"
+        << "<sdf version='1.8'>model.sdf</sdf>"
+        << "</model>";
+  }
+  const std::string modelFile = sdf::filesystem::append(tmpDir, "model.sdf");
+
+  sdf::ParserConfig config;
+  EXPECT_EQ(modelFile, sdf::getModelFilePath(tmpDir, config));
+
+  auto cache = std::make_shared<sdf::FileLookupCache>();
+  config.SetFileLookupCache(cache);
+  EXPECT_EQ(modelFile, sdf::getModelFilePath(tmpDir, config));
+  EXPECT_EQ(1u, cache->MissCount());
+  EXPECT_EQ(modelFile, sdf::getModelFilePath(tmpDir, config));
+  EXPECT_EQ(1u, cache->HitCount());
+
+  // Finding model.config and reading it were avoided.
+  EXPECT_EQ(2u, cache->QueriesAvoided());
+
+  EXPECT_TRUE(cache->IsDirectory(tmpDir));
+  EXPECT_FALSE(cache->IsDirectory(modelFile));
+  EXPECT_TRUE(cache->IsDirectory(tmpDir));
+  EXPECT_EQ(2u, cache->HitCount());
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/IncludeCache.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+/// \brief Find the test models through SDF_PATH. The cache is not used
+/// when a find file callback is set.
+void setModelPath()
+{
+  sdf::testing::setenv("SDF_PATH",
+      sdf::testing::TestFile("integration", "model"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Load a file and print the resulting element tree followed by
+/// any errors.
+/// \param[in] _file File to load.
+/// \param[in] _config Parser configuration.
+/// \return The printed element tree and errors.
+std::string loadToString(const std::string &_file,
+                         const sdf::ParserConfig &_config)
+{
+  sdf::Root root;
+  sdf::Errors errors = root.Load(_file, _config);
+  std::string result;
+  if (nullptr != root.Element())
+    result = root.Element()->ToString("");
+  for (const auto &error : errors)
+    result += error.Message() + "\n";
+  return result;
+}
+
+/////////////////////////////////////////////////
+TEST(IncludeCache, Construction)
+{
+  sdf::IncludeCache cache;
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_EQ(0u, cache.HitCount());
+  EXPECT_EQ(0u, cache.MissCount());
+
+  sdf::ParserConfig config;
+  EXPECT_EQ(nullptr, config.IncludeCache());
+
+  auto cachePtr = std::make_shared<sdf::IncludeCache>();
+  config.SetIncludeCache(cachePtr);
+  EXPECT_EQ(cachePtr, config.IncludeCache());
+
+  // Copies of the config share the cache.
+  sdf::ParserConfig copy = config;
+  EXPECT_EQ(cachePtr, copy.IncludeCache());
+
+  config.SetIncludeCache(nullptr);
+  EXPECT_EQ(nullptr, config.IncludeCache());
+}
+
+/////////////////////////////////////////////////
+/// Including a file that is in the cache gives the same elements as reading
+/// it from disk, with the overrides of each <include> applied.
+TEST(IncludeCache, SameResultAsUncached)
+{
+  const std::string worldFile =
+      sdf::testing::TestFile("sdf", "includes.sdf");
+
+  setModelPath();
+  sdf::ParserConfig uncached;
+
+  auto cache = std::make_shared<sdf::IncludeCache>();
+  sdf::ParserConfig cached = uncached;
+  cached.SetIncludeCache(cache);
+
+  const std::string expected = loadToString(worldFile, uncached);
+  ASSERT_FALSE(expected.empty());
+
+  // includes.sdf includes test_model three times, test_light and
+  // test_actor twice, so only three of the seven includes miss.
+  EXPECT_EQ(expected, loadToString(worldFile, cached));
+  EXPECT_EQ(3u, cache->Size());
+  EXPECT_EQ(3u, cache->MissCount());
+  EXPECT_EQ(4u, cache->HitCount());
+
+  // The cache is kept across loads.
+  EXPECT_EQ(expected, loadToString(worldFile, cached));
+  EXPECT_EQ(3u, cache->MissCount());
+  EXPECT_EQ(11u, cache->HitCount());
+
+  // So is the result when includes are read on several threads.
+  cached.SetIncludeThreadCount(4u);
+  EXPECT_EQ(expected, loadToString(worldFile, cached));
+  EXPECT_EQ(3u, cache->MissCount());
+
+  // Settings that change how files are read are part of the key.
+  cached.URDFSetPreserveFixedJoint(true);
+  EXPECT_EQ(expected, loadToString(worldFile, cached));
+  EXPECT_EQ(6u, cache->Size());
+
+  cache->Clear();
+  EXPECT_EQ(0u, cache->Size());
+}
+
+/////////////////////////////////////////////////
+/// The overrides of an <include> are applied to a copy of the cached
+/// elements, and do not leak into later includes of the same file.
+TEST(IncludeCache, Overrides)
+{
+  const std::string worldString = R"(
+    <sdf version="1.8">
+      <world name="default">
+        <include>
+          <uri>test_model</uri>
+          <name>first</name>
+          <pose>1 2 3 0 0 0</pose>
+          <static>true</static>
+        </include>
+        <include>
+          <uri>test_model</uri>
+          <name>second</name>
+        </include>
+        <include>
+          <uri>test_model</uri>
+        </include>
+      </world>
+    </sdf>)";
+
+  setModelPath();
+  auto cache = std::make_shared<sdf::IncludeCache>();
+  sdf::ParserConfig config;
+  config.SetIncludeCache(cache);
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(worldString, config);
+  EXPECT_TRUE(errors.empty());
+  EXPECT_EQ(1u, cache->MissCount());
+  EXPECT_EQ(2u, cache->HitCount());
+
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(3u, world->ModelCount());
+
+  const sdf::Model *first = world->ModelByIndex(0);
+  EXPECT_EQ("first", first->Name());
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0), first->RawPose());
+  EXPECT_TRUE(first->Static());
+
+  const sdf::Model *second = world->ModelByIndex(1);
+  EXPECT_EQ("second", second->Name());
+  EXPECT_EQ(ignition::math::Pose3d::Zero, second->RawPose());
+  EXPECT_FALSE(second->Static());
+
+  EXPECT_EQ("test_model", world->ModelByIndex(2)->Name());
+}
+
+/////////////////////////////////////////////////
+/// A find file callback can resolve the same URI to different files, so
+/// the cache is not used while one is set.
+TEST(IncludeCache, FindCallback)
+{
+  const std::string worldFile =
+      sdf::testing::TestFile("sdf", "includes.sdf");
+
+  auto cache = std::make_shared<sdf::IncludeCache>();
+  sdf::ParserConfig config;
+  config.SetIncludeCache(cache);
+  config.SetFindCallback([](const std::string &_file)
+      {
+        return sdf::testing::TestFile("integration", "model", _file);
+      });
+
+  EXPECT_FALSE(loadToString(worldFile, config).empty());
+  EXPECT_EQ(0u, cache->Size());
+  EXPECT_EQ(0u, cache->HitCount());
+}
+
+/////////////////////////////////////////////////
+/// A cached file is read again once it, or a file it includes, changes.
+TEST(IncludeCache, FileChanged)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  sdf::filesystem::create_directory(tmpDir);
+  const std::string modelDir =
+      sdf::filesystem::append(tmpDir, "include_cache_model");
+  sdf::filesystem::create_directory(modelDir);
+  const std::string innerFile =
+      sdf::filesystem::append(modelDir, "inner.sdf");
+  const std::string outerFile =
+      sdf::filesystem::append(modelDir, "outer.sdf");
+
+  auto writeInner = [&](const std::string &_linkName)
+  {
+    std::ofstream out(innerFile);
+    out << "<sdf version='1.8'><model name='inner'>"
+        << "<link name='" << _linkName << "'/>"
+        << "</model></sdf>";
+  };
+  writeInner("link");
+  {
+    std::ofstream out(outerFile);
+    out << "<sdf version='1.8'><model name='outer'>"
+        << "<include><uri>" << innerFile << "</uri></include>"
+        << "</model></sdf>";
+  }
+
+  const std::string worldString =
+      "<sdf version='1.8'><world name='default'>"
+      "<include><uri>" + outerFile + "</uri></include>"
+      "</world></sdf>";
+
+  auto cache = std::make_shared<sdf::IncludeCache>();
+  sdf::ParserConfig config;
+  config.SetIncludeCache(cache);
+
+  auto innerLinkName = [&]() -> std::string
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(worldString, config);
+    EXPECT_TRUE(errors.empty());
+    const sdf::World *world = root.WorldByIndex(0);
+    if (nullptr == world || nullptr == world->ModelByIndex(0))
+      return "";
+    const sdf::Model *inner = world->ModelByIndex(0)->ModelByIndex(0);
+    if (nullptr == inner || nullptr == inner->LinkByIndex(0))
+      return "";
+    return inner->LinkByIndex(0)->Name();
+  };
+
+  EXPECT_EQ("link", innerLinkName());
+  EXPECT_EQ(2u, cache->MissCount());
+
+  EXPECT_EQ("link", innerLinkName());
+  EXPECT_EQ(2u, cache->MissCount());
+  EXPECT_EQ(1u, cache->HitCount());
+
+  // Changing the nested file invalidates the entry of the outer file too.
+  writeInner("renamed_link");
+  EXPECT_EQ("renamed_link", innerLinkName());
+  EXPECT_EQ(4u, cache->MissCount());
+}
+
+/////////////////////////////////////////////////
+/// An entry keeps the stamps its files had before they were read, so that
+/// a file that changed while it was read is read again.
+TEST(IncludeCache, StampsFromBeforeRead)
+{
+  const std::string file =
+      sdf::testing::TestFile("integration", "model", "test_model",
+                             "model.sdf");
+
+  sdf::SDFPtr sdf(new sdf::SDF);
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readFile(file, sdf));
+
+  sdf::IncludeCache cache;
+  sdf::ParserConfig config;
+  sdf::StampedFiles files;
+  sdf::SDFPtr found(new sdf::SDF);
+  sdf::Errors errors;
+
+  // The file did not match this stamp when it was read.
+  files.emplace_back(file, sdf::FileStamp());
+  cache.Insert(file, config, sdf, {}, files);
+  EXPECT_EQ(1u, cache.Size());
+  EXPECT_FALSE(cache.Find(file, config, found, errors, files));
+  EXPECT_EQ(1u, cache.MissCount());
+
+  // Entries without the stamp of the file itself are not made.
+  cache.Clear();
+  cache.Insert(file, config, sdf, {}, {});
+  EXPECT_EQ(0u, cache.Size());
+}
+
+/////////////////////////////////////////////////
+/// The files included by a file that are read on include threads are
+/// recorded as its dependencies too.
+TEST(IncludeCache, FileChangedWithIncludeThreads)
+{
+  std::string tmpDir;
+  ASSERT_TRUE(sdf::testing::TestTmpPath(tmpDir));
+  sdf::filesystem::create_directory(tmpDir);
+  const std::string modelDir =
+      sdf::filesystem::append(tmpDir, "include_cache_threads");
+  sdf::filesystem::create_directory(modelDir);
+  const std::string innerFile1 =
+      sdf::filesystem::append(modelDir, "inner1.sdf");
+  const std::string innerFile2 =
+      sdf::filesystem::append(modelDir, "inner2.sdf");
+  const std::string outerFile =
+      sdf::filesystem::append(modelDir, "outer.sdf");
+
+  auto writeInner = [](const std::string &_filename,
+                       const std::string &_linkName)
+  {
+    std::ofstream out(_filename);
+    out << "<sdf version='1.8'><model name='inner'>"
+        << "<link name='" << _linkName << "'/>"
+        << "</model></sdf>";
+  };
+  writeInner(innerFile1, "link");
+  writeInner(innerFile2, "link");
+  {
+    std::ofstream out(outerFile);
+    out << "<sdf version='1.8'><model name='outer'>"
+        << "<include><uri>" << innerFile1 << "</uri>"
+        << "<name>inner1</name></include>"
+        << "<include><uri>" << innerFile2 << "</uri>"
+        << "<name>inner2</name></include>"
+        << "</model></sdf>";
+  }
+
+  const std::string worldString =
+      "<sdf version='1.8'><world name='default'>"
+      "<include><uri>" + outerFile + "</uri></include>"
+      "</world></sdf>";
+
+  auto cache = std::make_shared<sdf::IncludeCache>();
+  sdf::ParserConfig config;
+  config.SetIncludeCache(cache);
+  config.SetIncludeThreadCount(2);
+
+  auto innerLinkNames = [&]() -> std::string
+  {
+    sdf::Root root;
+    sdf::Errors errors = root.LoadSdfString(worldString, config);
+    EXPECT_TRUE(errors.empty()) << errors;
+    const sdf::World *world = root.WorldByIndex(0);
+    if (nullptr == world || nullptr == world->ModelByIndex(0))
+      return "";
+    std::string names;
+    for (const std::string inner : {"inner1", "inner2"})
+    {
+      const sdf::Model *model = world->ModelByIndex(0)->ModelByName(inner);
+      if (nullptr == model || nullptr == model->LinkByIndex(0))
+        return "";
+      names += model->LinkByIndex(0)->Name() + " ";
+    }
+    return names;
+  };
+
+  EXPECT_EQ("link link ", innerLinkNames());
+  EXPECT_EQ("link link ", innerLinkNames());
+  EXPECT_EQ(1u, cache->HitCount());
+
+  writeInner(innerFile2, "renamed_link");
+  EXPECT_EQ("link renamed_link ", innerLinkNames());
+}
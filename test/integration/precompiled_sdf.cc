@@ -0,0 +1,218 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+#include "test_utils.hh"
+
+/////////////////////////////////////////////////
+/// Loading a precompiled file gives the same elements and errors as
+/// reading the file.
+TEST(PrecompiledSdf, SameResultAsXml)
+{
+  // The test files are copied, so that precompiled files are not written
+  // to the source tree.
+  const std::string dir = sdf::testing::TmpDirectory("precompiled_sdf_files");
+  std::vector<std::string> files;
+  sdf::testing::CopyDirectory(sdf::testing::TestFile("sdf"),
+                sdf::filesystem::append(dir, "sdf"), files);
+  sdf::testing::CopyDirectory(sdf::testing::TestFile("integration", "model"),
+                sdf::filesystem::append(dir, "model"), files);
+  ASSERT_GT(files.size(), 100u);
+
+  // Files read with a find file callback are not precompiled, so included
+  // models are found through SDF_PATH.
+  sdf::testing::setenv("SDF_PATH", sdf::filesystem::append(dir, "model"));
+  sdf::ParserConfig config;
+  config.SetUsePrecompiledFiles(true);
+
+  std::size_t precompiled = 0;
+  for (const auto &file : files)
+  {
+    const std::string expected = sdf::testing::ReadFileToString(file, config);
+    sdf::Errors errors;
+    if (!sdf::precompileFile(file, config, errors))
+      continue;
+
+    ++precompiled;
+    EXPECT_TRUE(sdf::filesystem::exists(file + "b")) << file;
+    EXPECT_EQ(expected, sdf::testing::ReadFileToString(file, config)) << file;
+  }
+
+  // Files that cannot be read are not precompiled.
+  EXPECT_GT(precompiled, 100u);
+
+  // Neither are files read with a find file callback.
+  config.SetFindCallback([&](const std::string &_file)
+  {
+    return sdf::filesystem::append(dir, "model", _file);
+  });
+  sdf::Errors errors;
+  EXPECT_FALSE(sdf::precompileFile(files.front(), config, errors));
+  EXPECT_FALSE(errors.empty());
+}
+
+/////////////////////////////////////////////////
+/// A precompiled file is only loaded while the files it was read from are
+/// unchanged, and with the same settings.
+TEST(PrecompiledSdf, Dependencies)
+{
+  const std::string dir = sdf::testing::TmpDirectory("precompiled_sdf");
+  const std::string innerFile = sdf::filesystem::append(dir, "inner.sdf");
+  const std::string outerFile = sdf::filesystem::append(dir, "outer.sdf");
+
+  auto writeFile = [](const std::string &_filename,
+                      const std::string &_linkName)
+  {
+    std::ofstream out(_filename);
+    out << "<sdf version='1.8'><model name='m'>"
+        << "<link name='" << _linkName << "'/>"
+        << "</model></sdf>";
+  };
+  writeFile(innerFile, "link");
+  {
+    std::ofstream out(outerFile);
+    out << "<sdf version='1.8'><model name='outer'>"
+        << "<include><uri>" << innerFile << "</uri></include>"
+        << "</model></sdf>";
+  }
+
+  sdf::ParserConfig config;
+  config.SetUsePrecompiledFiles(true);
+  auto innerLinkName = [&](bool _convert = true) -> std::string
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    const bool result = _convert ?
+        sdf::readFile(outerFile, config, sdf, errors) :
+        sdf::readFileWithoutConversion(outerFile, config, sdf, errors);
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(errors.empty());
+    return sdf->Root()->GetElement("model")->GetElement("model")
+        ->GetElement("link")->Get<std::string>("name");
+  };
+
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::precompileFile(outerFile, config, errors));
+  EXPECT_TRUE(errors.empty());
+  EXPECT_EQ("link", innerLinkName());
+
+  // Replace the included file with one of the same size and modification
+  // time. The precompiled file is still loaded, since it is not read.
+  const auto mtime = std::filesystem::last_write_time(innerFile);
+  writeFile(innerFile, "abcd");
+  std::filesystem::last_write_time(innerFile, mtime);
+  EXPECT_EQ("link", innerLinkName());
+
+  // Precompiled files are ignored unless the config asks for them.
+  config.SetUsePrecompiledFiles(false);
+  EXPECT_EQ("abcd", innerLinkName());
+  config.SetUsePrecompiledFiles(true);
+
+  // Files read without conversion, or with other settings, are read again.
+  EXPECT_EQ("abcd", innerLinkName(false));
+  config.SetWarningsPolicy(sdf::EnforcementPolicy::ERR);
+  EXPECT_EQ("abcd", innerLinkName());
+  config.SetWarningsPolicy(sdf::EnforcementPolicy::WARN);
+  EXPECT_EQ("link", innerLinkName());
+
+  // Changing the included file makes the precompiled file stale.
+  writeFile(innerFile, "renamed_link");
+  EXPECT_EQ("renamed_link", innerLinkName());
+
+  ASSERT_TRUE(sdf::precompileFile(outerFile, config, errors));
+  EXPECT_EQ("renamed_link", innerLinkName());
+
+  // A truncated precompiled file is ignored.
+  const std::string precompiledFile = outerFile + "b";
+  const auto size = std::filesystem::file_size(precompiledFile);
+  std::filesystem::resize_file(precompiledFile, size - 10);
+  const auto renamedMtime = std::filesystem::last_write_time(innerFile);
+  writeFile(innerFile, "renamed_abcd");
+  std::filesystem::last_write_time(innerFile, renamedMtime);
+  EXPECT_EQ("renamed_abcd", innerLinkName());
+}
+
+/////////////////////////////////////////////////
+/// The files included by a file that are read on include threads are
+/// recorded as dependencies of its precompiled file too.
+TEST(PrecompiledSdf, DependenciesWithIncludeThreads)
+{
+  const std::string dir = sdf::testing::TmpDirectory("precompiled_sdf_threads");
+  const std::string innerFile1 = sdf::filesystem::append(dir, "inner1.sdf");
+  const std::string innerFile2 = sdf::filesystem::append(dir, "inner2.sdf");
+  const std::string outerFile = sdf::filesystem::append(dir, "outer.sdf");
+
+  auto writeFile = [](const std::string &_filename,
+                      const std::string &_linkName)
+  {
+    std::ofstream out(_filename);
+    out << "<sdf version='1.8'><model name='m'>"
+        << "<link name='" << _linkName << "'/>"
+        << "</model></sdf>";
+  };
+  writeFile(innerFile1, "link");
+  writeFile(innerFile2, "link");
+  {
+    std::ofstream out(outerFile);
+    out << "<sdf version='1.8'><model name='outer'>"
+        << "<include><uri>" << innerFile1 << "</uri>"
+        << "<name>inner1</name></include>"
+        << "<include><uri>" << innerFile2 << "</uri>"
+        << "<name>inner2</name></include>"
+        << "</model></sdf>";
+  }
+
+  sdf::ParserConfig config;
+  config.SetUsePrecompiledFiles(true);
+  config.SetIncludeThreadCount(2);
+  auto innerLinkNames = [&]() -> std::string
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    sdf::init(sdf, config);
+    sdf::Errors errors;
+    EXPECT_TRUE(sdf::readFile(outerFile, config, sdf, errors));
+    EXPECT_TRUE(errors.empty()) << errors;
+    std::string names;
+    for (auto model = sdf->Root()->GetElement("model")->GetElement("model");
+         model; model = model->GetNextElement("model"))
+    {
+      names += model->GetElement("link")->Get<std::string>("name") + " ";
+    }
+    return names;
+  };
+
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::precompileFile(outerFile, config, errors));
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ("link link ", innerLinkNames());
+
+  writeFile(innerFile2, "renamed_link");
+  EXPECT_EQ("link renamed_link ", innerLinkNames());
+}
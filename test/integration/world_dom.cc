@@ -16,14 +16,18 @@
  */
 
 #include <iostream>
+#include <map>
 #include <string>
 #include <gtest/gtest.h>
+#include <ignition/math/Pose3.hh>
 
 #include "sdf/SDFImpl.hh"
 #include "sdf/parser.hh"
 #include "sdf/Frame.hh"
+#include "sdf/Link.hh"
 #include "sdf/Model.hh"
 #include "sdf/Root.hh"
+#include "sdf/SemanticPose.hh"
 #include "sdf/World.hh"
 #include "test_config.h"
 #include "test_utils.hh"
@@ -312,6 +316,75 @@ TEST(DOMWorld, NestedFrames)
 }
 
 
+/////////////////////////////////////////////////
+TEST(DOMWorld, ResolveAllPoses)
+{
+  std::map<std::string, ignition::math::Pose3d> poses;
+  sdf::World unloaded;
+  auto errors = unloaded.ResolveAllPoses(poses);
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, errors[0].Code());
+  EXPECT_TRUE(poses.empty());
+
+  const std::string sdfString = R"(
+    <sdf version='1.9'>
+      <world name='default'>
+        <frame name='F'><pose>0 0 1 0 0 0</pose></frame>
+        <model name='M'>
+          <pose relative_to='F'>1 0 0 0 0 1.5707963267948966</pose>
+          <link name='L'><pose>0 2 0 0 0 0</pose></link>
+          <model name='N'>
+            <pose relative_to='L'>0 0 3 0 0 0</pose>
+            <link name='L'/>
+            <frame name='NF' attached_to='L'><pose>1 1 1 0 0 0</pose></frame>
+          </model>
+        </model>
+      </world>
+    </sdf>)";
+
+  sdf::Root root;
+  errors = root.LoadSdfString(sdfString);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  errors = world->ResolveAllPoses(poses);
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Pose3d::Zero, poses["world"]);
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 1, 0, 0, 0), poses["F"]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 1, 0, 0, IGN_PI_2), poses["M"]);
+  EXPECT_EQ(ignition::math::Pose3d(-1, 0, 1, 0, 0, IGN_PI_2), poses["M::L"]);
+  EXPECT_EQ(ignition::math::Pose3d(-2, 1, 5, 0, 0, IGN_PI_2),
+            poses["M::N::NF"]);
+
+  // The poses agree with those resolved one at a time.
+  const sdf::Model *model = world->ModelByName("M");
+  ASSERT_NE(nullptr, model);
+  std::map<std::string, ignition::math::Pose3d> modelPoses;
+  errors = model->ResolveAllPoses(modelPoses);
+  EXPECT_TRUE(errors.empty()) << errors;
+  for (const std::string name : {"L", "N", "N::L", "N::NF"})
+  {
+    ASSERT_EQ(1u, modelPoses.count(name)) << name;
+    EXPECT_EQ(poses["M"] * modelPoses[name], poses["M::" + name]) << name;
+  }
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(model->LinkByName("L")->SemanticPose().Resolve(pose).empty());
+  EXPECT_EQ(pose, modelPoses["L"]);
+
+  // Resolved relative to another frame.
+  modelPoses.clear();
+  errors = model->ResolveAllPoses(modelPoses, "L");
+  EXPECT_TRUE(errors.empty()) << errors;
+  EXPECT_EQ(ignition::math::Pose3d(0, -2, 0, 0, 0, 0), modelPoses["__model__"]);
+  EXPECT_EQ(ignition::math::Pose3d(1, 1, 4, 0, 0, 0), modelPoses["N::NF"]);
+
+  modelPoses.clear();
+  errors = model->ResolveAllPoses(modelPoses, "F");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+}
+
 /////////////////////////////////////////////////
 TEST(DOMWorld, LoadWorldWithDuplicateChildNames)
 {
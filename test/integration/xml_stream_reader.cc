@@ -0,0 +1,138 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+#include "test_utils.hh"
+
+/////////////////////////////////////////////////
+/// Documents that are read without building a tinyxml2 document give the
+/// same elements and errors as when a tinyxml2 document is built.
+TEST(XmlStreamReader, SameResultAsDom)
+{
+  std::vector<std::string> files;
+  sdf::testing::FindSdfFiles(sdf::testing::TestFile("sdf"), files);
+  sdf::testing::FindSdfFiles(sdf::testing::TestFile("integration"), files);
+  ASSERT_GT(files.size(), 190u);
+
+  sdf::ParserConfig config;
+  config.SetFindCallback([](const std::string &_file)
+  {
+    return sdf::testing::TestFile("integration", "model", _file);
+  });
+
+  for (const auto &file : files)
+  {
+    std::ifstream in(file);
+    std::stringstream contents;
+    contents << in.rdbuf();
+
+    // The streaming reader does not accept document type declarations, so
+    // the parser builds a tinyxml2 document of the second copy. Documents
+    // that need to be converted are only streamed without conversion.
+    const std::string domXml = contents.str() + "\n<!DOCTYPE sdf>";
+    EXPECT_EQ(sdf::testing::ReadStringToString(domXml, config),
+              sdf::testing::ReadStringToString(contents.str(), config))
+        << file;
+    EXPECT_EQ(sdf::testing::ReadStringToString(domXml, config, false),
+              sdf::testing::ReadStringToString(contents.str(), config, false))
+        << file;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Files that are memory-mapped and streamed by readFile give the same
+/// elements and errors as when a tinyxml2 document is built of them.
+TEST(XmlStreamReader, ReadFileSameResultAsDom)
+{
+  // Both copies of the test files have the same layout, so that includes
+  // are resolved the same way. Every file of the second copy has a document
+  // type declaration, which makes the parser build a tinyxml2 document.
+  const std::string dir = sdf::testing::TmpDirectory("xml_stream_reader");
+  const std::string streamDir = sdf::filesystem::append(dir, "stream");
+  const std::string domDir = sdf::filesystem::append(dir, "dom");
+  std::vector<std::string> files;
+  std::vector<std::string> domFiles;
+  sdf::testing::CopyDirectory(
+      sdf::testing::TestFile("integration"), streamDir, files);
+  sdf::testing::CopyDirectory(
+      sdf::testing::TestFile("integration"), domDir, domFiles);
+  ASSERT_GT(files.size(), 50u);
+  for (const auto &file : domFiles)
+  {
+    std::ofstream out(file, std::ios::app);
+    out << "\n<!DOCTYPE sdf>";
+  }
+
+  auto readFile = [](const std::string &_file, const std::string &_dir)
+  {
+    sdf::ParserConfig config;
+    config.SetFindCallback([_dir](const std::string &_uri)
+    {
+      return sdf::filesystem::append(_dir, "model", _uri);
+    });
+    return sdf::testing::ReadFileToString(_file, config);
+  };
+
+  for (const auto &file : files)
+  {
+    const std::string relative = file.substr(streamDir.size());
+    std::string domResult = readFile(domDir + relative, domDir);
+    for (std::size_t pos = domResult.find(domDir); pos != std::string::npos;
+         pos = domResult.find(domDir, pos + streamDir.size()))
+    {
+      domResult.replace(pos, domDir.size(), streamDir);
+    }
+    EXPECT_EQ(domResult, readFile(file, streamDir)) << file;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Features of XML that only some test files use.
+TEST(XmlStreamReader, Text)
+{
+  const std::string xml =
+      "<?xml version='1.0'?>\r\n"
+      "<sdf version='" + sdf::SDF::Version() + "'>\r\n"
+      "  <model name='a&amp;b'>\r\n"
+      "    <!-- comment -->\r\n"
+      "    <link name=\"l\">\r\n"
+      "      <pose>  1 2\r\n 3   0 0 0 </pose>\r\n"
+      "      <must_be_base_link><!-- x -->true</must_be_base_link>\r\n"
+      "      <foo:bar baz='&lt;'>  text &gt; <x/></foo:bar>\r\n"
+      "      <unknown/>\r\n"
+      "    </link>\r\n"
+      "  </model>\r\n"
+      "</sdf>\r\n";
+
+  sdf::ParserConfig config;
+  const std::string streamed = sdf::testing::ReadStringToString(xml, config);
+  EXPECT_EQ(sdf::testing::ReadStringToString(xml + "<!DOCTYPE sdf>", config),
+            streamed);
+  EXPECT_NE(std::string::npos, streamed.find("link 5 /sdf/model")) << streamed;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/// \brief Number of worlds loaded for each thread count.
+static const std::size_t kWorldCount = 64u;
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with the given number of models, each with a
+/// few links connected by revolute joints.
+/// \param[in] _modelCount Number of models in the world.
+/// \return The SDFormat string of the world.
+std::string makeWorldString(std::size_t _modelCount)
+{
+  std::string worldString =
+      "<?xml version='1.0'?>\n"
+      "<sdf version='1.9'>\n"
+      "  <world name='default'>\n";
+  for (std::size_t i = 0; i < _modelCount; ++i)
+  {
+    worldString +=
+        "    <model name='model_" + std::to_string(i) + "'>\n"
+        "      <pose>" + std::to_string(i) + " 0 0 0 0 0</pose>\n"
+        "      <link name='base'>\n"
+        "        <inertial><mass>1.0</mass></inertial>\n"
+        "        <collision name='collision'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </collision>\n"
+        "        <visual name='visual'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </visual>\n"
+        "      </link>\n"
+        "      <link name='arm'>\n"
+        "        <pose>0 0 1 0 0 0</pose>\n"
+        "      </link>\n"
+        "      <joint name='joint' type='revolute'>\n"
+        "        <parent>base</parent>\n"
+        "        <child>arm</child>\n"
+        "        <axis><xyz>0 0 1</xyz></axis>\n"
+        "      </joint>\n"
+        "    </model>\n";
+  }
+  worldString +=
+      "  </world>\n"
+      "</sdf>";
+  return worldString;
+}
+
+/////////////////////////////////////////////////
+/// \brief Load kWorldCount worlds with Root::LoadSdfString, spread over
+/// _threadCount threads, and print the throughput.
+/// \param[in] _worldString World to load.
+/// \param[in] _threadCount Number of threads.
+void timeConcurrentLoad(const std::string &_worldString,
+                        std::size_t _threadCount)
+{
+  const sdf::ParserConfig config;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> failures{0};
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < _threadCount; ++t)
+  {
+    threads.emplace_back([&]()
+    {
+      while (next++ < kWorldCount)
+      {
+        sdf::Root root;
+        if (!root.LoadSdfString(_worldString, config).empty())
+          ++failures;
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(0u, failures);
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << _threadCount << " threads: loaded " << kWorldCount
+            << " worlds in " << seconds * 1000.0 << " ms ("
+            << kWorldCount / seconds << " worlds/s)" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentLoad, Throughput)
+{
+  const std::string worldString = makeWorldString(100u);
+
+  // Warm up the spec description cache so it is not counted.
+  sdf::Root warmUp;
+  ASSERT_TRUE(warmUp.LoadSdfString(worldString).empty());
+
+  const std::size_t maxThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1u; threads <= maxThreads; threads *= 2u)
+  {
+    timeConcurrentLoad(worldString, threads);
+  }
+}
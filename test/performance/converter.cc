@@ -0,0 +1,124 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <tinyxml2.h>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Converter.hh"
+#include "test_config.h"
+#include "test_utils.hh"
+
+/////////////////////////////////////////////////
+/// \brief Find the SDFormat files in a directory and its subdirectories.
+/// \param[in] _dir The directory.
+/// \param[out] _files The files that were found, by SDFormat version.
+void findSdfFilesByVersion(
+    const std::string &_dir,
+    std::map<std::string, std::vector<std::string>> &_files)
+{
+  std::vector<std::string> files;
+  sdf::testing::FindSdfFiles(_dir, files);
+  for (const auto &path : files)
+  {
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(path.c_str()) != tinyxml2::XML_SUCCESS)
+      continue;
+    tinyxml2::XMLElement *sdfElem = doc.FirstChildElement("sdf");
+    if (sdfElem && sdfElem->Attribute("version"))
+      _files[sdfElem->Attribute("version")].push_back(path);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Time converting files to the latest version, either with one call
+/// or with a call for each version in between.
+/// \param[in] _files The files.
+/// \param[in] _steps The versions to convert to, in order. Only the last
+/// one is used when converting with one call.
+/// \param[in] _stepwise True to convert one version at a time.
+/// \param[in] _repeat Number of times each file is converted.
+/// \return The time it took, in milliseconds.
+double timeConvert(const std::vector<std::string> &_files,
+                   const std::vector<std::string> &_steps,
+                   bool _stepwise, int _repeat)
+{
+  std::vector<std::string> contents;
+  for (const auto &file : _files)
+  {
+    tinyxml2::XMLDocument doc;
+    doc.LoadFile(file.c_str());
+    tinyxml2::XMLPrinter printer;
+    doc.Print(&printer);
+    contents.push_back(printer.CStr());
+  }
+
+  std::chrono::steady_clock::duration total{0};
+  for (int i = 0; i < _repeat; ++i)
+  {
+    for (const auto &content : contents)
+    {
+      tinyxml2::XMLDocument doc;
+      doc.Parse(content.c_str());
+
+      auto start = std::chrono::steady_clock::now();
+      if (_stepwise)
+      {
+        for (const auto &step : _steps)
+          EXPECT_TRUE(sdf::Converter::Convert(&doc, step));
+      }
+      else
+      {
+        EXPECT_TRUE(sdf::Converter::Convert(&doc, _steps.back()));
+      }
+      total += std::chrono::steady_clock::now() - start;
+    }
+  }
+  return std::chrono::duration<double, std::milli>(total).count();
+}
+
+/////////////////////////////////////////////////
+TEST(Converter, TestFilesToLatest)
+{
+  const std::vector<std::string> versions =
+      {"1.0", "1.2", "1.3", "1.4", "1.5", "1.6", "1.7", "1.8", "1.9"};
+
+  std::map<std::string, std::vector<std::string>> files;
+  findSdfFilesByVersion(sdf::testing::TestFile("integration"), files);
+
+  for (auto version = versions.begin(); version + 1 != versions.end();
+       ++version)
+  {
+    if (files.count(*version) == 0)
+      continue;
+
+    const std::vector<std::string> steps(version + 1, versions.end());
+    const auto &versionFiles = files[*version];
+    const int repeat = 200;
+    std::cout << versionFiles.size() << " files of version " << *version
+              << " converted " << repeat << " times to " << versions.back()
+              << ": " << timeConvert(versionFiles, steps, false, repeat)
+              << " ms at once, "
+              << timeConvert(versionFiles, steps, true, repeat)
+              << " ms one version at a time" << std::endl;
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/World.hh"
+
+/////////////////////////////////////////////////
+/// \brief Build a world with the given number of models, each containing a
+/// single link.
+/// \param[in] _modelCount Number of models to add to the world.
+/// \return The populated world.
+sdf::World makeWorld(std::size_t _modelCount)
+{
+  sdf::World world;
+  world.SetName("default");
+
+  for (std::size_t i = 0; i < _modelCount; ++i)
+  {
+    sdf::Link link;
+    link.SetName("link");
+
+    sdf::Model model;
+    model.SetName("model_" + std::to_string(i));
+    EXPECT_TRUE(model.AddLink(link));
+
+    EXPECT_TRUE(world.AddModel(model));
+  }
+
+  return world;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time World::ToElement for the given number of models.
+/// \param[in] _modelCount Number of models in the world.
+void timeWorldToElement(std::size_t _modelCount)
+{
+  sdf::World world = makeWorld(_modelCount);
+  ASSERT_EQ(_modelCount, world.ModelCount());
+
+  auto start = std::chrono::steady_clock::now();
+  sdf::ElementPtr elem = world.ToElement();
+  auto end = std::chrono::steady_clock::now();
+
+  ASSERT_NE(nullptr, elem);
+  std::size_t count = 0;
+  for (sdf::ElementPtr modelElem = elem->GetElement("model"); modelElem;
+       modelElem = modelElem->GetNextElement("model"))
+  {
+    ++count;
+  }
+  EXPECT_EQ(_modelCount, count);
+
+  std::cout << "World::ToElement with " << _modelCount << " models took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   end - start).count()
+            << " ms" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(DOMToElement, World1kModels)
+{
+  timeWorldToElement(1000u);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMToElement, World10kModels)
+{
+  timeWorldToElement(10000u);
+}
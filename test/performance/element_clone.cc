@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with the given number of models. Each model has a
+/// link with a collision, a visual and poses in degrees, so that both
+/// reparsed and non-reparsed params are cloned.
+/// \param[in] _modelCount Number of models in the world.
+/// \return The SDFormat string of the world.
+std::string makeWorldString(std::size_t _modelCount)
+{
+  std::string worldString =
+      "<?xml version='1.0'?>\n"
+      "<sdf version='1.9'>\n"
+      "  <world name='default'>\n";
+  for (std::size_t i = 0; i < _modelCount; ++i)
+  {
+    worldString +=
+        "    <model name='model_" + std::to_string(i) + "'>\n"
+        "      <pose degrees='true'>" + std::to_string(i) +
+        " 0 0 0 0 90</pose>\n"
+        "      <link name='link'>\n"
+        "        <inertial><mass>1.0</mass></inertial>\n"
+        "        <collision name='collision'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </collision>\n"
+        "        <visual name='visual'>\n"
+        "          <pose>0 0 0.5 0 0 0</pose>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </visual>\n"
+        "      </link>\n"
+        "    </model>\n";
+  }
+  worldString +=
+      "  </world>\n"
+      "</sdf>";
+  return worldString;
+}
+
+/////////////////////////////////////////////////
+TEST(ElementClone, LargeWorld)
+{
+  const std::size_t modelCount = 5000u;
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  ASSERT_TRUE(sdf::readString(makeWorldString(modelCount), sdfParsed));
+
+  const int runs = 5;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < runs; ++i)
+  {
+    sdf::ElementPtr clone = sdfParsed->Root()->Clone();
+    ASSERT_NE(nullptr, clone);
+    ASSERT_TRUE(clone->HasElement("world"));
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << "Element::Clone of a world with " << modelCount
+            << " models took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   end - start).count() / runs
+            << " ms on average" << std::endl;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Element.hh"
+
+/////////////////////////////////////////////////
+/// \brief Time iterating over the children of an element with
+/// GetNextElement, for an increasing number of children. Links and joints are
+/// interleaved so that iteration filtered by name skips elements.
+TEST(ElementIteration, GetNextElementScaling)
+{
+  for (std::size_t childCount : {100u, 1000u, 10000u, 100000u})
+  {
+    sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+    parent->SetName("model");
+    for (std::size_t i = 0; i < childCount; ++i)
+    {
+      sdf::ElementPtr child = std::make_shared<sdf::Element>();
+      child->SetName(i % 2 == 0 ? "link" : "joint");
+      parent->InsertElement(child, true);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t linkCount = 0;
+    for (sdf::ElementPtr link = parent->FindElement("link"); link;
+         link = link->GetNextElement("link"))
+    {
+      ++linkCount;
+    }
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_EQ((childCount + 1) / 2, linkCount);
+
+    std::size_t allCount = 0;
+    for (sdf::ElementPtr elem = parent->GetFirstElement(); elem;
+         elem = elem->GetNextElement())
+    {
+      ++allCount;
+    }
+    EXPECT_EQ(childCount, allCount);
+
+    std::cout << "Iterating over " << linkCount << " links out of "
+              << childCount << " children took "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     end - start).count()
+              << " us" << std::endl;
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with the given number of models, each with a
+/// link that has a collision and a visual.
+/// \param[in] _modelCount Number of models in the world.
+/// \return The SDFormat string of the world.
+std::string makeWorldString(std::size_t _modelCount)
+{
+  std::string worldString =
+      "<?xml version='1.0'?>\n"
+      "<sdf version='1.9'>\n"
+      "  <world name='default'>\n";
+  for (std::size_t i = 0; i < _modelCount; ++i)
+  {
+    worldString +=
+        "    <model name='model_" + std::to_string(i) + "'>\n"
+        "      <pose>" + std::to_string(i) + " 0 0 0 0 0</pose>\n"
+        "      <link name='link'>\n"
+        "        <inertial><mass>1.0</mass></inertial>\n"
+        "        <collision name='collision'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </collision>\n"
+        "        <visual name='visual'>\n"
+        "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+        "        </visual>\n"
+        "      </link>\n"
+        "    </model>\n";
+  }
+  worldString +=
+      "  </world>\n"
+      "</sdf>";
+  return worldString;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the resident set size of the process.
+/// \return The resident set size in kilobytes, or 0 if it is not known.
+std::size_t residentSetSize()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmRSS:") == 0)
+      return std::stoul(line.substr(6));
+  }
+  return 0;
+}
+
+/////////////////////////////////////////////////
+/// Report the memory used by the elements of a world with 50k models.
+TEST(ElementMemory, LargeWorld)
+{
+  const std::size_t modelCount = 50000u;
+  const std::string worldString = makeWorldString(modelCount);
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  const std::size_t rssBefore = residentSetSize();
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(sdf::readString(worldString, sdfParsed));
+  auto end = std::chrono::steady_clock::now();
+  const std::size_t rssAfter = residentSetSize();
+
+  std::cout << "Reading a world with " << modelCount << " models took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   end - start).count()
+            << " ms" << std::endl;
+  if (rssBefore > 0)
+  {
+    std::cout << "Its elements use " << (rssAfter - rssBefore) / 1024
+              << " MB" << std::endl;
+  }
+  std::cout << "The interned string table has "
+            << sdf::InternedString::TableSize() << " strings" << std::endl;
+}
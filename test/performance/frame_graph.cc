@@ -0,0 +1,168 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+
+#include "FrameSemantics.hh"
+#include "ScopedGraph.hh"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with _modelCount models that each have a link and a
+/// chain of _frameCount frames, where each frame is attached to the
+/// previous one.
+std::string frameChainWorld(std::size_t _modelCount, std::size_t _frameCount)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.9'><world name='default'>";
+  for (std::size_t m = 0; m < _modelCount; ++m)
+  {
+    stream << "<model name='model_" << m << "'><link name='frame_0'/>";
+    for (std::size_t f = 1; f <= _frameCount; ++f)
+    {
+      stream << "<frame name='frame_" << f << "' attached_to='frame_"
+             << f - 1 << "'><pose>0 0 0.1 0 0 0</pose></frame>";
+    }
+    stream << "</model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the resident set size of the process.
+/// \return The resident set size in kilobytes, or 0 if it is not known.
+std::size_t residentSetSize()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmRSS:") == 0)
+      return std::stoul(line.substr(6));
+  }
+  return 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time looking up every frame of a world with 50k frames by name,
+/// and resolving the body each frame is attached to, before and after the
+/// graphs are frozen, and report the memory of the frozen copies, which
+/// replace the graphs.
+TEST(FrameGraph, FrozenLookups)
+{
+  const std::size_t modelCount = 1000;
+  const std::size_t frameCount = 47;
+
+  sdf::Root root;
+  sdf::Errors errors =
+      root.LoadSdfString(frameChainWorld(modelCount, frameCount));
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  std::size_t rss = residentSetSize();
+  auto frameGraph = sdf::ScopedGraph<sdf::FrameAttachedToGraph>(
+      std::make_shared<sdf::FrameAttachedToGraph>());
+  EXPECT_TRUE(sdf::buildFrameAttachedToGraph(frameGraph, world).empty());
+  auto poseGraph = sdf::ScopedGraph<sdf::PoseRelativeToGraph>(
+      std::make_shared<sdf::PoseRelativeToGraph>());
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(poseGraph, world).empty());
+  const std::size_t graphKb = residentSetSize() - rss;
+  const std::size_t vertexCount = frameGraph.Map().size();
+  EXPECT_LT(50000u, vertexCount);
+
+  // The scope of each model, and the local names of its frames.
+  std::vector<sdf::ScopedGraph<sdf::FrameAttachedToGraph>> scopes;
+  for (std::size_t m = 0; m < modelCount; ++m)
+    scopes.push_back(frameGraph.ChildModelScope("model_" + std::to_string(m)));
+  std::vector<std::string> names;
+  for (std::size_t f = 0; f <= frameCount; ++f)
+    names.push_back("frame_" + std::to_string(f));
+
+  auto lookUp = [&](std::vector<std::size_t> &_ids)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &scope : scopes)
+    {
+      for (const auto &name : names)
+        _ids.push_back(scope.VertexIdByName(name));
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  auto resolveBodies = [&](std::vector<std::string> &_bodies)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &scope : scopes)
+    {
+      for (const auto &name : names)
+      {
+        std::string body;
+        EXPECT_TRUE(
+            sdf::resolveFrameAttachedToBody(body, scope, name).empty());
+        _bodies.push_back(body);
+      }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+
+  std::vector<std::size_t> ids;
+  std::vector<std::string> bodies;
+  const double lookUpMs = lookUp(ids);
+  const double resolveMs = resolveBodies(bodies);
+
+  frameGraph.Freeze();
+  poseGraph.Freeze();
+  ASSERT_NE(nullptr, frameGraph.Frozen());
+  ASSERT_NE(nullptr, poseGraph.Frozen());
+  const std::size_t frozenBytes = frameGraph.Frozen()->MemoryUsage() +
+      poseGraph.Frozen()->MemoryUsage();
+
+  std::vector<std::size_t> frozenIds;
+  std::vector<std::string> frozenBodies;
+  const double frozenLookUpMs = lookUp(frozenIds);
+  const double frozenResolveMs = resolveBodies(frozenBodies);
+  EXPECT_EQ(ids, frozenIds);
+  EXPECT_EQ(bodies, frozenBodies);
+
+  // The graphs and their maps are released by freezing, so the frozen
+  // copies replace their memory. The resident set size is not reported
+  // after freezing, since the allocator may keep the released memory.
+  std::cout << vertexCount << " vertices per graph\n"
+            << "Memory of both graphs: " << graphKb << " kB resident\n"
+            << "Memory of both frozen copies, which replace the graphs: "
+            << frozenBytes / 1024 << " kB allocated, "
+            << (graphKb ? 100 * frozenBytes / 1024 / graphKb : 0)
+            << "% of the graphs\n"
+            << "VertexIdByName: " << lookUpMs << " ms, frozen "
+            << frozenLookUpMs << " ms for " << ids.size() << " names\n"
+            << "resolveFrameAttachedToBody: " << resolveMs << " ms, frozen "
+            << frozenResolveMs << " ms for " << bodies.size() << " frames"
+            << std::endl;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "sdf/Frame.hh"
+#include "sdf/Joint.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
+#include "sdf/World.hh"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with _modelCount models that each have
+/// _nestedCount nested models, which each have _linkCount links, a joint
+/// between each pair of consecutive links and a frame.
+std::string nestedWorld(std::size_t _modelCount, std::size_t _nestedCount,
+                        std::size_t _linkCount)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.9'><world name='default'>";
+  for (std::size_t m = 0; m < _modelCount; ++m)
+  {
+    stream << "<model name='model_" << m << "'>";
+    for (std::size_t n = 0; n < _nestedCount; ++n)
+    {
+      stream << "<model name='nested_" << n << "'>";
+      for (std::size_t l = 0; l < _linkCount; ++l)
+        stream << "<link name='link_" << l << "'/>";
+      for (std::size_t l = 1; l < _linkCount; ++l)
+      {
+        stream << "<joint name='joint_" << l << "' type='fixed'>"
+               << "<parent>link_" << l - 1 << "</parent>"
+               << "<child>link_" << l << "</child></joint>";
+      }
+      stream << "<frame name='frame' attached_to='link_0'/></model>";
+    }
+    stream << "</model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Time resolving every model, link, joint and frame of a world with
+/// about 10k entities by its name scoped to the world. Models and frames
+/// are resolved by the world. Links and joints are resolved by their
+/// top-level model, which is found by the world.
+TEST(NameLookup, FullyQualifiedNames)
+{
+  const std::size_t modelCount = 100;
+  const std::size_t nestedCount = 10;
+  const std::size_t linkCount = 5;
+
+  sdf::Root root;
+  sdf::Errors errors =
+      root.LoadSdfString(nestedWorld(modelCount, nestedCount, linkCount));
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(modelCount, world->ModelCount());
+
+  // Names of the entities, scoped to the world, along with the entities.
+  std::vector<std::pair<std::string, const sdf::Model *>> models;
+  std::vector<std::pair<std::string, const sdf::Link *>> links;
+  std::vector<std::pair<std::string, const sdf::Joint *>> joints;
+  std::vector<std::pair<std::string, const sdf::Frame *>> frames;
+  for (uint64_t m = 0; m < world->ModelCount(); ++m)
+  {
+    const sdf::Model *model = world->ModelByIndex(m);
+    models.emplace_back(model->Name(), model);
+    for (uint64_t n = 0; n < model->ModelCount(); ++n)
+    {
+      const sdf::Model *nested = model->ModelByIndex(n);
+      const std::string scope = model->Name() + "::" + nested->Name() + "::";
+      models.emplace_back(scope.substr(0, scope.size() - 2), nested);
+      for (uint64_t l = 0; l < nested->LinkCount(); ++l)
+      {
+        const sdf::Link *link = nested->LinkByIndex(l);
+        links.emplace_back(scope + link->Name(), link);
+      }
+      for (uint64_t j = 0; j < nested->JointCount(); ++j)
+      {
+        const sdf::Joint *joint = nested->JointByIndex(j);
+        joints.emplace_back(scope + joint->Name(), joint);
+      }
+      for (uint64_t f = 0; f < nested->FrameCount(); ++f)
+      {
+        const sdf::Frame *frame = nested->FrameByIndex(f);
+        frames.emplace_back(scope + frame->Name(), frame);
+      }
+    }
+  }
+  const std::size_t entityCount =
+      models.size() + links.size() + joints.size() + frames.size();
+  EXPECT_LT(10000u, entityCount);
+
+  // Split a name into the name of its top-level model and the rest.
+  auto topLevelModel = [&](const std::string &_name)
+  {
+    const auto index = _name.find("::");
+    return std::make_pair(world->ModelByName(_name.substr(0, index)),
+                          _name.substr(index + 2));
+  };
+
+  const int repeats = 10;
+  std::size_t resolved = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; ++r)
+  {
+    for (const auto &[name, model] : models)
+      resolved += world->ModelByName(name) == model;
+    for (const auto &[name, link] : links)
+    {
+      const auto [model, rest] = topLevelModel(name);
+      resolved += model->LinkByName(rest) == link;
+    }
+    for (const auto &[name, joint] : joints)
+    {
+      const auto [model, rest] = topLevelModel(name);
+      resolved += model->JointByName(rest) == joint;
+    }
+    for (const auto &[name, frame] : frames)
+      resolved += world->FrameByName(name) == frame;
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(repeats * entityCount, resolved);
+
+  const auto us =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+  std::cout << "Resolving " << entityCount << " entities by name " << repeats
+            << " times took " << us.count() << " us ("
+            << 1000.0 * us.count() / (repeats * entityCount)
+            << " ns per name)" << std::endl;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time building a model with 20k links, joints and frames through
+/// AddLink, AddJoint and AddFrame, which each check that the name of the new
+/// entity is not taken.
+TEST(NameLookup, AddEntities)
+{
+  const std::size_t count = 20000;
+
+  sdf::Model model;
+  model.SetName("model");
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    sdf::Link link;
+    link.SetName("link_" + std::to_string(i));
+    EXPECT_TRUE(model.AddLink(link));
+    sdf::Joint joint;
+    joint.SetName("joint_" + std::to_string(i));
+    EXPECT_TRUE(model.AddJoint(joint));
+    sdf::Frame frame;
+    frame.SetName("frame_" + std::to_string(i));
+    EXPECT_TRUE(model.AddFrame(frame));
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(count, model.LinkCount());
+  EXPECT_EQ(count, model.JointCount());
+  EXPECT_EQ(count, model.FrameCount());
+
+  const auto us =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+  std::cout << "Adding " << 3 * count << " entities took " << us.count()
+            << " us (" << 1000.0 * us.count() / (3 * count)
+            << " ns per entity)" << std::endl;
+}
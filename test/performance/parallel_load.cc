@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/World.hh"
+#include "sdf/parser.hh"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with _modelCount models that each have a nested
+/// model, and a few links with collisions and visuals connected by joints.
+/// \param[in] _modelCount Number of models in the world.
+/// \return The SDFormat string of the world.
+std::string makeWorldString(std::size_t _modelCount)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.9'><world name='default'>";
+  for (std::size_t m = 0; m < _modelCount; ++m)
+  {
+    stream << "<model name='model_" << m << "'>"
+           << "<pose>" << m << " 0 0 0 0 0</pose>";
+    for (const std::string link : {"base", "arm"})
+    {
+      stream << "<link name='" << link << "'>"
+             << "<inertial><mass>1.0</mass></inertial>"
+             << "<collision name='collision'>"
+             << "<geometry><box><size>1 1 1</size></box></geometry>"
+             << "</collision>"
+             << "<visual name='visual'>"
+             << "<geometry><box><size>1 1 1</size></box></geometry>"
+             << "</visual></link>";
+    }
+    stream << "<joint name='joint' type='revolute'>"
+           << "<parent>base</parent><child>arm</child>"
+           << "<axis><xyz>0 0 1</xyz></axis></joint>"
+           << "<model name='nested'><pose>0 0 1 0 0 0</pose>"
+           << "<link name='link'><visual name='visual'>"
+           << "<geometry><sphere><radius>0.5</radius></sphere></geometry>"
+           << "</visual></link></model></model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Time loading the DOM objects of a world with 10k models from its
+/// parsed elements, with an increasing number of threads.
+TEST(ParallelLoad, ThreadSweep)
+{
+  const std::size_t modelCount = 10000;
+  sdf::ParserConfig config;
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  sdf::Errors errors;
+  ASSERT_TRUE(sdf::readString(makeWorldString(modelCount), config,
+      sdfParsed, errors));
+  ASSERT_TRUE(errors.empty()) << errors;
+
+  // Load once first, so that the elements created for optional children
+  // with default values are not counted.
+  {
+    sdf::Root root;
+    errors = root.Load(sdfParsed, config);
+    ASSERT_TRUE(errors.empty()) << errors;
+  }
+
+  const unsigned int maxThreads =
+      std::max(2u, std::thread::hardware_concurrency());
+  double serialMs = 0;
+  for (unsigned int threads = 1u; threads <= maxThreads; threads *= 2u)
+  {
+    config.SetLoadThreadCount(threads);
+
+    sdf::Root root;
+    auto start = std::chrono::steady_clock::now();
+    errors = root.Load(sdfParsed, config);
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_TRUE(errors.empty()) << errors;
+    ASSERT_NE(nullptr, root.WorldByIndex(0));
+    EXPECT_EQ(modelCount, root.WorldByIndex(0)->ModelCount());
+
+    const double ms =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    if (threads == 1u)
+      serialMs = ms;
+    std::cout << threads << " threads: loaded " << modelCount
+              << " models in " << ms << " ms (speedup "
+              << serialMs / ms << ")" << std::endl;
+  }
+}
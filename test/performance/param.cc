@@ -0,0 +1,144 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Color.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/Param.hh"
+#include "sdf/Types.hh"
+
+/// \brief Number of iterations of each timed operation.
+static const int kIterations = 100000;
+
+/////////////////////////////////////////////////
+/// \brief Time SetFromString, Set, Get and GetAsString for a parameter type.
+/// \param[in] _typeName Name of the parameter type.
+/// \param[in] _valueStr Value used with SetFromString.
+template<typename T>
+void timeParam(const std::string &_typeName, const std::string &_valueStr)
+{
+  sdf::Param param("key", _typeName, _valueStr, false, "description");
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i)
+  {
+    ASSERT_TRUE(param.SetFromString(_valueStr));
+  }
+  auto setFromString = std::chrono::steady_clock::now();
+
+  T value;
+  ASSERT_TRUE(param.Get<T>(value));
+  for (int i = 0; i < kIterations; ++i)
+  {
+    ASSERT_TRUE(param.Set<T>(value));
+  }
+  auto set = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < kIterations; ++i)
+  {
+    ASSERT_TRUE(param.Get<T>(value));
+  }
+  auto get = std::chrono::steady_clock::now();
+
+  std::size_t length = 0;
+  for (int i = 0; i < kIterations; ++i)
+  {
+    length += param.GetAsString().size();
+  }
+  auto getAsString = std::chrono::steady_clock::now();
+  EXPECT_GT(length, 0u);
+
+  auto nsPerCall = [](auto _start, auto _end)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        _end - _start).count() / kIterations;
+  };
+
+  std::cout << std::setw(14) << _typeName
+            << ": SetFromString " << std::setw(6)
+            << nsPerCall(start, setFromString) << " ns"
+            << ", Set " << std::setw(6) << nsPerCall(setFromString, set)
+            << " ns"
+            << ", Get " << std::setw(6) << nsPerCall(set, get) << " ns"
+            << ", GetAsString " << std::setw(6)
+            << nsPerCall(get, getAsString) << " ns" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(Param, AllTypes)
+{
+  timeParam<bool>("bool", "true");
+  timeParam<char>("char", "a");
+  timeParam<std::string>("string", "hello");
+  timeParam<int>("int", "-42");
+  timeParam<std::uint64_t>("uint64_t", "42");
+  timeParam<unsigned int>("unsigned int", "42");
+  timeParam<double>("double", "3.14159");
+  timeParam<float>("float", "2.5");
+  timeParam<sdf::Time>("time", "1 500");
+  timeParam<ignition::math::Angle>("angle", "1.57");
+  timeParam<ignition::math::Color>("color", "0.1 0.2 0.3 1");
+  timeParam<ignition::math::Vector2i>("vector2i", "1 2");
+  timeParam<ignition::math::Vector2d>("vector2d", "1.5 2.5");
+  timeParam<ignition::math::Vector3d>("vector3", "1 2 3");
+  timeParam<ignition::math::Quaterniond>("quaternion", "1 0 0 0");
+  timeParam<ignition::math::Pose3d>("pose", "1 2 3 0.1 0.2 0.3");
+}
+
+/////////////////////////////////////////////////
+TEST(Param, NumericConversions)
+{
+  sdf::Param doubleParam("key", "double", "0", false, "description");
+  sdf::Param intParam("key", "int", "0", false, "description");
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i)
+  {
+    ASSERT_TRUE(doubleParam.Set<int>(i));
+  }
+  auto set = std::chrono::steady_clock::now();
+
+  double sum = 0;
+  for (int i = 0; i < kIterations; ++i)
+  {
+    ASSERT_TRUE(intParam.Set<int>(i));
+    double value;
+    ASSERT_TRUE(intParam.Get<double>(value));
+    sum += value;
+  }
+  auto get = std::chrono::steady_clock::now();
+  EXPECT_GT(sum, 0.0);
+
+  std::cout << "Set<int> on a double param "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   set - start).count() / kIterations << " ns"
+            << ", Get<double> on an int param "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   get - set).count() / kIterations << " ns" << std::endl;
+}
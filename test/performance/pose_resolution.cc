@@ -0,0 +1,121 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/Joint.hh"
+#include "sdf/Link.hh"
+#include "sdf/Model.hh"
+#include "sdf/Root.hh"
+#include "sdf/SemanticPose.hh"
+#include "sdf/World.hh"
+
+/////////////////////////////////////////////////
+/// \brief Write a world with _modelCount models that each have a chain of
+/// _linkCount links, where the pose of each link is relative to the
+/// previous one and a fixed joint connects them.
+std::string chainWorld(std::size_t _modelCount, std::size_t _linkCount)
+{
+  std::ostringstream stream;
+  stream << "<sdf version='1.9'><world name='default'>";
+  for (std::size_t m = 0; m < _modelCount; ++m)
+  {
+    stream << "<model name='model_" << m << "'>"
+           << "<pose>" << m << " 0 0 0 0 0</pose>"
+           << "<link name='link_0'/>";
+    for (std::size_t l = 1; l < _linkCount; ++l)
+    {
+      stream << "<link name='link_" << l << "'>"
+             << "<pose relative_to='link_" << l - 1 << "'>"
+             << "0 0 0.1 0 0 0.1</pose></link>"
+             << "<joint name='joint_" << l << "' type='fixed'>"
+             << "<parent>link_" << l - 1 << "</parent>"
+             << "<child>link_" << l << "</child></joint>";
+    }
+    stream << "</model>";
+  }
+  stream << "</world></sdf>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Time resolving the poses of every link and joint of a world with
+/// about 100k frames, first one SemanticPose at a time relative to the
+/// model, and then all at once relative to the world.
+TEST(PoseResolution, ChainedLinks)
+{
+  const std::size_t modelCount = 2500;
+  const std::size_t linkCount = 20;
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(chainWorld(modelCount, linkCount));
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+  ASSERT_EQ(modelCount, world->ModelCount());
+
+  std::size_t resolved = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t m = 0; m < world->ModelCount(); ++m)
+  {
+    const sdf::Model *model = world->ModelByIndex(m);
+    for (std::size_t l = 0; l < model->LinkCount(); ++l)
+    {
+      ignition::math::Pose3d pose;
+      resolved += model->LinkByIndex(l)->SemanticPose().Resolve(
+          pose).empty();
+    }
+    for (std::size_t j = 0; j < model->JointCount(); ++j)
+    {
+      ignition::math::Pose3d pose;
+      resolved += model->JointByIndex(j)->SemanticPose().Resolve(
+          pose).empty();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(modelCount * (2 * linkCount - 1), resolved);
+  std::cout << "SemanticPose::Resolve: " << resolved << " poses in "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms" << std::endl;
+
+  std::map<std::string, ignition::math::Pose3d> poses;
+  start = std::chrono::steady_clock::now();
+  errors = world->ResolveAllPoses(poses);
+  end = std::chrono::steady_clock::now();
+  EXPECT_TRUE(errors.empty()) << errors;
+  std::cout << "World::ResolveAllPoses: " << poses.size() << " poses in "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms" << std::endl;
+
+  // Models with their __model__ frames, links, joints and the world frame.
+  EXPECT_EQ(modelCount * (2 * linkCount + 1) + 1, poses.size());
+
+  // The last link of the last model agrees with its SemanticPose.
+  const std::string lastModel = "model_" + std::to_string(modelCount - 1);
+  const std::string lastLink = "link_" + std::to_string(linkCount - 1);
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(world->ModelByName(lastModel)->LinkByName(lastLink)
+      ->SemanticPose().Resolve(pose).empty());
+  EXPECT_EQ(poses[lastModel] * pose, poses[lastModel + "::" + lastLink]);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with the given number of models. Each model has
+/// a chain of links connected by revolute joints.
+/// \param[in] _modelCount Number of models in the world.
+/// \param[in] _linkCount Number of links in each model.
+/// \return The SDFormat string of the world.
+std::string makeWorldString(std::size_t _modelCount, std::size_t _linkCount)
+{
+  std::string worldString =
+      "<?xml version='1.0'?>\n"
+      "<sdf version='1.9'>\n"
+      "  <world name='default'>\n";
+  for (std::size_t i = 0; i < _modelCount; ++i)
+  {
+    worldString +=
+        "    <model name='model_" + std::to_string(i) + "'>\n"
+        "      <pose>" + std::to_string(i) + " 0 0 0 0 0</pose>\n";
+    for (std::size_t j = 0; j < _linkCount; ++j)
+    {
+      const std::string link = "link_" + std::to_string(j);
+      worldString +=
+          "      <link name='" + link + "'>\n"
+          "        <pose>0 0 " + std::to_string(j) + " 0 0 0</pose>\n"
+          "        <inertial><mass>1.0</mass></inertial>\n"
+          "      </link>\n";
+      if (j > 0)
+      {
+        worldString +=
+            "      <joint name='joint_" + std::to_string(j) +
+            "' type='revolute'>\n"
+            "        <parent>link_" + std::to_string(j - 1) + "</parent>\n"
+            "        <child>" + link + "</child>\n"
+            "        <axis><xyz>0 0 1</xyz></axis>\n"
+            "      </joint>\n";
+      }
+    }
+    worldString += "    </model>\n";
+  }
+  worldString +=
+      "  </world>\n"
+      "</sdf>";
+  return worldString;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time parsing a world into an Element tree and loading it with
+/// Root::Load.
+/// \param[in] _modelCount Number of models in the world.
+/// \param[in] _linkCount Number of links in each model.
+void timeRootLoad(std::size_t _modelCount, std::size_t _linkCount)
+{
+  const std::string worldString = makeWorldString(_modelCount, _linkCount);
+
+  auto start = std::chrono::steady_clock::now();
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  ASSERT_TRUE(sdf::readString(worldString, sdfParsed));
+  auto parsed = std::chrono::steady_clock::now();
+
+  sdf::Root root;
+  sdf::Errors errors = root.Load(sdfParsed);
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_TRUE(errors.empty()) << errors;
+  ASSERT_NE(nullptr, root.WorldByIndex(0));
+  EXPECT_EQ(_modelCount, root.WorldByIndex(0)->ModelCount());
+
+  std::cout << "World with " << _modelCount << " models of " << _linkCount
+            << " links: parsing took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   parsed - start).count()
+            << " ms, Root::Load took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   end - parsed).count()
+            << " ms" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(RootLoad, ManyModels)
+{
+  timeRootLoad(5000u, 2u);
+}
+
+/////////////////////////////////////////////////
+TEST(RootLoad, ManyLinks)
+{
+  timeRootLoad(10u, 500u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Time loading a flat world of many models, and then checking the
+/// uniqueness of the names in it as `ign sdf --check` does.
+TEST(RootLoad, FlatWorldNameChecks)
+{
+  const std::size_t modelCount = 50000u;
+  timeRootLoad(modelCount, 1u);
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(makeWorldString(modelCount, 1u));
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(sdf::recursiveSiblingUniqueNames(root.Element()));
+  EXPECT_TRUE(sdf::recursiveSameTypeUniqueNames(root.Element()));
+  EXPECT_TRUE(sdf::recursiveSiblingNoDoubleColonInNames(root.Element()));
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << "Checking the names of a world with " << modelCount
+            << " models took "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   end - start).count()
+            << " ms" << std::endl;
+}
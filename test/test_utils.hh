@@ -17,11 +17,21 @@
 #ifndef SDF_TEST_UTILS_HH_
 #define SDF_TEST_UTILS_HH_
 
+#include <cstdio>
+#include <fstream>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "sdf/Console.hh"
+#include "sdf/Element.hh"
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
 #include "sdf/Root.hh"
+#include "sdf/SDFImpl.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
 
 namespace sdf
 {
@@ -29,8 +39,8 @@ namespace testing
 {
 
 /// \brief Calls a function when going out of scope.
-/// Taken from:
-/// https://github.com/ros2/rclcpp/blob/master/rclcpp/include/rclcpp/scope_exit.hpp
+/// Taken from rclcpp/scope_exit.hpp in:
+/// https://github.com/ros2/rclcpp/blob/master/rclcpp/include
 template <typename Callable>
 struct ScopeExit
 {
@@ -112,7 +122,7 @@ class RedirectConsoleStream
 /// \param[in] _root The sdf::Root object to load the file into
 /// \return True if a file named _fileName was successfully loaded into
 /// _root. False otherwise
-bool LoadSdfFile(const std::string &_fileName, sdf::Root &_root)
+inline bool LoadSdfFile(const std::string &_fileName, sdf::Root &_root)
 {
   auto errors = _root.Load(_fileName);
   if (!errors.empty())
@@ -126,6 +136,142 @@ bool LoadSdfFile(const std::string &_fileName, sdf::Root &_root)
   return true;
 }
 
+/// \brief Find the SDFormat files in a directory and its subdirectories.
+/// \param[in] _dir The directory.
+/// \param[out] _files The files that were found.
+inline void FindSdfFiles(const std::string &_dir,
+                         std::vector<std::string> &_files)
+{
+  for (sdf::filesystem::DirIter it(_dir); it != sdf::filesystem::DirIter();
+       ++it)
+  {
+    const std::string path = *it;
+    if (sdf::filesystem::is_directory(path))
+      FindSdfFiles(path, _files);
+    else if (path.size() > 4 && path.substr(path.size() - 4) == ".sdf")
+      _files.push_back(path);
+  }
+}
+
+/// \brief Copy a directory and its subdirectories.
+/// \param[in] _from The directory to copy.
+/// \param[in] _to The copy, which is created.
+/// \param[out] _sdfFiles The SDFormat files that were copied.
+inline void CopyDirectory(const std::string &_from, const std::string &_to,
+                          std::vector<std::string> &_sdfFiles)
+{
+  sdf::filesystem::create_directory(_to);
+  for (sdf::filesystem::DirIter it(_from); it != sdf::filesystem::DirIter();
+       ++it)
+  {
+    const std::string path = *it;
+    const std::string copy =
+        sdf::filesystem::append(_to, sdf::filesystem::basename(path));
+    if (sdf::filesystem::is_directory(path))
+    {
+      CopyDirectory(path, copy, _sdfFiles);
+      continue;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    std::ofstream out(copy, std::ios::binary);
+    out << in.rdbuf();
+    if (path.size() > 4 && path.substr(path.size() - 4) == ".sdf")
+      _sdfFiles.push_back(copy);
+  }
+}
+
+/// \brief Create an empty directory for the files of a test.
+/// \param[in] _name Name of the directory.
+/// \return Full path of the directory, or an empty string if there is no
+/// temporary directory.
+inline std::string TmpDirectory(const std::string &_name)
+{
+  std::string tmpDir;
+  if (!TestTmpPath(tmpDir))
+    return "";
+  sdf::filesystem::create_directory(tmpDir);
+  const std::string dir = sdf::filesystem::append(tmpDir, _name);
+  sdf::filesystem::create_directory(dir);
+  for (sdf::filesystem::DirIter it(dir); it != sdf::filesystem::DirIter();
+       ++it)
+  {
+    std::remove((*it).c_str());
+  }
+  return dir;
+}
+
+/// \brief Print where an element and all its descendants were read from.
+/// \param[in] _elem The element.
+/// \param[out] _out Stream to print to.
+inline void PrintSource(sdf::ElementPtr _elem, std::ostream &_out)
+{
+  _out << _elem->GetName() << ' ' << _elem->LineNumber().value_or(-1) << ' '
+       << _elem->XmlPath() << ' ' << _elem->FilePath() << ' '
+       << _elem->OriginalVersion() << ' ' << _elem->GetExplicitlySetInFile()
+       << '\n';
+  if (_elem->GetIncludeElement())
+    _out << _elem->GetIncludeElement()->ToString("include: ");
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    PrintSource(child, _out);
+  }
+}
+
+/// \brief Print everything that a read gave.
+/// \param[in] _result The result of the read.
+/// \param[in] _sdf The SDF object that was read into.
+/// \param[in] _errors The errors of the read.
+/// \return The result, the element tree, the source of each element and the
+/// errors.
+inline std::string PrintRead(bool _result, const sdf::SDFPtr &_sdf,
+                             const sdf::Errors &_errors)
+{
+  std::stringstream out;
+  out << _result << ' ' << _sdf->FilePath() << ' ' << _sdf->OriginalVersion()
+      << '\n' << _sdf->Root()->ToString("");
+  PrintSource(_sdf->Root(), out);
+  for (const auto &error : _errors)
+  {
+    out << error << ' ' << error.LineNumber().value_or(-1) << ' '
+        << error.XmlPath().value_or("") << '\n';
+  }
+  return out.str();
+}
+
+/// \brief Read a file and print everything that is read.
+/// \param[in] _filename The file.
+/// \param[in] _config Parser configuration.
+/// \return See PrintRead.
+inline std::string ReadFileToString(const std::string &_filename,
+                                    const sdf::ParserConfig &_config)
+{
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf, _config);
+  sdf::Errors errors;
+  const bool result = sdf::readFile(_filename, _config, sdf, errors);
+  return PrintRead(result, sdf, errors);
+}
+
+/// \brief Read a document from a string and print everything that is read.
+/// \param[in] _xml The document.
+/// \param[in] _config Parser configuration.
+/// \param[in] _convert Convert the document to the latest version if true.
+/// \return See PrintRead.
+inline std::string ReadStringToString(const std::string &_xml,
+                                      const sdf::ParserConfig &_config,
+                                      bool _convert = true)
+{
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf, _config);
+  sdf::Errors errors;
+  const bool result = _convert ?
+      sdf::readString(_xml, _config, sdf, errors) :
+      sdf::readStringWithoutConversion(_xml, _config, sdf, errors);
+  return PrintRead(result, sdf, errors);
+}
+
 } // namespace testing
 } // namespace sdf
 